@@ -2,6 +2,8 @@
 
 in vec3 APosition;
 in vec3 ANormal;
+in vec3 APositionNext;
+in vec3 ANormalNext;
 in vec3 AOffset;
 
 out vec3 SNormal;
@@ -11,11 +13,14 @@ uniform mat4 UTransform = mat4(1, 0, 0, 0,
                                0, 1, 0, 0,
                                0, 0, 1, 0,
                                0, 0, 0, 1);
+// Blend factor from the previous simulation state to the current one.
+uniform float UAlpha = 0.0;
 
 void main()
 {
-  vec3 pos_fin = APosition + AOffset;
+  vec3 position = mix(APosition, APositionNext, UAlpha);
+  vec3 pos_fin = position + AOffset;
   gl_Position = UTransform * vec4(pos_fin.x, pos_fin.y, pos_fin.z, 1.0);
-  SNormal = ANormal;
+  SNormal = mix(ANormal, ANormalNext, UAlpha);
   SFragPos = pos_fin;
 }
@@ -1,199 +1,156 @@
-//////////////////////////////////////////////////////////////////////////////
-/// @file Action.hh
-/// @author Connor Deakin
-/// @email connor.deakin@digipen.edu
-/// @date 2017-07-09
-///
-/// @brief Contains the interface and implementation of the Action class.
-///////////////////////////////////////////////////////////////////////////////
-#pragma once
-
-#include "GenericAction.h"
-
-//! The types ease types that can be used for Actions. More can be added
-// upon request.
-enum ACTIONTYPE
-{
-  LINEAR, QUADIN, QUADOUT, QUADOUTIN,
-  NUMTYPES
-};
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Actions allow for value fading over time. Given a the value that
-/// will be changed, its starting value, ending value, the amount of time it
-/// must change over, and an ease type, the value will change over the given
-/// time frame with the appropriate ease type.
-///
-/// @par Important Notes
-/// - The type of the value must have the + and * operations defined.
-/// - Actions can only be created with the Action<T>::Create function.
-///////////////////////////////////////////////////////////////////////////////
-/// Wants: strenght parameter for giving the action different highs and lows.
-template <typename T>
-class Action : public GenericAction
-{
-public:
-  static void Create(T & value, T start, T end, float time, ACTIONTYPE type);
-private:
-  Action(T & value, T & start, T & end, float time, ACTIONTYPE type);
-  virtual void Update();
-  void Linear(float time_passed);
-  void QuadOut(float time_passed);
-  void QuadIn(float time_passed);
-  void QuadOutIn(float time_passed);
-  //! The value that will change over time.
-  T & m_Value;
-  //! The starting position of the value.
-  T m_Start;
-  //! The middle position of the value.
-  T m_Mid;
-  //! The ending position of the value.
-  T m_End;
-  //! The distance that is being traveled.
-  T m_Travel;
-  //! Half of the distance that is being traveled.
-  T m_HalfTravel;
-  //! The time at which the Action began.
-  float m_StartTime;
-  //! The amount of time the Action must take.
-  float m_Time;
-  //! Half of the amount of time the Action must take.
-  float m_HalfTime;
-  //! The ease type of the Action.
-  ACTIONTYPE m_Type;
-};
-
-#include "Time.h"
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Creates an Action that will fade a value over time.
-///
-/// @tparam T The type of the value that the Action is being created for.
-/// @param value The value that will fade over time.
-/// @param start Where the value will begin.
-/// @param end Where the value will end.
-/// @param time The amount of time the action will take.
-/// @param type The ease type that the Action will perform on the value.
-///////////////////////////////////////////////////////////////////////////////
-template<typename T>
-inline void Action<T>::Create(T & value, T start, T end, float time, ACTIONTYPE type)
-{
-  Action<T> * new_action = new Action<T>(value, start, end, time, type);
-  m_AllActions.push_back(new_action);
-}
-
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Instantiates an Action that will fade a value over time.
-///
-/// @tparam T The type of the value that the Action is being created for.
-/// @param value The value that will fade over time.
-/// @param start Where the value will begin.
-/// @param end Where the value will end.
-/// @param time The amount of time the action will take.
-/// @param type The ease type that the Action will perform on the value.
-///////////////////////////////////////////////////////////////////////////////
-template<typename T>
-Action<T>::Action(T & value, T & start, T & end, float time, ACTIONTYPE type) :
-  m_Value(value), m_Start(start), m_End(end), m_Travel(end - start),
-  m_StartTime(Time::TotalTime()), m_Time(time), m_Type(type)
-{
-  if (m_Type == QUADOUTIN) {
-    m_HalfTravel = m_Travel * 0.5f;
-    m_HalfTime = m_Time * 0.5f;
-    m_Mid = m_Start + m_HalfTravel;
-  }
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Updates the value to its new value according to the Action ease
-/// type
-///
-/// @tparam T The type of the value that the Action is acting on.
-///////////////////////////////////////////////////////////////////////////////
-template<typename T>
-void Action<T>::Update()
-{
-  float time_passed = Time::TotalTime() - m_StartTime;
-  // ending action
-  if (time_passed >= m_Time) {
-    m_Value = m_End;
-    m_Done = true;
-    return;
-  }
-  // middle of action - finding ease type
-  switch (m_Type)
-  {
-  case LINEAR: Linear(time_passed);  break;
-  case QUADIN: QuadIn(time_passed); break;
-  case QUADOUT: QuadOut(time_passed); break;
-  case QUADOUTIN: QuadOutIn(time_passed); break;
-  }
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Updates the Action value with a linear ease.
-///
-/// @tparam T The type of the value that the Action is acting on.
-/// @param time_passed The amount of time that has passed since creation.
-///////////////////////////////////////////////////////////////////////////////
-template<typename T>
-inline void Action<T>::Linear(float time_passed)
-{
-  float percentage = (Time::TotalTime() - m_StartTime) / m_Time;
-  m_Value = m_Start + percentage * m_Travel;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Updates the Action value with a QuadOut (x * x) ease.
-///
-/// @tparam T The type of the value that the Action is acting on.
-/// @param time_passed The amount of time that has passed since creation.
-///////////////////////////////////////////////////////////////////////////////
-template<typename T>
-inline void Action<T>::QuadOut(float time_passed)
-{
-  float percentage = time_passed / m_Time;
-  m_Value = m_Start + (percentage * percentage) * m_Travel;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Updates the Action value with a QuadIn ease. A traditional
-/// quadratic that is first flipped, then pushed forward 1 on both the
-/// x and y axis.
-/// (-1 *(x - 1)^2) + 1 
-///
-/// @tparam T The type of the value that the Action is acting on.
-/// @param time_passed The amount of time that has passed since creation.
-///////////////////////////////////////////////////////////////////////////////
-template<typename T>
-inline void Action<T>::QuadIn(float time_passed)
-{
-  float percentage = time_passed / m_Time;
-  float scaler = ((-percentage + 1.0f) * (percentage - 1.0f)) + 1.0f;
-  m_Value = m_Start + scaler * m_Travel;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Updates the Action value with a QuadOutIn ease. This ease will
-/// begin as QuadOut, but halfway through, it will switch to QuadIn.
-///
-/// @tparam T The type of the value that the Action is acting on.
-/// @param time_passed The amount of time that has passed since creation.
-///////////////////////////////////////////////////////////////////////////////
-template<typename T>
-inline void Action<T>::QuadOutIn(float time_passed)
-{
-  // QuadOut ease
-  if (time_passed < m_HalfTime) {
-    float perc = time_passed / m_HalfTime;
-    float scaler = perc * perc;
-    m_Value = m_Start + scaler * m_HalfTravel;
-  }
-  // QuadIn ease
-  else{
-    float perc = (time_passed - m_HalfTime) / m_HalfTime;
-    float scaler = ((-perc + 1.0f) * (perc - 1.0f)) + 1.0f;
-    m_Value = m_Mid + scaler * m_HalfTravel;
-  }
-}
\ No newline at end of file
+//////////////////////////////////////////////////////////////////////////////
+/// @file Action.hh
+/// @author Connor Deakin
+/// @email connor.deakin@digipen.edu
+/// @date 2017-07-09
+///
+/// @brief Contains the interface and implementation of the Action class.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "GenericAction.h"
+
+//! The types ease types that can be used for Actions. More can be added
+// upon request.
+enum ACTIONTYPE
+{
+  LINEAR, QUADIN, QUADOUT, QUADOUTIN,
+  NUMTYPES
+};
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Actions allow for value fading over time. Given a the value that
+/// will be changed, its starting value, ending value, the amount of time it
+/// must change over, and an ease type, the value will change over the given
+/// time frame with the appropriate ease type.
+///
+/// Every Action of type T is stored in a single pool. The values of all
+/// Actions in the pool are kept in contiguous arrays and updated in one
+/// tight loop during GenericAction::UpdateAll.
+///
+/// @par Important Notes
+/// - The type of the value must have the + and * operations defined.
+/// - Actions can only be created with the Action<T>::Create function.
+/// - The value being changed must outlive the Action. Cancel the Action with
+///   the returned handle if the value is destroyed early.
+///////////////////////////////////////////////////////////////////////////////
+/// Wants: strenght parameter for giving the action different highs and lows.
+template <typename T>
+class Action : public GenericAction
+{
+public:
+  static ActionHandle Create(T & value, T start, T end, float time, 
+    ACTIONTYPE type);
+private:
+  Action() {}
+  static Action<T> & Pool();
+  virtual void Update(float time);
+  virtual void SwapRemove(unsigned index);
+  //! The values that will change over time.
+  std::vector<T *> m_Values;
+  //! The starting position of the values.
+  std::vector<T> m_Starts;
+  //! The distance that is being traveled by the values.
+  std::vector<T> m_Travels;
+  //! The ending position of the values.
+  std::vector<T> m_Ends;
+};
+
+#include "Time.h"
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Creates an Action that will fade a value over time.
+///
+/// @tparam T The type of the value that the Action is being created for.
+/// @param value The value that will fade over time.
+/// @param start Where the value will begin.
+/// @param end Where the value will end.
+/// @param time The amount of time the action will take.
+/// @param type The ease type that the Action will perform on the value.
+///
+/// @return A handle that can be used to cancel the Action. If the time is
+///   not positive, the value is set to the end value immediately and the
+///   handle will not refer to any Action.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+inline ActionHandle Action<T>::Create(T & value, T start, T end, float time,
+  ACTIONTYPE type)
+{
+  if (time <= 0.0f) {
+    value = end;
+    return ActionHandle();
+  }
+  Action<T> & pool = Pool();
+  pool.m_Values.push_back(&value);
+  pool.m_Starts.push_back(start);
+  pool.m_Travels.push_back(end - start);
+  pool.m_Ends.push_back(end);
+  return pool.AddAction(Time::TotalTime(), time, type);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the pool that stores every Action of type T. The pool is
+/// created the first time an Action of type T is created.
+///
+/// @tparam T The type of the values in the pool.
+///
+/// @return The pool for type T.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+Action<T> & Action<T>::Pool()
+{
+  static Action<T> * pool = new Action<T>();
+  return *pool;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Updates every value in the pool according to its ease type. The
+/// ease percentages are computed for the entire pool first, then applied in
+/// a single pass. Finished Actions are removed afterwards by walking the pool
+/// backwards so no Action is skipped when the last Action is swapped in.
+///
+/// @tparam T The type of the values that the Actions are acting on.
+/// @param time The current total time.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void Action<T>::Update(float time)
+{
+  ComputeScalers(time);
+  unsigned size = (unsigned)m_Values.size();
+  const float * scalers = m_Scalers.data();
+  T * const * values = m_Values.data();
+  const T * starts = m_Starts.data();
+  const T * travels = m_Travels.data();
+  for (unsigned i = 0; i < size; ++i)
+    *values[i] = starts[i] + scalers[i] * travels[i];
+  // ending actions
+  for (unsigned i = size; i-- > 0;) {
+    if (scalers[i] >= 1.0f) {
+      *values[i] = m_Ends[i];
+      RemoveAction(i);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Removes the type dependent values of an Action by moving the
+/// values of the last Action into its place.
+///
+/// @tparam T The type of the values that the Actions are acting on.
+/// @param index The index of the Action being removed.
+///////////////////////////////////////////////////////////////////////////////
+template<typename T>
+void Action<T>::SwapRemove(unsigned index)
+{
+  unsigned last = (unsigned)m_Values.size() - 1;
+  if (index != last) {
+    m_Values[index] = m_Values[last];
+    m_Starts[index] = m_Starts[last];
+    m_Travels[index] = m_Travels[last];
+    m_Ends[index] = m_Ends[last];
+  }
+  m_Values.pop_back();
+  m_Starts.pop_back();
+  m_Travels.pop_back();
+  m_Ends.pop_back();
+}
@@ -0,0 +1,449 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file Buoyancy.cpp
+/// @date 2026-10-17
+///
+/// @brief Contains the implementation of the floating rigid bodies.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "Error.h"
+#include "WaterFFT.h"
+
+#include "Buoyancy.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define BUOYANCY_SIMD
+#include <emmintrin.h>
+#endif
+
+// The lines used to find the inside of a hull are moved off the centers of
+// the cells by these fractions of the spacing. This keeps them off the
+// shared edges of triangles, where a crossing would be counted twice.
+#define HULL_NUDGE_Y 0.0000618f
+#define HULL_NUDGE_Z 0.0000414f
+
+#ifdef BUOYANCY_SIMD
+static inline float Sum4(__m128 values)
+{
+  float lanes[4];
+  _mm_storeu_ps(lanes, values);
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+#endif
+
+Buoyancy::Buoyancy(unsigned threads) :
+  m_Density(1025.0f), m_Gravity(9.81f), m_LinearDrag(100.0f),
+  m_QuadraticDrag(500.0f),
+  m_Pool(threads ? threads : std::thread::hardware_concurrency())
+{}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Adds a body whose volume is split evenly between sample points.
+/// The mass is also split evenly between the points to find the inertia.
+///
+/// @param points The sample points in the body's space.
+/// @param count The number of points.
+/// @param volume The volume of the whole body in cubic meters.
+/// @param mass The mass of the whole body in kilograms.
+/// @param state The starting position and motion of the body.
+///
+/// @return The index of the new body.
+///////////////////////////////////////////////////////////////////////////////
+unsigned Buoyancy::AddBody(const glm::vec3 * points, unsigned count,
+  float volume, float mass, const BodyState & state)
+{
+  if (count == 0 || volume <= 0.0f || mass <= 0.0f)
+  {
+    Error error("Buoyancy.cpp", "Buoyancy::AddBody");
+    error.Add("A body needs at least one point and a positive volume and "
+      "mass.");
+    throw(error);
+  }
+  Body body;
+  body.m_State = state;
+  body.m_FirstPoint = (unsigned)m_LocalX.size();
+  body.m_PointCount = (count + 3) & ~3u;
+  float point_volume = volume / (float)count;
+  float point_mass = mass / (float)count;
+  body.m_Side = std::cbrt(point_volume);
+  body.m_Mass = mass;
+  body.m_Force = glm::vec3(0.0f);
+  body.m_Torque = glm::vec3(0.0f);
+  body.m_Submerged = 0.0f;
+
+  // Each point is a solid cube, which adds m * s^2 / 6 around every axis.
+  glm::mat3 inertia(point_mass * body.m_Side * body.m_Side / 6.0f *
+    (float)count);
+  for (unsigned i = 0; i < count; ++i)
+  {
+    const glm::vec3 & r = points[i];
+    inertia += point_mass * (glm::dot(r, r) * glm::mat3(1.0f) -
+      glm::outerProduct(r, r));
+  }
+  body.m_InverseInertia = glm::inverse(inertia);
+
+  unsigned total = body.m_FirstPoint + body.m_PointCount;
+  m_LocalX.resize(total, 0.0f);
+  m_LocalY.resize(total, 0.0f);
+  m_LocalZ.resize(total, 0.0f);
+  m_Volume.resize(total, 0.0f);
+  for (unsigned i = 0; i < count; ++i)
+  {
+    m_LocalX[body.m_FirstPoint + i] = points[i].x;
+    m_LocalY[body.m_FirstPoint + i] = points[i].y;
+    m_LocalZ[body.m_FirstPoint + i] = points[i].z;
+    m_Volume[body.m_FirstPoint + i] = point_volume;
+  }
+  m_ArmX.resize(total);
+  m_ArmY.resize(total);
+  m_ArmZ.resize(total);
+  m_WorldX.resize(total);
+  m_WorldZ.resize(total);
+  m_Surface.resize(total);
+  m_Bodies.push_back(body);
+  return (unsigned)m_Bodies.size() - 1;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Adds a body from a closed triangle mesh. The inside of the mesh is
+/// filled with cubes and the body is made from their centers.
+///
+/// @param vertices The vertices of the hull in the body's space.
+/// @param indices Three vertex indices per triangle.
+/// @param triangle_count The number of triangles.
+/// @param spacing The length of a side of each cube. Smaller values follow
+///   the hull more closely but make more points.
+/// @param mass The mass of the whole body in kilograms.
+/// @param state The starting position and motion of the body.
+///
+/// @return The index of the new body.
+///////////////////////////////////////////////////////////////////////////////
+unsigned Buoyancy::AddHull(const glm::vec3 * vertices,
+  const unsigned * indices, unsigned triangle_count, float spacing,
+  float mass, const BodyState & state)
+{
+  if (triangle_count == 0 || spacing <= 0.0f)
+  {
+    Error error("Buoyancy.cpp", "Buoyancy::AddHull");
+    error.Add("A hull needs at least one triangle and a positive spacing.");
+    throw(error);
+  }
+  glm::vec3 low = vertices[indices[0]];
+  glm::vec3 high = low;
+  for (unsigned i = 1; i < triangle_count * 3; ++i)
+  {
+    low = glm::min(low, vertices[indices[i]]);
+    high = glm::max(high, vertices[indices[i]]);
+  }
+  glm::vec3 cells = glm::max(glm::ceil((high - low) / spacing),
+    glm::vec3(1.0f));
+
+  // A line along x through a cell center crosses the hull an even number of
+  // times. The cells between the first and second crossing, the third and
+  // fourth, and so on are inside.
+  std::vector<glm::vec3> points;
+  std::vector<float> crossings;
+  for (unsigned z = 0; z < (unsigned)cells.z; ++z)
+  {
+    float pz = low.z + ((float)z + 0.5f + HULL_NUDGE_Z) * spacing;
+    for (unsigned y = 0; y < (unsigned)cells.y; ++y)
+    {
+      float py = low.y + ((float)y + 0.5f + HULL_NUDGE_Y) * spacing;
+      crossings.clear();
+      for (unsigned t = 0; t < triangle_count; ++t)
+      {
+        const glm::vec3 & a = vertices[indices[t * 3]];
+        const glm::vec3 & b = vertices[indices[t * 3 + 1]];
+        const glm::vec3 & c = vertices[indices[t * 3 + 2]];
+        // Solve a + u * (b - a) + v * (c - a) = (py, pz) on the yz plane.
+        float det = (b.y - a.y) * (c.z - a.z) - (c.y - a.y) * (b.z - a.z);
+        if (det == 0.0f)
+          continue;
+        float u = ((py - a.y) * (c.z - a.z) - (c.y - a.y) * (pz - a.z)) / det;
+        float v = ((b.y - a.y) * (pz - a.z) - (py - a.y) * (b.z - a.z)) / det;
+        if (u < 0.0f || v < 0.0f || u + v > 1.0f)
+          continue;
+        crossings.push_back(a.x + u * (b.x - a.x) + v * (c.x - a.x));
+      }
+      std::sort(crossings.begin(), crossings.end());
+      for (unsigned x = 0; x < (unsigned)cells.x; ++x)
+      {
+        float px = low.x + ((float)x + 0.5f) * spacing;
+        size_t before = std::upper_bound(crossings.begin(), crossings.end(),
+          px) - crossings.begin();
+        if (before % 2 == 1)
+          points.push_back(glm::vec3(px, low.y + ((float)y + 0.5f) * spacing,
+            low.z + ((float)z + 0.5f) * spacing));
+      }
+    }
+  }
+  if (points.empty())
+  {
+    Error error("Buoyancy.cpp", "Buoyancy::AddHull");
+    error.Add("The hull does not hold any cubes. It must be closed and wider "
+      "than the spacing.");
+    throw(error);
+  }
+  float volume = (float)points.size() * spacing * spacing * spacing;
+  return AddBody(points.data(), (unsigned)points.size(), volume, mass, state);
+}
+
+//! Removes every body.
+void Buoyancy::Clear()
+{
+  m_Bodies.clear();
+  m_LocalX.clear();
+  m_LocalY.clear();
+  m_LocalZ.clear();
+  m_Volume.clear();
+  m_ArmX.clear();
+  m_ArmY.clear();
+  m_ArmZ.clear();
+  m_WorldX.clear();
+  m_WorldZ.clear();
+  m_Surface.clear();
+}
+
+unsigned Buoyancy::BodyCount() const
+{
+  return (unsigned)m_Bodies.size();
+}
+
+//! The state of a body. It may be changed between calls to Step.
+BodyState & Buoyancy::State(unsigned body)
+{
+  return m_Bodies[body].m_State;
+}
+
+//! The force found by the last Solve. Gravity is not included.
+const glm::vec3 & Buoyancy::Force(unsigned body) const
+{
+  return m_Bodies[body].m_Force;
+}
+
+//! The torque around the center of mass found by the last Solve.
+const glm::vec3 & Buoyancy::Torque(unsigned body) const
+{
+  return m_Bodies[body].m_Torque;
+}
+
+//! The volume of the body that was under the surface at the last Solve.
+float Buoyancy::SubmergedVolume(unsigned body) const
+{
+  return m_Bodies[body].m_Submerged;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Finds the force and torque on every body from the water. The
+/// results are read with Force, Torque, and SubmergedVolume.
+///
+/// @param water The surface the bodies float on.
+///////////////////////////////////////////////////////////////////////////////
+void Buoyancy::Solve(WaterFFT & water)
+{
+  m_Pool.ParallelFor((unsigned)m_Bodies.size(),
+    [this, &water](unsigned begin, unsigned end)
+  {
+    SolveBodies(water, begin, end);
+  });
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Solves for the forces on every body and then moves the bodies
+/// forward in time with them and gravity.
+///
+/// @param water The surface the bodies float on.
+/// @param dt The time to move forward in seconds.
+///////////////////////////////////////////////////////////////////////////////
+void Buoyancy::Step(WaterFFT & water, float dt)
+{
+  Solve(water);
+  m_Pool.ParallelFor((unsigned)m_Bodies.size(),
+    [this, dt](unsigned begin, unsigned end)
+  {
+    Integrate(dt, begin, end);
+  });
+}
+
+void Buoyancy::SolveBodies(WaterFFT & water, unsigned begin, unsigned end)
+{
+  if (begin == end)
+    return;
+  // Move the points into world space.
+  for (unsigned b = begin; b < end; ++b)
+  {
+    const Body & body = m_Bodies[b];
+    glm::mat3 r = glm::mat3_cast(body.m_State.m_Orientation);
+    const glm::vec3 & position = body.m_State.m_Position;
+    unsigned first = body.m_FirstPoint;
+    unsigned last = first + body.m_PointCount;
+#ifdef BUOYANCY_SIMD
+    __m128 r00 = _mm_set1_ps(r[0][0]), r01 = _mm_set1_ps(r[1][0]);
+    __m128 r02 = _mm_set1_ps(r[2][0]), r10 = _mm_set1_ps(r[0][1]);
+    __m128 r11 = _mm_set1_ps(r[1][1]), r12 = _mm_set1_ps(r[2][1]);
+    __m128 r20 = _mm_set1_ps(r[0][2]), r21 = _mm_set1_ps(r[1][2]);
+    __m128 r22 = _mm_set1_ps(r[2][2]);
+    __m128 px = _mm_set1_ps(position.x);
+    __m128 pz = _mm_set1_ps(position.z);
+    for (unsigned i = first; i < last; i += 4)
+    {
+      __m128 lx = _mm_loadu_ps(&m_LocalX[i]);
+      __m128 ly = _mm_loadu_ps(&m_LocalY[i]);
+      __m128 lz = _mm_loadu_ps(&m_LocalZ[i]);
+      __m128 ax = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r00, lx),
+        _mm_mul_ps(r01, ly)), _mm_mul_ps(r02, lz));
+      __m128 ay = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r10, lx),
+        _mm_mul_ps(r11, ly)), _mm_mul_ps(r12, lz));
+      __m128 az = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r20, lx),
+        _mm_mul_ps(r21, ly)), _mm_mul_ps(r22, lz));
+      _mm_storeu_ps(&m_ArmX[i], ax);
+      _mm_storeu_ps(&m_ArmY[i], ay);
+      _mm_storeu_ps(&m_ArmZ[i], az);
+      _mm_storeu_ps(&m_WorldX[i], _mm_add_ps(px, ax));
+      _mm_storeu_ps(&m_WorldZ[i], _mm_add_ps(pz, az));
+    }
+#else
+    for (unsigned i = first; i < last; ++i)
+    {
+      glm::vec3 arm = r * glm::vec3(m_LocalX[i], m_LocalY[i], m_LocalZ[i]);
+      m_ArmX[i] = arm.x;
+      m_ArmY[i] = arm.y;
+      m_ArmZ[i] = arm.z;
+      m_WorldX[i] = position.x + arm.x;
+      m_WorldZ[i] = position.z + arm.z;
+    }
+#endif
+  }
+  // One query finds the surface under every point of this thread's bodies.
+  // Bodies hold a multiple of four points, so every point takes the same
+  // path through the query however the bodies are split between threads.
+  unsigned first = m_Bodies[begin].m_FirstPoint;
+  unsigned last = m_Bodies[end - 1].m_FirstPoint +
+    m_Bodies[end - 1].m_PointCount;
+  water.HeightsAtLocations(&m_WorldX[first], &m_WorldZ[first], last - first,
+    &m_Surface[first]);
+  for (unsigned b = begin; b < end; ++b)
+    SumForces(m_Bodies[b]);
+}
+
+// Each point is a cube of side s whose center is depth meters below the
+// surface. It is submerged by f = clamp(depth / s + 1 / 2, 0, 1) and feels
+//   buoyancy = density * gravity * f * volume upwards
+//   drag = -(linear * f * volume + quadratic * f * s^2 * |v|) * v
+// where v is the velocity of the point. The torque is arm x force.
+void Buoyancy::SumForces(Body & body)
+{
+  const BodyState & state = body.m_State;
+  float inverse_side = 1.0f / body.m_Side;
+  float lift = m_Density * m_Gravity;
+  unsigned first = body.m_FirstPoint;
+  unsigned last = first + body.m_PointCount;
+#ifdef BUOYANCY_SIMD
+  __m128 py = _mm_set1_ps(state.m_Position.y);
+  __m128 vx = _mm_set1_ps(state.m_Velocity.x);
+  __m128 vy = _mm_set1_ps(state.m_Velocity.y);
+  __m128 vz = _mm_set1_ps(state.m_Velocity.z);
+  __m128 wx = _mm_set1_ps(state.m_AngularVelocity.x);
+  __m128 wy = _mm_set1_ps(state.m_AngularVelocity.y);
+  __m128 wz = _mm_set1_ps(state.m_AngularVelocity.z);
+  __m128 inverse_side4 = _mm_set1_ps(inverse_side);
+  __m128 half = _mm_set1_ps(0.5f);
+  __m128 one = _mm_set1_ps(1.0f);
+  __m128 zero = _mm_setzero_ps();
+  __m128 lift4 = _mm_set1_ps(lift);
+  __m128 linear = _mm_set1_ps(m_LinearDrag);
+  __m128 quadratic = _mm_set1_ps(m_QuadraticDrag);
+  __m128 sum_fx = zero, sum_fy = zero, sum_fz = zero;
+  __m128 sum_tx = zero, sum_ty = zero, sum_tz = zero;
+  __m128 sum_submerged = zero;
+  for (unsigned i = first; i < last; i += 4)
+  {
+    __m128 ax = _mm_loadu_ps(&m_ArmX[i]);
+    __m128 ay = _mm_loadu_ps(&m_ArmY[i]);
+    __m128 az = _mm_loadu_ps(&m_ArmZ[i]);
+    __m128 depth = _mm_sub_ps(_mm_loadu_ps(&m_Surface[i]),
+      _mm_add_ps(py, ay));
+    __m128 fraction = _mm_add_ps(_mm_mul_ps(depth, inverse_side4), half);
+    fraction = _mm_min_ps(_mm_max_ps(fraction, zero), one);
+    __m128 submerged = _mm_mul_ps(fraction, _mm_loadu_ps(&m_Volume[i]));
+    // The velocity of each point is v + w x arm.
+    __m128 px = _mm_add_ps(vx,
+      _mm_sub_ps(_mm_mul_ps(wy, az), _mm_mul_ps(wz, ay)));
+    __m128 pv = _mm_add_ps(vy,
+      _mm_sub_ps(_mm_mul_ps(wz, ax), _mm_mul_ps(wx, az)));
+    __m128 pz = _mm_add_ps(vz,
+      _mm_sub_ps(_mm_mul_ps(wx, ay), _mm_mul_ps(wy, ax)));
+    __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px, px),
+      _mm_mul_ps(pv, pv)), _mm_mul_ps(pz, pz)));
+    // The cross section is the submerged volume divided by the side.
+    __m128 drag = _mm_mul_ps(submerged,
+      _mm_add_ps(linear, _mm_mul_ps(quadratic, _mm_mul_ps(speed,
+      inverse_side4))));
+    __m128 fx = _mm_sub_ps(zero, _mm_mul_ps(drag, px));
+    __m128 fy = _mm_sub_ps(_mm_mul_ps(lift4, submerged),
+      _mm_mul_ps(drag, pv));
+    __m128 fz = _mm_sub_ps(zero, _mm_mul_ps(drag, pz));
+    sum_fx = _mm_add_ps(sum_fx, fx);
+    sum_fy = _mm_add_ps(sum_fy, fy);
+    sum_fz = _mm_add_ps(sum_fz, fz);
+    sum_tx = _mm_add_ps(sum_tx,
+      _mm_sub_ps(_mm_mul_ps(ay, fz), _mm_mul_ps(az, fy)));
+    sum_ty = _mm_add_ps(sum_ty,
+      _mm_sub_ps(_mm_mul_ps(az, fx), _mm_mul_ps(ax, fz)));
+    sum_tz = _mm_add_ps(sum_tz,
+      _mm_sub_ps(_mm_mul_ps(ax, fy), _mm_mul_ps(ay, fx)));
+    sum_submerged = _mm_add_ps(sum_submerged, submerged);
+  }
+  body.m_Force = glm::vec3(Sum4(sum_fx), Sum4(sum_fy), Sum4(sum_fz));
+  body.m_Torque = glm::vec3(Sum4(sum_tx), Sum4(sum_ty), Sum4(sum_tz));
+  body.m_Submerged = Sum4(sum_submerged);
+#else
+  glm::vec3 force(0.0f);
+  glm::vec3 torque(0.0f);
+  float total_submerged = 0.0f;
+  for (unsigned i = first; i < last; ++i)
+  {
+    glm::vec3 arm(m_ArmX[i], m_ArmY[i], m_ArmZ[i]);
+    float depth = m_Surface[i] - (state.m_Position.y + arm.y);
+    float fraction = glm::clamp(depth * inverse_side + 0.5f, 0.0f, 1.0f);
+    float submerged = fraction * m_Volume[i];
+    glm::vec3 velocity = state.m_Velocity +
+      glm::cross(state.m_AngularVelocity, arm);
+    float drag = submerged * (m_LinearDrag +
+      m_QuadraticDrag * glm::length(velocity) * inverse_side);
+    glm::vec3 point_force = -drag * velocity;
+    point_force.y += lift * submerged;
+    force += point_force;
+    torque += glm::cross(arm, point_force);
+    total_submerged += submerged;
+  }
+  body.m_Force = force;
+  body.m_Torque = torque;
+  body.m_Submerged = total_submerged;
+#endif
+}
+
+// Semi-implicit Euler. The velocities are updated first and the new
+// velocities move the body.
+void Buoyancy::Integrate(float dt, unsigned begin, unsigned end)
+{
+  for (unsigned b = begin; b < end; ++b)
+  {
+    Body & body = m_Bodies[b];
+    BodyState & state = body.m_State;
+    glm::mat3 r = glm::mat3_cast(state.m_Orientation);
+    glm::mat3 inverse_inertia = r * body.m_InverseInertia *
+      glm::transpose(r);
+    state.m_Velocity += (body.m_Force / body.m_Mass +
+      glm::vec3(0.0f, -m_Gravity, 0.0f)) * dt;
+    state.m_AngularVelocity += inverse_inertia * body.m_Torque * dt;
+    state.m_Position += state.m_Velocity * dt;
+    glm::quat spin(0.0f, state.m_AngularVelocity.x,
+      state.m_AngularVelocity.y, state.m_AngularVelocity.z);
+    state.m_Orientation = glm::normalize(state.m_Orientation +
+      spin * state.m_Orientation * (0.5f * dt));
+  }
+}
@@ -0,0 +1,118 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file Buoyancy.h
+/// @date 2026-10-17
+///
+/// @brief Contains the interface for the rigid bodies that float on the
+/// WaterFFT surface.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <GLM\glm\glm.hpp>
+#include <GLM\glm\gtc\quaternion.hpp>
+#include <vector>
+
+#include "ThreadUtils.h"
+
+class WaterFFT;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// The position and motion of a rigid body.
+///////////////////////////////////////////////////////////////////////////////
+struct BodyState
+{
+  //! The location of the center of mass.
+  glm::vec3 m_Position;
+  //! The rotation from the body's space to world space.
+  glm::quat m_Orientation;
+  //! The velocity of the center of mass in meters per second.
+  glm::vec3 m_Velocity;
+  //! The angular velocity in radians per second around each world axis.
+  glm::vec3 m_AngularVelocity;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Finds the buoyant force, drag, and torque on many rigid bodies and can
+/// move the bodies with them.
+///
+/// The volume of a body is split into small cubes around sample points. A
+/// cube is submerged by how far its center is below the surface, so the
+/// surface clips the body one cube at a time. The points of every body are
+/// kept in one set of arrays per value. Solve splits the bodies between the
+/// threads of a pool. Each thread moves its points into world space, finds
+/// the surface under all of them with one WaterFFT::HeightsAtLocations call,
+/// and sums the forces on four points at a time.
+///
+/// Important Notes
+/// - The origin of a body's space is its center of mass.
+/// - The surface is read from the WaterFFT's read buffer, so call Solve and
+///   Step on the thread that calls WaterFFTThread::Wait.
+/// - The water is treated as still when finding drag.
+///////////////////////////////////////////////////////////////////////////////
+class Buoyancy
+{
+public:
+  Buoyancy(unsigned threads = 0);
+  unsigned AddBody(const glm::vec3 * points, unsigned count, float volume,
+    float mass, const BodyState & state);
+  unsigned AddHull(const glm::vec3 * vertices, const unsigned * indices,
+    unsigned triangle_count, float spacing, float mass,
+    const BodyState & state);
+  void Clear();
+  unsigned BodyCount() const;
+  BodyState & State(unsigned body);
+  const glm::vec3 & Force(unsigned body) const;
+  const glm::vec3 & Torque(unsigned body) const;
+  float SubmergedVolume(unsigned body) const;
+  void Solve(WaterFFT & water);
+  void Step(WaterFFT & water, float dt);
+  //! The density of the water in kilograms per cubic meter.
+  float m_Density;
+  //! The gravitational constant.
+  float m_Gravity;
+  //! The drag on a submerged cubic meter moving at one meter per second.
+  float m_LinearDrag;
+  //! The drag on a submerged square meter of cross section is this times the
+  // square of its speed.
+  float m_QuadraticDrag;
+private:
+  //! A body and the range of points that make up its volume.
+  struct Body
+  {
+    BodyState m_State;
+    //! The index of the body's first point. The count is a multiple of four.
+    unsigned m_FirstPoint;
+    unsigned m_PointCount;
+    //! The length of a side of each point's cube.
+    float m_Side;
+    float m_Mass;
+    //! The inverse of the inertia tensor in the body's space.
+    glm::mat3 m_InverseInertia;
+    //! The results of the last Solve.
+    glm::vec3 m_Force;
+    glm::vec3 m_Torque;
+    float m_Submerged;
+  };
+  void SolveBodies(WaterFFT & water, unsigned begin, unsigned end);
+  void SumForces(Body & body);
+  void Integrate(float dt, unsigned begin, unsigned end);
+
+  std::vector<Body> m_Bodies;
+  //! The points of every body in their body's space. Padding points have no
+  // volume.
+  std::vector<float> m_LocalX;
+  std::vector<float> m_LocalY;
+  std::vector<float> m_LocalZ;
+  std::vector<float> m_Volume;
+  //! The offset of each point from its body's center of mass in world space.
+  std::vector<float> m_ArmX;
+  std::vector<float> m_ArmY;
+  std::vector<float> m_ArmZ;
+  //! The xz location of each point and the surface height above it.
+  std::vector<float> m_WorldX;
+  std::vector<float> m_WorldZ;
+  std::vector<float> m_Surface;
+  //! The threads used by Solve and Step.
+  ThreadPool m_Pool;
+};
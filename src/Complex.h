@@ -1,43 +1,165 @@
-//////////////////////////////////////////////////////////////////////////////
-/// @file Complex.h
-/// @author Connor Deakin
-/// @email connor.deakin@digipen.edu
-/// @date 2017-09-21
-///
-/// @brief Interface and implementation for complex number arithmetic.
-///////////////////////////////////////////////////////////////////////////////
-#ifndef COMPLEX_H
-#define COMPLEX_H
-
-#include <FFTW\fftw3.h>
-
-class Complex
-{
-public:
-  Complex();
-  Complex(float real, float imaginary);
-  Complex(const Complex & other);
-  float Real();
-  float Imaginary();
-  Complex Conjugate();
-  Complex operator+(const Complex & rhs);
-  Complex operator-(const Complex & rhs);
-  Complex operator*(const Complex & rhs) const;
-  Complex operator*(float rhs) const;
-  Complex & operator+=(const Complex & rhs);
-  Complex & operator-=(const Complex & rhs);
-  Complex & operator*=(const Complex & rhs);
-  Complex & operator*=(float rhs);
-private:
-  union
-  {
-    struct
-    {
-      float m_Real, m_Imaginary;
-    };
-    float m_Values[2];
-    fftwf_complex m_FFTWComplex;
-  };
-};
-
-#endif // !COMPLEX_H
\ No newline at end of file
+//////////////////////////////////////////////////////////////////////////////
+/// @file Complex.h
+/// @author Connor Deakin
+/// @email connor.deakin@digipen.edu
+/// @date 2017-09-21
+///
+/// @brief Interface and implementation for complex number arithmetic. All of
+/// the arithmetic is defined here so it can be inlined into the loops that
+/// use it.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef COMPLEX_H
+#define COMPLEX_H
+
+#include <complex>
+#include <type_traits>
+#include <FFTW/fftw3.h>
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// A complex number stored as two floats.
+///
+/// Important Notes
+/// - Complex is trivially copyable and has the same layout as fftwf_complex
+///   and std::complex<float>, so arrays of it can be handed to FFTW directly.
+///////////////////////////////////////////////////////////////////////////////
+class Complex
+{
+public:
+  constexpr Complex() : m_Real(0.0f), m_Imaginary(0.0f) {}
+  constexpr Complex(float real, float imaginary) :
+    m_Real(real), m_Imaginary(imaginary) {}
+  Complex(const std::complex<float> & other) :
+    m_Real(other.real()), m_Imaginary(other.imag()) {}
+  Complex(const fftwf_complex & other) :
+    m_Real(other[0]), m_Imaginary(other[1]) {}
+  Complex(const Complex & other) = default;
+  Complex & operator=(const Complex & other) = default;
+  operator std::complex<float>() const
+  {
+    return std::complex<float>(m_Real, m_Imaginary);
+  }
+  constexpr float Real() const { return m_Real; }
+  constexpr float Imaginary() const { return m_Imaginary; }
+  constexpr Complex Conjugate() const { return Complex(m_Real, -m_Imaginary); }
+  constexpr Complex operator+(const Complex & rhs) const
+  {
+    return Complex(m_Real + rhs.m_Real, m_Imaginary + rhs.m_Imaginary);
+  }
+  constexpr Complex operator-(const Complex & rhs) const
+  {
+    return Complex(m_Real - rhs.m_Real, m_Imaginary - rhs.m_Imaginary);
+  }
+  constexpr Complex operator*(const Complex & rhs) const
+  {
+    return Complex(m_Real * rhs.m_Real - m_Imaginary * rhs.m_Imaginary,
+      m_Real * rhs.m_Imaginary + m_Imaginary * rhs.m_Real);
+  }
+  constexpr Complex operator*(float rhs) const
+  {
+    return Complex(m_Real * rhs, m_Imaginary * rhs);
+  }
+  Complex & operator+=(const Complex & rhs)
+  {
+    m_Real += rhs.m_Real;
+    m_Imaginary += rhs.m_Imaginary;
+    return *this;
+  }
+  Complex & operator-=(const Complex & rhs)
+  {
+    m_Real -= rhs.m_Real;
+    m_Imaginary -= rhs.m_Imaginary;
+    return *this;
+  }
+  Complex & operator*=(const Complex & rhs)
+  {
+    float new_real = m_Real * rhs.m_Real - m_Imaginary * rhs.m_Imaginary;
+    m_Imaginary = m_Real * rhs.m_Imaginary + m_Imaginary * rhs.m_Real;
+    m_Real = new_real;
+    return *this;
+  }
+  Complex & operator*=(float rhs)
+  {
+    m_Real *= rhs;
+    m_Imaginary *= rhs;
+    return *this;
+  }
+  static fftwf_complex * ToFFTW(Complex * values)
+  {
+    return reinterpret_cast<fftwf_complex *>(values);
+  }
+  static Complex * FromFFTW(fftwf_complex * values)
+  {
+    return reinterpret_cast<Complex *>(values);
+  }
+private:
+  float m_Real, m_Imaginary;
+};
+
+static_assert(std::is_trivially_copyable<Complex>::value,
+  "Complex must be trivially copyable");
+static_assert(sizeof(Complex) == sizeof(fftwf_complex),
+  "Complex must have the same layout as fftwf_complex");
+static_assert(sizeof(Complex) == sizeof(std::complex<float>),
+  "Complex must have the same layout as std::complex<float>");
+
+// BULK HELPERS ///////////////////////////////////////////////////////////////
+// These work on count contiguous values. The loops only use float arithmetic
+// on the two parts of each value so the compiler is free to vectorize them.
+// The input and output may be the same array.
+
+// out[i] = in[i] * (i * k[i])
+inline void ComplexMultiplyI(const Complex * in, const float * k, Complex * out,
+  unsigned count)
+{
+  const float * in_f = reinterpret_cast<const float *>(in);
+  float * out_f = reinterpret_cast<float *>(out);
+  for (unsigned i = 0; i < count; ++i)
+  {
+    float real = in_f[2 * i];
+    float imaginary = in_f[2 * i + 1];
+    out_f[2 * i] = -imaginary * k[i];
+    out_f[2 * i + 1] = real * k[i];
+  }
+}
+
+// out[i] = in[i] * (i * k)
+inline void ComplexMultiplyI(const Complex * in, float k, Complex * out,
+  unsigned count)
+{
+  const float * in_f = reinterpret_cast<const float *>(in);
+  float * out_f = reinterpret_cast<float *>(out);
+  for (unsigned i = 0; i < count; ++i)
+  {
+    float real = in_f[2 * i];
+    float imaginary = in_f[2 * i + 1];
+    out_f[2 * i] = -imaginary * k;
+    out_f[2 * i + 1] = real * k;
+  }
+}
+
+// out[i] = a[i] + conjugate(b[i])
+inline void ComplexConjugateAdd(const Complex * a, const Complex * b,
+  Complex * out, unsigned count)
+{
+  const float * a_f = reinterpret_cast<const float *>(a);
+  const float * b_f = reinterpret_cast<const float *>(b);
+  float * out_f = reinterpret_cast<float *>(out);
+  for (unsigned i = 0; i < count; ++i)
+  {
+    out_f[2 * i] = a_f[2 * i] + b_f[2 * i];
+    out_f[2 * i + 1] = a_f[2 * i + 1] - b_f[2 * i + 1];
+  }
+}
+
+// out[i] = in[i] * scale
+inline void ComplexScale(const Complex * in, float scale, Complex * out,
+  unsigned count)
+{
+  const float * in_f = reinterpret_cast<const float *>(in);
+  float * out_f = reinterpret_cast<float *>(out);
+  for (unsigned i = 0; i < 2 * count; ++i)
+    out_f[i] = in_f[i] * scale;
+}
+
+#endif // !COMPLEX_H
@@ -1,57 +1,111 @@
-#pragma once
-
-#include <iostream>
-#include "Complex.h"
-
-void test_complex();
-void test_add();
-void test_sub();
-void test_mul();
-
-void test_complex()
-{
-  test_add();
-  test_sub();
-  test_mul();
-}
-
-void test_add()
-{
-  Complex a( 4.0f,  2.0f);
-  Complex b( 3.0f, -2.0f);
-  Complex c( 0.0f,  5.0f);
-  Complex d(-3.0f,  0.0f);
-
-  Complex res = a + b;
-  c += res;
-  res += d + c;
-  // res: 11 + 5i
-  std::cout << res.Real() << " + i * " << res.Imaginary() << std::endl;
-}
-
-void test_sub()
-{
-  Complex a(4.0f, 2.0f);
-  Complex b(3.0f, -2.0f);
-  Complex c(0.0f, 5.0f);
-  Complex d(-3.0f, 0.0f);
-
-  Complex res = a - b;
-  c -= res;
-  res -= d - c;
-  // res: 3 + 5i
-  std::cout << res.Real() << " + i * " << res.Imaginary() << std::endl;
-}
-
-void test_mul()
-{
-  Complex a(4.0f, 2.0f);
-  Complex b(3.0f, -2.0f);
-  Complex c(0.0f, 5.0f);
-  Complex d(-3.0f, 0.0f);
-
-  Complex res = a * b;
-  res *= c * d;
-  // res: -30 - 240i
-  std::cout << res.Real() << " + i * " << res.Imaginary() << std::endl;
-}
\ No newline at end of file
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "Complex.h"
+
+void test_complex();
+void test_add();
+void test_sub();
+void test_mul();
+void test_bulk();
+void bench_complex();
+
+void test_complex()
+{
+  test_add();
+  test_sub();
+  test_mul();
+  test_bulk();
+}
+
+void test_add()
+{
+  Complex a( 4.0f,  2.0f);
+  Complex b( 3.0f, -2.0f);
+  Complex c( 0.0f,  5.0f);
+  Complex d(-3.0f,  0.0f);
+
+  Complex res = a + b;
+  c += res;
+  res += d + c;
+  // res: 11 + 5i
+  std::cout << res.Real() << " + i * " << res.Imaginary() << std::endl;
+}
+
+void test_sub()
+{
+  Complex a(4.0f, 2.0f);
+  Complex b(3.0f, -2.0f);
+  Complex c(0.0f, 5.0f);
+  Complex d(-3.0f, 0.0f);
+
+  Complex res = a - b;
+  c -= res;
+  res -= d - c;
+  // res: 3 + 5i
+  std::cout << res.Real() << " + i * " << res.Imaginary() << std::endl;
+}
+
+void test_mul()
+{
+  Complex a(4.0f, 2.0f);
+  Complex b(3.0f, -2.0f);
+  Complex c(0.0f, 5.0f);
+  Complex d(-3.0f, 0.0f);
+
+  Complex res = a * b;
+  res *= c * d;
+  // res: -30 - 240i
+  std::cout << res.Real() << " + i * " << res.Imaginary() << std::endl;
+}
+
+void test_bulk()
+{
+  Complex a[2] = { Complex(4.0f, 2.0f), Complex(3.0f, -2.0f) };
+  Complex b[2] = { Complex(0.0f, 5.0f), Complex(-3.0f, 0.0f) };
+  float k[2] = { 2.0f, -1.0f };
+  Complex res[2];
+  ComplexMultiplyI(a, k, res, 2);
+  // res: -4 + 8i, -2 - 3i
+  std::cout << res[0].Real() << " + i * " << res[0].Imaginary() << ", "
+    << res[1].Real() << " + i * " << res[1].Imaginary() << std::endl;
+  ComplexConjugateAdd(a, b, res, 2);
+  ComplexScale(res, 2.0f, res, 2);
+  // res: 8 - 6i, 0 - 4i
+  std::cout << res[0].Real() << " + i * " << res[0].Imaginary() << ", "
+    << res[1].Real() << " + i * " << res[1].Imaginary() << std::endl;
+}
+
+// Times the loop UpdateFFT used to run against the bulk helper that replaced
+// it. Build with optimizations. Since every Complex operation is inline, the
+// two loops should compile without calls and take about the same time.
+void bench_complex()
+{
+  const unsigned count = 512 * 512;
+  const unsigned repeats = 100;
+  std::vector<Complex> in(count, Complex(1.0f, 2.0f));
+  std::vector<Complex> out(count);
+  std::vector<float> k(count, 0.5f);
+  typedef std::chrono::high_resolution_clock Clock;
+
+  Clock::time_point start = Clock::now();
+  for (unsigned r = 0; r < repeats; ++r)
+    for (unsigned i = 0; i < count; ++i)
+      out[i] = in[i] * Complex(0.0f, k[i]);
+  Clock::time_point end = Clock::now();
+  float operator_ms = std::chrono::duration<float, std::milli>(end - start)
+    .count() / repeats;
+
+  start = Clock::now();
+  for (unsigned r = 0; r < repeats; ++r)
+    ComplexMultiplyI(in.data(), k.data(), out.data(), count);
+  end = Clock::now();
+  float bulk_ms = std::chrono::duration<float, std::milli>(end - start)
+    .count() / repeats;
+
+  // The result is printed so the loops are not removed.
+  std::cout << "operator: " << operator_ms << " ms, bulk: " << bulk_ms
+    << " ms (" << out[count - 1].Real() << ")" << std::endl;
+}
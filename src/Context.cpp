@@ -1,1046 +1,1612 @@
-/* All content(c) 2016 - 2017 DigiPen(USA) Corporation, all rights reserved. */
-/*****************************************************************************/
-/*!
-\file Context.cpp
-\author Connor Deakin
-\par E-mail: connor.deakin\@digipen.edu
-\par Project: Graphics
-\date 30/09/2016
-\brief
-  Contains the implementation of the static Context class. Look at the 
-  documentation of the Context class for more info on this code.
-*/
-/*****************************************************************************/
-
-// S_CONTEXT //////////////////////////////////////////////////////////////////
-
-#include <SDL\SDL.h>
-// Undefine the main define by SDL
-#undef main
-#include "Error.h"
-
-#include "Context.h"
-
-
-// static initializations
-bool Context::_close = true;
-bool Context::_created = false;
-void(*Context::_adjustViewport)() = nullptr;
-void(*Context::_processEvent)(SDL_Event * event) = nullptr;
-SDL_Window * Context::_window = nullptr;
-
-/*****************************************************************************/
-/*!
-\brief
-  Constructor for the Context class. If all of the parameters are not given,
-  the following the defaults will be applied. If the given width and height
-  are zero, the Context will instantly fullscreen.
-
-\par
-  Defaults
-   - name: "Context"
-   - opengl: false
-   - adjust_viewport: nullptr
-   - width:  600
-   - height: 600
-   - xposition: 0
-   - yposition: 0
-
-\param name
-  The name that will be seen in the top left of the window.
-\param opengl
-  Set to true if this Context is being used for an OpenGLContext.
-\param adjust_viewport
-  Callback function for adjusting the graphics viewport after window resizing.
-\param width
-  The width of the window.
-\param height
-  The height of the window.
-\param xposition
-  The X position of the top left corner of the window.
-\param yposition
-  The Y position of the top left cornter of the window.
-*/
-/*****************************************************************************/
-void Context::Create(const char * name, bool opengl, void(*adjust_viewport)(),
-                     int width, int height,
-                     int xposition, int yposition)
-{
-  // throwing error if context already exists
-  if (_created)
-  {
-    RootError root_error("Context.cpp", "Init");
-    root_error.Add("A Context already exists.");
-    root_error.Add("Only one context can exist at a time.");
-    throw(root_error);
-  }
-  // initialize sdl
-  SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMECONTROLLER);
-  // create window flags
-  Uint32 flags = SDL_WINDOW_RESIZABLE | SDL_WINDOW_INPUT_FOCUS |
-    SDL_WINDOW_MOUSE_FOCUS;
-  if (width == 0 && height == 0)
-    flags = flags | SDL_WINDOW_FULLSCREEN_DESKTOP;
-  if (opengl)
-    flags = flags | SDL_WINDOW_OPENGL;
-  // creating window
-  _window = SDL_CreateWindow(name, xposition, yposition, width, height, flags);
-  // making sure windo was created
-  if (!_window)
-  {
-    SDL_Quit();
-    RootError root_error("Context.cpp", "CreateContext");
-    root_error.Add("SDL window creation failed.");
-    throw(root_error);
-  }
-  // setting callback
-  _adjustViewport = adjust_viewport;
-  // done
-  _close = false;
-  _created = true;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Destructor for the Context class. This will clean up all the Context
-  resources.
-*/
-/*****************************************************************************/
-void Context::Purge()
-{
-  SDL_DestroyWindow(_window);
-  SDL_Quit();
-  _created = false;
-}
-
-/*****************************************************************************/
-/*!
-\brief Add a function that will process events sent from SDL. This will
- typically be used if events that are not checked by the Context class and
- you want those events or, alternatively, an external library needs access to
- the SDL events.
-
-\param process_event The function that will be used for processing the SDL
-  events.
-*/
-/*****************************************************************************/
-void Context::AddEventProcessor(void (*process_event)(SDL_Event * event))
-{
-  _processEvent = process_event;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Checks for any SDL Events that exits within SDL's event queue and acts
-  according to the type of the event.
-*/
-/*****************************************************************************/           
-void Context::CheckEvents()
-{
-  // Clearing pressed keys and other values
-  // from previous frame
-  Input::Reset();
-  SDL_Event event;
-  // reading all events in queue
-  while (SDL_PollEvent(&event))
-  {
-    switch (event.type)
-    {
-      case SDL_WINDOWEVENT: OnWindowEvent(event); break;
-      case SDL_KEYDOWN: Input::OnKeyDownEvent(event); break;
-      case SDL_KEYUP: Input::OnKeyUpEvent(event); break;
-      case SDL_MOUSEBUTTONDOWN: Input::OnMouseButtonDownEvent(event); break;
-      case SDL_MOUSEBUTTONUP: Input::OnMouseButtonUpEvent(event); break;
-      case SDL_MOUSEWHEEL: Input::OnMouseWheelEvent(event); break;
-      case SDL_MOUSEMOTION: Input::OnMouseMotionEvent(event); break;
-      case SDL_CONTROLLERDEVICEADDED: Input::OnControllerAdded(event); break;
-      case SDL_CONTROLLERDEVICEREMOVED: Input::OnControllerRemoved(event); break;
-      case SDL_CONTROLLERBUTTONDOWN: Input::OnControllerDown(event); break;
-      case SDL_CONTROLLERBUTTONUP: Input::OnControllerUp(event); break;
-      case SDL_CONTROLLERAXISMOTION: Input::OnControllerAxis(event); break;
-    }
-  }
-  // use external event processor
-  if (_processEvent)
-    _processEvent(&event);
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  If called, both the contex will be made fullscreen. Update
-  does not have to be called after this function. The function will handle the
-  Context change.
-*/
-/*****************************************************************************/
-void Context::Fullscreen()
-{
-  SDL_SetWindowFullscreen(_window, SDL_WINDOW_FULLSCREEN_DESKTOP);
-  if(_adjustViewport)
-    _adjustViewport();
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Used to show or hide the cursor when it is hovering over the Context.
-
-\param hide
-  If true, the cursor will be hidden when hovering over the context. If false,
-  the cursor will always be visible.
-*/
-/*****************************************************************************/
-void Context::HideCursor(bool hide)
-{
-  if(hide)
-    SDL_ShowCursor(SDL_DISABLE);
-  else
-    SDL_ShowCursor(SDL_ENABLE);
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Gets a pointer to the SDL window for this context.
-
-\return A pointer to the SDL window for this context.
-*/
-/*****************************************************************************/
-SDL_Window * Context::SDLWindow()
-{
-  return _window;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Identifies whether the SDL context has been created or not. 
-
-\return If the SDL Context has been created, true.
-*/
-/*****************************************************************************/
-bool Context::Created()
-{
-  return _created;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Get the current Context status. If it is to remain open, this will return
-  true. Otherwise, this will return false.
-
-\return The current status of the Context.
-*/
-/*****************************************************************************/
-bool Context::KeepOpen()
-{
-  if(_close)
-    return false;
-  return true;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Calling this signifies that the context should close. It will not actually
-  close when this function called. The close bool in the class will simply be
-  set to true. It is your job to check this value using the KeepOpen function.
-  This function and KeepOpen are used to maintain a game loop.
-*/
-/*****************************************************************************/
-void Context::Close()
-{
-  _close = true;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  This will be called from CheckEvents() when SDL sends a window event. This
-  includes evetns such as maximizing, minimizing, resizing, closing, etc.
-
-\param event
-  The window event that was pulled off the event queue from SDL_PollEvents.
-*/
-/*****************************************************************************/
-void Context::OnWindowEvent(const SDL_Event & event)
-{
-  switch (event.window.event)
-  {
-    case SDL_WINDOWEVENT_RESIZED: if(_adjustViewport) _adjustViewport(); break;
-    case SDL_WINDOWEVENT_CLOSE: Close(); break;
-  }
-}
-
-// S_INPUT ////////////////////////////////////////////////////////////////////
-
-// static initializations
-bool Input::_keysDown[NUMKEYS] = { false };
-std::vector<Key> Input::_keysPressed;
-bool Input::_mouseButtonsDown[NUMMBUTTONS] = { false };
-std::vector<MButton> Input::_mouseButtonsPressed;
-std::pair<int, int> Input::_mouseMotion(0, 0);
-std::pair<int, int> Input::_mouseLocation(0, 0);
-int Input::_mouseWheelMotion = 0;
-std::vector<Sint32> Input::_inactiveController;
-std::vector<Input::Controller> Input::_activeController;
-float Input::_analogThreshold = 0.1f;
-
-
-/*****************************************************************************/
-/*!
-\brief
-  Used to find out if a key was down during the previous frame.
-  
-\param key
-  The key that is being checked.
-
-\return If the key was down, true.
-*/
-/*****************************************************************************/
-bool Input::KeyDown(Key key)
-{
-  return _keysDown[key];
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Used to find out if a key was pressed during the previous frame.
-
-\param key
-  The key that is being checked.
-
-\return If the key was pressed, true.
-*/
-/*****************************************************************************/
-bool Input::KeyPressed(Key key)
-{
-  unsigned size = _keysPressed.size();
-  for (unsigned i = 0; i < size; ++i){
-    if (_keysPressed[i] == key)
-      return true;
-  }
-  return false;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Used to find out if any key on the keyboard was pressed during the previous
-  frame.
-
-\return If a key was pressed, true.
-*/
-/*****************************************************************************/
-bool Input::AnyKeyPressed()
-{
-  if (_keysPressed.size() > 0)
-    return true;
-  return false;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Used to find out if a mouse button was down during the previous frame.
-
-\param mouse_button
-  The mouse button that is being checked.
-
-\return If the mouse button was down, true.
-*/
-/*****************************************************************************/
-bool Input::MouseButtonDown(MButton mouse_button)
-{
-  return _mouseButtonsDown[mouse_button];
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Used to find out if a mouse button was pressed during the previous frame.
-
-\param mouse_button
-  The mouse button that is being checked.
-
-\return If the mouse button was pressed, true.
-*/
-/*****************************************************************************/
-bool Input::MouseButtonPressed(MButton mouse_button)
-{
-  unsigned size = _mouseButtonsPressed.size();
-  for (unsigned i = 0; i < size; ++i) {
-    if (_mouseButtonsPressed[i] == mouse_button)
-      return true;
-  }
-  return false;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Used to check if any mouse button was pressed during the previous frame.
-
-\return If a mouse button was pressed, true.
-*/
-/*****************************************************************************/
-bool Input::AnyMouseButtonPressed()
-{
-  if (_mouseButtonsPressed.size() > 0)
-    return true;
-  return false;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Returns the motion undergone by the mouse during the previous frame. The 
-  first value in the pair is the X motion and the second value is the Y motion.
-
-\return A pair containing the motion of the mouse during the previous frame.
-*/
-/*****************************************************************************/
-const std::pair<int, int> & Input::MouseMotion()
-{
-  return _mouseMotion;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Returns the location of the mouse during the previous frame. The first value
-  in the pair is the X location and the second value is the Y location.
-
-\return A pair containing the location of the mouse during the previous frame.
-*/
-/*****************************************************************************/
-const std::pair<int, int> & Input::MouseLocation()
-{
-  return _mouseLocation;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Returns the motion undergone by the mouse wheel during the previous frame.
-  Motion away from the user will result in a positive one and motion towards
-  the user will result in a negative one.
-
-\return Described in the brief.
-*/
-/*****************************************************************************/
-int Input::MouseWheelMotion()
-{
-  return _mouseWheelMotion;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Returns the lowest inactive controller. For example, if controllers 1, 2,
-  and 3 are inactive, controller 1 will be returned. If there are no inactive
-  controllers, -1 will be returned.
-
-\return The id of the inactive controller.
-*/
-/*****************************************************************************/
-Sint32 Input::GetInactiveController()
-{
-  // making sure there are inactive controllers.
-  if (_inactiveController.size() == 0)
-    return -1;
-  const Sint32 max_controllers = 4;
-  Sint32 id = max_controllers;
-  for (Sint32 c_id : _inactiveController) {
-    if (c_id < id)
-      id = c_id;
-  }
-  return id;
-}
-
-/*****************************************************************************/
-/*!
-\brief 
-  Find out whether a controller is active or not through an id. This id
-  will be a number from 0 to 3.
-
-\param id The id of the controller.
-
-\return If the controller is active, true, otherwise, false.
-*/
-/*****************************************************************************/
-bool Input::IsActiveControlller(Sint32 id)
-{
-  for (const Controller & controller : _activeController) {
-    if (controller._id == id)
-      return true;
-  }
-  return false;
-}
-
-/*****************************************************************************/
-/*!
-\brief 
-  Activates then specified controller. Throws an error if the controller
-  id did not exist among the current inactive controllers. 
-
-\param id The id that was given by GetInactiveController.
-*/
-/*****************************************************************************/
-void Input::ActivateController(Sint32 id)
-{
-  std::vector<Sint32>::iterator it = _inactiveController.begin();
-  std::vector<Sint32>::iterator it_e = _inactiveController.end();
-  for (; it != it_e; ++it) {
-    if (*it == id) {
-      SDL_GameController * controller = SDL_GameControllerOpen(id);
-      _inactiveController.erase(it);
-      _activeController.push_back(Controller(id, controller));
-      return;
-    }
-  }
-  Error error("Context.cpp", "ActivateController");
-  error.Add("The controller ID did not exist among inactive controllers.");
-  throw(error);
-}
-
-/*****************************************************************************/
-/*!
-\brief 
-  Deactivates a specified controller. An error is thrown if the given id is
-  not found among the active controllers.
-
-\param id The id of the active controller that is to be deactivated.
-*/
-/*****************************************************************************/
-void Input::DeactiveateController(Sint32 id)
-{
-  std::vector<Controller>::iterator it = _activeController.begin();
-  std::vector<Controller>::iterator it_e = _activeController.end();
-  for (; it != it_e; ++it) {
-    if (id == (*it)._id) {
-      SDL_GameControllerClose((*it)._sdlController);
-      _activeController.erase(it);
-      _inactiveController.push_back(id);
-      return;
-    }
-  }
-  Error error("Context.cpp", "DeactivateController");
-  error.Add("The controller ID did not exist among the active controllers.");
-  throw(error);
-}
-
-
-/*****************************************************************************/
-/*!
-\brief
-  Returns the Controller instance of a controller given a specific id for that
-  controller. An error will be thrown if the id does not exist among the active
-  controllers.
-
-\param id The id of the controller to be fetched.
-
-\return The controller instance.
-*/
-/*****************************************************************************/
-Input::Controller * Input::GetController(Sint32 id)
-{
-  for (Controller & controller : _activeController) {
-    if (id == controller._id)
-      return &controller;
-  }
-  Error error("Context.cpp", "GetController");
-  error.Add("The requested controller is not active.");
-  throw(error);
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Identfies whether a button was down during the previous frame or not.
-
-\param button
-  The button being evaluated.
-
-\return If the button was down, true.
-*/
-/*****************************************************************************/
-bool Input::Controller::ButtonDown(CButton button) const
-{
-  return _buttonsDown[button];
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Identifies whether a button was pressed during the previous frame.
-
-\param button
-  The button being evaluated.
-
-\return If the button was pressed. true
-*/
-/*****************************************************************************/
-bool Input::Controller::ButtonPressed(CButton button) const
-{
-  for (CButton pressed_button : _buttonsPressed) {
-    if (pressed_button == button)
-      return true;
-  }
-  return false;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Gets the raw analog value of an analog during the previous frame.
-
-\param analog The analog whose value will be returned.
-
-\return The analog's raw value.
-*/
-/*****************************************************************************/
-Sint16 Input::Controller::AnalogValue(CAnalog analog) const
-{
-  return _analogs[analog];
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Identifies whether an anlog is beyond the analog threshold, therefore
-  making the analog a valid input.
-
-\param analog The analog being checked for validity.
-
-\return If the analog value is above the analog threshold, true.
-*/
-/*****************************************************************************/
-bool Input::Controller::AnalogActive(CAnalog analog) const
-{
-  return _activeAnalogs[analog];
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  The analog value of the left trigger. Will be given as a number from 0 to 1.
-
-\return That floating analog value of the left trigger.
-*/
-/*****************************************************************************/
-float Input::Controller::TriggerLeft() const
-{
-  return _triggerLeft;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  The analog value of the right trigger. Will be given as a number from 0 to 1.
-
-\return That floating analog value of the right trigger.
-*/
-/*****************************************************************************/
-float Input::Controller::TriggerRight() const
-{
-  return _triggerRight;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Returns the floating point values associated with the left stick. These
-  values will be between 0 and 1.
-
-\return The floating analog values. The first value is x, the second is y.
-*/
-/*****************************************************************************/
-const std::pair<float, float> & Input::Controller::StickLeft() const
-{
-  return _stickLeft;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Returns the floating point values associated with the right stick. These
-  values will be between 0 and 1.
-
-\return The floating analog values. The first value is x, the second is y.
-*/
-/*****************************************************************************/
-const std::pair<float, float> & Input::Controller::StickRight() const
-{
-  return _stickRight;
-}
-
-
-
-/*!
-\brief Controller instance constuctor.
-\param id The SDL id of the controller.
-\param controller The SDL_GameController value.
-*/
-Input::Controller::Controller(Sint32 id, SDL_GameController * controller) :
-  _id(id), _sdlController(controller), _buttonsDown{ false }, _analogs{ 0 },
-  _triggerLeft(0.0f), _triggerRight(0.0f), _stickLeft(0.0f, 0.0f),
-  _stickRight(0.0f, 0.0f), _activeAnalogs{ false }
-{}
-
-
-#include <iostream>
-
-/*!
-\brief Updates an analog value of the controller.
-\param analog The analog being updated.
-\param value The analog's new value.
-*/
-inline void Input::Controller::UpdateAnalog(CAnalog analog, Sint16 value)
-{
-  const float max_analog = 32767.0f;
-  float norm_value = (float)value / max_analog;
-  _analogs[analog] = value;
-  switch (analog)
-  {
-  case TRIGGERLEFT: _triggerLeft = norm_value; break;
-  case TRIGGERRIGHT: _triggerRight = norm_value; break;
-  case STICKLEFTX: _stickLeft.first = norm_value; break;
-  case STICKLEFTY: _stickLeft.second = -norm_value; break;
-  case STICKRIGHTX: _stickRight.first = norm_value; break;
-  case STICKRIGHTY: _stickRight.second = -norm_value; break;
-  default: break;
-  }
-  if (norm_value > _analogThreshold || -norm_value > _analogThreshold)
-    _activeAnalogs[analog] = true;
-  else
-    _activeAnalogs[analog] = false;
-}
-
-/*!
-\brief Converts an SDL scancode to a Key.
-\param value The SDL_Scancode value.
-\return The SDL_Scancode's corresponding Key value.
-*/
-Key Input::ScancodeToKey(SDL_Scancode value)
-{
-  // not proud of this, but I also don't want to type
-  // SDL_SCANCODE_ again.
-  switch (value)
-  {
-    case SDL_SCANCODE_ESCAPE: return ESCAPE;
-    case SDL_SCANCODE_F1: return F1;
-    case SDL_SCANCODE_F2: return F2;
-    case SDL_SCANCODE_F3: return F3;
-    case SDL_SCANCODE_F4: return F4;
-    case SDL_SCANCODE_F5: return F5;
-    case SDL_SCANCODE_F6: return F6;
-    case SDL_SCANCODE_F7: return F7;
-    case SDL_SCANCODE_F8: return F8;
-    case SDL_SCANCODE_F9: return F9;
-    case SDL_SCANCODE_F10: return F10;
-    case SDL_SCANCODE_F11: return F11;
-    case SDL_SCANCODE_F12: return F12;
-    case SDL_SCANCODE_GRAVE: return TILDE;
-    case SDL_SCANCODE_1: return N1;
-    case SDL_SCANCODE_2: return N2;
-    case SDL_SCANCODE_3: return N3;
-    case SDL_SCANCODE_4: return N4;
-    case SDL_SCANCODE_5: return N5;
-    case SDL_SCANCODE_6: return N6;
-    case SDL_SCANCODE_7: return N7;
-    case SDL_SCANCODE_8: return N8;
-    case SDL_SCANCODE_9: return N9;
-    case SDL_SCANCODE_0: return N0;
-    case SDL_SCANCODE_MINUS: return MINUS;
-    case SDL_SCANCODE_EQUALS: return EQUAL;
-    case SDL_SCANCODE_BACKSPACE: return BACKSPACE;
-    case SDL_SCANCODE_TAB: return TAB;
-    case SDL_SCANCODE_Q: return Q;
-    case SDL_SCANCODE_W: return W;
-    case SDL_SCANCODE_E: return E;
-    case SDL_SCANCODE_R: return R;
-    case SDL_SCANCODE_T: return T;
-    case SDL_SCANCODE_Y: return Y;
-    case SDL_SCANCODE_U: return U;
-    case SDL_SCANCODE_I: return I;
-    case SDL_SCANCODE_O: return O;
-    case SDL_SCANCODE_P: return P;
-    case SDL_SCANCODE_LEFTBRACKET: return BRACKETLEFT;
-    case SDL_SCANCODE_RIGHTBRACKET: return BRACKETRIGHT;
-    case SDL_SCANCODE_BACKSLASH: return BACKSLASH;
-    case SDL_SCANCODE_CAPSLOCK: return CAPSLOCK;
-    case SDL_SCANCODE_A: return A;
-    case SDL_SCANCODE_S: return S;
-    case SDL_SCANCODE_D: return D;
-    case SDL_SCANCODE_F: return F;
-    case SDL_SCANCODE_G: return G;
-    case SDL_SCANCODE_H: return H;
-    case SDL_SCANCODE_J: return J;
-    case SDL_SCANCODE_K: return K;
-    case SDL_SCANCODE_L: return L;
-    case SDL_SCANCODE_SEMICOLON: return SEMICOLON;
-    case SDL_SCANCODE_APOSTROPHE: return APOSTROPHE;
-    case SDL_SCANCODE_RETURN: return RETURN;
-    case SDL_SCANCODE_LSHIFT: return SHIFTLEFT;
-    case SDL_SCANCODE_Z: return Z;
-    case SDL_SCANCODE_X: return X;
-    case SDL_SCANCODE_C: return C;
-    case SDL_SCANCODE_V: return V;
-    case SDL_SCANCODE_B: return B;
-    case SDL_SCANCODE_N: return N;
-    case SDL_SCANCODE_M: return M;
-    case SDL_SCANCODE_COMMA: return COMMA;
-    case SDL_SCANCODE_PERIOD: return PERIOD;
-    case SDL_SCANCODE_SLASH: return FOWARDSLASH;
-    case SDL_SCANCODE_RSHIFT: return SHIFTRIGHT;
-    case SDL_SCANCODE_LCTRL: return CTRLLEFT;
-    case SDL_SCANCODE_LGUI: return GUILEFT;
-    case SDL_SCANCODE_LALT: return ALTLEFT;
-    case SDL_SCANCODE_SPACE: return SPACE;
-    case SDL_SCANCODE_RALT: return ALTRIGHT;
-    case SDL_SCANCODE_SELECT: return SELECT;
-    case SDL_SCANCODE_RCTRL: return CTRLRIGHT;
-    case SDL_SCANCODE_PRINTSCREEN: return PRINTSCREEN;
-    case SDL_SCANCODE_SCROLLLOCK: return SCROLLLOCK;
-    case SDL_SCANCODE_PAUSE: return PAUSE;
-    case SDL_SCANCODE_INSERT: return INSERT;
-    case SDL_SCANCODE_HOME: return HOME;
-    case SDL_SCANCODE_PAGEUP: return PAGEUP;
-    case SDL_SCANCODE_DELETE: return Key::DELETE;
-    case SDL_SCANCODE_END: return END;
-    case SDL_SCANCODE_PAGEDOWN: return PAGEDOWN;
-    case SDL_SCANCODE_UP: return ARROWUP;
-    case SDL_SCANCODE_DOWN: return ARROWDOWN;
-    case SDL_SCANCODE_LEFT: return ARROWLEFT;
-    case SDL_SCANCODE_RIGHT: return ARROWRIGHT;
-    default: return Key::OTHERKEY;
-  }
-}
-
-/*!
-\brief Converts an SDL unsigned value to an MButton.
-\param value The unsigned int SDL uses to refer to a mouse button.
-\return The corresponding MButton value.
-*/
-MButton Input::UnsignedToMButton(unsigned value)
-{
-  switch (value)
-  {
-    case SDL_BUTTON_LEFT: return LEFT;
-    case SDL_BUTTON_MIDDLE: return MIDDLE;
-    case SDL_BUTTON_RIGHT: return RIGHT;
-    default: return MButton::OTHERMBUTTON;
-  }
-}
-
-/*!
-\brief Convert an SDL unsigned value to a CButton.
-\param value The SDL unsigned value.
-\return The corresponding CButton.
-*/
-CButton Input::UnsignedToCButton(unsigned value)
-{
-  switch (value)
-  {
-    case SDL_CONTROLLER_BUTTON_A: return EX;  break;
-    case SDL_CONTROLLER_BUTTON_B: return CIRCLE; break;
-    case SDL_CONTROLLER_BUTTON_X: return SQUARE; break;
-    case SDL_CONTROLLER_BUTTON_Y: return TRIANGLE; break;
-    case SDL_CONTROLLER_BUTTON_DPAD_UP: return DPADUP; break;
-    case SDL_CONTROLLER_BUTTON_DPAD_DOWN: return DPADDOWN; break;
-    case SDL_CONTROLLER_BUTTON_DPAD_LEFT: return DPADLEFT; break;
-    case SDL_CONTROLLER_BUTTON_DPAD_RIGHT: return DPADRIGHT; break;
-    case SDL_CONTROLLER_BUTTON_LEFTSHOULDER: return BUMPERLEFT; break;
-    case SDL_CONTROLLER_BUTTON_RIGHTSHOULDER: return BUMPERRIGHT; break;
-    case SDL_CONTROLLER_BUTTON_LEFTSTICK: return STICKLEFT; break;
-    case SDL_CONTROLLER_BUTTON_RIGHTSTICK: return STICKRIGHT; break;
-    case SDL_CONTROLLER_BUTTON_BACK: return RESET; break;
-    case SDL_CONTROLLER_BUTTON_START: return START; break;
-    default: return OTHERCBUTTON; break;
-  }
-  return CButton::EX;
-}
-
-/*!
-\brief Convert an SDL unsigned value to a CAnalog.
-\param value The SDL unsigned value.
-\return The corresponding CAnalog.
-*/
-CAnalog Input::UnsignedToCAnalgo(unsigned analog)
-{
-  switch (analog)
-  {
-  case SDL_CONTROLLER_AXIS_TRIGGERLEFT: return TRIGGERLEFT; break;
-  case SDL_CONTROLLER_AXIS_TRIGGERRIGHT: return TRIGGERRIGHT; break;
-  case SDL_CONTROLLER_AXIS_LEFTX: return STICKLEFTX; break;
-  case SDL_CONTROLLER_AXIS_LEFTY: return STICKLEFTY; break;
-  case SDL_CONTROLLER_AXIS_RIGHTX: return STICKRIGHTX; break;
-  case SDL_CONTROLLER_AXIS_RIGHTY: return STICKRIGHTY; break;
-  default: return OTHERCANALOG; break;
-  }
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Resets values that should only be present for a single frame. This is called
-  but Context::CheckEvents before events are checked for.
-*/
-/*****************************************************************************/
-inline void Input::Reset()
-{
-  _keysPressed.clear();
-  _mouseButtonsPressed.clear();
-  _mouseMotion.first = 0;
-  _mouseMotion.second = 0;
-  _mouseWheelMotion = 0;
-  for (Controller & controller : _activeController){
-    controller._buttonsPressed.clear();
-  }
-}
-
-
-/*!
-\brief Updates Input values for a corresponding SDL_KEYDOWN event.
-\param event The SDL event.
-*/
-void Input::OnKeyDownEvent(const SDL_Event & event)
-{
-  if (event.key.repeat)
-    return;
-  Key value = ScancodeToKey(event.key.keysym.scancode);
-  _keysDown[value] = true;
-  _keysPressed.push_back(value);
-}
-
-
-/*!
-\brief Updates Input values for a corresponding SDL_KEYUP event.
-\param event The SDL event.
-*/
-void Input::OnKeyUpEvent(const SDL_Event & event)
-{
-  Key value = ScancodeToKey(event.key.keysym.scancode);
-  _keysDown[value] = false;
-}
-
-/*!
-\brief Updates Input values for a corresponding SDL_MOUSEBUTTONDOWN event.
-\param event The SDL event.
-*/
-void Input::OnMouseButtonDownEvent(const SDL_Event & event)
-{
-  MButton value = UnsignedToMButton(event.button.button);
-  _mouseButtonsDown[value] = true;
-  _mouseButtonsPressed.push_back(value);
-}
-
-/*!
-\brief Updates Input values for a corresponding SDL_MOUSEBUTTONUP event.
-\param event The SDL event.
-*/
-void Input::OnMouseButtonUpEvent(const SDL_Event & event)
-{
-  MButton value = UnsignedToMButton(event.button.button);
-  _mouseButtonsDown[value] = false;
-}
-
-/*!
-\brief Updates Input values for a corresponding SDL_MOUSEMOTION event.
-\param event The SDL event.
-*/
-void Input::OnMouseMotionEvent(const SDL_Event & event)
-{
-  _mouseMotion.first = event.motion.xrel;
-  _mouseMotion.second = event.motion.yrel;
-  _mouseLocation.first = event.motion.x;
-  _mouseLocation.second = event.motion.y;
-}
-
-/*!
-\brief Updates Input values for a corresponding SDL_MOUSEWHEEL event.
-\param event The SDL event.
-*/
-void Input::OnMouseWheelEvent(const SDL_Event & event)
-{
-  _mouseWheelMotion = static_cast<int>(event.wheel.y);
-}
-
-/*!
-\brief Adds a controller to the inactive controllers vector when it is added.
-\param The SDL event.
-*/
-void Input::OnControllerAdded(const SDL_Event & event)
-{
-  _inactiveController.push_back(event.cdevice.which);
-}
-
-/*!
-\brief Removes a controller from the input class on a remove controller event.
-\param event The SDL event.
-*/
-void Input::OnControllerRemoved(const SDL_Event & event)
-{
-  if (IsActiveControlller(event.cdevice.which))
-    DeactiveateController(event.cdevice.which);
-  std::vector<Sint32>::iterator it = _inactiveController.begin();
-  std::vector<Sint32>::iterator it_e = _inactiveController.end();
-  for (; it != it_e; ++it) {
-    if (*it == event.cdevice.which) {
-      _inactiveController.erase(it);
-      return;
-    }
-  }
-}
-
-/*!
-\brief Updates a controllers instance's button states on a button down event.
-\param event The SDL event.
-*/
-void Input::OnControllerDown(const SDL_Event & event)
-{
-  CButton button = UnsignedToCButton(event.cbutton.button);
-  for (Controller & controller : _activeController) {
-    if (event.cbutton.which == controller._id) {
-      controller._buttonsDown[button] = true;
-      controller._buttonsPressed.push_back(button);
-      return;
-    }
-  }
-}
-
-/*!
-\brief Called when a controller button is lifted.
-\param event The SDL event.
-*/
-void Input::OnControllerUp(const SDL_Event & event)
-{
-  CButton button = UnsignedToCButton(event.cbutton.button);
-  for (Controller & controller : _activeController) {
-    if (event.cbutton.which == controller._id) {
-      controller._buttonsDown[button] = false;
-      return;
-    }
-  }
-}
-
-/*!
-\brief Updates a changed controller analog.
-\param event The SDL event.
-*/
-void Input::OnControllerAxis(const SDL_Event & event)
-{
-  CAnalog analog = UnsignedToCAnalgo(event.caxis.axis);
-  for (Controller & controller : _activeController) {
-    if (event.caxis.which == controller._id) {
-      CAnalog analog = UnsignedToCAnalgo(event.caxis.axis);
-      controller.UpdateAnalog(analog, event.caxis.value);
-      return;
-    }
-  }
-}
+/* All content(c) 2016 - 2017 DigiPen(USA) Corporation, all rights reserved. */
+/*****************************************************************************/
+/*!
+\file Context.cpp
+\author Connor Deakin
+\par E-mail: connor.deakin\@digipen.edu
+\par Project: Graphics
+\date 30/09/2016
+\brief
+  Contains the implementation of the static Context class. Look at the 
+  documentation of the Context class for more info on this code.
+*/
+/*****************************************************************************/
+
+// S_CONTEXT //////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iterator>
+
+#include <SDL\SDL.h>
+// Undefine the main define by SDL
+#undef main
+#include "Error.h"
+#include "Time.h"
+
+#include "Context.h"
+
+
+// static initializations
+bool Context::_close = true;
+bool Context::_created = false;
+void(*Context::_adjustViewport)() = nullptr;
+void(*Context::_processEvent)(SDL_Event * event) = nullptr;
+SDL_Window * Context::_window = nullptr;
+
+/*****************************************************************************/
+/*!
+\brief
+  Constructor for the Context class. If all of the parameters are not given,
+  the following the defaults will be applied. If the given width and height
+  are zero, the Context will instantly fullscreen.
+
+\par
+  Defaults
+   - name: "Context"
+   - opengl: false
+   - adjust_viewport: nullptr
+   - width:  600
+   - height: 600
+   - xposition: 0
+   - yposition: 0
+
+\param name
+  The name that will be seen in the top left of the window.
+\param opengl
+  Set to true if this Context is being used for an OpenGLContext.
+\param adjust_viewport
+  Callback function for adjusting the graphics viewport after window resizing.
+\param width
+  The width of the window.
+\param height
+  The height of the window.
+\param xposition
+  The X position of the top left corner of the window.
+\param yposition
+  The Y position of the top left cornter of the window.
+*/
+/*****************************************************************************/
+void Context::Create(const char * name, bool opengl, void(*adjust_viewport)(),
+                     int width, int height,
+                     int xposition, int yposition)
+{
+  // throwing error if context already exists
+  if (_created)
+  {
+    RootError root_error("Context.cpp", "Init");
+    root_error.Add("A Context already exists.");
+    root_error.Add("Only one context can exist at a time.");
+    throw(root_error);
+  }
+  // initialize sdl
+  SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMECONTROLLER);
+  // create window flags
+  Uint32 flags = SDL_WINDOW_RESIZABLE | SDL_WINDOW_INPUT_FOCUS |
+    SDL_WINDOW_MOUSE_FOCUS;
+  if (width == 0 && height == 0)
+    flags = flags | SDL_WINDOW_FULLSCREEN_DESKTOP;
+  if (opengl)
+    flags = flags | SDL_WINDOW_OPENGL;
+  // creating window
+  _window = SDL_CreateWindow(name, xposition, yposition, width, height, flags);
+  // making sure windo was created
+  if (!_window)
+  {
+    SDL_Quit();
+    RootError root_error("Context.cpp", "CreateContext");
+    root_error.Add("SDL window creation failed.");
+    throw(root_error);
+  }
+  // setting callback
+  _adjustViewport = adjust_viewport;
+  // done
+  _close = false;
+  _created = true;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Destructor for the Context class. This will clean up all the Context
+  resources.
+*/
+/*****************************************************************************/
+void Context::Purge()
+{
+  SDL_DestroyWindow(_window);
+  SDL_Quit();
+  _created = false;
+}
+
+/*****************************************************************************/
+/*!
+\brief Add a function that will process events sent from SDL. This will
+ typically be used if events that are not checked by the Context class and
+ you want those events or, alternatively, an external library needs access to
+ the SDL events.
+
+\param process_event The function that will be used for processing the SDL
+  events.
+*/
+/*****************************************************************************/
+void Context::AddEventProcessor(void (*process_event)(SDL_Event * event))
+{
+  _processEvent = process_event;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Checks for any SDL Events that exits within SDL's event queue and acts
+  according to the type of the event.
+*/
+/*****************************************************************************/           
+void Context::CheckEvents()
+{
+  // Clearing pressed keys and other values
+  // from previous frame
+  Input::Reset();
+  SDL_Event event;
+  // input comes from the recording while replaying
+  bool replaying = Input::Replaying();
+  // reading all events in queue
+  while (SDL_PollEvent(&event))
+  {
+    if (replaying && event.type != SDL_WINDOWEVENT)
+      continue;
+    switch (event.type)
+    {
+      case SDL_WINDOWEVENT: OnWindowEvent(event); break;
+      case SDL_KEYDOWN: Input::OnKeyDownEvent(event); break;
+      case SDL_KEYUP: Input::OnKeyUpEvent(event); break;
+      case SDL_MOUSEBUTTONDOWN: Input::OnMouseButtonDownEvent(event); break;
+      case SDL_MOUSEBUTTONUP: Input::OnMouseButtonUpEvent(event); break;
+      case SDL_MOUSEWHEEL: Input::OnMouseWheelEvent(event); break;
+      case SDL_MOUSEMOTION: Input::OnMouseMotionEvent(event); break;
+      case SDL_CONTROLLERDEVICEADDED: Input::OnControllerAdded(event); break;
+      case SDL_CONTROLLERDEVICEREMOVED: Input::OnControllerRemoved(event); break;
+      case SDL_CONTROLLERBUTTONDOWN: Input::OnControllerDown(event); break;
+      case SDL_CONTROLLERBUTTONUP: Input::OnControllerUp(event); break;
+      case SDL_CONTROLLERAXISMOTION: Input::OnControllerAxis(event); break;
+    }
+  }
+  if (replaying && !Input::ReplayFrame())
+    Close();
+  // use external event processor
+  if (_processEvent)
+    _processEvent(&event);
+  // making the new input state visible
+  Input::Swap();
+  if (Input::Recording())
+    Input::RecordFrame();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  If called, both the contex will be made fullscreen. Update
+  does not have to be called after this function. The function will handle the
+  Context change.
+*/
+/*****************************************************************************/
+void Context::Fullscreen()
+{
+  SDL_SetWindowFullscreen(_window, SDL_WINDOW_FULLSCREEN_DESKTOP);
+  if(_adjustViewport)
+    _adjustViewport();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Used to show or hide the cursor when it is hovering over the Context.
+
+\param hide
+  If true, the cursor will be hidden when hovering over the context. If false,
+  the cursor will always be visible.
+*/
+/*****************************************************************************/
+void Context::HideCursor(bool hide)
+{
+  if(hide)
+    SDL_ShowCursor(SDL_DISABLE);
+  else
+    SDL_ShowCursor(SDL_ENABLE);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Hides the window. Rendering still takes place, which allows a replay to be
+  run as a benchmark without the window getting in the way.
+*/
+/*****************************************************************************/
+void Context::HideWindow()
+{
+  SDL_HideWindow(_window);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Gets a pointer to the SDL window for this context.
+
+\return A pointer to the SDL window for this context.
+*/
+/*****************************************************************************/
+SDL_Window * Context::SDLWindow()
+{
+  return _window;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Identifies whether the SDL context has been created or not. 
+
+\return If the SDL Context has been created, true.
+*/
+/*****************************************************************************/
+bool Context::Created()
+{
+  return _created;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Get the current Context status. If it is to remain open, this will return
+  true. Otherwise, this will return false.
+
+\return The current status of the Context.
+*/
+/*****************************************************************************/
+bool Context::KeepOpen()
+{
+  if(_close)
+    return false;
+  return true;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Calling this signifies that the context should close. It will not actually
+  close when this function called. The close bool in the class will simply be
+  set to true. It is your job to check this value using the KeepOpen function.
+  This function and KeepOpen are used to maintain a game loop.
+*/
+/*****************************************************************************/
+void Context::Close()
+{
+  _close = true;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  This will be called from CheckEvents() when SDL sends a window event. This
+  includes evetns such as maximizing, minimizing, resizing, closing, etc.
+
+\param event
+  The window event that was pulled off the event queue from SDL_PollEvents.
+*/
+/*****************************************************************************/
+void Context::OnWindowEvent(const SDL_Event & event)
+{
+  switch (event.window.event)
+  {
+    case SDL_WINDOWEVENT_RESIZED: if(_adjustViewport) _adjustViewport(); break;
+    case SDL_WINDOWEVENT_CLOSE: Close(); break;
+  }
+}
+
+// S_INPUT ////////////////////////////////////////////////////////////////////
+
+// static initializations
+Input::Snapshot Input::_snapshots[2];
+int Input::_front = 0;
+std::mutex Input::_mutex;
+Input::Event Input::_events[INPUT_EVENT_CAPACITY];
+unsigned long long Input::_eventCount = 0;
+std::ofstream Input::_recordFile;
+unsigned long long Input::_recordCursor = 0;
+std::vector<char> Input::_replayData;
+size_t Input::_replayOffset = 0;
+float Input::_replayStep = 0.0f;
+bool Input::_replaying = false;
+std::vector<float *> Input::_trackedValues;
+std::vector<float> Input::_recordedValues;
+std::vector<Sint32> Input::_inactiveController;
+std::vector<Input::Controller> Input::_activeController;
+std::vector<int> Input::_controllerIndex;
+float Input::_analogThreshold = 0.1f;
+
+
+/*****************************************************************************/
+/*!
+\brief
+  Used to find out if a key was down during the previous frame.
+  
+\param key
+  The key that is being checked.
+
+\return If the key was down, true.
+*/
+/*****************************************************************************/
+bool Input::KeyDown(Key key)
+{
+  return _snapshots[_front].KeyDown(key);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Used to find out if a key was pressed during the previous frame.
+
+\param key
+  The key that is being checked.
+
+\return If the key was pressed, true.
+*/
+/*****************************************************************************/
+bool Input::KeyPressed(Key key)
+{
+  return _snapshots[_front].KeyPressed(key);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Used to find out if a key was released during the previous frame.
+
+\param key
+  The key that is being checked.
+
+\return If the key was released, true.
+*/
+/*****************************************************************************/
+bool Input::KeyReleased(Key key)
+{
+  return _snapshots[_front].KeyReleased(key);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Used to find out if any key on the keyboard was pressed during the previous
+  frame.
+
+\return If a key was pressed, true.
+*/
+/*****************************************************************************/
+bool Input::AnyKeyPressed()
+{
+  return _snapshots[_front].AnyKeyPressed();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Used to find out if a mouse button was down during the previous frame.
+
+\param mouse_button
+  The mouse button that is being checked.
+
+\return If the mouse button was down, true.
+*/
+/*****************************************************************************/
+bool Input::MouseButtonDown(MButton mouse_button)
+{
+  return _snapshots[_front].MouseButtonDown(mouse_button);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Used to find out if a mouse button was pressed during the previous frame.
+
+\param mouse_button
+  The mouse button that is being checked.
+
+\return If the mouse button was pressed, true.
+*/
+/*****************************************************************************/
+bool Input::MouseButtonPressed(MButton mouse_button)
+{
+  return _snapshots[_front].MouseButtonPressed(mouse_button);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Used to find out if a mouse button was released during the previous frame.
+
+\param mouse_button
+  The mouse button that is being checked.
+
+\return If the mouse button was released, true.
+*/
+/*****************************************************************************/
+bool Input::MouseButtonReleased(MButton mouse_button)
+{
+  return _snapshots[_front].MouseButtonReleased(mouse_button);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Used to check if any mouse button was pressed during the previous frame.
+
+\return If a mouse button was pressed, true.
+*/
+/*****************************************************************************/
+bool Input::AnyMouseButtonPressed()
+{
+  return _snapshots[_front].AnyMouseButtonPressed();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Returns the motion undergone by the mouse during the previous frame. The 
+  first value in the pair is the X motion and the second value is the Y motion.
+
+\return A pair containing the motion of the mouse during the previous frame.
+*/
+/*****************************************************************************/
+const std::pair<int, int> & Input::MouseMotion()
+{
+  return _snapshots[_front].MouseMotion();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Returns the location of the mouse during the previous frame. The first value
+  in the pair is the X location and the second value is the Y location.
+
+\return A pair containing the location of the mouse during the previous frame.
+*/
+/*****************************************************************************/
+const std::pair<int, int> & Input::MouseLocation()
+{
+  return _snapshots[_front].MouseLocation();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Returns the motion undergone by the mouse wheel during the previous frame.
+  Motion away from the user will result in a positive one and motion towards
+  the user will result in a negative one.
+
+\return Described in the brief.
+*/
+/*****************************************************************************/
+int Input::MouseWheelMotion()
+{
+  return _snapshots[_front].MouseWheelMotion();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Returns the front Snapshot. Only use this on the thread that calls
+  Context::CheckEvents.
+
+\return The Snapshot for the previous frame.
+*/
+/*****************************************************************************/
+const Input::Snapshot & Input::Current()
+{
+  return _snapshots[_front];
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Copies the front Snapshot. This is safe to call from any thread.
+
+\return A copy of the Snapshot for the previous frame.
+*/
+/*****************************************************************************/
+Input::Snapshot Input::Capture()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _snapshots[_front];
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Reads the event that comes after a cursor in the event ring and moves the
+  cursor forward. A cursor that starts at zero will read every event. If the
+  reader falls more than INPUT_EVENT_CAPACITY events behind, the cursor skips
+  ahead to the oldest event still in the ring. This is safe to call from any
+  thread.
+
+\param cursor
+  The number of events the caller has already read.
+\param event
+  Filled with the event if there was one.
+
+\return If an event was read, true.
+*/
+/*****************************************************************************/
+bool Input::NextEvent(unsigned long long & cursor, Event & event)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (cursor >= _eventCount)
+    return false;
+  if (_eventCount - cursor > INPUT_EVENT_CAPACITY)
+    cursor = _eventCount - INPUT_EVENT_CAPACITY;
+  event = _events[cursor % INPUT_EVENT_CAPACITY];
+  ++cursor;
+  return true;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Starts recording the input for every frame to a file. Each frame stores
+  its delta time, the motion of the mouse and wheel, the events that
+  happened during the frame, and the tracked values that changed since the
+  previous frame. The first frame stores every tracked value.
+
+\param filename
+  The file that the recording is written to.
+*/
+/*****************************************************************************/
+void Input::Record(const char * filename)
+{
+  StopRecording();
+  _recordFile.open(filename, std::ios::binary | std::ios::trunc);
+  if (!_recordFile.is_open()) {
+    Error error("Context.cpp", "Input::Record");
+    error.Add("The recording file could not be opened.");
+    error.Add(filename);
+    throw(error);
+  }
+  unsigned header[2] = { INPUT_RECORD_MAGIC, INPUT_RECORD_VERSION };
+  _recordFile.write((const char *)header, sizeof(header));
+  _recordCursor = _eventCount;
+  _recordedValues.clear();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Stops recording and closes the recording file.
+*/
+/*****************************************************************************/
+void Input::StopRecording()
+{
+  if (_recordFile.is_open())
+    _recordFile.close();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Identifies whether frames are being recorded.
+
+\return If frames are being recorded, true.
+*/
+/*****************************************************************************/
+bool Input::Recording()
+{
+  return _recordFile.is_open();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Starts replaying a file written by Record. The entire recording is read
+  into memory so the replay does not wait on the disk. The Context is closed
+  after the final frame is replayed.
+
+\param filename
+  The recording to replay.
+\param time_step
+  The fixed delta time given to every frame. If this is not positive, the
+  delta times stored in the recording are used.
+*/
+/*****************************************************************************/
+void Input::Replay(const char * filename, float time_step)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    Error error("Context.cpp", "Input::Replay");
+    error.Add("The recording file could not be opened.");
+    error.Add(filename);
+    throw(error);
+  }
+  _replayData.assign(std::istreambuf_iterator<char>(file),
+    std::istreambuf_iterator<char>());
+  unsigned header[2] = { 0, 0 };
+  if (_replayData.size() >= sizeof(header))
+    memcpy(header, _replayData.data(), sizeof(header));
+  if (header[0] != INPUT_RECORD_MAGIC || header[1] != INPUT_RECORD_VERSION) {
+    _replayData.clear();
+    Error error("Context.cpp", "Input::Replay");
+    error.Add("The file is not a recording made by this version.");
+    error.Add(filename);
+    throw(error);
+  }
+  _replayOffset = sizeof(header);
+  _replayStep = time_step;
+  _replaying = true;
+  PrepareReplayStep();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Identifies whether a recording is being replayed.
+
+\return If a recording is being replayed, true.
+*/
+/*****************************************************************************/
+bool Input::Replaying()
+{
+  return _replaying;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Adds a value to the values that are recorded with every frame. While
+  replaying, the recorded changes are written to the value when the frame
+  they were recorded with is replayed, so changes made through the editor
+  happen at the same point in the replay.
+
+\param value
+  The value. It must stay valid while recording or replaying.
+*/
+/*****************************************************************************/
+void Input::TrackValue(float * value)
+{
+  _trackedValues.push_back(value);
+}
+
+// S_INPUT_SNAPSHOT ///////////////////////////////////////////////////////////
+
+/*!
+\brief Creates a Snapshot where nothing is down and the mouse has not moved.
+*/
+Input::Snapshot::Snapshot() :
+  _mouseMotion(0, 0), _mouseLocation(0, 0), _mouseWheelMotion(0)
+{}
+
+/*!
+\brief Identifies whether a key was down.
+\param key The key that is being checked.
+\return If the key was down, true.
+*/
+bool Input::Snapshot::KeyDown(Key key) const
+{
+  return _keysDown[key];
+}
+
+/*!
+\brief Identifies whether a key was pressed during the frame.
+\param key The key that is being checked.
+\return If the key was pressed, true.
+*/
+bool Input::Snapshot::KeyPressed(Key key) const
+{
+  return _keysPressed[key];
+}
+
+/*!
+\brief Identifies whether a key was released during the frame.
+\param key The key that is being checked.
+\return If the key was released, true.
+*/
+bool Input::Snapshot::KeyReleased(Key key) const
+{
+  return _keysReleased[key];
+}
+
+/*!
+\brief Identifies whether any key was pressed during the frame.
+\return If a key was pressed, true.
+*/
+bool Input::Snapshot::AnyKeyPressed() const
+{
+  return _keysPressed.any();
+}
+
+/*!
+\brief Identifies whether a mouse button was down.
+\param mouse_button The mouse button that is being checked.
+\return If the mouse button was down, true.
+*/
+bool Input::Snapshot::MouseButtonDown(MButton mouse_button) const
+{
+  return _mouseButtonsDown[mouse_button];
+}
+
+/*!
+\brief Identifies whether a mouse button was pressed during the frame.
+\param mouse_button The mouse button that is being checked.
+\return If the mouse button was pressed, true.
+*/
+bool Input::Snapshot::MouseButtonPressed(MButton mouse_button) const
+{
+  return _mouseButtonsPressed[mouse_button];
+}
+
+/*!
+\brief Identifies whether a mouse button was released during the frame.
+\param mouse_button The mouse button that is being checked.
+\return If the mouse button was released, true.
+*/
+bool Input::Snapshot::MouseButtonReleased(MButton mouse_button) const
+{
+  return _mouseButtonsReleased[mouse_button];
+}
+
+/*!
+\brief Identifies whether any mouse button was pressed during the frame.
+\return If a mouse button was pressed, true.
+*/
+bool Input::Snapshot::AnyMouseButtonPressed() const
+{
+  return _mouseButtonsPressed.any();
+}
+
+/*!
+\brief Gets the motion of the mouse during the frame.
+\return The x and y motion of the mouse.
+*/
+const std::pair<int, int> & Input::Snapshot::MouseMotion() const
+{
+  return _mouseMotion;
+}
+
+/*!
+\brief Gets the location of the mouse at the end of the frame.
+\return The x and y location of the mouse.
+*/
+const std::pair<int, int> & Input::Snapshot::MouseLocation() const
+{
+  return _mouseLocation;
+}
+
+/*!
+\brief Gets the motion of the mouse wheel during the frame.
+\return The motion of the mouse wheel.
+*/
+int Input::Snapshot::MouseWheelMotion() const
+{
+  return _mouseWheelMotion;
+}
+
+/*!
+\brief Clears the values that should only be present for a single frame.
+*/
+void Input::Snapshot::BeginFrame()
+{
+  _keysPressed.reset();
+  _keysReleased.reset();
+  _mouseButtonsPressed.reset();
+  _mouseButtonsReleased.reset();
+  _mouseMotion.first = 0;
+  _mouseMotion.second = 0;
+  _mouseWheelMotion = 0;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Returns the lowest inactive controller. For example, if controllers 1, 2,
+  and 3 are inactive, controller 1 will be returned. If there are no inactive
+  controllers, -1 will be returned.
+
+\return The id of the inactive controller.
+*/
+/*****************************************************************************/
+Sint32 Input::GetInactiveController()
+{
+  // making sure there are inactive controllers.
+  if (_inactiveController.size() == 0)
+    return -1;
+  const Sint32 max_controllers = 4;
+  Sint32 id = max_controllers;
+  for (Sint32 c_id : _inactiveController) {
+    if (c_id < id)
+      id = c_id;
+  }
+  return id;
+}
+
+/*****************************************************************************/
+/*!
+\brief 
+  Find out whether a controller is active or not through an id. This id
+  will be a number from 0 to 3.
+
+\param id The id of the controller.
+
+\return If the controller is active, true, otherwise, false.
+*/
+/*****************************************************************************/
+bool Input::IsActiveControlller(Sint32 id)
+{
+  return FindController(id) != nullptr;
+}
+
+/*****************************************************************************/
+/*!
+\brief 
+  Activates then specified controller. Throws an error if the controller
+  id did not exist among the current inactive controllers. 
+
+\param id The id that was given by GetInactiveController.
+*/
+/*****************************************************************************/
+void Input::ActivateController(Sint32 id)
+{
+  std::vector<Sint32>::iterator it = _inactiveController.begin();
+  std::vector<Sint32>::iterator it_e = _inactiveController.end();
+  for (; it != it_e; ++it) {
+    if (*it == id) {
+      SDL_GameController * controller = SDL_GameControllerOpen(id);
+      _inactiveController.erase(it);
+      if (id >= (Sint32)_controllerIndex.size())
+        _controllerIndex.resize(id + 1, -1);
+      _controllerIndex[id] = (int)_activeController.size();
+      _activeController.push_back(Controller(id, controller));
+      return;
+    }
+  }
+  Error error("Context.cpp", "ActivateController");
+  error.Add("The controller ID did not exist among inactive controllers.");
+  throw(error);
+}
+
+/*****************************************************************************/
+/*!
+\brief 
+  Deactivates a specified controller. An error is thrown if the given id is
+  not found among the active controllers.
+
+\param id The id of the active controller that is to be deactivated.
+*/
+/*****************************************************************************/
+void Input::DeactiveateController(Sint32 id)
+{
+  Controller * controller = FindController(id);
+  if (controller) {
+    SDL_GameControllerClose(controller->_sdlController);
+    // the last controller takes the place of the removed controller
+    int index = _controllerIndex[id];
+    _activeController[index] = _activeController.back();
+    _controllerIndex[_activeController[index]._id] = index;
+    _activeController.pop_back();
+    _controllerIndex[id] = -1;
+    _inactiveController.push_back(id);
+    return;
+  }
+  Error error("Context.cpp", "DeactivateController");
+  error.Add("The controller ID did not exist among the active controllers.");
+  throw(error);
+}
+
+
+/*****************************************************************************/
+/*!
+\brief
+  Returns the Controller instance of a controller given a specific id for that
+  controller. An error will be thrown if the id does not exist among the active
+  controllers.
+
+\param id The id of the controller to be fetched.
+
+\return The controller instance.
+*/
+/*****************************************************************************/
+Input::Controller * Input::GetController(Sint32 id)
+{
+  Controller * controller = FindController(id);
+  if (controller)
+    return controller;
+  Error error("Context.cpp", "GetController");
+  error.Add("The requested controller is not active.");
+  throw(error);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Identfies whether a button was down during the previous frame or not.
+
+\param button
+  The button being evaluated.
+
+\return If the button was down, true.
+*/
+/*****************************************************************************/
+bool Input::Controller::ButtonDown(CButton button) const
+{
+  return _buttonsDown[button];
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Identifies whether a button was pressed during the previous frame.
+
+\param button
+  The button being evaluated.
+
+\return If the button was pressed. true
+*/
+/*****************************************************************************/
+bool Input::Controller::ButtonPressed(CButton button) const
+{
+  return _buttonsPressed[button];
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Gets the raw analog value of an analog during the previous frame.
+
+\param analog The analog whose value will be returned.
+
+\return The analog's raw value.
+*/
+/*****************************************************************************/
+Sint16 Input::Controller::AnalogValue(CAnalog analog) const
+{
+  return _analogs[analog];
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Identifies whether an anlog is beyond the analog threshold, therefore
+  making the analog a valid input.
+
+\param analog The analog being checked for validity.
+
+\return If the analog value is above the analog threshold, true.
+*/
+/*****************************************************************************/
+bool Input::Controller::AnalogActive(CAnalog analog) const
+{
+  return _activeAnalogs[analog];
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  The analog value of the left trigger. Will be given as a number from 0 to 1.
+
+\return That floating analog value of the left trigger.
+*/
+/*****************************************************************************/
+float Input::Controller::TriggerLeft() const
+{
+  return _triggerLeft;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  The analog value of the right trigger. Will be given as a number from 0 to 1.
+
+\return That floating analog value of the right trigger.
+*/
+/*****************************************************************************/
+float Input::Controller::TriggerRight() const
+{
+  return _triggerRight;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Returns the floating point values associated with the left stick. These
+  values will be between 0 and 1.
+
+\return The floating analog values. The first value is x, the second is y.
+*/
+/*****************************************************************************/
+const std::pair<float, float> & Input::Controller::StickLeft() const
+{
+  return _stickLeft;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Returns the floating point values associated with the right stick. These
+  values will be between 0 and 1.
+
+\return The floating analog values. The first value is x, the second is y.
+*/
+/*****************************************************************************/
+const std::pair<float, float> & Input::Controller::StickRight() const
+{
+  return _stickRight;
+}
+
+
+
+/*!
+\brief Controller instance constuctor.
+\param id The SDL id of the controller.
+\param controller The SDL_GameController value.
+*/
+Input::Controller::Controller(Sint32 id, SDL_GameController * controller) :
+  _id(id), _sdlController(controller), _analogs{ 0 },
+  _triggerLeft(0.0f), _triggerRight(0.0f), _stickLeft(0.0f, 0.0f),
+  _stickRight(0.0f, 0.0f), _activeAnalogs{ false }
+{}
+
+
+#include <iostream>
+
+/*!
+\brief Updates an analog value of the controller.
+\param analog The analog being updated.
+\param value The analog's new value.
+*/
+inline void Input::Controller::UpdateAnalog(CAnalog analog, Sint16 value)
+{
+  const float max_analog = 32767.0f;
+  float norm_value = (float)value / max_analog;
+  _analogs[analog] = value;
+  switch (analog)
+  {
+  case TRIGGERLEFT: _triggerLeft = norm_value; break;
+  case TRIGGERRIGHT: _triggerRight = norm_value; break;
+  case STICKLEFTX: _stickLeft.first = norm_value; break;
+  case STICKLEFTY: _stickLeft.second = -norm_value; break;
+  case STICKRIGHTX: _stickRight.first = norm_value; break;
+  case STICKRIGHTY: _stickRight.second = -norm_value; break;
+  default: break;
+  }
+  if (norm_value > _analogThreshold || -norm_value > _analogThreshold)
+    _activeAnalogs[analog] = true;
+  else
+    _activeAnalogs[analog] = false;
+}
+
+/*!
+\brief Converts an SDL scancode to a Key.
+\param value The SDL_Scancode value.
+\return The SDL_Scancode's corresponding Key value.
+*/
+Key Input::ScancodeToKey(SDL_Scancode value)
+{
+  // not proud of this, but I also don't want to type
+  // SDL_SCANCODE_ again.
+  switch (value)
+  {
+    case SDL_SCANCODE_ESCAPE: return ESCAPE;
+    case SDL_SCANCODE_F1: return F1;
+    case SDL_SCANCODE_F2: return F2;
+    case SDL_SCANCODE_F3: return F3;
+    case SDL_SCANCODE_F4: return F4;
+    case SDL_SCANCODE_F5: return F5;
+    case SDL_SCANCODE_F6: return F6;
+    case SDL_SCANCODE_F7: return F7;
+    case SDL_SCANCODE_F8: return F8;
+    case SDL_SCANCODE_F9: return F9;
+    case SDL_SCANCODE_F10: return F10;
+    case SDL_SCANCODE_F11: return F11;
+    case SDL_SCANCODE_F12: return F12;
+    case SDL_SCANCODE_GRAVE: return TILDE;
+    case SDL_SCANCODE_1: return N1;
+    case SDL_SCANCODE_2: return N2;
+    case SDL_SCANCODE_3: return N3;
+    case SDL_SCANCODE_4: return N4;
+    case SDL_SCANCODE_5: return N5;
+    case SDL_SCANCODE_6: return N6;
+    case SDL_SCANCODE_7: return N7;
+    case SDL_SCANCODE_8: return N8;
+    case SDL_SCANCODE_9: return N9;
+    case SDL_SCANCODE_0: return N0;
+    case SDL_SCANCODE_MINUS: return MINUS;
+    case SDL_SCANCODE_EQUALS: return EQUAL;
+    case SDL_SCANCODE_BACKSPACE: return BACKSPACE;
+    case SDL_SCANCODE_TAB: return TAB;
+    case SDL_SCANCODE_Q: return Q;
+    case SDL_SCANCODE_W: return W;
+    case SDL_SCANCODE_E: return E;
+    case SDL_SCANCODE_R: return R;
+    case SDL_SCANCODE_T: return T;
+    case SDL_SCANCODE_Y: return Y;
+    case SDL_SCANCODE_U: return U;
+    case SDL_SCANCODE_I: return I;
+    case SDL_SCANCODE_O: return O;
+    case SDL_SCANCODE_P: return P;
+    case SDL_SCANCODE_LEFTBRACKET: return BRACKETLEFT;
+    case SDL_SCANCODE_RIGHTBRACKET: return BRACKETRIGHT;
+    case SDL_SCANCODE_BACKSLASH: return BACKSLASH;
+    case SDL_SCANCODE_CAPSLOCK: return CAPSLOCK;
+    case SDL_SCANCODE_A: return A;
+    case SDL_SCANCODE_S: return S;
+    case SDL_SCANCODE_D: return D;
+    case SDL_SCANCODE_F: return F;
+    case SDL_SCANCODE_G: return G;
+    case SDL_SCANCODE_H: return H;
+    case SDL_SCANCODE_J: return J;
+    case SDL_SCANCODE_K: return K;
+    case SDL_SCANCODE_L: return L;
+    case SDL_SCANCODE_SEMICOLON: return SEMICOLON;
+    case SDL_SCANCODE_APOSTROPHE: return APOSTROPHE;
+    case SDL_SCANCODE_RETURN: return RETURN;
+    case SDL_SCANCODE_LSHIFT: return SHIFTLEFT;
+    case SDL_SCANCODE_Z: return Z;
+    case SDL_SCANCODE_X: return X;
+    case SDL_SCANCODE_C: return C;
+    case SDL_SCANCODE_V: return V;
+    case SDL_SCANCODE_B: return B;
+    case SDL_SCANCODE_N: return N;
+    case SDL_SCANCODE_M: return M;
+    case SDL_SCANCODE_COMMA: return COMMA;
+    case SDL_SCANCODE_PERIOD: return PERIOD;
+    case SDL_SCANCODE_SLASH: return FOWARDSLASH;
+    case SDL_SCANCODE_RSHIFT: return SHIFTRIGHT;
+    case SDL_SCANCODE_LCTRL: return CTRLLEFT;
+    case SDL_SCANCODE_LGUI: return GUILEFT;
+    case SDL_SCANCODE_LALT: return ALTLEFT;
+    case SDL_SCANCODE_SPACE: return SPACE;
+    case SDL_SCANCODE_RALT: return ALTRIGHT;
+    case SDL_SCANCODE_SELECT: return SELECT;
+    case SDL_SCANCODE_RCTRL: return CTRLRIGHT;
+    case SDL_SCANCODE_PRINTSCREEN: return PRINTSCREEN;
+    case SDL_SCANCODE_SCROLLLOCK: return SCROLLLOCK;
+    case SDL_SCANCODE_PAUSE: return PAUSE;
+    case SDL_SCANCODE_INSERT: return INSERT;
+    case SDL_SCANCODE_HOME: return HOME;
+    case SDL_SCANCODE_PAGEUP: return PAGEUP;
+    case SDL_SCANCODE_DELETE: return Key::DELETE;
+    case SDL_SCANCODE_END: return END;
+    case SDL_SCANCODE_PAGEDOWN: return PAGEDOWN;
+    case SDL_SCANCODE_UP: return ARROWUP;
+    case SDL_SCANCODE_DOWN: return ARROWDOWN;
+    case SDL_SCANCODE_LEFT: return ARROWLEFT;
+    case SDL_SCANCODE_RIGHT: return ARROWRIGHT;
+    default: return Key::OTHERKEY;
+  }
+}
+
+/*!
+\brief Converts an SDL unsigned value to an MButton.
+\param value The unsigned int SDL uses to refer to a mouse button.
+\return The corresponding MButton value.
+*/
+MButton Input::UnsignedToMButton(unsigned value)
+{
+  switch (value)
+  {
+    case SDL_BUTTON_LEFT: return LEFT;
+    case SDL_BUTTON_MIDDLE: return MIDDLE;
+    case SDL_BUTTON_RIGHT: return RIGHT;
+    default: return MButton::OTHERMBUTTON;
+  }
+}
+
+/*!
+\brief Convert an SDL unsigned value to a CButton.
+\param value The SDL unsigned value.
+\return The corresponding CButton.
+*/
+CButton Input::UnsignedToCButton(unsigned value)
+{
+  switch (value)
+  {
+    case SDL_CONTROLLER_BUTTON_A: return EX;  break;
+    case SDL_CONTROLLER_BUTTON_B: return CIRCLE; break;
+    case SDL_CONTROLLER_BUTTON_X: return SQUARE; break;
+    case SDL_CONTROLLER_BUTTON_Y: return TRIANGLE; break;
+    case SDL_CONTROLLER_BUTTON_DPAD_UP: return DPADUP; break;
+    case SDL_CONTROLLER_BUTTON_DPAD_DOWN: return DPADDOWN; break;
+    case SDL_CONTROLLER_BUTTON_DPAD_LEFT: return DPADLEFT; break;
+    case SDL_CONTROLLER_BUTTON_DPAD_RIGHT: return DPADRIGHT; break;
+    case SDL_CONTROLLER_BUTTON_LEFTSHOULDER: return BUMPERLEFT; break;
+    case SDL_CONTROLLER_BUTTON_RIGHTSHOULDER: return BUMPERRIGHT; break;
+    case SDL_CONTROLLER_BUTTON_LEFTSTICK: return STICKLEFT; break;
+    case SDL_CONTROLLER_BUTTON_RIGHTSTICK: return STICKRIGHT; break;
+    case SDL_CONTROLLER_BUTTON_BACK: return RESET; break;
+    case SDL_CONTROLLER_BUTTON_START: return START; break;
+    default: return OTHERCBUTTON; break;
+  }
+  return CButton::EX;
+}
+
+/*!
+\brief Convert an SDL unsigned value to a CAnalog.
+\param value The SDL unsigned value.
+\return The corresponding CAnalog.
+*/
+CAnalog Input::UnsignedToCAnalgo(unsigned analog)
+{
+  switch (analog)
+  {
+  case SDL_CONTROLLER_AXIS_TRIGGERLEFT: return TRIGGERLEFT; break;
+  case SDL_CONTROLLER_AXIS_TRIGGERRIGHT: return TRIGGERRIGHT; break;
+  case SDL_CONTROLLER_AXIS_LEFTX: return STICKLEFTX; break;
+  case SDL_CONTROLLER_AXIS_LEFTY: return STICKLEFTY; break;
+  case SDL_CONTROLLER_AXIS_RIGHTX: return STICKRIGHTX; break;
+  case SDL_CONTROLLER_AXIS_RIGHTY: return STICKRIGHTY; break;
+  default: return OTHERCANALOG; break;
+  }
+}
+
+/*!
+\brief Finds an active controller in constant time.
+\param id The id of the controller.
+\return The controller or nullptr if the controller is not active.
+*/
+Input::Controller * Input::FindController(Sint32 id)
+{
+  if (id < 0 || id >= (Sint32)_controllerIndex.size())
+    return nullptr;
+  int index = _controllerIndex[id];
+  if (index < 0)
+    return nullptr;
+  return &_activeController[index];
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Prepares the back Snapshot for a new frame. The down state is carried over
+  from the front Snapshot and values that should only be present for a single
+  frame are cleared. This is called by Context::CheckEvents before events are
+  checked for.
+*/
+/*****************************************************************************/
+inline void Input::Reset()
+{
+  Snapshot & back = _snapshots[_front ^ 1];
+  back = _snapshots[_front];
+  back.BeginFrame();
+  for (Controller & controller : _activeController){
+    controller._buttonsPressed.reset();
+  }
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Makes the back Snapshot the front Snapshot. This is called by
+  Context::CheckEvents after all events have been applied.
+*/
+/*****************************************************************************/
+void Input::Swap()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _front ^= 1;
+}
+
+/*!
+\brief Pushes an event onto the event ring, overwriting the oldest event if
+  the ring is full.
+\param type The type of the event.
+\param value The key, mouse button, or wheel motion.
+\param x The x location for motion events.
+\param y The y location for motion events.
+*/
+void Input::PushEvent(Event::Type type, int value, int x, int y)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  Event & event = _events[_eventCount % INPUT_EVENT_CAPACITY];
+  event._type = type;
+  event._value = value;
+  event._x = x;
+  event._y = y;
+  ++_eventCount;
+}
+
+/*!
+\brief Applies a keyboard or mouse event to the back Snapshot and pushes it
+  onto the event ring. Used for events from SDL and events from a replay.
+\param event The event.
+*/
+void Input::ApplyEvent(const Event & event)
+{
+  Snapshot & back = _snapshots[_front ^ 1];
+  switch (event._type)
+  {
+  case Event::KEYDOWN:
+    back._keysDown.set(event._value);
+    back._keysPressed.set(event._value);
+    break;
+  case Event::KEYUP:
+    back._keysDown.reset(event._value);
+    back._keysReleased.set(event._value);
+    break;
+  case Event::MOUSEBUTTONDOWN:
+    back._mouseButtonsDown.set(event._value);
+    back._mouseButtonsPressed.set(event._value);
+    break;
+  case Event::MOUSEBUTTONUP:
+    back._mouseButtonsDown.reset(event._value);
+    back._mouseButtonsReleased.set(event._value);
+    break;
+  case Event::MOUSEMOTION:
+    back._mouseLocation.first = event._x;
+    back._mouseLocation.second = event._y;
+    break;
+  case Event::MOUSEWHEEL:
+    back._mouseWheelMotion = event._value;
+    break;
+  }
+  PushEvent(event._type, event._value, event._x, event._y);
+}
+
+/*!
+\brief Writes the front Snapshot's frame to the recording file. The events
+  pushed since the previous recorded frame are written. If more than
+  INPUT_EVENT_CAPACITY events happen in one frame, only the newest are kept.
+*/
+void Input::RecordFrame()
+{
+  const Snapshot & front = _snapshots[_front];
+  unsigned long long first = _recordCursor;
+  if (_eventCount - first > INPUT_EVENT_CAPACITY)
+    first = _eventCount - INPUT_EVENT_CAPACITY;
+  float delta = Time::DT();
+  short frame[3] = { (short)front._mouseMotion.first,
+    (short)front._mouseMotion.second, (short)front._mouseWheelMotion };
+  unsigned short count = (unsigned short)(_eventCount - first);
+  _recordFile.write((const char *)&delta, sizeof(delta));
+  _recordFile.write((const char *)frame, sizeof(frame));
+  _recordFile.write((const char *)&count, sizeof(count));
+  for (unsigned long long i = first; i < _eventCount; ++i) {
+    const Event & event = _events[i % INPUT_EVENT_CAPACITY];
+    unsigned char type = (unsigned char)event._type;
+    short values[3] = { (short)event._value, (short)event._x, (short)event._y };
+    _recordFile.write((const char *)&type, sizeof(type));
+    _recordFile.write((const char *)values, sizeof(values));
+  }
+  _recordCursor = _eventCount;
+  RecordValues();
+}
+
+/*!
+\brief Writes the tracked values that changed since the previous recorded
+  frame. Each change is the index of the value followed by the value.
+*/
+void Input::RecordValues()
+{
+  bool first = _recordedValues.size() != _trackedValues.size();
+  _recordedValues.resize(_trackedValues.size());
+  std::vector<unsigned short> changed;
+  for (unsigned short i = 0; i < _trackedValues.size(); ++i) {
+    if (first || *_trackedValues[i] != _recordedValues[i]) {
+      _recordedValues[i] = *_trackedValues[i];
+      changed.push_back(i);
+    }
+  }
+  unsigned short count = (unsigned short)changed.size();
+  _recordFile.write((const char *)&count, sizeof(count));
+  for (unsigned short index : changed) {
+    _recordFile.write((const char *)&index, sizeof(index));
+    _recordFile.write((const char *)&_recordedValues[index], sizeof(float));
+  }
+}
+
+/*!
+\brief Applies the next frame of the recording to the back Snapshot.
+\return If there was a frame to apply, true. If the recording has ended,
+  false and replaying stops.
+*/
+bool Input::ReplayFrame()
+{
+  // delta, mouse motion, wheel motion, and event count
+  const size_t frame_size = sizeof(float) + 3 * sizeof(short) +
+    sizeof(unsigned short);
+  const size_t event_size = sizeof(unsigned char) + 3 * sizeof(short);
+  const size_t value_size = sizeof(unsigned short) + sizeof(float);
+  if (_replayOffset + frame_size > _replayData.size()) {
+    _replaying = false;
+    return false;
+  }
+  const char * data = _replayData.data() + _replayOffset;
+  short frame[3];
+  unsigned short count;
+  memcpy(frame, data + sizeof(float), sizeof(frame));
+  memcpy(&count, data + sizeof(float) + sizeof(frame), sizeof(count));
+  size_t values_offset = _replayOffset + frame_size + count * event_size;
+  unsigned short value_count = 0;
+  if (values_offset + sizeof(value_count) <= _replayData.size())
+    memcpy(&value_count, _replayData.data() + values_offset,
+      sizeof(value_count));
+  size_t end = values_offset + sizeof(value_count) + value_count * value_size;
+  if (end > _replayData.size()) {
+    _replaying = false;
+    Error error("Context.cpp", "Input::ReplayFrame");
+    error.Add("The recording ends in the middle of a frame.");
+    throw(error);
+  }
+  data += frame_size;
+  for (unsigned short i = 0; i < count; ++i) {
+    unsigned char type;
+    short values[3];
+    memcpy(&type, data, sizeof(type));
+    memcpy(values, data + sizeof(type), sizeof(values));
+    data += event_size;
+    Event event;
+    event._type = (Event::Type)type;
+    event._value = values[0];
+    event._x = values[1];
+    event._y = values[2];
+    ApplyEvent(event);
+  }
+  Snapshot & back = _snapshots[_front ^ 1];
+  back._mouseMotion.first = frame[0];
+  back._mouseMotion.second = frame[1];
+  back._mouseWheelMotion = frame[2];
+  data += sizeof(value_count);
+  for (unsigned short i = 0; i < value_count; ++i) {
+    unsigned short index;
+    float value;
+    memcpy(&index, data, sizeof(index));
+    memcpy(&value, data + sizeof(index), sizeof(value));
+    data += value_size;
+    if (index < _trackedValues.size())
+      *_trackedValues[index] = value;
+  }
+  _replayOffset = end;
+  PrepareReplayStep();
+  return true;
+}
+
+/*!
+\brief Gives the Time class the delta time for the next replayed frame. The
+  next Time::Update happens before the next frame is replayed.
+*/
+void Input::PrepareReplayStep()
+{
+  float delta = _replayStep;
+  if (delta <= 0.0f && _replayOffset + sizeof(float) <= _replayData.size())
+    memcpy(&delta, _replayData.data() + _replayOffset, sizeof(float));
+  Time::FixedStep(delta);
+}
+
+/*!
+\brief Updates Input values for a corresponding SDL_KEYDOWN event.
+\param event The SDL event.
+*/
+void Input::OnKeyDownEvent(const SDL_Event & event)
+{
+  if (event.key.repeat)
+    return;
+  Event key_event = { Event::KEYDOWN,
+    ScancodeToKey(event.key.keysym.scancode), 0, 0 };
+  ApplyEvent(key_event);
+}
+
+
+/*!
+\brief Updates Input values for a corresponding SDL_KEYUP event.
+\param event The SDL event.
+*/
+void Input::OnKeyUpEvent(const SDL_Event & event)
+{
+  Event key_event = { Event::KEYUP,
+    ScancodeToKey(event.key.keysym.scancode), 0, 0 };
+  ApplyEvent(key_event);
+}
+
+/*!
+\brief Updates Input values for a corresponding SDL_MOUSEBUTTONDOWN event.
+\param event The SDL event.
+*/
+void Input::OnMouseButtonDownEvent(const SDL_Event & event)
+{
+  Event button_event = { Event::MOUSEBUTTONDOWN,
+    UnsignedToMButton(event.button.button), 0, 0 };
+  ApplyEvent(button_event);
+}
+
+/*!
+\brief Updates Input values for a corresponding SDL_MOUSEBUTTONUP event.
+\param event The SDL event.
+*/
+void Input::OnMouseButtonUpEvent(const SDL_Event & event)
+{
+  Event button_event = { Event::MOUSEBUTTONUP,
+    UnsignedToMButton(event.button.button), 0, 0 };
+  ApplyEvent(button_event);
+}
+
+/*!
+\brief Updates Input values for a corresponding SDL_MOUSEMOTION event.
+\param event The SDL event.
+*/
+void Input::OnMouseMotionEvent(const SDL_Event & event)
+{
+  Snapshot & back = _snapshots[_front ^ 1];
+  back._mouseMotion.first = event.motion.xrel;
+  back._mouseMotion.second = event.motion.yrel;
+  Event motion_event = { Event::MOUSEMOTION, 0, event.motion.x,
+    event.motion.y };
+  ApplyEvent(motion_event);
+}
+
+/*!
+\brief Updates Input values for a corresponding SDL_MOUSEWHEEL event.
+\param event The SDL event.
+*/
+void Input::OnMouseWheelEvent(const SDL_Event & event)
+{
+  Event wheel_event = { Event::MOUSEWHEEL, static_cast<int>(event.wheel.y),
+    0, 0 };
+  ApplyEvent(wheel_event);
+}
+
+/*!
+\brief Adds a controller to the inactive controllers vector when it is added.
+\param The SDL event.
+*/
+void Input::OnControllerAdded(const SDL_Event & event)
+{
+  _inactiveController.push_back(event.cdevice.which);
+}
+
+/*!
+\brief Removes a controller from the input class on a remove controller event.
+\param event The SDL event.
+*/
+void Input::OnControllerRemoved(const SDL_Event & event)
+{
+  if (IsActiveControlller(event.cdevice.which))
+    DeactiveateController(event.cdevice.which);
+  std::vector<Sint32>::iterator it = _inactiveController.begin();
+  std::vector<Sint32>::iterator it_e = _inactiveController.end();
+  for (; it != it_e; ++it) {
+    if (*it == event.cdevice.which) {
+      _inactiveController.erase(it);
+      return;
+    }
+  }
+}
+
+/*!
+\brief Updates a controllers instance's button states on a button down event.
+\param event The SDL event.
+*/
+void Input::OnControllerDown(const SDL_Event & event)
+{
+  CButton button = UnsignedToCButton(event.cbutton.button);
+  Controller * controller = FindController(event.cbutton.which);
+  if (controller) {
+    controller->_buttonsDown.set(button);
+    controller->_buttonsPressed.set(button);
+  }
+}
+
+/*!
+\brief Called when a controller button is lifted.
+\param event The SDL event.
+*/
+void Input::OnControllerUp(const SDL_Event & event)
+{
+  CButton button = UnsignedToCButton(event.cbutton.button);
+  Controller * controller = FindController(event.cbutton.which);
+  if (controller)
+    controller->_buttonsDown.reset(button);
+}
+
+/*!
+\brief Updates a changed controller analog.
+\param event The SDL event.
+*/
+void Input::OnControllerAxis(const SDL_Event & event)
+{
+  CAnalog analog = UnsignedToCAnalgo(event.caxis.axis);
+  Controller * controller = FindController(event.caxis.which);
+  if (controller)
+    controller->UpdateAnalog(analog, event.caxis.value);
+}
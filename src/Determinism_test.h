@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include "Buoyancy.h"
+#include "Ripple.h"
+#include "Wake.h"
+#include "WaterFFT.h"
+
+#define TEST_DETERMINISM_SEED 20171005ull
+#define TEST_DETERMINISM_GRID 128
+#define TEST_DETERMINISM_WINDOW 64
+#define TEST_DETERMINISM_TICKS 16
+#define TEST_DETERMINISM_STEP (1.0 / 30.0)
+#define TEST_DETERMINISM_THREADS_A 1
+#define TEST_DETERMINISM_THREADS_B 4
+
+void test_determinism();
+void test_time_order();
+void test_thread_counts();
+std::vector<char> simulate_replica(unsigned threads);
+std::vector<char> simulate_replica_process(unsigned threads);
+
+void test_determinism()
+{
+  test_time_order();
+  test_thread_counts();
+}
+
+// Builds two WaterFFTs from the same seed and updates one forward in time
+// and the other backward. Every state must match bitwise.
+void test_time_order()
+{
+  WaterFFT forward(TEST_DETERMINISM_GRID, 128.0f, 1);
+  WaterFFT backward(TEST_DETERMINISM_GRID, 128.0f, 1);
+  forward.Deterministic(true);
+  backward.Deterministic(true);
+  forward.Seed(TEST_DETERMINISM_SEED);
+  backward.Seed(TEST_DETERMINISM_SEED);
+  unsigned mismatches = 0;
+  for (unsigned i = 0; i < TEST_DETERMINISM_TICKS; ++i)
+  {
+    double forward_time = i * TEST_DETERMINISM_STEP;
+    double backward_time =
+      (TEST_DETERMINISM_TICKS - 1 - i) * TEST_DETERMINISM_STEP;
+    forward.Update(forward_time, i % WATER_VERTEX_BUFFERS);
+    backward.Update(backward_time,
+      (TEST_DETERMINISM_TICKS - 1 - i) % WATER_VERTEX_BUFFERS);
+  }
+  // Only the last WATER_VERTEX_BUFFERS states of each are still held, so
+  // the forward states are made again and compared with what is left.
+  for (unsigned i = 0; i < WATER_VERTEX_BUFFERS; ++i)
+  {
+    forward.Update(i * TEST_DETERMINISM_STEP, 0);
+    if (memcmp(forward.VertexBuffer(0), backward.VertexBuffer(i),
+      forward.VertexBufferSizeBytes()))
+      ++mismatches;
+  }
+  std::cout << "time order mismatches: " << mismatches
+    << (mismatches == 0 ? " PASS" : " FAIL") << std::endl;
+}
+
+// Runs the same replica in two processes with a different number of threads
+// for the layers and the bodies and compares the results bytewise.
+void test_thread_counts()
+{
+  std::vector<char> a = simulate_replica_process(TEST_DETERMINISM_THREADS_A);
+  std::vector<char> b = simulate_replica_process(TEST_DETERMINISM_THREADS_B);
+  bool same = !a.empty() && a == b;
+  std::cout << "threads " << TEST_DETERMINISM_THREADS_A << " and "
+    << TEST_DETERMINISM_THREADS_B << ", bytes compared: " << a.size()
+    << (same ? " PASS" : " FAIL") << std::endl;
+}
+
+// Simulates the water with a ripple, a ship's wake, and floating bodies from
+// a fixed seed. The result is every vertex buffer and body state in order.
+std::vector<char> simulate_replica(unsigned threads)
+{
+  WaterFFT water(TEST_DETERMINISM_GRID, 128.0f, 1);
+  water.Deterministic(true);
+  water.Seed(TEST_DETERMINISM_SEED);
+  Ripple ripple(TEST_DETERMINISM_WINDOW, 1.0f, threads);
+  Wake wake(TEST_DETERMINISM_WINDOW, 1.0f, threads);
+  water.AttachLayer(&ripple);
+  water.AttachLayer(&wake);
+  RippleSource source = { glm::vec2(3.0f, -5.0f), 4.0f, 0.5f };
+  ripple.Disturb(&source, 1);
+  ShipTrack ship = { glm::vec2(-10.0f, 2.0f), 0.3f, 8.0f };
+  wake.SetShips(&ship, 1);
+
+  Buoyancy bodies(threads);
+  glm::vec3 points[5] = { glm::vec3(-1.0f, 0.0f, -1.0f),
+    glm::vec3(1.0f, 0.0f, -1.0f), glm::vec3(-1.0f, 0.0f, 1.0f),
+    glm::vec3(1.0f, 0.0f, 1.0f), glm::vec3(0.0f, -0.5f, 0.0f) };
+  for (unsigned i = 0; i < 9; ++i)
+  {
+    BodyState state;
+    state.m_Position = glm::vec3(6.0f * (float)(i % 3) - 6.0f, 1.0f,
+      6.0f * (float)(i / 3) - 6.0f);
+    state.m_Orientation = glm::angleAxis((float)i, glm::vec3(0.0f, 1.0f,
+      0.0f));
+    state.m_Velocity = glm::vec3(0.0f);
+    state.m_AngularVelocity = glm::vec3(0.0f);
+    bodies.AddBody(points, 5, 4.0f, 2000.0f, state);
+  }
+
+  std::vector<char> result;
+  for (unsigned i = 0; i < TEST_DETERMINISM_TICKS; ++i)
+  {
+    unsigned buffer = i % WATER_VERTEX_BUFFERS;
+    water.Update(i * TEST_DETERMINISM_STEP, buffer);
+    water.SetReadBuffer(buffer);
+    bodies.Step(water, (float)TEST_DETERMINISM_STEP);
+    const char * vertices = (const char *)water.VertexBuffer(buffer);
+    result.insert(result.end(), vertices,
+      vertices + water.VertexBufferSizeBytes());
+    for (unsigned b = 0; b < bodies.BodyCount(); ++b)
+    {
+      const char * state = (const char *)&bodies.State(b);
+      result.insert(result.end(), state, state + sizeof(BodyState));
+    }
+  }
+  return result;
+}
+
+// Runs simulate_replica in a child process and reads its result back. The
+// replica runs in this process where fork is not available.
+std::vector<char> simulate_replica_process(unsigned threads)
+{
+#ifdef _WIN32
+  return simulate_replica(threads);
+#else
+  int pipe_ends[2];
+  if (pipe(pipe_ends) != 0)
+    return std::vector<char>();
+  pid_t child = fork();
+  if (child < 0)
+  {
+    close(pipe_ends[0]);
+    close(pipe_ends[1]);
+    return std::vector<char>();
+  }
+  if (child == 0)
+  {
+    close(pipe_ends[0]);
+    std::vector<char> result = simulate_replica(threads);
+    size_t written = 0;
+    while (written < result.size())
+    {
+      ssize_t bytes = write(pipe_ends[1], result.data() + written,
+        result.size() - written);
+      if (bytes <= 0)
+        break;
+      written += (size_t)bytes;
+    }
+    _exit(written == result.size() ? 0 : 1);
+  }
+  close(pipe_ends[1]);
+  std::vector<char> result;
+  char block[65536];
+  ssize_t bytes;
+  while ((bytes = read(pipe_ends[0], block, sizeof(block))) > 0)
+    result.insert(result.end(), block, block + bytes);
+  close(pipe_ends[0]);
+  int status = 0;
+  waitpid(child, &status, 0);
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    return std::vector<char>();
+  return result;
+#endif
+}
@@ -1,201 +1,423 @@
-/* All content(c) 2016 - 2017 DigiPen(USA) Corporation, all rights reserved. */
-/*****************************************************************************/
-/*!
-\file Error.cpp
-\author Connor Deakin
-\par E-mail: connor.deakin\@digipen.edu
-\par Project: Graphics
-\date 30/09/2016
-\brief
-  Contains the implementation of the Error interface.
-*/
-/*****************************************************************************/
-
-// PARAMETERS
-//! The filename that Error exceptions will be written to from the 
-// ErrorLog class.
-#define ERROR_LOG_FILENAME     "water.error"
-#define ROOTERROR_LOG_FILENAME "water.error.root"
-// !PARAMETERS
-
-#include <iostream>
-#include <string>
-#include <vector>
-
-#include "Error.h"
-
-// ERROR //////////////////////////////////////////////////////////////////////
-
-/*****************************************************************************/
-/*!
-\brief
-  This is the only constructor for an Error.
-
-\param file
-  The name of the file where an error was thrown.
-\param function
-  The name of the function where an error was thrown.
-*/
-/*****************************************************************************/
-Error::Error(const char * file, const char * function)
-: _file(file), _function(function) {}
-
-/*****************************************************************************/
-/*!
-\brief
-  Use this to add information to the Error's log. This can be called multiple
-  times on a single Error. All of the log information is stored in a vector.
-  See the operator<< to see how this is printed to console.
-
-\param info
-  The Error info to be added to the log.
-*/
-/*****************************************************************************/
-void Error::Add(const char * info)
-{
-  _log.push_back(info);
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Use this to add information to the Error's log. This can be called multiple
-  times on a single Error. All of the log information is stored in a vector.
-  See the operator<< to see how this is printed to console.
-
-\param info
-  The Error info to be added to the log.
-*/
-/*****************************************************************************/
-void Error::Add(const std::string & info)
-{
-  _log.push_back(info);
-}
-
-// ROOTERROR //////////////////////////////////////////////////////////////////
-
-/*****************************************************************************/
-/*!
-\brief
-  Creates a RootError. This should only be thrown in the error termninates the
-  program.
-
-\param file
-  The file in which the error occured.
-\param function
-  The function in which the error occured.
-*/
-/*****************************************************************************/
-RootError::RootError(const char * file, const char * function) :
-  Error(file, function)
-{}
-
-// ERRORLOG ///////////////////////////////////////////////////////////////////
-
-// STATIC INITIALIZATIONS
-bool ErrorLog::_errorWritten = false;
-bool ErrorLog::_rootErrorWritten = false;
-std::string ErrorLog::_errorFilename = ERROR_LOG_FILENAME;
-std::string ErrorLog::_rootErrorFilename = ROOTERROR_LOG_FILENAME;
-std::ofstream ErrorLog::_errorLog;
-
-/*****************************************************************************/
-/*!
-\brief
-  Rights clean to at the top of both log files to signify that there are no
-  errors.
-*/
-/*****************************************************************************/
-void ErrorLog::Clean()
-{
-  _errorLog.open(_errorFilename);
-  if (_errorLog.is_open()) {
-    _errorLog << "CLEAN" << std::endl;
-    _errorLog.close();
-  }
-  _errorLog.open(_rootErrorFilename);
-  if (_errorLog.is_open()) {
-    _errorLog << "CLEAN" << std::endl;
-    _errorLog.close();
-  }
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Writes an Error to the filename specified in ERROR_LOG_FILENAME at the top
-  of this file.
-
-\param error
-  The error that is being written to the error log file.
-*/
-/*****************************************************************************/
-void ErrorLog::Write(const Error & error)
-{
-  // append or overwrite
-  if (_errorWritten) 
-    _errorLog.open(_errorFilename, std::fstream::app);
-  else {
-    _errorLog.open(_errorFilename);
-    _errorWritten = true;
-  }
-  // writing to file
-  if (_errorLog.is_open()) {
-    _errorLog << error;
-    _errorLog.close();
-  }
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Writes an RootError to the filename specified in ROOTERROR_LOG_FILENAME at the 
-  top of this file.
-
-\param root_error
-  The root error that is being written to the root error log file.
-*/
-/*****************************************************************************/
-void ErrorLog::Write(const RootError & root_error)
-{
-  _errorLog.open(_rootErrorFilename);
-  // writing root error
-  if (_errorLog.is_open()) {
-    // Checking for multiple root errors
-    if (_rootErrorWritten) 
-      _errorLog << "> MULTIPLE RootErrors";
-    else 
-      _rootErrorWritten = true;
-    _errorLog << root_error;
-    _errorLog.close();
-  }
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Operator << overload for the Error class. When an error is printed, the file 
-  name, function name, and log will all be printed.
-
-\param os
-  The outstream being printed to.
-\param error
-  The Error to be printed.
-
-\return The outstream being printed to.
-*/
-/*****************************************************************************/
-std::ostream & operator<<(std::ostream & os, const Error & error)
-{
-  //print header
-  os << "---- Error Start ----" << std::endl
-            << "File - " << error._file << std::endl
-            << "Function - " << error._function << std::endl
-            << "> Log" << std::endl;
-  //print log
-  std::vector<std::string>::const_iterator info;
-  for (info = error._log.begin(); info != error._log.end(); ++info)
-    os << *(info) << std::endl;
-  os << "----- Error End -----" << std::endl;
-  return os;
+/* All content(c) 2016 - 2017 DigiPen(USA) Corporation, all rights reserved. */
+/*****************************************************************************/
+/*!
+\file Error.cpp
+\author Connor Deakin
+\par E-mail: connor.deakin\@digipen.edu
+\par Project: Graphics
+\date 30/09/2016
+\brief
+  Contains the implementation of the Error interface.
+*/
+/*****************************************************************************/
+
+// PARAMETERS
+//! The filename that Error exceptions will be written to from the 
+// ErrorLog class.
+#define ERROR_LOG_FILENAME     "water.error"
+#define ROOTERROR_LOG_FILENAME "water.error.root"
+//! The maximum number of Errors that can wait in the queue. Errors written
+// while the queue is full are dropped and counted.
+#define ERROR_LOG_QUEUE_LIMIT  1024
+//! The maximum number of distinct Errors written to file each second.
+#define ERROR_LOG_RATE         32
+//! The number of milliseconds the writer thread sleeps between queue checks.
+#define ERROR_LOG_WAKE_MS      20
+// !PARAMETERS
+
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Error.h"
+
+// ERROR //////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/*!
+\brief
+  This is the only constructor for an Error.
+
+\param file
+  The name of the file where an error was thrown.
+\param function
+  The name of the function where an error was thrown.
+*/
+/*****************************************************************************/
+Error::Error(const char * file, const char * function)
+: _file(file), _function(function) {}
+
+/*****************************************************************************/
+/*!
+\brief
+  Use this to add information to the Error's log. This can be called multiple
+  times on a single Error. All of the log information is stored in a vector.
+  See the operator<< to see how this is printed to console.
+
+\param info
+  The Error info to be added to the log.
+*/
+/*****************************************************************************/
+void Error::Add(const char * info)
+{
+  _log.push_back(info);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Use this to add information to the Error's log. This can be called multiple
+  times on a single Error. All of the log information is stored in a vector.
+  See the operator<< to see how this is printed to console.
+
+\param info
+  The Error info to be added to the log.
+*/
+/*****************************************************************************/
+void Error::Add(const std::string & info)
+{
+  _log.push_back(info);
+}
+
+// ROOTERROR //////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/*!
+\brief
+  Creates a RootError. This should only be thrown in the error termninates the
+  program.
+
+\param file
+  The file in which the error occured.
+\param function
+  The function in which the error occured.
+*/
+/*****************************************************************************/
+RootError::RootError(const char * file, const char * function) :
+  Error(file, function)
+{}
+
+// ERRORLOG ///////////////////////////////////////////////////////////////////
+
+// STATIC INITIALIZATIONS
+bool ErrorLog::_errorWritten = false;
+bool ErrorLog::_rootErrorWritten = false;
+std::string ErrorLog::_errorFilename = ERROR_LOG_FILENAME;
+std::string ErrorLog::_rootErrorFilename = ROOTERROR_LOG_FILENAME;
+std::ofstream ErrorLog::_errorLog;
+std::atomic<ErrorLog::Entry *> ErrorLog::_head(nullptr);
+ErrorLog::Entry * ErrorLog::_tail = nullptr;
+std::atomic<int> ErrorLog::_pending(0);
+std::atomic<unsigned> ErrorLog::_dropped(0);
+std::atomic<bool> ErrorLog::_running(false);
+std::thread * ErrorLog::_writer = nullptr;
+std::mutex ErrorLog::_writerMutex;
+std::string ErrorLog::_lastText;
+unsigned ErrorLog::_repeats = 0;
+unsigned ErrorLog::_windowWrites = 0;
+std::chrono::steady_clock::time_point ErrorLog::_windowStart;
+
+//! Makes sure the writer thread is joined if Purge is never called. This is
+// defined after the ErrorLog statics so it is destroyed before them.
+static struct ErrorLogGuard
+{
+  ~ErrorLogGuard() { ErrorLog::Purge(); }
+} error_log_guard;
+
+/*****************************************************************************/
+/*!
+\brief
+  Rights clean to at the top of both log files to signify that there are no
+  errors. This also starts the writer thread.
+*/
+/*****************************************************************************/
+void ErrorLog::Clean()
+{
+  Purge();
+  _errorWritten = false;
+  _errorLog.open(_errorFilename);
+  if (_errorLog.is_open()) {
+    _errorLog << "CLEAN" << std::endl;
+    _errorLog.close();
+  }
+  _errorLog.open(_rootErrorFilename);
+  if (_errorLog.is_open()) {
+    _errorLog << "CLEAN" << std::endl;
+    _errorLog.close();
+  }
+  StartWriter();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Queues an Error to be written to the filename specified in
+  ERROR_LOG_FILENAME at the top of this file. The Error is formatted on the
+  calling thread and written by the writer thread, so this never waits on
+  the file system.
+
+\param error
+  The error that is being written to the error log file.
+*/
+/*****************************************************************************/
+void ErrorLog::Write(const Error & error)
+{
+  StartWriter();
+  if (_pending.fetch_add(1) >= ERROR_LOG_QUEUE_LIMIT) {
+    _pending.fetch_sub(1);
+    _dropped.fetch_add(1);
+    return;
+  }
+  std::ostringstream text;
+  text << error;
+  Entry * entry = new Entry();
+  entry->_text = text.str();
+  // The entry becomes the new head and is then linked to the old head. The
+  // writer stops at an old head whose link has not been set yet.
+  Entry * previous = _head.exchange(entry, std::memory_order_acq_rel);
+  previous->_next.store(entry, std::memory_order_release);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Writes an RootError to the filename specified in ROOTERROR_LOG_FILENAME at the 
+  top of this file. Any queued Errors are written first.
+
+\param root_error
+  The root error that is being written to the root error log file.
+*/
+/*****************************************************************************/
+void ErrorLog::Write(const RootError & root_error)
+{
+  Flush();
+  std::ofstream root_log(_rootErrorFilename);
+  // writing root error
+  if (root_log.is_open()) {
+    // Checking for multiple root errors
+    if (_rootErrorWritten) 
+      root_log << "> MULTIPLE RootErrors";
+    else 
+      _rootErrorWritten = true;
+    root_log << root_error;
+    root_log.close();
+  }
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Blocks until every Error queued before the call has been written to file.
+*/
+/*****************************************************************************/
+void ErrorLog::Flush()
+{
+  while (_running && _pending > 0)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Writes all queued Errors, stops the writer thread, and closes the error
+  log file. Errors written after this will start the writer again.
+*/
+/*****************************************************************************/
+void ErrorLog::Purge()
+{
+  std::lock_guard<std::mutex> lock(_writerMutex);
+  if (!_writer)
+    return;
+  _running = false;
+  _writer->join();
+  delete _writer;
+  _writer = nullptr;
+  if (_errorLog.is_open())
+    _errorLog.close();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Starts the writer thread if it is not already running.
+*/
+/*****************************************************************************/
+void ErrorLog::StartWriter()
+{
+  static std::once_flag queue_created;
+  std::call_once(queue_created, []() {
+    // The queue always holds one entry that has already been written.
+    _tail = new Entry();
+    _head = _tail;
+    _windowStart = std::chrono::steady_clock::now();
+  });
+  if (_running)
+    return;
+  std::lock_guard<std::mutex> lock(_writerMutex);
+  if (_running)
+    return;
+  _running = true;
+  _writer = new std::thread(RunWriter);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  The loop run by the writer thread. The queue is drained every
+  ERROR_LOG_WAKE_MS milliseconds until the ErrorLog is purged.
+*/
+/*****************************************************************************/
+void ErrorLog::RunWriter()
+{
+  while (_running) {
+    Drain();
+    std::this_thread::sleep_for(
+      std::chrono::milliseconds(ERROR_LOG_WAKE_MS));
+  }
+  Drain();
+  WriteSummary();
+  if (_errorLog.is_open())
+    _errorLog.flush();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Writes every Entry that is currently in the queue and flushes the file.
+*/
+/*****************************************************************************/
+void ErrorLog::Drain()
+{
+  // A new rate limit window starts every second. The repeats and drops from
+  // the previous window are written so a persistent Error stays visible.
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if (now - _windowStart >= std::chrono::seconds(1)) {
+    WriteSummary();
+    if (_errorLog.is_open())
+      _errorLog.flush();
+    _windowStart = now;
+    _windowWrites = 0;
+  }
+  Entry * entry = Pop();
+  if (!entry)
+    return;
+  while (entry) {
+    WriteEntry(entry->_text);
+    delete entry;
+    _pending.fetch_sub(1);
+    entry = Pop();
+  }
+  if (_errorLog.is_open())
+    _errorLog.flush();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Takes the oldest Entry off of the queue. Only the writer thread calls this.
+
+\return The oldest Entry or nullptr if the queue is empty. The returned Entry
+  must be deleted by the caller.
+*/
+/*****************************************************************************/
+ErrorLog::Entry * ErrorLog::Pop()
+{
+  Entry * next = _tail->_next.load(std::memory_order_acquire);
+  if (!next)
+    return nullptr;
+  // The next entry becomes the new tail, so its text is moved into the old
+  // tail and the old tail is handed back.
+  Entry * entry = _tail;
+  entry->_text = std::move(next->_text);
+  _tail = next;
+  return entry;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Writes the text of a single Entry to the error log file. An Entry that is
+  the same as the previously written one is only counted. Entries past the
+  rate limit for the current window are dropped.
+
+\param text
+  The formatted Error.
+*/
+/*****************************************************************************/
+void ErrorLog::WriteEntry(const std::string & text)
+{
+  if (_errorWritten && text == _lastText) {
+    ++_repeats;
+    return;
+  }
+  if (_windowWrites >= ERROR_LOG_RATE) {
+    _dropped.fetch_add(1);
+    return;
+  }
+  // append or overwrite
+  if (!_errorLog.is_open()) {
+    if (_errorWritten)
+      _errorLog.open(_errorFilename, std::fstream::app);
+    else
+      _errorLog.open(_errorFilename);
+  }
+  if (!_errorLog.is_open())
+    return;
+  _errorWritten = true;
+  WriteSummary();
+  _errorLog << text;
+  _lastText = text;
+  ++_windowWrites;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Writes the number of times the previous Error was repeated and the number
+  of Errors that were dropped since the last summary.
+*/
+/*****************************************************************************/
+void ErrorLog::WriteSummary()
+{
+  if (!_errorLog.is_open())
+    return;
+  if (_repeats > 0) {
+    _errorLog << "> PREVIOUS ERROR REPEATED " << _repeats << " TIMES"
+      << std::endl;
+    _repeats = 0;
+  }
+  unsigned dropped = _dropped.exchange(0);
+  if (dropped > 0)
+    _errorLog << "> " << dropped << " ERRORS DROPPED" << std::endl;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Operator << overload for the Error class. When an error is printed, the file 
+  name, function name, and log will all be printed.
+
+\param os
+  The outstream being printed to.
+\param error
+  The Error to be printed.
+
+\return The outstream being printed to.
+*/
+/*****************************************************************************/
+std::ostream & operator<<(std::ostream & os, const Error & error)
+{
+  //print header
+  os << "---- Error Start ----" << std::endl
+            << "File - " << error._file << std::endl
+            << "Function - " << error._function << std::endl
+            << "> Log" << std::endl;
+  //print log
+  std::vector<std::string>::const_iterator info;
+  for (info = error._log.begin(); info != error._log.end(); ++info)
+    os << *(info) << std::endl;
+  os << "----- Error End -----" << std::endl;
+  return os;
 }
\ No newline at end of file
@@ -1,100 +1,154 @@
-/* All content(c) 2016 - 2017 DigiPen(USA) Corporation, all rights reserved. */
-/*****************************************************************************/
-/*!
-\file Error.h
-\author Connor Deakin
-\par E-mail: connor.deakin\@digipen.edu
-\date 30/09/2016
-\brief
-  Contains the interface for error management. The feature included here are
-  the following.
-  - Error exception class
-  - RootError exception class
-  - ErrorLog for writing Error exceptions
-  At the top of Error.cpp, you will find parameters that can be modified for
-  a specific project.
-*/
-/*****************************************************************************/
-
-#ifndef ERROR_H
-#define ERROR_H
-
-#include <string>
-#include <vector>
-#include <fstream>
-
-/*****************************************************************************/
-/*!
-\class Error
-\brief
-  The Error class is to be used for exception based error management. When
-  creating an error class, you must supply the name of the file where the error
-  occured and which function it occured in in order to print the error
-  information when the Error is caught.
-*/
-/*****************************************************************************/
-class Error
-{
-public:
-  Error(const char * file, const char * function);
-  void Add(const char * info);
-  void Add(const std::string & info);
-  friend std::ostream & operator<<(std::ostream & os, const Error & error);
-private:
-  //! The name of the file in which an Error was thrown.
-  std::string _file;
-  //! The name of the function in which an Error was thrown.
-  std::string _function;
-  //! Contains a detailed description of what error occured.
-  std::vector<std::string> _log;
-};
-
-/*****************************************************************************/
-/*!
-\class RootError
-\brief
-  The RootError exception class is intended for errors that should terminate
-  the program. A root exception should never be caught inside of any core
-  code. It should only be caught in main.
-*/
-/*****************************************************************************/
-class RootError : public Error
-{
-public:
-  RootError(const char * file, const char * function);
-};
-
-/*****************************************************************************/
-/*!
-\class ErrorLog
-\brief
-  This will write errors to the files specified at the top of Error.cpp. Error
-  instances will be written to ROOTERROR_LOG_FILENAME or ERROR_LOG_FILENAME
-  depending on their type (Error/RootError).
-
-\par Important Notes
-  - No writing will occur if the files fail to open.
-*/
-/*****************************************************************************/
-class ErrorLog
-{
-public:
-  static void Clean();
-  static void Write(const Error & error);
-  static void Write(const RootError & root_error);
-private:
-  ErrorLog() {}
-  //! Tracks whether an error has been written to file yet or not.
-  static bool _errorWritten;
-  //! Tracks whether a root error has been written to file yet or not.
-  static bool _rootErrorWritten;
-  //! The file that Error instances will be written to.
-  static std::string _errorFilename;
-  //! The file that RootError instances will be written to.
-  static std::string _rootErrorFilename;
-  //! Stream used for file writing.
-  static std::ofstream _errorLog;
-};
-
-
+/* All content(c) 2016 - 2017 DigiPen(USA) Corporation, all rights reserved. */
+/*****************************************************************************/
+/*!
+\file Error.h
+\author Connor Deakin
+\par E-mail: connor.deakin\@digipen.edu
+\date 30/09/2016
+\brief
+  Contains the interface for error management. The feature included here are
+  the following.
+  - Error exception class
+  - RootError exception class
+  - ErrorLog for writing Error exceptions
+  At the top of Error.cpp, you will find parameters that can be modified for
+  a specific project.
+*/
+/*****************************************************************************/
+
+#ifndef ERROR_H
+#define ERROR_H
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*****************************************************************************/
+/*!
+\class Error
+\brief
+  The Error class is to be used for exception based error management. When
+  creating an error class, you must supply the name of the file where the error
+  occured and which function it occured in in order to print the error
+  information when the Error is caught.
+*/
+/*****************************************************************************/
+class Error
+{
+public:
+  Error(const char * file, const char * function);
+  void Add(const char * info);
+  void Add(const std::string & info);
+  friend std::ostream & operator<<(std::ostream & os, const Error & error);
+private:
+  //! The name of the file in which an Error was thrown.
+  std::string _file;
+  //! The name of the function in which an Error was thrown.
+  std::string _function;
+  //! Contains a detailed description of what error occured.
+  std::vector<std::string> _log;
+};
+
+/*****************************************************************************/
+/*!
+\class RootError
+\brief
+  The RootError exception class is intended for errors that should terminate
+  the program. A root exception should never be caught inside of any core
+  code. It should only be caught in main.
+*/
+/*****************************************************************************/
+class RootError : public Error
+{
+public:
+  RootError(const char * file, const char * function);
+};
+
+/*****************************************************************************/
+/*!
+\class ErrorLog
+\brief
+  This will write errors to the files specified at the top of Error.cpp. Error
+  instances will be written to ROOTERROR_LOG_FILENAME or ERROR_LOG_FILENAME
+  depending on their type (Error/RootError).
+
+  Error instances are not written on the calling thread. They are formatted
+  and pushed onto a lock free queue that a background writer thread drains
+  into a file that is kept open. The writer collapses an Error that is
+  repeated back to back into a single entry and limits the number of entries
+  written each second (see the parameters at the top of Error.cpp).
+
+\par Important Notes
+  - No writing will occur if the files fail to open.
+  - Write(const Error &) can be called from any thread.
+  - Call Purge before the program exits so all queued errors are written.
+  - RootError instances are written immediately since the program is about
+    to terminate.
+*/
+/*****************************************************************************/
+class ErrorLog
+{
+public:
+  static void Clean();
+  static void Write(const Error & error);
+  static void Write(const RootError & root_error);
+  static void Flush();
+  static void Purge();
+private:
+  ErrorLog() {}
+  //! A single formatted Error waiting in the queue.
+  struct Entry
+  {
+    Entry() : _next(nullptr) {}
+    //! The next Entry in the queue.
+    std::atomic<Entry *> _next;
+    //! The formatted Error.
+    std::string _text;
+  };
+  static void StartWriter();
+  static void RunWriter();
+  static void Drain();
+  static Entry * Pop();
+  static void WriteEntry(const std::string & text);
+  static void WriteSummary();
+  //! Tracks whether an error has been written to file yet or not.
+  static bool _errorWritten;
+  //! Tracks whether a root error has been written to file yet or not.
+  static bool _rootErrorWritten;
+  //! The file that Error instances will be written to.
+  static std::string _errorFilename;
+  //! The file that RootError instances will be written to.
+  static std::string _rootErrorFilename;
+  //! Stream used for file writing.
+  static std::ofstream _errorLog;
+  //! The most recently pushed Entry. Producers swap themselves in here.
+  static std::atomic<Entry *> _head;
+  //! The Entry before the next one to be written. Only the writer uses this.
+  static Entry * _tail;
+  //! The number of Entries that have been pushed but not yet written.
+  static std::atomic<int> _pending;
+  //! The number of Errors that were dropped because the queue was full or
+  // the write rate limit was hit.
+  static std::atomic<unsigned> _dropped;
+  //! Tracks whether the writer thread should keep running.
+  static std::atomic<bool> _running;
+  //! The background thread that writes Entries to file.
+  static std::thread * _writer;
+  //! Guards starting and stopping _writer.
+  static std::mutex _writerMutex;
+  //! The text of the most recently written Entry.
+  static std::string _lastText;
+  //! The number of times _lastText was repeated without being written.
+  static unsigned _repeats;
+  //! The number of Entries written during the current rate limit window.
+  static unsigned _windowWrites;
+  //! The time at which the current rate limit window started.
+  static std::chrono::steady_clock::time_point _windowStart;
+};
+
+
 #endif // !ERROR_H
\ No newline at end of file
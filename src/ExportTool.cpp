@@ -0,0 +1,166 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file ExportTool.cpp
+/// @date 2026-10-17
+///
+/// @brief
+/// Entry point for the export tool. The tool runs a WaterFFT without a
+/// window and writes the displacement and normal fields of a range of frames
+/// to an image sequence. The simulation runs on the main thread while a
+/// FrameExporter encodes and writes earlier frames. This must be compiled
+/// with WATER_HEADLESS.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "Error.h"
+#include "FrameExporter.h"
+#include "WaterFFT.h"
+
+// Command line options
+//  -out <prefix>     The start of every file name. Defaults to ocean.
+//  -format <name>    exr, exr_rle, or raw. Defaults to exr_rle.
+//  -grid <size>      The number of quads along each side. Defaults to 256.
+//  -length <meters>  The width of the tile. Defaults to 256.
+//  -frames <count>   The number of frames to write. Defaults to 100.
+//  -rate <fps>       The frames per simulated second. Defaults to 30.
+//  -start <seconds>  The simulation time of the first frame.
+//  -seed <value>     The seed of the spectrum. See WaterFFT::Seed.
+//  -threads <count>  The number of writing threads. Zero uses every core.
+//  -queue <count>    The number of frames that can wait to be written.
+struct Options
+{
+  Options(int argc, char * argv[]);
+  static void PrintUsage();
+  std::string prefix;
+  FrameExporter::Format format;
+  unsigned grid;
+  float length;
+  unsigned frames;
+  double rate;
+  double start;
+  uint64_t seed;
+  unsigned threads;
+  unsigned queue;
+  bool valid;
+};
+
+Options::Options(int argc, char * argv[]) :
+  prefix("ocean"), format(FrameExporter::EXR_RLE), grid(256), length(256.0f),
+  frames(100), rate(30.0), start(0.0), seed(WATER_DEFAULT_SEED), threads(0),
+  queue(EXPORT_QUEUE_FRAMES), valid(true)
+{
+  for (int i = 1; i < argc && valid; ++i)
+  {
+    // Every option takes a value.
+    if (i + 1 == argc)
+    {
+      std::cerr << argv[i] << " is missing its value." << std::endl;
+      valid = false;
+    }
+    else if (!strcmp(argv[i], "-out"))
+      prefix = argv[++i];
+    else if (!strcmp(argv[i], "-format"))
+    {
+      const char * name = argv[++i];
+      if (!strcmp(name, "exr"))
+        format = FrameExporter::EXR;
+      else if (!strcmp(name, "exr_rle"))
+        format = FrameExporter::EXR_RLE;
+      else if (!strcmp(name, "raw"))
+        format = FrameExporter::RAW;
+      else
+      {
+        std::cerr << "The format must be exr, exr_rle, or raw." << std::endl;
+        valid = false;
+      }
+    }
+    else if (!strcmp(argv[i], "-grid"))
+      grid = (unsigned)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-length"))
+      length = (float)atof(argv[++i]);
+    else if (!strcmp(argv[i], "-frames"))
+      frames = (unsigned)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-rate"))
+      rate = atof(argv[++i]);
+    else if (!strcmp(argv[i], "-start"))
+      start = atof(argv[++i]);
+    else if (!strcmp(argv[i], "-seed"))
+      seed = strtoull(argv[++i], nullptr, 0);
+    else if (!strcmp(argv[i], "-threads"))
+      threads = (unsigned)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-queue"))
+      queue = (unsigned)atoi(argv[++i]);
+    else
+    {
+      std::cerr << "Unknown option " << argv[i] << "." << std::endl;
+      valid = false;
+    }
+  }
+  if (valid && rate <= 0.0)
+  {
+    std::cerr << "The rate must be positive." << std::endl;
+    valid = false;
+  }
+}
+
+void Options::PrintUsage()
+{
+  std::cerr << "usage: water_export [-out <prefix>] [-format exr|exr_rle|raw]"
+    " [-grid <size>]\n  [-length <meters>] [-frames <count>] [-rate <fps>]"
+    " [-start <seconds>]\n  [-seed <value>] [-threads <count>]"
+    " [-queue <count>]" << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+  Options options(argc, argv);
+  if (!options.valid)
+  {
+    Options::PrintUsage();
+    return 1;
+  }
+  try {
+    // The plans are estimated so the same options always give the same
+    // files.
+    WaterFFT water(options.grid, options.length, 1);
+    water.Deterministic(true);
+    water.Seed(options.seed);
+    FrameExporter exporter(options.prefix, options.format, options.threads,
+      options.queue);
+
+    std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+    double simulate_seconds = 0.0;
+    for (unsigned frame = 0; frame < options.frames; ++frame)
+    {
+      std::chrono::steady_clock::time_point update_start =
+        std::chrono::steady_clock::now();
+      water.Update(options.start + frame / options.rate, 0);
+      std::chrono::duration<double> update =
+        std::chrono::steady_clock::now() - update_start;
+      simulate_seconds += update.count();
+      exporter.Export(water, 0, frame);
+    }
+    exporter.Finish();
+    std::chrono::duration<double> total =
+      std::chrono::steady_clock::now() - start;
+
+    std::cout << "Wrote " << exporter.Written() << " frames in "
+      << total.count() << " s. Simulating took " << simulate_seconds
+      << " s and waiting for the writers took "
+      << exporter.BlockedSeconds() << " s." << std::endl;
+  }
+  catch (const WaterFFTError & error) {
+    std::cerr << error.GetDescription() << std::endl;
+    return 1;
+  }
+  catch (Error & error) {
+    std::cerr << error << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -1,79 +1,144 @@
-// THIS IS ONLY A TEMPORARY FFT IMPLEMENTATION
-// THIS WILL BE REPLACED BY KISS OR A CUSTOM IMPLEMENTATION
-
-#include "FFT.h"
-
-#define M_PI 3.14159265358979323846264f
-
-FFT::FFT(unsigned int N) : N(N), reversed(0), W(0), pi2(2 * M_PI) {
-	c[0] = c[1] = 0;
-
-	log_2_N = log(N)/log(2);
-
-	reversed = new unsigned int[N];		// prep bit reversals
-	for (int i = 0; i < N; i++) reversed[i] = reverse(i);
-
-	int pow2 = 1;
-	W = new Complex*[log_2_N];		// prep W
-	for (int i = 0; i < log_2_N; i++) {
-		W[i] = new Complex[pow2];
-		for (int j = 0; j < pow2; j++) W[i][j] = w(j, pow2 * 2);
-		pow2 *= 2;
-	}
-
-	c[0] = new Complex[N];
-	c[1] = new Complex[N];
-	which = 0;
-}
-
-FFT::~FFT() {
-	if (c[0]) delete [] c[0];
-	if (c[1]) delete [] c[1];
-	if (W) {
-		for (int i = 0; i < log_2_N; i++) if (W[i]) delete [] W[i];
-		delete [] W;
-	}
-	if (reversed) delete [] reversed;
-}
-
-unsigned int FFT::reverse(unsigned int i) {
-	unsigned int res = 0;
-	for (int j = 0; j < log_2_N; j++) {
-		res = (res << 1) + (i & 1);
-		i >>= 1;
-	}
-	return res;
-}
-
-Complex FFT::w(unsigned int x, unsigned int N) {
-	return Complex(cos(pi2 * x / N), sin(pi2 * x / N));
-}
-
-void FFT::fft(Complex* input, Complex* output, int stride, int offset) {
-	for (int i = 0; i < N; i++) c[which][i] = input[reversed[i] * stride + offset];
-
-	int loops       = N>>1;
-	int size        = 1<<1;
-	int size_over_2 = 1;
-	int w_          = 0;
-	for (int i = 1; i <= log_2_N; i++) {
-		which ^= 1;
-		for (int j = 0; j < loops; j++) {
-			for (int k = 0; k < size_over_2; k++) {
-				c[which][size * j + k] =  c[which^1][size * j + k] +
-							  c[which^1][size * j + size_over_2 + k] * W[w_][k];
-			}
-
-			for (int k = size_over_2; k < size; k++) {
-				c[which][size * j + k] =  c[which^1][size * j - size_over_2 + k] -
-							  c[which^1][size * j + k] * W[w_][k - size_over_2];
-			}
-		}
-		loops       >>= 1;
-		size        <<= 1;
-		size_over_2 <<= 1;
-		w_++;
-	}
-
-	for (int i = 0; i < N; i++) output[i * stride + offset] = c[which][i];
-}
\ No newline at end of file
+// THIS IS ONLY A TEMPORARY FFT IMPLEMENTATION
+// THIS WILL BE REPLACED BY KISS OR A CUSTOM IMPLEMENTATION
+
+#include "Error.h"
+#include "FFT.h"
+
+#define TAU 6.283185307179586476925
+
+// The number of columns transformed together by FFT2D. Eight values fill a
+// 64 byte cache line.
+#define FFT_PANEL_WIDTH 8
+
+// The supported radices in the order that they are factored out of N.
+static const unsigned int radices[] = { 2, 3, 5, 7 };
+
+FFT::FFT(unsigned int N) : N(N), codelet(FindFFTCodelet(N)) {
+	c[0] = c[1] = 0;
+	if (!Supported(N)) {
+		Error error("FFT.cpp", "FFT::FFT");
+		error.Add("The fft size must be a product of 2, 3, 5 and 7.");
+		throw(error);
+	}
+
+	// prep a pass and its twiddles for every factor
+	unsigned int length = N;
+	unsigned int stride = 1;
+	for (unsigned int radix : radices) {
+		while (length % radix == 0) {
+			Stage stage = { radix, length, stride, (unsigned int)twiddles.size() };
+			stages.push_back(stage);
+			unsigned int sub_length = length / radix;
+			for (unsigned int p = 0; p < sub_length; p++)
+				for (unsigned int u = 0; u < radix; u++)
+					twiddles.push_back(w(p * u, length));
+			if (roots[radix].empty())
+				for (unsigned int u = 0; u < radix; u++)
+					roots[radix].push_back(w(u, radix));
+			length = sub_length;
+			stride *= radix;
+		}
+	}
+
+	c[0] = new Complex[N];
+	c[1] = new Complex[N];
+}
+
+FFT::~FFT() {
+	if (c[0]) delete [] c[0];
+	if (c[1]) delete [] c[1];
+}
+
+// Identifies whether N can be transformed. N must be positive and have no
+// prime factors other than 2, 3, 5 and 7.
+bool FFT::Supported(unsigned int N) {
+	if (N == 0)
+		return false;
+	for (unsigned int radix : radices)
+		while (N % radix == 0)
+			N /= radix;
+	return N == 1;
+}
+
+Complex FFTTwiddle(unsigned x, unsigned N) {
+	// the angle is found in double so large sizes keep accurate twiddles
+	double angle = TAU * (double)x / (double)N;
+	return Complex((float)cos(angle), (float)sin(angle));
+}
+
+Complex FFT::w(unsigned int x, unsigned int N) {
+	return FFTTwiddle(x, N);
+}
+
+void FFT::fft(Complex* input, Complex* output, int stride, int offset) {
+	if (codelet) {
+		codelet(input + offset, stride, c[0]);
+		for (unsigned int i = 0; i < N; i++) output[i * stride + offset] = c[0][i];
+		return;
+	}
+
+	for (unsigned int i = 0; i < N; i++) c[0][i] = input[i * stride + offset];
+
+	// Each pass splits every sub-transform of the given length into radix
+	// interleaved sub-transforms. After the final pass the values are in
+	// natural order.
+	unsigned int which = 0;
+	Complex a[7];
+	for (const Stage & stage : stages) {
+		const Complex * x = c[which];
+		Complex * y = c[which ^ 1];
+		const Complex * twiddle = &twiddles[stage.twiddle_offset];
+		const Complex * root = roots[stage.radix].data();
+		unsigned int radix = stage.radix;
+		unsigned int s = stage.stride;
+		unsigned int m = stage.length / radix;
+		for (unsigned int p = 0; p < m; p++) {
+			for (unsigned int q = 0; q < s; q++) {
+				for (unsigned int r = 0; r < radix; r++)
+					a[r] = x[q + s * (p + r * m)];
+				for (unsigned int u = 0; u < radix; u++) {
+					Complex sum = a[0];
+					for (unsigned int r = 1; r < radix; r++)
+						sum += a[r] * root[(r * u) % radix];
+					y[q + s * (radix * p + u)] = sum * twiddle[p * radix + u];
+				}
+			}
+		}
+		which ^= 1;
+	}
+
+	for (unsigned int i = 0; i < N; i++) output[i * stride + offset] = c[which][i];
+}
+
+FFT2D::FFT2D(unsigned int width, unsigned int height) :
+	width(width), height(height), rows(width), columns(height), panel(0) {
+	panel = new Complex[FFT_PANEL_WIDTH * height];
+}
+
+FFT2D::~FFT2D() {
+	if (panel) delete [] panel;
+}
+
+// The input and output may be the same array.
+void FFT2D::fft(Complex* input, Complex* output) {
+	for (unsigned int z = 0; z < height; z++)
+		rows.fft(input + z * width, output + z * width, 1, 0);
+
+	// The columns are transformed a panel at a time. Each row of a panel is a
+	// single cache line of the grid, so the panel is gathered and scattered
+	// with whole lines instead of touching a new line for every value.
+	for (unsigned int x_begin = 0; x_begin < width; x_begin += FFT_PANEL_WIDTH) {
+		unsigned int panel_width = width - x_begin;
+		if (panel_width > FFT_PANEL_WIDTH) panel_width = FFT_PANEL_WIDTH;
+		for (unsigned int z = 0; z < height; z++) {
+			const Complex* row = output + z * width + x_begin;
+			for (unsigned int x = 0; x < panel_width; x++) panel[x * height + z] = row[x];
+		}
+		for (unsigned int x = 0; x < panel_width; x++)
+			columns.fft(panel + x * height, panel + x * height, 1, 0);
+		for (unsigned int z = 0; z < height; z++) {
+			Complex* row = output + z * width + x_begin;
+			for (unsigned int x = 0; x < panel_width; x++) row[x] = panel[x * height + z];
+		}
+	}
+}
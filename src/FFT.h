@@ -1,28 +1,67 @@
-// THIS IS ONLY A TEMPORARY FFT IMPLEMENTATION
-// THIS WILL BE REPLACED BY KISS OR A CUSTOM IMPLEMENTATION
-
-
-#ifndef FFT_H
-#define FFT_H
-
-#include <math.h>
-#include "Complex.h"
-
-class FFT {
-private:
-  unsigned int N, which;
-  unsigned int log_2_N;
-  float pi2;
-  unsigned int *reversed;
-  Complex **W;
-  Complex *c[2];
-protected:
-public:
-  FFT(unsigned int N);
-  ~FFT();
-  unsigned int reverse(unsigned int i);
-  Complex w(unsigned int x, unsigned int N);
-  void fft(Complex* input, Complex* output, int stride, int offset);
-};
-
-#endif
\ No newline at end of file
+// THIS IS ONLY A TEMPORARY FFT IMPLEMENTATION
+// THIS WILL BE REPLACED BY KISS OR A CUSTOM IMPLEMENTATION
+
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <math.h>
+#include <vector>
+#include "Complex.h"
+#include "FFTCodelet.h"
+
+// A mixed radix fft for any size whose prime factors are 2, 3, 5 and 7. The
+// transform uses the positive exponent exp(2 * pi * i * x * k / N) and is not
+// normalized. Each pass reads from one work array and writes to the other in
+// natural order (Stockham), so no bit reversal is needed.
+class FFT {
+private:
+  // One pass of the transform.
+  struct Stage {
+    // The radix of the pass.
+    unsigned int radix;
+    // The length of the sub-transforms that are split by this pass.
+    unsigned int length;
+    // The distance between the elements of a single sub-transform.
+    unsigned int stride;
+    // The index of this pass's first twiddle within twiddles.
+    unsigned int twiddle_offset;
+  };
+  unsigned int N;
+  std::vector<Stage> stages;
+  // The twiddles for every pass. A pass of radix r and length n uses
+  // n twiddles: w(p * u, n) for p < n / r and u < r.
+  std::vector<Complex> twiddles;
+  // The r-th roots of unity for each radix, stored at roots[r][u].
+  std::vector<Complex> roots[8];
+  // The compile time transform used instead of the passes when N is one of
+  // the shipped grid sizes.
+  FFTCodeletFunction codelet;
+  Complex *c[2];
+public:
+  FFT(unsigned int N);
+  ~FFT();
+  static bool Supported(unsigned int N);
+  Complex w(unsigned int x, unsigned int N);
+  void fft(Complex* input, Complex* output, int stride, int offset);
+};
+
+// A 2D fft of a row-major grid that is width values wide and height values
+// tall. Reading a column directly puts each value a whole row away from the
+// previous one, so once the grid is larger than the cache every value costs a
+// miss. Instead, a panel of neighbouring columns is transposed into a small
+// buffer, its columns are transformed as contiguous rows, and the panel is
+// transposed back.
+class FFT2D {
+private:
+  unsigned int width, height;
+  FFT rows;
+  FFT columns;
+  Complex *panel;
+public:
+  FFT2D(unsigned int width, unsigned int height);
+  ~FFT2D();
+  void fft(Complex* input, Complex* output);
+};
+
+#endif
@@ -0,0 +1,167 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file FFTCodelet.h
+/// @date 2026-10-17
+///
+/// @brief Contains fft transforms that are specialised at compile time for
+/// the grid sizes that are shipped.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef FFTCODELET_H
+#define FFTCODELET_H
+
+#include "Complex.h"
+
+#define FFT_CODELET_SQRT_HALF 0.70710678118654752440f
+
+// Gives w(x, N) = exp(2 * pi * i * x / N). This is defined in FFT.cpp.
+Complex FFTTwiddle(unsigned x, unsigned N);
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// The twiddles used by the final pass of a size N transform. The table
+/// holds w(k, N) for k < N / 2.
+///
+/// Important Notes
+/// - FFTTwiddle is not constexpr, so each table is built once when the
+///   program starts.
+///////////////////////////////////////////////////////////////////////////////
+template <unsigned N>
+struct FFTTwiddles
+{
+  FFTTwiddles()
+  {
+    for (unsigned k = 0; k < N / 2; ++k)
+      m_Values[k] = FFTTwiddle(k, N);
+  }
+  Complex m_Values[N / 2];
+  static const FFTTwiddles s_Table;
+};
+
+template <unsigned N>
+const FFTTwiddles<N> FFTTwiddles<N>::s_Table;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// A radix 2 transform of size N. N is known at compile time, so the
+/// recursion depth and every loop bound are constants and the compiler can
+/// unroll the recursion down to the hand written leaves. This uses the same
+/// convention as FFT: the positive exponent with no normalization.
+///
+/// Important Notes
+/// - The input is read with a stride and the output is contiguous. The
+///   input and output must not overlap.
+/// - N must be a power of 2.
+///////////////////////////////////////////////////////////////////////////////
+template <unsigned N>
+struct FFTCodelet
+{
+  static_assert(N > 8 && (N & (N - 1)) == 0,
+    "FFTCodelet sizes must be powers of 2");
+  static void Transform(const Complex * in, unsigned stride, Complex * out)
+  {
+    // The even and odd elements are transformed into the two halves of the
+    // output and then combined.
+    FFTCodelet<N / 2>::Transform(in, stride * 2, out);
+    FFTCodelet<N / 2>::Transform(in + stride, stride * 2, out + N / 2);
+    const Complex * w = FFTTwiddles<N>::s_Table.m_Values;
+    for (unsigned k = 0; k < N / 2; ++k)
+    {
+      Complex even = out[k];
+      Complex odd = w[k] * out[k + N / 2];
+      out[k] = even + odd;
+      out[k + N / 2] = even - odd;
+    }
+  }
+};
+
+template <>
+struct FFTCodelet<2>
+{
+  static void Transform(const Complex * in, unsigned stride, Complex * out)
+  {
+    Complex a = in[0];
+    Complex b = in[stride];
+    out[0] = a + b;
+    out[1] = a - b;
+  }
+};
+
+template <>
+struct FFTCodelet<4>
+{
+  static void Transform(const Complex * in, unsigned stride, Complex * out)
+  {
+    Complex a = in[0];
+    Complex b = in[stride];
+    Complex c = in[2 * stride];
+    Complex d = in[3 * stride];
+    Complex ac_sum = a + c;
+    Complex ac_dif = a - c;
+    Complex bd_sum = b + d;
+    // multiplying by w(1, 4) = i
+    Complex bd_dif_i(d.Imaginary() - b.Imaginary(), b.Real() - d.Real());
+    out[0] = ac_sum + bd_sum;
+    out[1] = ac_dif + bd_dif_i;
+    out[2] = ac_sum - bd_sum;
+    out[3] = ac_dif - bd_dif_i;
+  }
+};
+
+template <>
+struct FFTCodelet<8>
+{
+  static void Transform(const Complex * in, unsigned stride, Complex * out)
+  {
+    FFTCodelet<4>::Transform(in, stride * 2, out);
+    FFTCodelet<4>::Transform(in + stride, stride * 2, out + 4);
+    // w(k, 8) for k < 4
+    const float h = FFT_CODELET_SQRT_HALF;
+    const Complex w1(h, h);
+    const Complex w3(-h, h);
+    Complex o0 = out[4];
+    Complex o1 = w1 * out[5];
+    Complex o2(-out[6].Imaginary(), out[6].Real());
+    Complex o3 = w3 * out[7];
+    Complex e0 = out[0];
+    Complex e1 = out[1];
+    Complex e2 = out[2];
+    Complex e3 = out[3];
+    out[0] = e0 + o0;
+    out[1] = e1 + o1;
+    out[2] = e2 + o2;
+    out[3] = e3 + o3;
+    out[4] = e0 - o0;
+    out[5] = e1 - o1;
+    out[6] = e2 - o2;
+    out[7] = e3 - o3;
+  }
+};
+
+//! A transform from a strided input to a contiguous output.
+typedef void (*FFTCodeletFunction)(const Complex * in, unsigned stride,
+  Complex * out);
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Finds the compile time transform for a size.
+///
+/// @param N The size of the transform.
+///
+/// @return The transform, or nullptr if N is not one of the shipped grid
+///   sizes (64, 128, 256, 512, and 1024) or one of the large sizes used by
+///   FFT2D (2048 and 4096).
+///////////////////////////////////////////////////////////////////////////////
+inline FFTCodeletFunction FindFFTCodelet(unsigned N)
+{
+  switch (N)
+  {
+  case 64: return &FFTCodelet<64>::Transform;
+  case 128: return &FFTCodelet<128>::Transform;
+  case 256: return &FFTCodelet<256>::Transform;
+  case 512: return &FFTCodelet<512>::Transform;
+  case 1024: return &FFTCodelet<1024>::Transform;
+  case 2048: return &FFTCodelet<2048>::Transform;
+  case 4096: return &FFTCodelet<4096>::Transform;
+  default: return nullptr;
+  }
+}
+
+#endif // !FFTCODELET_H
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <vector>
+#include "FFT.h"
+#include "Random.h"
+#include "WaterFFT.h"
+
+// The largest error allowed between FFT2D and a direct DFT, as a fraction of
+// the largest output.
+#define TEST_FFT_ERROR_BUDGET 1.0e-5f
+#define TEST_FFT_SEED 4242
+#define TEST_FFT_TAU 6.283185307179586476925
+// The number of output values checked at each size. Each one is a direct sum
+// over the whole grid.
+#define TEST_FFT_BINS 24
+#define BENCH_FFT_UPDATES 50
+// The time each size of the FFT2D sweep is run for.
+#define BENCH_FFT2D_SECONDS 0.5
+
+void test_fft();
+void test_builtin_fft();
+float test_fft2d(unsigned width, unsigned height);
+void bench_fft();
+float bench_fft_update(unsigned grid, bool builtin);
+void bench_fft2d();
+
+void test_fft()
+{
+  test_builtin_fft();
+}
+
+// Compares FFT2D against a direct DFT at every grid size with a codelet,
+// at sizes that use the radix 3, 5, and 7 passes, and at rectangular sizes.
+void test_builtin_fft()
+{
+  unsigned sizes[][2] = { { 64, 64 }, { 128, 128 }, { 256, 256 },
+    { 512, 512 }, { 1024, 1024 }, { 2048, 2048 }, { 4096, 4096 },
+    { 120, 120 }, { 210, 98 }, { 256, 60 } };
+  float max_error = 0.0f;
+  for (const unsigned * size : sizes)
+    max_error = glm::max(max_error, test_fft2d(size[0], size[1]));
+  // relative error: less than TEST_FFT_ERROR_BUDGET
+  std::cout << "max FFT2D error relative to a direct DFT: " << max_error
+    << (max_error < TEST_FFT_ERROR_BUDGET ? " PASS" : " FAIL") << std::endl;
+}
+
+// Transforms random values with FFT2D and compares a set of outputs against
+// the sum exp(2 * pi * i * (kx * x / width + kz * z / height)) * value found
+// in double. Returns the largest error as a fraction of the largest output.
+float test_fft2d(unsigned width, unsigned height)
+{
+  Random random(TEST_FFT_SEED);
+  std::vector<Complex> input(width * height);
+  for (Complex & value : input)
+    value = Complex(2.0f * random.Uniform() - 1.0f,
+      2.0f * random.Uniform() - 1.0f);
+  std::vector<Complex> output(input);
+  FFT2D fft(width, height);
+  fft.fft(output.data(), output.data());
+
+  std::vector<std::complex<double> > w_x(width);
+  for (unsigned x = 0; x < width; ++x)
+    w_x[x] = std::polar(1.0, TEST_FFT_TAU * (double)x / (double)width);
+  std::vector<std::complex<double> > w_z(height);
+  for (unsigned z = 0; z < height; ++z)
+    w_z[z] = std::polar(1.0, TEST_FFT_TAU * (double)z / (double)height);
+
+  float max_value = 0.0f;
+  for (const Complex & value : output)
+    max_value = glm::max(max_value, glm::max(std::fabs(value.Real()),
+      std::fabs(value.Imaginary())));
+  // The first outputs are the constant term and the Nyquist terms, where
+  // every twiddle is 1 or -1.
+  float max_error = 0.0f;
+  for (unsigned bin = 0; bin < TEST_FFT_BINS; ++bin)
+  {
+    unsigned kx = bin == 1 || bin == 3 ? width / 2 : 0;
+    unsigned kz = bin == 2 || bin == 3 ? height / 2 : 0;
+    if (bin > 3)
+    {
+      kx = random.Next() % width;
+      kz = random.Next() % height;
+    }
+    std::complex<double> sum(0.0, 0.0);
+    for (unsigned z = 0; z < height; ++z)
+    {
+      std::complex<double> row_sum(0.0, 0.0);
+      const Complex * row = &input[z * width];
+      for (unsigned x = 0; x < width; ++x)
+        row_sum += std::complex<double>(row[x].Real(), row[x].Imaginary()) *
+          w_x[((uint64_t)kx * x) % width];
+      sum += row_sum * w_z[((uint64_t)kz * z) % height];
+    }
+    const Complex & value = output[kz * width + kx];
+    float error = (float)glm::max(std::fabs(sum.real() - value.Real()),
+      std::fabs(sum.imag() - value.Imaginary()));
+    max_error = glm::max(max_error, error);
+  }
+  return max_error / max_value;
+}
+
+// Times WaterFFT::Update with FFTW and with FFT2D at the shipped grid sizes.
+// The FFTW plans are measured, as they are in the demo.
+void bench_fft()
+{
+  unsigned grids[] = { 128, 256, 512 };
+  for (unsigned grid : grids)
+  {
+    float fftw_ms = bench_fft_update(grid, false);
+    float builtin_ms = bench_fft_update(grid, true);
+    std::cout << "grid " << grid << ": FFTW " << fftw_ms << " ms, FFT2D "
+      << builtin_ms << " ms per update" << std::endl;
+  }
+}
+
+float bench_fft_update(unsigned grid, bool builtin)
+{
+  typedef std::chrono::high_resolution_clock Clock;
+  WaterFFT water(grid, 256.0f, 1);
+  water.Seed(TEST_FFT_SEED);
+  water.BuiltinFFT(builtin);
+  // The first update touches every array once so it is not timed.
+  water.Update(0.0, 0);
+  Clock::time_point start = Clock::now();
+  for (unsigned i = 0; i < BENCH_FFT_UPDATES; ++i)
+    water.Update((double)i / 30.0, 0);
+  Clock::time_point end = Clock::now();
+  return std::chrono::duration<float, std::milli>(end - start).count() /
+    BENCH_FFT_UPDATES;
+}
+
+// Times a single FFT2D from 128 by 128 up to 4096 by 4096. An N by N
+// transform does N^2 log2(N) work, so the time per N^2 log2(N) stays flat
+// while the grid fits in the cache and grows once every pass over the
+// columns misses.
+void bench_fft2d()
+{
+  typedef std::chrono::high_resolution_clock Clock;
+  for (unsigned grid = 128; grid <= 4096; grid *= 2)
+  {
+    std::vector<Complex> values(grid * grid);
+    FFT2D fft(grid, grid);
+    // The first transform touches every value once so it is not timed.
+    fft.fft(values.data(), values.data());
+    unsigned runs = 0;
+    Clock::time_point start = Clock::now();
+    double seconds = 0.0;
+    while (seconds < BENCH_FFT2D_SECONDS)
+    {
+      fft.fft(values.data(), values.data());
+      ++runs;
+      seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    double ns = 1.0e9 * seconds / runs;
+    double squared = (double)grid * grid;
+    std::cout << "FFT2D " << grid << ": " << ns / 1.0e6 << " ms, "
+      << ns / squared << " ns per N^2, "
+      << ns / (squared * std::log2((double)grid)) << " ns per N^2 log2(N)"
+      << std::endl;
+  }
+}
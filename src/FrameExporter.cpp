@@ -0,0 +1,399 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file FrameExporter.cpp
+/// @date 2026-10-17
+///
+/// @brief Contains the implementation of the background frame exporter.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "Error.h"
+#include "Half.h"
+
+#include "FrameExporter.h"
+
+#define EXR_MAGIC 20000630
+// Version 2 with every flag cleared is a single part scanline file.
+#define EXR_VERSION 2
+#define EXR_PIXEL_HALF 1
+#define EXR_NO_COMPRESSION 0
+#define EXR_RLE_COMPRESSION 1
+#define EXR_RLE_MIN_RUN 3
+#define EXR_RLE_MAX_RUN 127
+
+// Appends bytes to the end of a buffer.
+static void Append(std::vector<char> * out, const void * data, size_t bytes)
+{
+  const char * begin = (const char *)data;
+  out->insert(out->end(), begin, begin + bytes);
+}
+
+// OpenEXR stores every value little endian.
+static void AppendInt(std::vector<char> * out, uint32_t value)
+{
+  char bytes[4] = { (char)value, (char)(value >> 8), (char)(value >> 16),
+    (char)(value >> 24) };
+  Append(out, bytes, 4);
+}
+
+static void AppendFloat(std::vector<char> * out, float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, 4);
+  AppendInt(out, bits);
+}
+
+static void WriteLong(std::vector<char> * out, size_t at, uint64_t value)
+{
+  for (unsigned i = 0; i < 8; ++i)
+    (*out)[at + i] = (char)(value >> (8 * i));
+}
+
+// Adds the name, type, and size of a header attribute. The value follows.
+static void AppendAttribute(std::vector<char> * out, const char * name,
+  const char * type, uint32_t size)
+{
+  Append(out, name, strlen(name) + 1);
+  Append(out, type, strlen(type) + 1);
+  AppendInt(out, size);
+}
+
+static void AppendBox(std::vector<char> * out, const char * name,
+  unsigned width, unsigned height)
+{
+  AppendAttribute(out, name, "box2i", 16);
+  AppendInt(out, 0);
+  AppendInt(out, 0);
+  AppendInt(out, width - 1);
+  AppendInt(out, height - 1);
+}
+
+// The channel names in the order of WaterFFT::FieldRow. OpenEXR needs them
+// sorted, and they already are.
+static const char * channel_names[WATER_FIELDS] = { "displacement.X",
+  "displacement.Y", "displacement.Z", "normal.X", "normal.Y", "normal.Z" };
+
+static void AppendExrHeader(std::vector<char> * out, unsigned width,
+  unsigned height, bool rle)
+{
+  AppendInt(out, EXR_MAGIC);
+  AppendInt(out, EXR_VERSION);
+
+  uint32_t channels_size = 1;
+  for (const char * name : channel_names)
+    channels_size += (uint32_t)strlen(name) + 1 + 16;
+  AppendAttribute(out, "channels", "chlist", channels_size);
+  for (const char * name : channel_names)
+  {
+    Append(out, name, strlen(name) + 1);
+    AppendInt(out, EXR_PIXEL_HALF);
+    // pLinear and three reserved bytes followed by the x and y sampling.
+    AppendInt(out, 0);
+    AppendInt(out, 1);
+    AppendInt(out, 1);
+  }
+  out->push_back(0);
+
+  AppendAttribute(out, "compression", "compression", 1);
+  out->push_back(rle ? EXR_RLE_COMPRESSION : EXR_NO_COMPRESSION);
+  AppendBox(out, "dataWindow", width, height);
+  AppendBox(out, "displayWindow", width, height);
+  AppendAttribute(out, "lineOrder", "lineOrder", 1);
+  out->push_back(0);
+  AppendAttribute(out, "pixelAspectRatio", "float", 4);
+  AppendFloat(out, 1.0f);
+  AppendAttribute(out, "screenWindowCenter", "v2f", 8);
+  AppendFloat(out, 0.0f);
+  AppendFloat(out, 0.0f);
+  AppendAttribute(out, "screenWindowWidth", "float", 4);
+  AppendFloat(out, 1.0f);
+  out->push_back(0);
+}
+
+// Compresses a scanline the way OpenEXR's RLE compressor does. The bytes are
+// split into the even and odd bytes, each byte is replaced by its difference
+// from the byte before it, and the result is run length encoded. Runs are a
+// count minus one followed by the byte. Literals are a negative count
+// followed by the bytes.
+static void CompressRle(const char * in, size_t size,
+  std::vector<unsigned char> * scratch, std::vector<char> * out)
+{
+  scratch->resize(size);
+  unsigned char * t1 = scratch->data();
+  unsigned char * t2 = scratch->data() + (size + 1) / 2;
+  for (size_t i = 0; i < size; ++i)
+  {
+    if (i % 2 == 0)
+      *t1++ = (unsigned char)in[i];
+    else
+      *t2++ = (unsigned char)in[i];
+  }
+  int previous = (*scratch)[0];
+  for (size_t i = 1; i < size; ++i)
+  {
+    int current = (*scratch)[i];
+    (*scratch)[i] = (unsigned char)(current - previous + 128 + 256);
+    previous = current;
+  }
+
+  const unsigned char * end = scratch->data() + size;
+  const unsigned char * run_start = scratch->data();
+  const unsigned char * run_end = run_start + 1;
+  while (run_start < end)
+  {
+    while (run_end < end && *run_start == *run_end &&
+      run_end - run_start - 1 < EXR_RLE_MAX_RUN)
+      ++run_end;
+    if (run_end - run_start >= EXR_RLE_MIN_RUN)
+    {
+      out->push_back((char)(run_end - run_start - 1));
+      out->push_back((char)*run_start);
+      run_start = run_end;
+    }
+    else
+    {
+      while (run_end < end &&
+        ((run_end + 1 >= end || *run_end != *(run_end + 1)) ||
+        (run_end + 2 >= end || *(run_end + 1) != *(run_end + 2))) &&
+        run_end - run_start < EXR_RLE_MAX_RUN)
+        ++run_end;
+      out->push_back((char)(run_start - run_end));
+      while (run_start < run_end)
+        out->push_back((char)*run_start++);
+    }
+    ++run_end;
+  }
+}
+
+// Encodes a frame as a scanline OpenEXR file with one scanline per chunk.
+// The halves are copied as they are, so this assumes a little endian
+// machine.
+static void EncodeExr(const float * fields, unsigned width, unsigned height,
+  bool rle, std::vector<char> * out)
+{
+  AppendExrHeader(out, width, height, rle);
+  size_t offsets = out->size();
+  out->resize(offsets + 8 * (size_t)height);
+
+  unsigned row_values = WATER_FIELDS * width;
+  size_t row_bytes = row_values * sizeof(Half);
+  std::vector<Half> halves(row_values);
+  std::vector<unsigned char> scratch;
+  std::vector<char> compressed;
+  for (unsigned y = 0; y < height; ++y)
+  {
+    WriteLong(out, offsets + 8 * (size_t)y, out->size());
+    FloatToHalf(fields + (size_t)y * row_values, halves.data(), row_values);
+    const char * data = (const char *)halves.data();
+    size_t data_bytes = row_bytes;
+    // A chunk that does not get smaller is stored as it is, which readers
+    // tell apart by its size.
+    if (rle)
+    {
+      compressed.clear();
+      CompressRle(data, row_bytes, &scratch, &compressed);
+      if (compressed.size() < row_bytes)
+      {
+        data = compressed.data();
+        data_bytes = compressed.size();
+      }
+    }
+    AppendInt(out, y);
+    AppendInt(out, (uint32_t)data_bytes);
+    Append(out, data, data_bytes);
+  }
+}
+
+// Encodes a frame as floats with the fields of each pixel together.
+static void EncodeRaw(const float * fields, unsigned width, unsigned height,
+  std::vector<char> * out)
+{
+  out->resize((size_t)width * height * WATER_FIELDS * sizeof(float));
+  float * pixels = (float *)out->data();
+  for (unsigned y = 0; y < height; ++y)
+  {
+    const float * row = fields + (size_t)y * width * WATER_FIELDS;
+    for (unsigned x = 0; x < width; ++x)
+    {
+      for (unsigned f = 0; f < WATER_FIELDS; ++f)
+        *pixels++ = row[f * width + x];
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Starts the writing threads.
+///
+/// @param prefix The start of every file name. It may include directories.
+/// @param format The format of the files.
+/// @param threads The number of writing threads. Zero uses one per core.
+/// @param queue_frames The number of frames that are allocated. More frames
+///   absorb slower writes at the cost of memory.
+///////////////////////////////////////////////////////////////////////////////
+FrameExporter::FrameExporter(const std::string & prefix, Format format,
+  unsigned threads, unsigned queue_frames) :
+  m_Prefix(prefix), m_Format(format), m_Stopping(false), m_Written(0),
+  m_BlockedSeconds(0.0)
+{
+  if (threads == 0)
+    threads = std::thread::hardware_concurrency();
+  if (threads == 0)
+    threads = 1;
+  if (queue_frames == 0)
+    queue_frames = 1;
+  m_Frames.resize(queue_frames);
+  for (Frame & frame : m_Frames)
+    m_Free.push_back(&frame);
+  for (unsigned i = 0; i < threads; ++i)
+    m_Threads.push_back(std::thread(&FrameExporter::Work, this));
+}
+
+//! Writes every queued frame and stops the threads. Errors are dropped, so
+// call Finish first to see them.
+FrameExporter::~FrameExporter()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stopping = true;
+  }
+  m_Queued.notify_all();
+  for (std::thread & thread : m_Threads)
+    thread.join();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Copies the fields of a frame and queues it to be written. This
+/// only blocks when every frame is queued or being written.
+///
+/// @param water The water to copy the frame from.
+/// @param buffer The vertex buffer holding the frame. It must not be written
+///   until this returns.
+/// @param number The number in the file name.
+///////////////////////////////////////////////////////////////////////////////
+void FrameExporter::Export(const WaterFFT & water, unsigned buffer,
+  unsigned number)
+{
+  Frame * frame;
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+    m_Freed.wait(lock,
+      [this]() { return !m_Free.empty() || !m_Failure.empty(); });
+    std::chrono::duration<double> blocked =
+      std::chrono::steady_clock::now() - start;
+    m_BlockedSeconds += blocked.count();
+    if (!m_Failure.empty())
+      ThrowFailure("FrameExporter::Export");
+    frame = m_Free.back();
+    m_Free.pop_back();
+  }
+
+  frame->m_Number = number;
+  frame->m_Width = water.XVertices() - 1;
+  frame->m_Height = water.ZVertices() - 1;
+  size_t row_values = (size_t)WATER_FIELDS * frame->m_Width;
+  frame->m_Fields.resize(row_values * frame->m_Height);
+  for (unsigned z = 0; z < frame->m_Height; ++z)
+    water.FieldRow(buffer, z, frame->m_Fields.data() + z * row_values);
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Queue.push_back(frame);
+  }
+  m_Queued.notify_one();
+}
+
+//! Waits until every queued frame is written.
+void FrameExporter::Finish()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_Freed.wait(lock, [this]()
+    { return m_Free.size() == m_Frames.size() || !m_Failure.empty(); });
+  if (!m_Failure.empty())
+    ThrowFailure("FrameExporter::Finish");
+}
+
+//! The number of frames that have been written.
+unsigned FrameExporter::Written() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Written;
+}
+
+//! The total time Export has waited for the writing threads in seconds.
+double FrameExporter::BlockedSeconds() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_BlockedSeconds;
+}
+
+// The loop run by each writing thread. Every thread keeps its own encoded
+// buffer, so frames are encoded in parallel.
+void FrameExporter::Work()
+{
+  std::vector<char> encoded;
+  while (true)
+  {
+    Frame * frame;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Queued.wait(lock,
+        [this]() { return !m_Queue.empty() || m_Stopping; });
+      if (m_Queue.empty())
+        return;
+      frame = m_Queue.front();
+      m_Queue.pop_front();
+    }
+    std::string failure = Write(*frame, &encoded);
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if (!failure.empty() && m_Failure.empty())
+        m_Failure = failure;
+      else if (failure.empty())
+        ++m_Written;
+      m_Free.push_back(frame);
+    }
+    m_Freed.notify_all();
+  }
+}
+
+// Encodes a frame and writes its file. Returns a description of the problem
+// when the file could not be written.
+std::string FrameExporter::Write(const Frame & frame,
+  std::vector<char> * encoded) const
+{
+  char number[16];
+  snprintf(number, sizeof(number), ".%04u", frame.m_Number);
+  std::string filename = m_Prefix + number;
+  encoded->clear();
+  if (m_Format == RAW)
+  {
+    filename += ".raw";
+    EncodeRaw(frame.m_Fields.data(), frame.m_Width, frame.m_Height, encoded);
+  }
+  else
+  {
+    filename += ".exr";
+    EncodeExr(frame.m_Fields.data(), frame.m_Width, frame.m_Height,
+      m_Format == EXR_RLE, encoded);
+  }
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  file.write(encoded->data(), encoded->size());
+  file.close();
+  if (!file)
+    return "Could not write " + filename + ".";
+  return std::string();
+}
+
+// Throws the failure of a writing thread. The mutex must be held.
+void FrameExporter::ThrowFailure(const char * function)
+{
+  Error error("FrameExporter.cpp", function);
+  error.Add(m_Failure);
+  throw(error);
+}
@@ -0,0 +1,97 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file FrameExporter.h
+/// @date 2026-10-17
+///
+/// @brief Contains the interface for writing WaterFFT frames to image
+/// sequences on background threads.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "WaterFFT.h"
+
+//! The number of frames that can wait to be written before Export blocks.
+#define EXPORT_QUEUE_FRAMES 4
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Writes the displacement and normal fields of WaterFFT frames to one file
+/// per frame. Export copies the fields into a free frame and queues it.
+/// Background threads encode the queued frames and write them, so the
+/// simulation only waits for the disk when every frame is in use.
+///
+/// The files are named <prefix>.<frame>.exr or <prefix>.<frame>.raw with
+/// the frame number padded to four digits. Row y of an image is row z of the
+/// mesh. The channels are displacement.X, displacement.Y, displacement.Z,
+/// normal.X, normal.Y, and normal.Z. See WaterFFT::FieldRow.
+/// - EXR and EXR_RLE are scanline OpenEXR files with half channels. EXR_RLE
+///   compresses each scanline with the OpenEXR RLE scheme on the writing
+///   thread.
+/// - RAW is little endian 32 bit floats with the six channels of a pixel
+///   next to each other and no header.
+///
+/// Important Notes
+/// - Export and Finish must be called from one thread.
+/// - Errors from the writing threads are thrown by the next Export or
+///   Finish.
+///////////////////////////////////////////////////////////////////////////////
+class FrameExporter
+{
+public:
+  //! The file formats frames can be written in.
+  enum Format
+  {
+    EXR,
+    EXR_RLE,
+    RAW
+  };
+  FrameExporter(const std::string & prefix, Format format,
+    unsigned threads = 0, unsigned queue_frames = EXPORT_QUEUE_FRAMES);
+  ~FrameExporter();
+  FrameExporter(const FrameExporter & other) = delete;
+  FrameExporter & operator=(const FrameExporter & other) = delete;
+  void Export(const WaterFFT & water, unsigned buffer, unsigned number);
+  void Finish();
+  unsigned Written() const;
+  double BlockedSeconds() const;
+private:
+  //! A frame waiting to be written.
+  struct Frame
+  {
+    unsigned m_Number;
+    unsigned m_Width;
+    unsigned m_Height;
+    //! Each row holds the WATER_FIELDS fields one after the other.
+    std::vector<float> m_Fields;
+  };
+  void Work();
+  std::string Write(const Frame & frame, std::vector<char> * encoded) const;
+  void ThrowFailure(const char * function);
+  //! The start of every file name.
+  std::string m_Prefix;
+  Format m_Format;
+  //! Every frame. A frame is either free, queued, or being written.
+  std::vector<Frame> m_Frames;
+  std::vector<Frame *> m_Free;
+  std::deque<Frame *> m_Queue;
+  //! Guards every value below and the lists of frames above.
+  mutable std::mutex m_Mutex;
+  //! Signaled when a frame is queued or the threads should stop.
+  std::condition_variable m_Queued;
+  //! Signaled when a frame is freed.
+  std::condition_variable m_Freed;
+  bool m_Stopping;
+  //! The first error from a writing thread. Empty when there was none.
+  std::string m_Failure;
+  //! The number of frames that have been written.
+  unsigned m_Written;
+  //! The time Export spent waiting for a free frame in seconds.
+  double m_BlockedSeconds;
+  std::vector<std::thread> m_Threads;
+};
@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file FramePublisher.cpp
+/// @date 2026-10-17
+///
+/// @brief Contains the implementation of the ocean frame publisher.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <new>
+
+#include "FramePublisher.h"
+
+// The floats in a WaterFFT vertex.
+#define FRAME_VERTEX_FLOATS 8
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Creates the shared memory and writes the ring header.
+///
+/// @param name The name readers open the ring with.
+/// @param x_vertices The number of vertices along the x axis of a frame.
+/// @param z_vertices The number of vertices along the z axis of a frame.
+/// @param x_length The length of the mesh on the x axis in meters.
+/// @param z_length The length of the mesh on the z axis in meters.
+///////////////////////////////////////////////////////////////////////////////
+FramePublisher::FramePublisher(const std::string & name,
+  unsigned x_vertices, unsigned z_vertices, float x_length, float z_length)
+{
+  m_FrameBytes = (size_t)x_vertices * z_vertices * FRAME_VERTEX_FLOATS *
+    sizeof(float);
+  uint32_t header_bytes = FrameRingAlign(sizeof(FrameRingHeader));
+  uint32_t slot_bytes = FrameRingAlign(FRAME_RING_ALIGNMENT + m_FrameBytes);
+  m_Memory.Create(name, (size_t)header_bytes +
+    (size_t)slot_bytes * FRAME_RING_SLOTS);
+
+  m_Header = new (m_Memory.Data()) FrameRingHeader;
+  m_Header->m_Version = FRAME_RING_VERSION;
+  m_Header->m_HeaderBytes = header_bytes;
+  m_Header->m_SlotBytes = slot_bytes;
+  m_Header->m_SlotCount = FRAME_RING_SLOTS;
+  m_Header->m_XVertices = x_vertices;
+  m_Header->m_ZVertices = z_vertices;
+  m_Header->m_VertexFloats = FRAME_VERTEX_FLOATS;
+  m_Header->m_XLength = x_length;
+  m_Header->m_ZLength = z_length;
+  m_Header->m_Published.store(0, std::memory_order_relaxed);
+  char * slots = (char *)m_Memory.Data() + header_bytes;
+  for (unsigned i = 0; i < FRAME_RING_SLOTS; ++i)
+  {
+    FrameSlotHeader * slot = new (slots + i * slot_bytes) FrameSlotHeader;
+    slot->m_Sequence.store(0, std::memory_order_relaxed);
+    slot->m_Frame = 0;
+    slot->m_Time = 0.0;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  m_Header->m_Magic = FRAME_RING_MAGIC;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Writes a frame into the oldest slot and makes it the newest frame.
+///
+/// @param vertices The vertex buffer of the frame.
+/// @param time The simulation time of the frame in seconds.
+///////////////////////////////////////////////////////////////////////////////
+void FramePublisher::Publish(const void * vertices, double time)
+{
+  uint64_t frame = m_Header->m_Published.load(std::memory_order_relaxed);
+  char * slot_start = (char *)m_Memory.Data() + m_Header->m_HeaderBytes +
+    (size_t)(frame % FRAME_RING_SLOTS) * m_Header->m_SlotBytes;
+  FrameSlotHeader * slot = (FrameSlotHeader *)slot_start;
+
+  uint64_t sequence = slot->m_Sequence.load(std::memory_order_relaxed);
+  slot->m_Sequence.store(sequence + 1, std::memory_order_relaxed);
+  // Keeps the writes below from being seen before the odd sequence.
+  std::atomic_thread_fence(std::memory_order_release);
+  slot->m_Frame = frame;
+  slot->m_Time = time;
+  std::memcpy(slot_start + FRAME_RING_ALIGNMENT, vertices, m_FrameBytes);
+  slot->m_Sequence.store(sequence + 2, std::memory_order_release);
+  m_Header->m_Published.store(frame + 1, std::memory_order_release);
+}
+
+//! The number of frames published so far.
+uint64_t FramePublisher::Published() const
+{
+  return m_Header->m_Published.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,38 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file FramePublisher.h
+/// @date 2026-10-17
+///
+/// @brief Contains the interface for publishing ocean frames to other
+/// processes.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "FrameRing.h"
+#include "SharedMemory.h"
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Writes finished WaterFFT vertex buffers into a ring of slots in shared
+/// memory. See FrameRing.h for the layout and FrameReader for the other
+/// side.
+///
+/// Important Notes
+/// - Publish must only be called from one thread at a time.
+/// - The vertices are copied once, straight into the slot.
+///////////////////////////////////////////////////////////////////////////////
+class FramePublisher
+{
+public:
+  FramePublisher(const std::string & name, unsigned x_vertices,
+    unsigned z_vertices, float x_length, float z_length);
+  void Publish(const void * vertices, double time);
+  uint64_t Published() const;
+private:
+  SharedMemory m_Memory;
+  FrameRingHeader * m_Header;
+  //! The number of bytes of vertices in a frame.
+  size_t m_FrameBytes;
+};
@@ -0,0 +1,133 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file FrameReader.cpp
+/// @date 2026-10-17
+///
+/// @brief Contains the implementation of the ocean frame reader.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include "Error.h"
+
+#include "FrameReader.h"
+
+// The number of times Read tries to copy a frame before it gives up. A copy
+// only fails when the publisher laps the reader, so this is rarely reached.
+#define FRAME_READ_TRIES 16
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Opens a ring and checks that its layout is the one this reader
+/// was built for.
+///
+/// @param name The name the FramePublisher was created with.
+///////////////////////////////////////////////////////////////////////////////
+FrameReader::FrameReader(const std::string & name)
+{
+  m_Memory.Open(name);
+  Error error("FrameReader.cpp", "FrameReader::FrameReader");
+  m_Header = (const FrameRingHeader *)m_Memory.Data();
+  if (m_Memory.Size() < sizeof(FrameRingHeader) ||
+    m_Header->m_Magic != FRAME_RING_MAGIC)
+  {
+    error.Add(name + " is not a frame ring or is not ready yet.");
+    throw(error);
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (m_Header->m_Version != FRAME_RING_VERSION)
+  {
+    error.Add(name + " has layout version " +
+      std::to_string(m_Header->m_Version) + " but version " +
+      std::to_string(FRAME_RING_VERSION) + " is expected.");
+    throw(error);
+  }
+  if (m_Header->m_SlotCount == 0 ||
+    m_Header->m_HeaderBytes < sizeof(FrameRingHeader))
+  {
+    error.Add(name + " has a damaged header.");
+    throw(error);
+  }
+  uint64_t frame_bytes = (uint64_t)m_Header->m_XVertices *
+    m_Header->m_ZVertices * m_Header->m_VertexFloats * sizeof(float);
+  if (m_Header->m_SlotBytes < FRAME_RING_ALIGNMENT + frame_bytes ||
+    m_Memory.Size() < (uint64_t)m_Header->m_HeaderBytes +
+    (uint64_t)m_Header->m_SlotBytes * m_Header->m_SlotCount)
+  {
+    error.Add(name + " is smaller than its header says.");
+    throw(error);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Copies the newest frame if it is newer than the one in frame.
+///
+/// @param frame The last frame read. It is replaced by the newest frame.
+///
+/// @return True when a newer frame was copied.
+///////////////////////////////////////////////////////////////////////////////
+bool FrameReader::Read(OceanFrame * frame)
+{
+  size_t floats = (size_t)m_Header->m_XVertices * m_Header->m_ZVertices *
+    m_Header->m_VertexFloats;
+  frame->m_Vertices.resize(floats);
+  for (unsigned i = 0; i < FRAME_READ_TRIES; ++i)
+  {
+    uint64_t published = m_Header->m_Published.load(
+      std::memory_order_acquire);
+    if (published == 0)
+      return false;
+    uint64_t newest = published - 1;
+    if (frame->m_Frame != UINT64_MAX && newest <= frame->m_Frame)
+      return false;
+    const char * slot_start = (const char *)m_Memory.Data() +
+      m_Header->m_HeaderBytes +
+      (size_t)(newest % m_Header->m_SlotCount) * m_Header->m_SlotBytes;
+    const FrameSlotHeader * slot = (const FrameSlotHeader *)slot_start;
+    uint64_t before = slot->m_Sequence.load(std::memory_order_acquire);
+    if (before & 1)
+      continue;
+    uint64_t slot_frame = slot->m_Frame;
+    double time = slot->m_Time;
+    std::memcpy(frame->m_Vertices.data(), slot_start + FRAME_RING_ALIGNMENT,
+      floats * sizeof(float));
+    // Keeps the copy from being moved after the second sequence load.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t after = slot->m_Sequence.load(std::memory_order_relaxed);
+    if (before != after || slot_frame != newest)
+      continue;
+    frame->m_Frame = slot_frame;
+    frame->m_Time = time;
+    return true;
+  }
+  return false;
+}
+
+//! The number of frames the publisher has written.
+uint64_t FrameReader::Published() const
+{
+  return m_Header->m_Published.load(std::memory_order_acquire);
+}
+
+unsigned FrameReader::XVertices() const
+{
+  return m_Header->m_XVertices;
+}
+
+unsigned FrameReader::ZVertices() const
+{
+  return m_Header->m_ZVertices;
+}
+
+unsigned FrameReader::VertexFloats() const
+{
+  return m_Header->m_VertexFloats;
+}
+
+float FrameReader::XLength() const
+{
+  return m_Header->m_XLength;
+}
+
+float FrameReader::ZLength() const
+{
+  return m_Header->m_ZLength;
+}
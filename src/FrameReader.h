@@ -0,0 +1,52 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file FrameReader.h
+/// @date 2026-10-17
+///
+/// @brief Contains the interface for reading ocean frames published by
+/// another process. A consumer only needs FrameReader, FrameRing.h,
+/// SharedMemory, and Error.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "FrameRing.h"
+#include "SharedMemory.h"
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// A frame copied out of the ring.
+///////////////////////////////////////////////////////////////////////////////
+struct OceanFrame
+{
+  OceanFrame() : m_Frame(UINT64_MAX), m_Time(0.0) {}
+  //! The frame number. UINT64_MAX before the first read.
+  uint64_t m_Frame;
+  //! The simulation time of the frame in seconds.
+  double m_Time;
+  //! The vertices, row by row along x. See FrameRingHeader::m_VertexFloats.
+  std::vector<float> m_Vertices;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Opens a ring made by a FramePublisher and copies the newest frame out of
+/// it. Reads never block the publisher.
+///////////////////////////////////////////////////////////////////////////////
+class FrameReader
+{
+public:
+  FrameReader(const std::string & name);
+  bool Read(OceanFrame * frame);
+  uint64_t Published() const;
+  unsigned XVertices() const;
+  unsigned ZVertices() const;
+  unsigned VertexFloats() const;
+  float XLength() const;
+  float ZLength() const;
+private:
+  SharedMemory m_Memory;
+  const FrameRingHeader * m_Header;
+};
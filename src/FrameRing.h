@@ -0,0 +1,76 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file FrameRing.h
+/// @date 2026-10-17
+///
+/// @brief Contains the layout of the shared memory that ocean frames are
+/// published to. This is shared by the FramePublisher and the FrameReader.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Identifies the block as a frame ring. The version changes whenever the
+// layout below changes.
+#define FRAME_RING_MAGIC 0x57524E47u
+#define FRAME_RING_VERSION 1u
+// The number of frames kept in the ring.
+#define FRAME_RING_SLOTS 4u
+// The ring header and each slot header take this many bytes so the vertices
+// start on a cache line.
+#define FRAME_RING_ALIGNMENT 64u
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// The start of the block. It is followed by m_SlotCount slots that are
+/// m_SlotBytes long. A slot is a FrameSlotHeader followed by the vertices.
+///
+/// Important Notes
+/// - Readers must check m_Magic and m_Version before using anything else.
+///   m_Magic is written last, after the rest of the header.
+///////////////////////////////////////////////////////////////////////////////
+struct FrameRingHeader
+{
+  uint32_t m_Magic;
+  uint32_t m_Version;
+  //! The offset of the first slot and the distance between slots in bytes.
+  uint32_t m_HeaderBytes;
+  uint32_t m_SlotBytes;
+  uint32_t m_SlotCount;
+  //! The number of vertices along the x and z axes of a frame.
+  uint32_t m_XVertices;
+  uint32_t m_ZVertices;
+  //! The number of floats in a vertex. They are the position (x, y, z, w)
+  // and the normal (x, y, z, w) of WaterFFT::Vertex.
+  uint32_t m_VertexFloats;
+  //! The length of the mesh on the x and z axes in meters.
+  float m_XLength;
+  float m_ZLength;
+  //! The number of frames published. Frame f is in slot f % m_SlotCount.
+  std::atomic<uint64_t> m_Published;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// The start of a slot. The slot is guarded by a seqlock. The publisher
+/// makes m_Sequence odd before it writes the slot and even after. A reader
+/// copies the slot and only keeps the copy if m_Sequence was the same even
+/// value before and after.
+///////////////////////////////////////////////////////////////////////////////
+struct FrameSlotHeader
+{
+  std::atomic<uint64_t> m_Sequence;
+  //! The frame number and the simulation time of the frame in seconds.
+  uint64_t m_Frame;
+  double m_Time;
+};
+
+static_assert(sizeof(FrameSlotHeader) <= FRAME_RING_ALIGNMENT,
+  "The slot header must fit before the vertices.");
+
+// Rounds a size up to FRAME_RING_ALIGNMENT.
+inline uint32_t FrameRingAlign(uint64_t bytes)
+{
+  return (uint32_t)((bytes + FRAME_RING_ALIGNMENT - 1) /
+    FRAME_RING_ALIGNMENT * FRAME_RING_ALIGNMENT);
+}
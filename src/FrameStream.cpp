@@ -0,0 +1,604 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file FrameStream.cpp
+/// @date 2026-10-17
+///
+/// @brief Contains the implementation of the compressed frame stream.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+#include "Error.h"
+
+#include "FrameStream.h"
+
+#define LZ_MIN_MATCH 4
+#define LZ_MAX_OFFSET 65535
+#define LZ_HASH_BITS 14
+#define LZ_NO_POSITION UINT32_MAX
+// The largest length that fits in half of a token.
+#define LZ_TOKEN_LENGTH 15
+
+// CODEC //////////////////////////////////////////////////////////////////////
+
+// Adds a length that did not fit in its half of a token.
+static void LzLength(std::vector<unsigned char> * out, size_t length)
+{
+  length -= LZ_TOKEN_LENGTH;
+  while (length >= 255)
+  {
+    out->push_back(255);
+    length -= 255;
+  }
+  out->push_back((unsigned char)length);
+}
+
+// Adds literals followed by a match. A match length of zero adds only the
+// literals, which is how every block ends.
+static void LzSequence(std::vector<unsigned char> * out,
+  const unsigned char * literals, size_t literal_count, size_t offset,
+  size_t match_length)
+{
+  size_t match_code = match_length ? match_length - LZ_MIN_MATCH : 0;
+  unsigned char token = (unsigned char)(
+    (std::min<size_t>(literal_count, LZ_TOKEN_LENGTH) << 4) |
+    std::min<size_t>(match_code, LZ_TOKEN_LENGTH));
+  out->push_back(token);
+  if (literal_count >= LZ_TOKEN_LENGTH)
+    LzLength(out, literal_count);
+  out->insert(out->end(), literals, literals + literal_count);
+  if (!match_length)
+    return;
+  out->push_back((unsigned char)offset);
+  out->push_back((unsigned char)(offset >> 8));
+  if (match_code >= LZ_TOKEN_LENGTH)
+    LzLength(out, match_code);
+}
+
+// Compresses a block with an LZ4 style codec. Each sequence is a token
+// holding the literal count and match length, the literals, a two byte
+// offset back into the output, and the rest of the match length. Matches
+// are found with a single hash table of four byte sequences.
+static void LzCompress(const unsigned char * in, size_t size,
+  std::vector<unsigned char> * out)
+{
+  out->clear();
+  std::vector<uint32_t> table(1u << LZ_HASH_BITS, LZ_NO_POSITION);
+  size_t anchor = 0;
+  size_t i = 0;
+  while (i + LZ_MIN_MATCH <= size)
+  {
+    uint32_t sequence;
+    memcpy(&sequence, in + i, LZ_MIN_MATCH);
+    uint32_t hash = (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+    uint32_t candidate = table[hash];
+    table[hash] = (uint32_t)i;
+    if (candidate == LZ_NO_POSITION || i - candidate > LZ_MAX_OFFSET ||
+      memcmp(in + candidate, in + i, LZ_MIN_MATCH))
+    {
+      ++i;
+      continue;
+    }
+    size_t length = LZ_MIN_MATCH;
+    while (i + length < size && in[candidate + length] == in[i + length])
+      ++length;
+    LzSequence(out, in + anchor, i - anchor, i - candidate, length);
+    i += length;
+    anchor = i;
+  }
+  LzSequence(out, in + anchor, size - anchor, 0, 0);
+}
+
+// Reads a length that did not fit in its half of a token.
+static bool LzReadLength(const unsigned char * in, size_t size, size_t * at,
+  size_t * length)
+{
+  unsigned char byte;
+  do {
+    if (*at >= size)
+      return false;
+    byte = in[(*at)++];
+    *length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+// Reverses LzCompress. Returns false if the block is damaged or does not
+// decompress to exactly out_size bytes.
+static bool LzDecompress(const unsigned char * in, size_t size,
+  unsigned char * out, size_t out_size)
+{
+  size_t at = 0;
+  size_t written = 0;
+  while (at < size)
+  {
+    unsigned char token = in[at++];
+    size_t literal_count = token >> 4;
+    if (literal_count == LZ_TOKEN_LENGTH &&
+      !LzReadLength(in, size, &at, &literal_count))
+      return false;
+    if (literal_count > size - at || literal_count > out_size - written)
+      return false;
+    memcpy(out + written, in + at, literal_count);
+    at += literal_count;
+    written += literal_count;
+    if (at == size)
+      break;
+
+    if (size - at < 2)
+      return false;
+    size_t offset = in[at] | ((size_t)in[at + 1] << 8);
+    at += 2;
+    size_t length = token & LZ_TOKEN_LENGTH;
+    if (length == LZ_TOKEN_LENGTH && !LzReadLength(in, size, &at, &length))
+      return false;
+    length += LZ_MIN_MATCH;
+    if (offset == 0 || offset > written || length > out_size - written)
+      return false;
+    // The match may overlap the bytes it is writing, so it is copied one
+    // byte at a time.
+    const unsigned char * from = out + written - offset;
+    for (size_t i = 0; i < length; ++i)
+      out[written + i] = from[i];
+    written += length;
+  }
+  return written == out_size;
+}
+
+// PREDICTION /////////////////////////////////////////////////////////////////
+
+// The integers are kept unsigned so every operation wraps the same way in
+// the writer and the reader.
+static uint32_t Quantize(float value, float step)
+{
+  double scaled = std::floor((double)value / step + 0.5);
+  if (!(scaled >= (double)INT32_MIN))
+    scaled = scaled != scaled ? 0.0 : (double)INT32_MIN;
+  scaled = std::min(scaled, (double)INT32_MAX);
+  return (uint32_t)(int32_t)scaled;
+}
+
+static uint32_t Predict(uint32_t prediction, uint32_t previous,
+  uint32_t older)
+{
+  if (prediction == FRAME_STREAM_PREDICT_LINEAR)
+    return 2u * previous - older;
+  if (prediction == FRAME_STREAM_PREDICT_PREVIOUS)
+    return previous;
+  return 0;
+}
+
+// Maps small negative and positive values to small unsigned values.
+static uint32_t ZigZag(uint32_t value)
+{
+  return (value << 1) ^ (0u - (value >> 31));
+}
+
+static uint32_t UnZigZag(uint32_t value)
+{
+  return (value >> 1) ^ (0u - (value & 1u));
+}
+
+// The step each channel is quantized with. Displacements use the position
+// step and normals use the normal step.
+static float ChannelStep(const FrameStreamHeader & header, unsigned channel)
+{
+  return channel < 3 ? header.m_PositionStep : header.m_NormalStep;
+}
+
+// FRAMESTREAMWRITER //////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Creates a stream file and writes its header. An existing file is
+/// replaced.
+///
+/// @param filename The file to write.
+/// @param x_vertices The number of vertices on the x axis of each frame.
+/// @param z_vertices The number of vertices on the z axis of each frame.
+/// @param x_length The length of the mesh in the x direction in meters.
+/// @param z_length The length of the mesh in the z direction in meters.
+/// @param keyframe_interval The frames from one keyframe to the next.
+/// @param position_step The precision of positions in meters.
+/// @param normal_step The precision of each component of the normals.
+///////////////////////////////////////////////////////////////////////////////
+FrameStreamWriter::FrameStreamWriter(const std::string & filename,
+  unsigned x_vertices, unsigned z_vertices, float x_length, float z_length,
+  unsigned keyframe_interval, float position_step, float normal_step) :
+  m_Filename(filename), m_Bytes(0)
+{
+  m_Header.m_Magic = FRAME_STREAM_MAGIC;
+  m_Header.m_Version = FRAME_STREAM_VERSION;
+  m_Header.m_XVertices = x_vertices;
+  m_Header.m_ZVertices = z_vertices;
+  m_Header.m_XLength = x_length;
+  m_Header.m_ZLength = z_length;
+  m_Header.m_PositionStep = position_step;
+  m_Header.m_NormalStep = normal_step;
+  m_Header.m_KeyframeInterval = std::max(keyframe_interval, 1u);
+  m_Header.m_Reserved = 0;
+  m_File.open(filename, std::ios::binary | std::ios::trunc);
+  m_File.write((const char *)&m_Header, sizeof(m_Header));
+  if (!m_File)
+  {
+    Error error("FrameStream.cpp", "FrameStreamWriter::FrameStreamWriter");
+    error.Add("Could not create " + filename + ".");
+    throw(error);
+  }
+  m_Bytes = sizeof(m_Header);
+  size_t values = (size_t)x_vertices * z_vertices * FRAME_STREAM_CHANNELS;
+  m_Current.resize(values);
+  m_Previous.resize(values);
+  m_Older.resize(values);
+  m_Planes.resize(values * sizeof(uint32_t));
+}
+
+FrameStreamWriter::~FrameStreamWriter()
+{
+  Close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Compresses a frame and appends it to the file.
+///
+/// @param vertices The frame in the WaterFFT vertex layout.
+/// @param time The simulation time of the frame in seconds.
+///////////////////////////////////////////////////////////////////////////////
+void FrameStreamWriter::Write(const void * vertices, double time)
+{
+  if (!m_File.is_open() ||
+    (!m_Entries.empty() && time <= m_Entries.back().m_Time))
+    return;
+
+  // Quantize the displacements and normals.
+  const float * vertex = (const float *)vertices;
+  size_t count = (size_t)m_Header.m_XVertices * m_Header.m_ZVertices;
+  float dx = m_Header.m_XLength / (float)(m_Header.m_XVertices - 1);
+  float dz = m_Header.m_ZLength / (float)(m_Header.m_ZVertices - 1);
+  float steps[FRAME_STREAM_CHANNELS];
+  for (unsigned c = 0; c < FRAME_STREAM_CHANNELS; ++c)
+    steps[c] = ChannelStep(m_Header, c);
+  size_t i = 0;
+  for (unsigned z = 0; z < m_Header.m_ZVertices; ++z)
+  {
+    float rest_z = (float)z * dz - m_Header.m_ZLength / 2.0f;
+    for (unsigned x = 0; x < m_Header.m_XVertices; ++x)
+    {
+      float rest_x = (float)x * dx - m_Header.m_XLength / 2.0f;
+      float values[FRAME_STREAM_CHANNELS] = { vertex[0] - rest_x, vertex[1],
+        vertex[2] - rest_z, vertex[4], vertex[5], vertex[6] };
+      for (unsigned c = 0; c < FRAME_STREAM_CHANNELS; ++c)
+        m_Current[c * count + i] = Quantize(values[c], steps[c]);
+      vertex += FRAME_STREAM_VERTEX_FLOATS;
+      ++i;
+    }
+  }
+
+  // Find the differences from the prediction and split them into planes.
+  unsigned since_keyframe =
+    (unsigned)(m_Entries.size() % m_Header.m_KeyframeInterval);
+  uint32_t prediction = FRAME_STREAM_PREDICT_LINEAR;
+  if (since_keyframe == 0)
+    prediction = FRAME_STREAM_PREDICT_NONE;
+  else if (since_keyframe == 1)
+    prediction = FRAME_STREAM_PREDICT_PREVIOUS;
+  size_t values = m_Current.size();
+  unsigned char * plane_0 = m_Planes.data();
+  unsigned char * plane_1 = plane_0 + values;
+  unsigned char * plane_2 = plane_1 + values;
+  unsigned char * plane_3 = plane_2 + values;
+  for (size_t v = 0; v < values; ++v)
+  {
+    uint32_t difference = ZigZag(m_Current[v] -
+      Predict(prediction, m_Previous[v], m_Older[v]));
+    plane_0[v] = (unsigned char)difference;
+    plane_1[v] = (unsigned char)(difference >> 8);
+    plane_2[v] = (unsigned char)(difference >> 16);
+    plane_3[v] = (unsigned char)(difference >> 24);
+  }
+  LzCompress(m_Planes.data(), m_Planes.size(), &m_Compressed);
+
+  FrameStreamRecord record;
+  record.m_Magic = FRAME_STREAM_RECORD_MAGIC;
+  record.m_Prediction = prediction;
+  record.m_Time = time;
+  record.m_Bytes = (uint32_t)m_Compressed.size();
+  record.m_Reserved = 0;
+  FrameStreamEntry entry;
+  entry.m_Offset = m_Bytes;
+  entry.m_Time = time;
+  entry.m_Prediction = prediction;
+  entry.m_Reserved = 0;
+  m_File.write((const char *)&record, sizeof(record));
+  m_File.write((const char *)m_Compressed.data(), m_Compressed.size());
+  if (!m_File)
+  {
+    m_File.close();
+    Error error("FrameStream.cpp", "FrameStreamWriter::Write");
+    error.Add("Could not write to " + m_Filename + ".");
+    throw(error);
+  }
+  m_Bytes += sizeof(record) + m_Compressed.size();
+  m_Entries.push_back(entry);
+  m_Older.swap(m_Previous);
+  m_Previous.swap(m_Current);
+}
+
+//! Writes the entries that make the stream seekable and closes the file.
+void FrameStreamWriter::Close()
+{
+  if (!m_File.is_open())
+    return;
+  FrameStreamTrailer trailer;
+  trailer.m_Entries = m_Bytes;
+  trailer.m_Count = (uint32_t)m_Entries.size();
+  trailer.m_Magic = FRAME_STREAM_TRAILER_MAGIC;
+  m_File.write((const char *)m_Entries.data(),
+    m_Entries.size() * sizeof(FrameStreamEntry));
+  m_File.write((const char *)&trailer, sizeof(trailer));
+  m_File.close();
+}
+
+unsigned FrameStreamWriter::XVertices() const
+{
+  return m_Header.m_XVertices;
+}
+
+unsigned FrameStreamWriter::ZVertices() const
+{
+  return m_Header.m_ZVertices;
+}
+
+//! The number of frames written.
+unsigned FrameStreamWriter::Frames() const
+{
+  return (unsigned)m_Entries.size();
+}
+
+//! The bytes written so far, not counting the entries added by Close.
+uint64_t FrameStreamWriter::Bytes() const
+{
+  return m_Bytes;
+}
+
+// FRAMESTREAMREADER //////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Opens a stream file and finds its frames.
+///
+/// @param filename The file made by a FrameStreamWriter.
+///////////////////////////////////////////////////////////////////////////////
+FrameStreamReader::FrameStreamReader(const std::string & filename) :
+  m_Filename(filename), m_Decoded(UINT32_MAX), m_PreviousValid(false)
+{
+  m_File.open(filename, std::ios::binary);
+  m_File.read((char *)&m_Header, sizeof(m_Header));
+  if (!m_File || m_Header.m_Magic != FRAME_STREAM_MAGIC ||
+    m_Header.m_Version != FRAME_STREAM_VERSION ||
+    m_Header.m_XVertices < 2 || m_Header.m_ZVertices < 2)
+  {
+    Error error("FrameStream.cpp", "FrameStreamReader::FrameStreamReader");
+    error.Add(filename + " is not a frame stream.");
+    throw(error);
+  }
+  FindFrames();
+  if (m_Entries.empty())
+  {
+    Error error("FrameStream.cpp", "FrameStreamReader::FrameStreamReader");
+    error.Add(filename + " has no frames.");
+    throw(error);
+  }
+  size_t values = (size_t)m_Header.m_XVertices * m_Header.m_ZVertices *
+    FRAME_STREAM_CHANNELS;
+  m_Current.resize(values);
+  m_Previous.resize(values);
+  m_Older.resize(values);
+  m_Planes.resize(values * sizeof(uint32_t));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Decodes a frame.
+///
+/// @param frame The frame. It must be less than Frames().
+/// @param vertices Where the frame is written in the WaterFFT vertex layout.
+///   This can be memory mapped from the gpu since it is only written.
+///////////////////////////////////////////////////////////////////////////////
+void FrameStreamReader::Read(unsigned frame, void * vertices)
+{
+  if (frame == m_Decoded)
+  {
+    WriteVertices(m_Current, vertices);
+    return;
+  }
+  if (m_PreviousValid && frame + 1 == m_Decoded)
+  {
+    WriteVertices(m_Previous, vertices);
+    return;
+  }
+  // Decoding has to start from a keyframe unless the frame is ahead of the
+  // last one decoded in the same run of frames.
+  unsigned start = frame;
+  while (m_Entries[start].m_Prediction != FRAME_STREAM_PREDICT_NONE &&
+    start > 0)
+    --start;
+  if (m_Decoded != UINT32_MAX && m_Decoded < frame && m_Decoded >= start)
+    start = m_Decoded + 1;
+  else
+    m_Decoded = UINT32_MAX;
+  for (unsigned f = start; f <= frame; ++f)
+    Decode(f);
+  WriteVertices(m_Current, vertices);
+}
+
+//! The last frame at or before a time. The first frame is given for times
+// before it.
+unsigned FrameStreamReader::FrameAt(double time) const
+{
+  std::vector<FrameStreamEntry>::const_iterator after = std::upper_bound(
+    m_Entries.begin(), m_Entries.end(), time,
+    [](double t, const FrameStreamEntry & entry)
+    { return t < entry.m_Time; });
+  if (after == m_Entries.begin())
+    return 0;
+  return (unsigned)(after - m_Entries.begin()) - 1;
+}
+
+//! The simulation time of a frame in seconds.
+double FrameStreamReader::FrameTime(unsigned frame) const
+{
+  return m_Entries[frame].m_Time;
+}
+
+unsigned FrameStreamReader::Frames() const
+{
+  return (unsigned)m_Entries.size();
+}
+
+unsigned FrameStreamReader::XVertices() const
+{
+  return m_Header.m_XVertices;
+}
+
+unsigned FrameStreamReader::ZVertices() const
+{
+  return m_Header.m_ZVertices;
+}
+
+float FrameStreamReader::XLength() const
+{
+  return m_Header.m_XLength;
+}
+
+float FrameStreamReader::ZLength() const
+{
+  return m_Header.m_ZLength;
+}
+
+// Reads the entries written by Close. When they are missing, the records
+// are walked from the start instead and a damaged record ends the stream.
+void FrameStreamReader::FindFrames()
+{
+  m_File.seekg(0, std::ios::end);
+  uint64_t size = (uint64_t)m_File.tellg();
+  FrameStreamTrailer trailer;
+  trailer.m_Magic = 0;
+  if (size >= sizeof(m_Header) + sizeof(trailer))
+  {
+    m_File.seekg(size - sizeof(trailer));
+    m_File.read((char *)&trailer, sizeof(trailer));
+  }
+  if (m_File && trailer.m_Magic == FRAME_STREAM_TRAILER_MAGIC &&
+    trailer.m_Entries + (uint64_t)trailer.m_Count * sizeof(FrameStreamEntry)
+    + sizeof(trailer) == size)
+  {
+    m_Entries.resize(trailer.m_Count);
+    m_File.seekg(trailer.m_Entries);
+    m_File.read((char *)m_Entries.data(),
+      m_Entries.size() * sizeof(FrameStreamEntry));
+    if (m_File)
+      return;
+    m_Entries.clear();
+  }
+
+  m_File.clear();
+  uint64_t offset = sizeof(m_Header);
+  while (offset + sizeof(FrameStreamRecord) <= size)
+  {
+    FrameStreamRecord record;
+    m_File.seekg(offset);
+    m_File.read((char *)&record, sizeof(record));
+    if (!m_File || record.m_Magic != FRAME_STREAM_RECORD_MAGIC ||
+      offset + sizeof(record) + record.m_Bytes > size)
+      break;
+    FrameStreamEntry entry;
+    entry.m_Offset = offset;
+    entry.m_Time = record.m_Time;
+    entry.m_Prediction = record.m_Prediction;
+    entry.m_Reserved = 0;
+    m_Entries.push_back(entry);
+    offset += sizeof(record) + record.m_Bytes;
+  }
+  m_File.clear();
+}
+
+// Decodes the frame after the last one decoded, or any keyframe.
+void FrameStreamReader::Decode(unsigned frame)
+{
+  const FrameStreamEntry & entry = m_Entries[frame];
+  FrameStreamRecord record;
+  m_File.seekg(entry.m_Offset);
+  m_File.read((char *)&record, sizeof(record));
+  bool valid = m_File && record.m_Magic == FRAME_STREAM_RECORD_MAGIC;
+  if (valid)
+  {
+    m_Compressed.resize(record.m_Bytes);
+    m_File.read((char *)m_Compressed.data(), record.m_Bytes);
+    valid = m_File && LzDecompress(m_Compressed.data(), m_Compressed.size(),
+      m_Planes.data(), m_Planes.size());
+  }
+  if (!valid)
+  {
+    m_File.clear();
+    m_Decoded = UINT32_MAX;
+    m_PreviousValid = false;
+    Error error("FrameStream.cpp", "FrameStreamReader::Decode");
+    error.Add("Frame " + std::to_string(frame) + " of " + m_Filename +
+      " is damaged.");
+    throw(error);
+  }
+
+  // The new frame is built in the oldest buffer, which is no longer needed.
+  size_t values = m_Current.size();
+  const unsigned char * plane_0 = m_Planes.data();
+  const unsigned char * plane_1 = plane_0 + values;
+  const unsigned char * plane_2 = plane_1 + values;
+  const unsigned char * plane_3 = plane_2 + values;
+  for (size_t v = 0; v < values; ++v)
+  {
+    uint32_t difference = (uint32_t)plane_0[v] |
+      ((uint32_t)plane_1[v] << 8) | ((uint32_t)plane_2[v] << 16) |
+      ((uint32_t)plane_3[v] << 24);
+    m_Older[v] = Predict(record.m_Prediction, m_Current[v], m_Previous[v]) +
+      UnZigZag(difference);
+  }
+  m_Previous.swap(m_Older);
+  m_Current.swap(m_Previous);
+  m_PreviousValid = m_Decoded != UINT32_MAX;
+  m_Decoded = frame;
+}
+
+// Turns the integers of a frame back into vertices.
+void FrameStreamReader::WriteVertices(const std::vector<uint32_t> & values,
+  void * vertices) const
+{
+  float * vertex = (float *)vertices;
+  size_t count = (size_t)m_Header.m_XVertices * m_Header.m_ZVertices;
+  float dx = m_Header.m_XLength / (float)(m_Header.m_XVertices - 1);
+  float dz = m_Header.m_ZLength / (float)(m_Header.m_ZVertices - 1);
+  float steps[FRAME_STREAM_CHANNELS];
+  for (unsigned c = 0; c < FRAME_STREAM_CHANNELS; ++c)
+    steps[c] = ChannelStep(m_Header, c);
+  size_t i = 0;
+  for (unsigned z = 0; z < m_Header.m_ZVertices; ++z)
+  {
+    float rest_z = (float)z * dz - m_Header.m_ZLength / 2.0f;
+    for (unsigned x = 0; x < m_Header.m_XVertices; ++x)
+    {
+      float rest_x = (float)x * dx - m_Header.m_XLength / 2.0f;
+      float channel[FRAME_STREAM_CHANNELS];
+      for (unsigned c = 0; c < FRAME_STREAM_CHANNELS; ++c)
+        channel[c] = (float)(int32_t)values[c * count + i] * steps[c];
+      vertex[0] = rest_x + channel[0];
+      vertex[1] = channel[1];
+      vertex[2] = rest_z + channel[2];
+      vertex[3] = 0.0f;
+      vertex[4] = channel[3];
+      vertex[5] = channel[4];
+      vertex[6] = channel[5];
+      vertex[7] = 0.0f;
+      vertex += FRAME_STREAM_VERTEX_FLOATS;
+      ++i;
+    }
+  }
+}
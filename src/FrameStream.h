@@ -0,0 +1,181 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file FrameStream.h
+/// @date 2026-10-17
+///
+/// @brief Contains the interface for recording ocean frames to a compressed
+/// file and playing them back.
+///
+/// A stream is a FrameStreamHeader followed by one FrameStreamRecord and its
+/// payload per frame. Closing the writer adds a FrameStreamEntry per frame
+/// and a FrameStreamTrailer so readers can seek. A stream that was never
+/// closed is still readable. The reader finds the frames by walking the
+/// records instead.
+///
+/// Each vertex is stored as six integers: the displacement of the position
+/// from its rest position in x, y, and z divided by the position step and
+/// the normal divided by the normal step. A frame stores the difference
+/// between its integers and a prediction made from the frames before it.
+/// Keyframes predict zero, the frame after a keyframe predicts the previous
+/// frame, and every other frame predicts 2 * previous - older. The
+/// differences are zigzag encoded, split into byte planes so the mostly
+/// zero high bytes are together, and compressed with an LZ4 style codec.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#define FRAME_STREAM_MAGIC 0x53465457u
+#define FRAME_STREAM_RECORD_MAGIC 0x46524657u
+#define FRAME_STREAM_TRAILER_MAGIC 0x58444957u
+#define FRAME_STREAM_VERSION 1u
+//! The floats in a vertex. This matches the WaterFFT vertex layout.
+#define FRAME_STREAM_VERTEX_FLOATS 8
+//! The integers stored for each vertex.
+#define FRAME_STREAM_CHANNELS 6
+//! The frames between keyframes. This bounds the frames decoded by a seek.
+#define FRAME_STREAM_KEYFRAME_INTERVAL 30
+//! One millimeter.
+#define FRAME_STREAM_POSITION_STEP 0.001f
+#define FRAME_STREAM_NORMAL_STEP (1.0f / 4096.0f)
+
+// The predictions a frame can be stored against.
+#define FRAME_STREAM_PREDICT_NONE 0u
+#define FRAME_STREAM_PREDICT_PREVIOUS 1u
+#define FRAME_STREAM_PREDICT_LINEAR 2u
+
+struct FrameStreamHeader
+{
+  uint32_t m_Magic;
+  uint32_t m_Version;
+  uint32_t m_XVertices;
+  uint32_t m_ZVertices;
+  float m_XLength;
+  float m_ZLength;
+  float m_PositionStep;
+  float m_NormalStep;
+  uint32_t m_KeyframeInterval;
+  uint32_t m_Reserved;
+};
+
+//! Comes before the compressed payload of every frame.
+struct FrameStreamRecord
+{
+  uint32_t m_Magic;
+  //! One of the FRAME_STREAM_PREDICT values.
+  uint32_t m_Prediction;
+  //! The simulation time of the frame in seconds.
+  double m_Time;
+  //! The bytes of payload that follow.
+  uint32_t m_Bytes;
+  uint32_t m_Reserved;
+};
+
+//! The location of a frame in the file.
+struct FrameStreamEntry
+{
+  uint64_t m_Offset;
+  double m_Time;
+  uint32_t m_Prediction;
+  uint32_t m_Reserved;
+};
+
+//! The last bytes of a closed stream.
+struct FrameStreamTrailer
+{
+  //! Where the entries start.
+  uint64_t m_Entries;
+  uint32_t m_Count;
+  uint32_t m_Magic;
+};
+
+static_assert(sizeof(FrameStreamHeader) == 40, "Unexpected header size.");
+static_assert(sizeof(FrameStreamRecord) == 24, "Unexpected record size.");
+static_assert(sizeof(FrameStreamEntry) == 24, "Unexpected entry size.");
+static_assert(sizeof(FrameStreamTrailer) == 16, "Unexpected trailer size.");
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Appends frames to a stream file. See the top of FrameStream.h for the
+/// format.
+///
+/// Important Notes
+/// - Frames must be written in order of time. Frames that are not after the
+///   last one are skipped.
+/// - The stream is only seekable without a scan after Close.
+///////////////////////////////////////////////////////////////////////////////
+class FrameStreamWriter
+{
+public:
+  FrameStreamWriter(const std::string & filename, unsigned x_vertices,
+    unsigned z_vertices, float x_length, float z_length,
+    unsigned keyframe_interval = FRAME_STREAM_KEYFRAME_INTERVAL,
+    float position_step = FRAME_STREAM_POSITION_STEP,
+    float normal_step = FRAME_STREAM_NORMAL_STEP);
+  ~FrameStreamWriter();
+  FrameStreamWriter(const FrameStreamWriter & other) = delete;
+  FrameStreamWriter & operator=(const FrameStreamWriter & other) = delete;
+  void Write(const void * vertices, double time);
+  void Close();
+  unsigned XVertices() const;
+  unsigned ZVertices() const;
+  unsigned Frames() const;
+  uint64_t Bytes() const;
+private:
+  std::string m_Filename;
+  std::ofstream m_File;
+  FrameStreamHeader m_Header;
+  std::vector<FrameStreamEntry> m_Entries;
+  //! The integers of the last two frames.
+  std::vector<uint32_t> m_Previous;
+  std::vector<uint32_t> m_Older;
+  std::vector<uint32_t> m_Current;
+  //! The planes before and after compression.
+  std::vector<unsigned char> m_Planes;
+  std::vector<unsigned char> m_Compressed;
+  //! The bytes written so far.
+  uint64_t m_Bytes;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Decodes frames from a stream file. Reading the frame after the last one
+/// read decodes a single frame. Any other frame is found by decoding from
+/// the keyframe before it.
+///////////////////////////////////////////////////////////////////////////////
+class FrameStreamReader
+{
+public:
+  FrameStreamReader(const std::string & filename);
+  FrameStreamReader(const FrameStreamReader & other) = delete;
+  FrameStreamReader & operator=(const FrameStreamReader & other) = delete;
+  void Read(unsigned frame, void * vertices);
+  unsigned FrameAt(double time) const;
+  double FrameTime(unsigned frame) const;
+  unsigned Frames() const;
+  unsigned XVertices() const;
+  unsigned ZVertices() const;
+  float XLength() const;
+  float ZLength() const;
+private:
+  void FindFrames();
+  void Decode(unsigned frame);
+  void WriteVertices(const std::vector<uint32_t> & values,
+    void * vertices) const;
+  std::string m_Filename;
+  std::ifstream m_File;
+  FrameStreamHeader m_Header;
+  std::vector<FrameStreamEntry> m_Entries;
+  //! The integers of the last frame decoded and the frame before it.
+  std::vector<uint32_t> m_Current;
+  std::vector<uint32_t> m_Previous;
+  std::vector<uint32_t> m_Older;
+  //! The last frame decoded. UINT32_MAX when none has been.
+  unsigned m_Decoded;
+  //! Identifies whether m_Previous holds the frame before m_Decoded.
+  bool m_PreviousValid;
+  std::vector<unsigned char> m_Planes;
+  std::vector<unsigned char> m_Compressed;
+};
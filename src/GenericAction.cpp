@@ -1,56 +1,277 @@
-//////////////////////////////////////////////////////////////////////////////
-/// @file GenericAction.cpp
-/// @author Connor Deakin
-/// @email connor.deakin@digipen.edu
-/// @date 2017-07-09
-///
-/// @brief Contains the implementation of the GenericAction.
-///////////////////////////////////////////////////////////////////////////////
-
-#include "GenericAction.h"
-
-// static initializations
-std::list<GenericAction *> GenericAction::m_AllActions = 
-  std::list<GenericAction *>();
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Constructor for the GenericAction.
-///////////////////////////////////////////////////////////////////////////////
-GenericAction::GenericAction() : m_Done(false)
-{}
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Updates All existing Actions.
-///////////////////////////////////////////////////////////////////////////////
-void GenericAction::UpdateAll()
-{
-  // needs to be modified iterator invalidation - using list for now
-  // Set an Actions to destory list.
-  // not many actions at once
-  std::list<GenericAction *>::iterator it = m_AllActions.begin();
-  std::list<GenericAction *>::iterator it_e = m_AllActions.end();
-  // updating all actions
-  while (it != it_e) {
-    (*it)->Update();
-    if ((*it)->m_Done) {
-      delete (*it);
-      m_AllActions.erase(it);
-    }
-    ++it;
-  }
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Destroys all existing Actions whether they are done or not.
-///////////////////////////////////////////////////////////////////////////////
-void GenericAction::DestroyAll()
-{
-  std::list<GenericAction *>::iterator it = m_AllActions.begin();
-  std::list<GenericAction *>::iterator it_e = m_AllActions.end();
-  // deleting all actions
-  while (it != it_e) {
-    delete (*it);
-    ++it;
-  }
-  m_AllActions.clear();
-}
\ No newline at end of file
+//////////////////////////////////////////////////////////////////////////////
+/// @file GenericAction.cpp
+/// @author Connor Deakin
+/// @email connor.deakin@digipen.edu
+/// @date 2017-07-09
+///
+/// @brief Contains the implementation of the GenericAction.
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ACTION_SSE
+#include <emmintrin.h>
+#endif
+
+#include "Time.h"
+#include "Action.hpp"
+
+#include "GenericAction.h"
+
+//! Used to mark the index of an id that is not in use.
+#define INVALID_INDEX 0xFFFFFFFF
+
+// ACTIONHANDLE ///////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Creates a handle that does not refer to any Action.
+///////////////////////////////////////////////////////////////////////////////
+ActionHandle::ActionHandle() :
+  m_Pool(INVALID_INDEX), m_Id(INVALID_INDEX), m_Generation(0)
+{}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Identifies whether the handle was ever given an Action. Use
+/// GenericAction::Running to find out if that Action is still running.
+///
+/// @return If the handle was created by Action<T>::Create, true.
+///////////////////////////////////////////////////////////////////////////////
+bool ActionHandle::Valid() const
+{
+  return m_Pool != INVALID_INDEX;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Creates a handle to an Action within a pool.
+///
+/// @param pool The index of the pool.
+/// @param id The id of the Action within the pool.
+/// @param generation The generation of the id.
+///////////////////////////////////////////////////////////////////////////////
+ActionHandle::ActionHandle(unsigned pool, unsigned id, unsigned generation) :
+  m_Pool(pool), m_Id(id), m_Generation(generation)
+{}
+
+// GENERICACTION //////////////////////////////////////////////////////////////
+
+// static initializations
+std::vector<GenericAction *> GenericAction::m_AllPools;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Constructor for the GenericAction. Registers the new pool so it is
+/// updated by UpdateAll.
+///////////////////////////////////////////////////////////////////////////////
+GenericAction::GenericAction() : m_PoolIndex((unsigned)m_AllPools.size())
+{
+  m_AllPools.push_back(this);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Updates All existing Actions. Each pool is updated with a single
+/// call.
+///////////////////////////////////////////////////////////////////////////////
+void GenericAction::UpdateAll()
+{
+  float time = Time::TotalTime();
+  for (GenericAction * pool : m_AllPools) {
+    if (!pool->m_Types.empty())
+      pool->Update(time);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Destroys all existing Actions whether they are done or not. The
+/// values being changed by the Actions will keep their current values.
+///////////////////////////////////////////////////////////////////////////////
+void GenericAction::DestroyAll()
+{
+  for (GenericAction * pool : m_AllPools) {
+    while (!pool->m_Types.empty())
+      pool->RemoveAction((unsigned)pool->m_Types.size() - 1);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Stops an Action before it finishes. The value being changed will
+/// keep its current value.
+///
+/// @param handle The handle returned by Action<T>::Create.
+///
+/// @return If the Action was still running and has been stopped, true.
+///////////////////////////////////////////////////////////////////////////////
+bool GenericAction::Cancel(const ActionHandle & handle)
+{
+  if (!Running(handle))
+    return false;
+  GenericAction * pool = m_AllPools[handle.m_Pool];
+  pool->RemoveAction(pool->m_IdToIndex[handle.m_Id]);
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Identifies whether the Action referred to by a handle is running.
+///
+/// @param handle The handle returned by Action<T>::Create.
+///
+/// @return If the Action has not finished and has not been canceled, true.
+///////////////////////////////////////////////////////////////////////////////
+bool GenericAction::Running(const ActionHandle & handle)
+{
+  if (handle.m_Pool >= m_AllPools.size())
+    return false;
+  const GenericAction * pool = m_AllPools[handle.m_Pool];
+  if (handle.m_Id >= pool->m_Generations.size())
+    return false;
+  return pool->m_Generations[handle.m_Id] == handle.m_Generation &&
+    pool->m_IdToIndex[handle.m_Id] != INVALID_INDEX;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Counts the Actions that are running across all pools.
+///
+/// @return The number of running Actions.
+///////////////////////////////////////////////////////////////////////////////
+unsigned GenericAction::RunningCount()
+{
+  unsigned count = 0;
+  for (const GenericAction * pool : m_AllPools)
+    count += (unsigned)pool->m_Types.size();
+  return count;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Adds the type independent values of a new Action to the end of the
+/// pool and gives it an id. The derived pool must add its own values at the
+/// same index.
+///
+/// @param start_time The time at which the Action begins.
+/// @param time The amount of time the Action must take. Must be positive.
+/// @param type The ease type of the Action.
+///
+/// @return The handle for the new Action.
+///////////////////////////////////////////////////////////////////////////////
+ActionHandle GenericAction::AddAction(float start_time, float time, int type)
+{
+  unsigned index = (unsigned)m_Types.size();
+  m_StartTimes.push_back(start_time);
+  m_InverseTimes.push_back(1.0f / time);
+  m_Types.push_back(type);
+  m_Scalers.push_back(0.0f);
+  // finding an id for the action
+  unsigned id;
+  if (m_FreeIds.empty()) {
+    id = (unsigned)m_IdToIndex.size();
+    m_IdToIndex.push_back(index);
+    m_Generations.push_back(0);
+  }
+  else {
+    id = m_FreeIds.back();
+    m_FreeIds.pop_back();
+    m_IdToIndex[id] = index;
+  }
+  m_IndexToId.push_back(id);
+  return ActionHandle(m_PoolIndex, id, m_Generations[id]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Finds the percentage of travel reached by every Action in the pool
+/// and stores it in m_Scalers. All of the ease types are evaluated without
+/// branching so four Actions are processed at once when SSE2 is available.
+///
+/// @param time The current total time.
+///////////////////////////////////////////////////////////////////////////////
+void GenericAction::ComputeScalers(float time)
+{
+  unsigned size = (unsigned)m_Types.size();
+  const float * start_times = m_StartTimes.data();
+  const float * inverse_times = m_InverseTimes.data();
+  const int * types = m_Types.data();
+  float * scalers = m_Scalers.data();
+  unsigned i = 0;
+#ifdef ACTION_SSE
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 two = _mm_set1_ps(2.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 now = _mm_set1_ps(time);
+  for (; i + 4 <= size; i += 4) {
+    __m128 p = _mm_mul_ps(_mm_sub_ps(now, _mm_loadu_ps(start_times + i)),
+      _mm_loadu_ps(inverse_times + i));
+    p = _mm_min_ps(_mm_max_ps(p, zero), one);
+    __m128 ip = _mm_sub_ps(one, p);
+    // every ease type is computed and the correct one is selected
+    __m128 quad_out = _mm_mul_ps(p, p);
+    __m128 quad_in = _mm_sub_ps(one, _mm_mul_ps(ip, ip));
+    __m128 first_half = _mm_mul_ps(two, quad_out);
+    __m128 second_half = _mm_sub_ps(one, _mm_mul_ps(two, _mm_mul_ps(ip, ip)));
+    __m128 in_first = _mm_cmplt_ps(p, half);
+    __m128 quad_out_in = _mm_or_ps(_mm_and_ps(in_first, first_half),
+      _mm_andnot_ps(in_first, second_half));
+    __m128i t = _mm_loadu_si128((const __m128i *)(types + i));
+    __m128 is_quad_out = _mm_castsi128_ps(
+      _mm_cmpeq_epi32(t, _mm_set1_epi32(QUADOUT)));
+    __m128 is_quad_in = _mm_castsi128_ps(
+      _mm_cmpeq_epi32(t, _mm_set1_epi32(QUADIN)));
+    __m128 is_quad_out_in = _mm_castsi128_ps(
+      _mm_cmpeq_epi32(t, _mm_set1_epi32(QUADOUTIN)));
+    __m128 result = p;
+    result = _mm_or_ps(_mm_and_ps(is_quad_out, quad_out),
+      _mm_andnot_ps(is_quad_out, result));
+    result = _mm_or_ps(_mm_and_ps(is_quad_in, quad_in),
+      _mm_andnot_ps(is_quad_in, result));
+    result = _mm_or_ps(_mm_and_ps(is_quad_out_in, quad_out_in),
+      _mm_andnot_ps(is_quad_out_in, result));
+    // finished actions always report exactly one
+    __m128 done = _mm_cmpge_ps(p, one);
+    result = _mm_or_ps(_mm_and_ps(done, one), _mm_andnot_ps(done, result));
+    _mm_storeu_ps(scalers + i, result);
+  }
+#endif
+  for (; i < size; ++i) {
+    float p = (time - start_times[i]) * inverse_times[i];
+    p = p < 0.0f ? 0.0f : p;
+    if (p >= 1.0f) {
+      scalers[i] = 1.0f;
+      continue;
+    }
+    float ip = 1.0f - p;
+    switch (types[i])
+    {
+    case QUADOUT: scalers[i] = p * p; break;
+    case QUADIN: scalers[i] = 1.0f - ip * ip; break;
+    case QUADOUTIN:
+      scalers[i] = p < 0.5f ? 2.0f * p * p : 1.0f - 2.0f * ip * ip; break;
+    default: scalers[i] = p; break;
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Removes an Action by moving the last Action of the pool into its
+/// place. The id of the removed Action is released.
+///
+/// @param index The index of the Action being removed.
+///////////////////////////////////////////////////////////////////////////////
+void GenericAction::RemoveAction(unsigned index)
+{
+  unsigned last = (unsigned)m_Types.size() - 1;
+  unsigned removed_id = m_IndexToId[index];
+  SwapRemove(index);
+  if (index != last) {
+    m_StartTimes[index] = m_StartTimes[last];
+    m_InverseTimes[index] = m_InverseTimes[last];
+    m_Types[index] = m_Types[last];
+    m_Scalers[index] = m_Scalers[last];
+    m_IndexToId[index] = m_IndexToId[last];
+    m_IdToIndex[m_IndexToId[index]] = index;
+  }
+  m_StartTimes.pop_back();
+  m_InverseTimes.pop_back();
+  m_Types.pop_back();
+  m_Scalers.pop_back();
+  m_IndexToId.pop_back();
+  // releasing the id
+  m_IdToIndex[removed_id] = INVALID_INDEX;
+  ++m_Generations[removed_id];
+  m_FreeIds.push_back(removed_id);
+}
@@ -1,43 +1,97 @@
-//////////////////////////////////////////////////////////////////////////////
-/// @file GenericAction.h
-/// @author Connor Deakin
-/// @email connor.deakin@digipen.edu
-/// @date 2017-07-09
-///
-/// @brief Contains the interface for a GenericAction. All Actions will
-/// identify as a GenericAction so all Actions can be acted on with a single
-/// call no matter what type the Action operates on.
-///////////////////////////////////////////////////////////////////////////////
-#pragma once
-
-#include <list>
-
-// pre-declaration
-template<typename T>
-class Action;
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief All Actions will identify as a GenericAction so all Actions can 
-/// be acted on with a single call no matter what type the Action operates on.
-///
-/// @par Important Notes
-/// - Call UpdateAll() once per frame in order to Update all existing Actions.
-/// - Call DestroyAll() to destroy all existing actions.
-///////////////////////////////////////////////////////////////////////////////
-class GenericAction
-{
-public:
-  static void UpdateAll();
-  static void DestroyAll();
-private:
-  GenericAction();
-  virtual void Update() = 0;
-  //! Determines whether the Action is done or not.
-  bool m_Done;
-  //! All of the Actions that have been created by the 
-  // Action<T>::Create function.
-  static std::list<GenericAction *> m_AllActions;
-  //! Friendng the Action calss.
-  template<typename T>
-  friend class Action;
-};
\ No newline at end of file
+//////////////////////////////////////////////////////////////////////////////
+/// @file GenericAction.h
+/// @author Connor Deakin
+/// @email connor.deakin@digipen.edu
+/// @date 2017-07-09
+///
+/// @brief Contains the interface for a GenericAction. Every Action<T> type
+/// owns a single pool that identifies as a GenericAction so all Actions can
+/// be acted on with a single call no matter what type the Action operates on.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <vector>
+
+// pre-declaration
+template<typename T>
+class Action;
+class GenericAction;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief A handle to an Action that was created with Action<T>::Create. It
+/// can be used to check whether the Action is still running or to cancel it.
+/// Handles stay safe to use after the Action finishes.
+///////////////////////////////////////////////////////////////////////////////
+class ActionHandle
+{
+public:
+  ActionHandle();
+  bool Valid() const;
+private:
+  ActionHandle(unsigned pool, unsigned id, unsigned generation);
+  //! The index of the pool that the Action lives in.
+  unsigned m_Pool;
+  //! The id of the Action within its pool.
+  unsigned m_Id;
+  //! The generation of the id when the Action was created.
+  unsigned m_Generation;
+  friend GenericAction;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief All Action pools will identify as a GenericAction so all Actions
+/// can be acted on with a single call no matter what type the Action operates
+/// on. The GenericAction stores everything about an Action that does not
+/// depend on the type of the value being changed. This data is kept in
+/// contiguous arrays so the ease values for an entire pool can be computed in
+/// one batched pass.
+///
+/// @par Important Notes
+/// - Call UpdateAll() once per frame in order to Update all existing Actions.
+/// - Call DestroyAll() to destroy all existing actions.
+/// - Finished Actions are removed by swapping the last Action into their
+///   place, so the order of Actions within a pool is not preserved.
+///////////////////////////////////////////////////////////////////////////////
+class GenericAction
+{
+public:
+  static void UpdateAll();
+  static void DestroyAll();
+  static bool Cancel(const ActionHandle & handle);
+  static bool Running(const ActionHandle & handle);
+  static unsigned RunningCount();
+protected:
+  GenericAction();
+  virtual ~GenericAction() {}
+  ActionHandle AddAction(float start_time, float time, int type);
+  void ComputeScalers(float time);
+  void RemoveAction(unsigned index);
+  virtual void Update(float time) = 0;
+  virtual void SwapRemove(unsigned index) = 0;
+  //! The time at which each Action began.
+  std::vector<float> m_StartTimes;
+  //! The inverse of the amount of time each Action must take.
+  std::vector<float> m_InverseTimes;
+  //! The ease type of each Action.
+  std::vector<int> m_Types;
+  //! The percentage of travel that each Action has reached after the most
+  // recent call to ComputeScalers. A value of 1 means the Action is done.
+  std::vector<float> m_Scalers;
+private:
+  //! The index of this pool within m_AllPools.
+  unsigned m_PoolIndex;
+  //! The id of the Action stored at each index of the pool.
+  std::vector<unsigned> m_IndexToId;
+  //! The index that each id currently refers to.
+  std::vector<unsigned> m_IdToIndex;
+  //! The generation of each id. It is bumped every time an id is released
+  // so old handles no longer refer to the new Action using that id.
+  std::vector<unsigned> m_Generations;
+  //! Ids that are not used by any Action.
+  std::vector<unsigned> m_FreeIds;
+  //! One pool for every type that Action<T>::Create has been used with.
+  static std::vector<GenericAction *> m_AllPools;
+  //! Friending the Action class.
+  template<typename T>
+  friend class Action;
+};
@@ -1,15 +1,15 @@
-#ifndef GRAPHICSTEST_H
-#define GRAPHICSTEST_H
-
-#include "Shader.h"
-#include "Camera.h"
-#include "CameraController.h"
-
-namespace GraphicsTest
-{
-  void Initialize();
-  void Update();
-
-} // !GraphicsTest
-
+#ifndef GRAPHICSTEST_H
+#define GRAPHICSTEST_H
+
+#include "Shader.h"
+#include "Camera.h"
+#include "CameraController.h"
+
+namespace GraphicsTest
+{
+  void Initialize();
+  void Update();
+
+} // !GraphicsTest
+
 #endif // !GRAPHICSTEST_H
\ No newline at end of file
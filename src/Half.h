@@ -0,0 +1,143 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file Half.h
+/// @date 2026-10-17
+///
+/// @brief Conversions between 32 bit floats and 16 bit half precision
+/// floats. Halves are only used for storage. All arithmetic is done on
+/// floats.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef HALF_H
+#define HALF_H
+
+#include <cstdint>
+#include <cstring>
+
+// The F16C instructions convert eight values at a time when they are
+// available. MSVC enables them with /arch:AVX2.
+#if defined(__F16C__) || defined(__AVX2__)
+#define HALF_F16C
+#include <immintrin.h>
+#endif
+
+typedef uint16_t Half;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Converts a float to the nearest half. Values too large for a half
+/// become infinity and values too small become zero or a subnormal.
+///
+/// @param value The float to convert.
+///
+/// @return The half.
+///////////////////////////////////////////////////////////////////////////////
+inline Half FloatToHalf(float value)
+{
+#ifdef HALF_F16C
+  return (Half)_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
+#else
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  uint32_t sign = (bits >> 16) & 0x8000;
+  uint32_t exponent = (bits >> 23) & 0xff;
+  uint32_t mantissa = bits & 0x7fffff;
+  // infinity and nan
+  if (exponent == 0xff)
+    return (Half)(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+  int half_exponent = (int)exponent - 127 + 15;
+  // too large for a half
+  if (half_exponent >= 0x1f)
+    return (Half)(sign | 0x7c00);
+  // subnormal or zero
+  if (half_exponent <= 0)
+  {
+    if (half_exponent < -10)
+      return (Half)sign;
+    mantissa |= 0x800000;
+    unsigned shift = (unsigned)(14 - half_exponent);
+    uint32_t half_mantissa = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half_mantissa & 1)))
+      ++half_mantissa;
+    return (Half)(sign | half_mantissa);
+  }
+  // normal, rounding the 13 dropped bits to nearest even. A carry out of the
+  // mantissa moves into the exponent, which is the correct result.
+  uint32_t half = sign | ((uint32_t)half_exponent << 10) | (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1fff;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    ++half;
+  return (Half)half;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Converts a half to a float. Every half is exactly representable.
+///
+/// @param value The half to convert.
+///
+/// @return The float.
+///////////////////////////////////////////////////////////////////////////////
+inline float HalfToFloat(Half value)
+{
+#ifdef HALF_F16C
+  return _cvtsh_ss(value);
+#else
+  uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+  uint32_t exponent = (value >> 10) & 0x1f;
+  uint32_t mantissa = value & 0x3ff;
+  uint32_t bits;
+  if (exponent == 0x1f)
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  else if (exponent != 0)
+    bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+  else if (mantissa == 0)
+    bits = sign;
+  else
+  {
+    // subnormal halves are normal floats
+    exponent = 127 - 15 + 1;
+    while (!(mantissa & 0x400))
+    {
+      mantissa <<= 1;
+      --exponent;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  }
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+#endif
+}
+
+// out[i] = FloatToHalf(in[i])
+inline void FloatToHalf(const float * in, Half * out, unsigned count)
+{
+  unsigned i = 0;
+#ifdef HALF_F16C
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(in + i),
+      _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128((__m128i *)(out + i), halves);
+  }
+#endif
+  for (; i < count; ++i)
+    out[i] = FloatToHalf(in[i]);
+}
+
+// out[i] = HalfToFloat(in[i])
+inline void HalfToFloat(const Half * in, float * out, unsigned count)
+{
+  unsigned i = 0;
+#ifdef HALF_F16C
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i halves = _mm_loadu_si128((const __m128i *)(in + i));
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(halves));
+  }
+#endif
+  for (; i < count; ++i)
+    out[i] = HalfToFloat(in[i]);
+}
+
+#endif // !HALF_H
@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file HeightProtocol.h
+/// @date 2026-10-17
+///
+/// @brief Contains the binary protocol spoken by the height server. This
+/// header does not depend on anything else in the project, so clients can
+/// copy it.
+///
+/// A client sends any number of requests without waiting for the responses.
+/// Responses come back in the same order. Every value is in the byte order
+/// of the machine, which is always the same machine for a Unix socket.
+///
+/// A request is a HeightRequest followed by m_Count (x, z) pairs of floats.
+/// A response is a HeightResponse followed by one array per requested field
+/// in the order height, normal, velocity:
+///   height    m_Count floats
+///   normal    m_Count (x, y, z) floats
+///   velocity  m_Count (x, y, z) floats in meters per second
+/// A response with a status other than HEIGHT_STATUS_OK has no arrays and
+/// the server closes the connection after sending it.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+
+#define HEIGHT_PROTOCOL_MAGIC 0x51485457u
+#define HEIGHT_PROTOCOL_VERSION 1u
+// The most locations a single request may hold.
+#define HEIGHT_MAX_LOCATIONS 65536u
+
+// The fields a request can ask for. They are combined with |.
+#define HEIGHT_FIELD_HEIGHT 1u
+#define HEIGHT_FIELD_NORMAL 2u
+#define HEIGHT_FIELD_VELOCITY 4u
+#define HEIGHT_FIELD_ALL 7u
+
+// The status of a response.
+#define HEIGHT_STATUS_OK 0u
+#define HEIGHT_STATUS_BAD_MAGIC 1u
+#define HEIGHT_STATUS_BAD_VERSION 2u
+#define HEIGHT_STATUS_BAD_FIELDS 3u
+#define HEIGHT_STATUS_TOO_MANY 4u
+// A location was infinite or NaN.
+#define HEIGHT_STATUS_BAD_LOCATION 5u
+
+struct HeightRequest
+{
+  //! Must be HEIGHT_PROTOCOL_MAGIC.
+  uint32_t m_Magic;
+  //! Any value. It is copied into the response.
+  uint32_t m_Id;
+  //! The HEIGHT_FIELD values wanted. At least one must be set.
+  uint16_t m_Fields;
+  //! Must be HEIGHT_PROTOCOL_VERSION.
+  uint16_t m_Version;
+  //! The number of locations that follow.
+  uint32_t m_Count;
+};
+
+struct HeightResponse
+{
+  uint32_t m_Magic;
+  uint32_t m_Id;
+  uint16_t m_Fields;
+  uint16_t m_Status;
+  uint32_t m_Count;
+  //! The simulation time the values are from in seconds.
+  double m_Time;
+};
+
+static_assert(sizeof(HeightRequest) == 16, "HeightRequest must be packed.");
+static_assert(sizeof(HeightResponse) == 24, "HeightResponse must be packed.");
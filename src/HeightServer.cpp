@@ -0,0 +1,521 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file HeightServer.cpp
+/// @date 2026-10-17
+///
+/// @brief
+/// Entry point for the height server. The server runs a WaterFFT without a
+/// window and answers height, normal, and velocity queries from other
+/// programs over a Unix domain socket. See HeightProtocol.h for the
+/// protocol. This must be compiled with WATER_HEADLESS.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Error.h"
+#include "HeightProtocol.h"
+#include "WaterFFT.h"
+
+// The most bytes of responses a client may have waiting before the server
+// stops reading its requests.
+#define SERVER_MAX_PENDING (8u << 20)
+#define SERVER_READ_CHUNK 65536u
+#define SERVER_MAX_EVENTS 64
+// The longest epoll_wait blocks so a stop signal is noticed.
+#define SERVER_WAIT_MS 100
+
+// Set by the signal handler to stop the event loop.
+volatile std::sig_atomic_t stop_requested = 0;
+
+void RequestStop(int)
+{
+  stop_requested = 1;
+}
+
+// The simulation time is the time since the server started.
+std::chrono::steady_clock::time_point start_time =
+  std::chrono::steady_clock::now();
+double last_fetched_time = 0.0;
+
+double ServerTime()
+{
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start_time;
+  last_fetched_time = elapsed.count();
+  return last_fetched_time;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// A single epoll event loop that accepts clients, reads their requests, and
+/// writes the responses. Every request that is complete when the loop wakes
+/// up is answered from the same pair of simulation ticks, so the loop only
+/// syncs with the simulation thread once per wake up.
+///////////////////////////////////////////////////////////////////////////////
+class HeightServer
+{
+public:
+  HeightServer(const std::string & path);
+  ~HeightServer();
+  void Run();
+private:
+  struct Client
+  {
+    Client() : m_InStart(0), m_OutStart(0), m_Closing(false), m_Events(0) {}
+    //! Received bytes. Bytes before m_InStart are already answered.
+    std::vector<char> m_In;
+    size_t m_InStart;
+    //! Responses waiting to be sent. Bytes before m_OutStart are sent.
+    std::vector<char> m_Out;
+    size_t m_OutStart;
+    //! Set after an error response. The client is closed once it is sent.
+    bool m_Closing;
+    //! The epoll events currently watched.
+    unsigned m_Events;
+  };
+  void Accept();
+  bool Receive(int socket, Client & client);
+  bool Send(int socket, Client & client);
+  bool HasRequest(const Client & client) const;
+  void Answer(Client & client);
+  void Respond(Client & client, const HeightRequest & request,
+    unsigned status);
+  void Watch(int socket, Client & client);
+  void Close(int socket);
+  void Refresh();
+
+  std::string m_Path;
+  int m_Listener;
+  int m_Epoll;
+  std::map<int, Client> m_Clients;
+  //! The buffers and blend of the ticks used for the current wake up.
+  unsigned m_Previous;
+  unsigned m_Current;
+  float m_Blend;
+  float m_Step;
+  double m_Time;
+  //! Scratch space used to answer a request.
+  std::vector<glm::vec2> m_Locations;
+  std::vector<WaterFFT::SurfaceSample> m_PreviousSamples;
+  std::vector<WaterFFT::SurfaceSample> m_CurrentSamples;
+};
+
+HeightServer::HeightServer(const std::string & path) :
+  m_Path(path), m_Listener(-1), m_Epoll(-1), m_Previous(0), m_Current(0),
+  m_Blend(0.0f), m_Step(0.0f), m_Time(0.0)
+{
+  Error error("HeightServer.cpp", "HeightServer::HeightServer");
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path))
+  {
+    error.Add("The socket path " + path + " is too long.");
+    throw(error);
+  }
+  std::strcpy(address.sun_path, path.c_str());
+  unlink(path.c_str());
+  m_Listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  if (m_Listener < 0 ||
+    bind(m_Listener, (sockaddr *)&address, sizeof(address)) != 0 ||
+    listen(m_Listener, SOMAXCONN) != 0)
+  {
+    error.Add("Could not listen on " + path + ": " + strerror(errno));
+    throw(error);
+  }
+  m_Epoll = epoll_create1(0);
+  epoll_event event;
+  event.events = EPOLLIN;
+  event.data.fd = m_Listener;
+  if (m_Epoll < 0 || epoll_ctl(m_Epoll, EPOLL_CTL_ADD, m_Listener, &event))
+  {
+    error.Add(std::string("Could not create the epoll instance: ") +
+      strerror(errno));
+    throw(error);
+  }
+}
+
+HeightServer::~HeightServer()
+{
+  while (!m_Clients.empty())
+    Close(m_Clients.begin()->first);
+  if (m_Epoll >= 0)
+    close(m_Epoll);
+  if (m_Listener >= 0)
+  {
+    close(m_Listener);
+    unlink(m_Path.c_str());
+  }
+}
+
+//! Serves clients until SIGINT or SIGTERM is received.
+void HeightServer::Run()
+{
+  epoll_event events[SERVER_MAX_EVENTS];
+  std::vector<int> closed;
+  while (!stop_requested)
+  {
+    int count = epoll_wait(m_Epoll, events, SERVER_MAX_EVENTS,
+      SERVER_WAIT_MS);
+    if (count < 0 && errno != EINTR)
+    {
+      Error error("HeightServer.cpp", "HeightServer::Run");
+      error.Add(std::string("epoll_wait failed: ") + strerror(errno));
+      throw(error);
+    }
+    closed.clear();
+    for (int i = 0; i < count; ++i)
+    {
+      int socket = events[i].data.fd;
+      if (socket == m_Listener)
+      {
+        Accept();
+        continue;
+      }
+      Client & client = m_Clients[socket];
+      bool open = true;
+      if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+        open = Receive(socket, client);
+      if (open && (events[i].events & EPOLLOUT))
+        open = Send(socket, client);
+      if (!open)
+        closed.push_back(socket);
+    }
+    for (int socket : closed)
+      Close(socket);
+
+    // Every waiting request is answered with the same ticks.
+    bool synced = false;
+    for (std::pair<const int, Client> & entry : m_Clients)
+    {
+      Client & client = entry.second;
+      if (client.m_Closing || client.m_Out.size() > SERVER_MAX_PENDING ||
+        !HasRequest(client))
+        continue;
+      if (!synced)
+      {
+        Refresh();
+        synced = true;
+      }
+      Answer(client);
+    }
+    closed.clear();
+    for (std::pair<const int, Client> & entry : m_Clients)
+    {
+      if (!Send(entry.first, entry.second))
+        closed.push_back(entry.first);
+      else
+        Watch(entry.first, entry.second);
+    }
+    for (int socket : closed)
+      Close(socket);
+  }
+}
+
+void HeightServer::Accept()
+{
+  while (true)
+  {
+    int socket = accept4(m_Listener, nullptr, nullptr, SOCK_NONBLOCK);
+    if (socket < 0)
+      return;
+    Client & client = m_Clients[socket];
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = socket;
+    epoll_ctl(m_Epoll, EPOLL_CTL_ADD, socket, &event);
+    client.m_Events = EPOLLIN;
+  }
+}
+
+// Reads everything the client has sent. Returns false when the client hung
+// up or the socket failed.
+bool HeightServer::Receive(int socket, Client & client)
+{
+  while (true)
+  {
+    size_t size = client.m_In.size();
+    client.m_In.resize(size + SERVER_READ_CHUNK);
+    ssize_t received = recv(socket, client.m_In.data() + size,
+      SERVER_READ_CHUNK, 0);
+    client.m_In.resize(size + (received > 0 ? received : 0));
+    if (received > 0)
+      continue;
+    if (received == 0)
+      return false;
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+  }
+}
+
+// Writes as many waiting responses as the socket takes. Returns false when
+// the client should be closed.
+bool HeightServer::Send(int socket, Client & client)
+{
+  while (client.m_OutStart < client.m_Out.size())
+  {
+    ssize_t sent = send(socket, client.m_Out.data() + client.m_OutStart,
+      client.m_Out.size() - client.m_OutStart, MSG_NOSIGNAL);
+    if (sent < 0)
+      return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    client.m_OutStart += sent;
+  }
+  client.m_Out.clear();
+  client.m_OutStart = 0;
+  return !client.m_Closing;
+}
+
+// A request is complete when its header and every location have arrived.
+// A header that is not valid counts as complete so it can be rejected.
+bool HeightServer::HasRequest(const Client & client) const
+{
+  size_t available = client.m_In.size() - client.m_InStart;
+  if (available < sizeof(HeightRequest))
+    return false;
+  HeightRequest request;
+  std::memcpy(&request, client.m_In.data() + client.m_InStart,
+    sizeof(request));
+  if (request.m_Magic != HEIGHT_PROTOCOL_MAGIC ||
+    request.m_Count > HEIGHT_MAX_LOCATIONS)
+    return true;
+  return available >= sizeof(HeightRequest) +
+    (size_t)request.m_Count * 2 * sizeof(float);
+}
+
+// Answers every complete request the client has sent.
+void HeightServer::Answer(Client & client)
+{
+  WaterFFT * water = WaterFFTHolder::GetWaterFFT();
+  while (!client.m_Closing && client.m_Out.size() <= SERVER_MAX_PENDING &&
+    HasRequest(client))
+  {
+    HeightRequest request;
+    const char * start = client.m_In.data() + client.m_InStart;
+    std::memcpy(&request, start, sizeof(request));
+    if (request.m_Magic != HEIGHT_PROTOCOL_MAGIC)
+    {
+      Respond(client, request, HEIGHT_STATUS_BAD_MAGIC);
+      break;
+    }
+    if (request.m_Version != HEIGHT_PROTOCOL_VERSION)
+    {
+      Respond(client, request, HEIGHT_STATUS_BAD_VERSION);
+      break;
+    }
+    if (request.m_Fields == 0 || (request.m_Fields & ~HEIGHT_FIELD_ALL))
+    {
+      Respond(client, request, HEIGHT_STATUS_BAD_FIELDS);
+      break;
+    }
+    if (request.m_Count > HEIGHT_MAX_LOCATIONS)
+    {
+      Respond(client, request, HEIGHT_STATUS_TOO_MANY);
+      break;
+    }
+    unsigned count = request.m_Count;
+    m_Locations.resize(count);
+    std::memcpy(m_Locations.data(), start + sizeof(request),
+      count * sizeof(glm::vec2));
+    bool finite = true;
+    for (const glm::vec2 & location : m_Locations)
+      finite = finite && std::isfinite(location.x) &&
+        std::isfinite(location.y);
+    if (!finite)
+    {
+      Respond(client, request, HEIGHT_STATUS_BAD_LOCATION);
+      break;
+    }
+    client.m_InStart += sizeof(request) + count * sizeof(glm::vec2);
+    m_PreviousSamples.resize(count);
+    m_CurrentSamples.resize(count);
+    water->SampleBuffer(m_Previous, m_Locations.data(), count,
+      m_PreviousSamples.data());
+    water->SampleBuffer(m_Current, m_Locations.data(), count,
+      m_CurrentSamples.data());
+
+    Respond(client, request, HEIGHT_STATUS_OK);
+    unsigned floats = 0;
+    if (request.m_Fields & HEIGHT_FIELD_HEIGHT)
+      floats += count;
+    if (request.m_Fields & HEIGHT_FIELD_NORMAL)
+      floats += 3 * count;
+    if (request.m_Fields & HEIGHT_FIELD_VELOCITY)
+      floats += 3 * count;
+    size_t size = client.m_Out.size();
+    client.m_Out.resize(size + floats * sizeof(float));
+    float * out = (float *)(client.m_Out.data() + size);
+    // The ticks are blended the same way the renderer blends them. The
+    // velocity is the change between the ticks, so it is the motion of the
+    // water that was at each location when the waves were flat.
+    if (request.m_Fields & HEIGHT_FIELD_HEIGHT)
+    {
+      for (unsigned i = 0; i < count; ++i)
+        *out++ = Lerp(m_PreviousSamples[i].m_Height,
+          m_CurrentSamples[i].m_Height, m_Blend);
+    }
+    if (request.m_Fields & HEIGHT_FIELD_NORMAL)
+    {
+      for (unsigned i = 0; i < count; ++i)
+      {
+        glm::vec3 normal = glm::normalize(glm::mix(
+          m_PreviousSamples[i].m_Normal, m_CurrentSamples[i].m_Normal,
+          m_Blend));
+        *out++ = normal.x;
+        *out++ = normal.y;
+        *out++ = normal.z;
+      }
+    }
+    if (request.m_Fields & HEIGHT_FIELD_VELOCITY)
+    {
+      for (unsigned i = 0; i < count; ++i)
+      {
+        const WaterFFT::SurfaceSample & a = m_PreviousSamples[i];
+        const WaterFFT::SurfaceSample & b = m_CurrentSamples[i];
+        *out++ = (b.m_Displacement.x - a.m_Displacement.x) / m_Step;
+        *out++ = (b.m_Height - a.m_Height) / m_Step;
+        *out++ = (b.m_Displacement.y - a.m_Displacement.y) / m_Step;
+      }
+    }
+  }
+  // Drop the answered bytes once they make up most of the buffer.
+  if (client.m_InStart > client.m_In.size() / 2)
+  {
+    client.m_In.erase(client.m_In.begin(),
+      client.m_In.begin() + client.m_InStart);
+    client.m_InStart = 0;
+  }
+}
+
+// Adds a response header. An error response also closes the client.
+void HeightServer::Respond(Client & client, const HeightRequest & request,
+  unsigned status)
+{
+  HeightResponse response;
+  response.m_Magic = HEIGHT_PROTOCOL_MAGIC;
+  response.m_Id = request.m_Id;
+  response.m_Fields = request.m_Fields;
+  response.m_Status = (uint16_t)status;
+  response.m_Count = (status == HEIGHT_STATUS_OK) ? request.m_Count : 0;
+  response.m_Time = m_Time;
+  const char * bytes = (const char *)&response;
+  client.m_Out.insert(client.m_Out.end(), bytes, bytes + sizeof(response));
+  if (status != HEIGHT_STATUS_OK)
+    client.m_Closing = true;
+}
+
+// Only reads from a client while its responses are under the limit and only
+// waits to write while responses are left.
+void HeightServer::Watch(int socket, Client & client)
+{
+  unsigned events = 0;
+  if (!client.m_Closing && client.m_Out.size() <= SERVER_MAX_PENDING)
+    events |= EPOLLIN;
+  if (client.m_OutStart < client.m_Out.size())
+    events |= EPOLLOUT;
+  if (events == client.m_Events)
+    return;
+  epoll_event event;
+  event.events = events;
+  event.data.fd = socket;
+  epoll_ctl(m_Epoll, EPOLL_CTL_MOD, socket, &event);
+  client.m_Events = events;
+}
+
+void HeightServer::Close(int socket)
+{
+  epoll_ctl(m_Epoll, EPOLL_CTL_DEL, socket, nullptr);
+  close(socket);
+  m_Clients.erase(socket);
+}
+
+// Gets the ticks around the current time from the simulation thread. This
+// only waits when the simulation has fallen behind, and the simulation never
+// waits on the server.
+void HeightServer::Refresh()
+{
+  if (!WaterFFTThread::Wait(&m_Previous, &m_Current, &m_Blend))
+  {
+    Error error("HeightServer.cpp", "HeightServer::Refresh");
+    error.Add("The simulation thread stopped.");
+    throw(error);
+  }
+  m_Time = last_fetched_time;
+  m_Step = 1.0f / WaterFFTThread::StepRate();
+}
+
+// Command line options
+//  -socket <path>  The socket to listen on. The default is
+//                  /tmp/water_heights.sock.
+//  -grid <size>    The number of vertices along each side of the grid. The
+//                  default is 256.
+int main(int argc, char * argv[])
+{
+  std::string path = "/tmp/water_heights.sock";
+  unsigned grid = 256;
+  bool valid = true;
+  for (int i = 1; i < argc && valid; ++i)
+  {
+    // Every option takes a value.
+    if (i + 1 == argc)
+    {
+      std::cerr << argv[i] << " is missing its value." << std::endl;
+      valid = false;
+    }
+    else if (!strcmp(argv[i], "-socket"))
+      path = argv[++i];
+    else if (!strcmp(argv[i], "-grid"))
+      grid = (unsigned)atoi(argv[++i]);
+    else
+    {
+      std::cerr << "Unknown option " << argv[i] << "." << std::endl;
+      valid = false;
+    }
+  }
+  if (valid && grid == 0)
+  {
+    std::cerr << "The grid must have at least one quad." << std::endl;
+    valid = false;
+  }
+  if (!valid)
+  {
+    std::cerr << "usage: height_server [-socket <path>] [-grid <size>]"
+      << std::endl;
+    return 1;
+  }
+  std::signal(SIGINT, RequestStop);
+  std::signal(SIGTERM, RequestStop);
+  int result = 0;
+  try {
+    WaterFFTHolder::Initialize(grid, 1);
+    WaterFFTThread::Execute(ServerTime);
+    try {
+      HeightServer server(path);
+      std::cout << "Serving heights on " << path << std::endl;
+      server.Run();
+    }
+    catch (Error & error) {
+      std::cerr << error << std::endl;
+      result = 1;
+    }
+    WaterFFTThread::Terminate();
+    WaterFFTHolder::Purge();
+  }
+  catch (Error & error) {
+    std::cerr << error << std::endl;
+    result = 1;
+  }
+  return result;
+}
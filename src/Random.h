@@ -1,23 +1,68 @@
-#include <stdlib.h>
-#include <math.h>
-#include "Complex.h"
-
-inline float UniformRandom()
-{
-  float rand_value = (float)rand() / (float)RAND_MAX;
-  return rand_value;
-}
-
-Complex NormalComplexRandom()
-{
-  float x1, x2, w;
-  do {
-    x1 = 2.0f * UniformRandom() - 1.0f;
-    x2 = 2.0f * UniformRandom() - 1.0f;
-    w = x1 * x1 + x2 * x2;
-  } while (w >= 1.0f);
-  w = sqrt((-2.0f * log(w)) / w);
-  float rand1 = x1 * w;
-  float rand2 = x2 * w;
-  return Complex(rand1, rand2);
-}
\ No newline at end of file
+//////////////////////////////////////////////////////////////////////////////
+/// @file Random.h
+/// @date 2026-10-17
+///
+/// @brief Contains the seeded random number generator used to build the
+/// water's spectrum.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include "Complex.h"
+
+#define RANDOM_MULTIPLIER 6364136223846793005ull
+#define RANDOM_INCREMENT 1442695040888963407ull
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// A PCG32 generator. Unlike rand, the integer sequence only depends on the
+/// seed, so it and Uniform are the same in every process and on every
+/// platform. NormalComplex uses std::log, so its values are only repeatable
+/// with the same build on the same kind of CPU, like WaterFFT::Deterministic.
+///////////////////////////////////////////////////////////////////////////////
+class Random
+{
+public:
+  Random(uint64_t seed = 0)
+  {
+    Seed(seed);
+  }
+  // Restarts the sequence.
+  void Seed(uint64_t seed)
+  {
+    m_State = 0;
+    Next();
+    m_State += seed;
+    Next();
+  }
+  uint32_t Next()
+  {
+    uint64_t state = m_State;
+    m_State = state * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+    uint32_t xor_shifted = (uint32_t)(((state >> 18u) ^ state) >> 27u);
+    uint32_t rotation = (uint32_t)(state >> 59u);
+    return (xor_shifted >> rotation) |
+      (xor_shifted << ((32u - rotation) & 31u));
+  }
+  // A float in [0, 1). Only 24 bits are used so every value is exact.
+  float Uniform()
+  {
+    return (float)(Next() >> 8) * (1.0f / 16777216.0f);
+  }
+  // A complex number whose parts are independent standard normal values.
+  // This uses the Marsaglia polar method.
+  Complex NormalComplex()
+  {
+    float x1, x2, w;
+    do {
+      x1 = 2.0f * Uniform() - 1.0f;
+      x2 = 2.0f * Uniform() - 1.0f;
+      w = x1 * x1 + x2 * x2;
+    } while (w >= 1.0f || w == 0.0f);
+    w = std::sqrt((-2.0f * std::log(w)) / w);
+    return Complex(x1 * w, x2 * w);
+  }
+private:
+  uint64_t m_State;
+};
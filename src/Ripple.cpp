@@ -0,0 +1,539 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file Ripple.cpp
+/// @date 2026-10-17
+///
+/// @brief Contains the implementation of the interactive ripple layer.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "Error.h"
+
+#include "Ripple.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define RIPPLE_SIMD
+#include <xmmintrin.h>
+#endif
+
+// The kernel covers the cells within this distance of the center cell on
+// each axis.
+#define RIPPLE_KERNEL_RADIUS 6
+#define RIPPLE_KERNEL_SIZE (2 * RIPPLE_KERNEL_RADIUS + 1)
+// The separable terms of the kernel are kept until their weight is below this
+// fraction of the largest weight or there are RIPPLE_KERNEL_MAX_RANK terms.
+#define RIPPLE_KERNEL_TOLERANCE 1.0e-3
+#define RIPPLE_KERNEL_MAX_RANK 4
+// The length of a simulation step in seconds and the most steps taken by one
+// Advance. When the simulation falls further behind, the time is skipped.
+#define RIPPLE_STEP (1.0f / 60.0f)
+#define RIPPLE_MAX_STEPS 4
+// Waves are faded out over this many cells at the edges of the window.
+#define RIPPLE_FADE_CELLS 16
+#define RIPPLE_FADE_RATE 0.1f
+
+// KERNEL HELPERS /////////////////////////////////////////////////////////////
+
+// The Bessel function J0 from the polynomial approximations in Abramowitz and
+// Stegun 9.4.1 and 9.4.3.
+static double BesselJ0(double x)
+{
+  x = std::fabs(x);
+  if (x <= 3.0)
+  {
+    double y = (x / 3.0) * (x / 3.0);
+    return 1.0 + y * (-2.2499997 + y * (1.2656208 + y * (-0.3163866 +
+      y * (0.0444479 + y * (-0.0039444 + y * 0.0002100)))));
+  }
+  double y = 3.0 / x;
+  double f = 0.79788456 + y * (-0.00000077 + y * (-0.00552740 +
+    y * (-0.00009512 + y * (0.00137237 + y * (-0.00072805 +
+    y * 0.00014476)))));
+  double theta = x - 0.78539816 + y * (-0.04166397 + y * (-0.00003954 +
+    y * (0.00262573 + y * (-0.00054125 + y * (-0.00029333 +
+    y * 0.00013558)))));
+  return f * std::cos(theta) / std::sqrt(x);
+}
+
+// The iWave vertical derivative kernel at a distance of r cells, normalized
+// so the center of the kernel is 1.
+static double VerticalDerivative(double r)
+{
+  const unsigned samples = 10000;
+  const double dq = 0.001;
+  double sum = 0.0;
+  double normal = 0.0;
+  for (unsigned n = 1; n <= samples; ++n)
+  {
+    double q = n * dq;
+    double weight = q * q * std::exp(-q * q);
+    sum += weight * BesselJ0(q * r);
+    normal += weight;
+  }
+  return sum / normal;
+}
+
+// Finds the eigenvalues and eigenvectors of a symmetric n by n matrix with
+// Jacobi rotations. The eigenvector of values[i] is column i of vectors.
+static void SymmetricEigen(std::vector<double> a, unsigned n,
+  std::vector<double> * values, std::vector<double> * vectors)
+{
+  std::vector<double> & v = *vectors;
+  v.assign(n * n, 0.0);
+  for (unsigned i = 0; i < n; ++i)
+    v[i * n + i] = 1.0;
+  for (unsigned sweep = 0; sweep < 64; ++sweep)
+  {
+    double off = 0.0;
+    for (unsigned p = 0; p < n; ++p)
+      for (unsigned q = p + 1; q < n; ++q)
+        off += a[p * n + q] * a[p * n + q];
+    if (off < 1.0e-24)
+      break;
+    for (unsigned p = 0; p < n; ++p)
+    {
+      for (unsigned q = p + 1; q < n; ++q)
+      {
+        double apq = a[p * n + q];
+        if (std::fabs(apq) < 1.0e-30)
+          continue;
+        double theta = (a[q * n + q] - a[p * n + p]) / (2.0 * apq);
+        double t = (theta >= 0.0 ? 1.0 : -1.0) /
+          (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+        double c = 1.0 / std::sqrt(t * t + 1.0);
+        double s = t * c;
+        for (unsigned k = 0; k < n; ++k)
+        {
+          double akp = a[k * n + p];
+          double akq = a[k * n + q];
+          a[k * n + p] = c * akp - s * akq;
+          a[k * n + q] = s * akp + c * akq;
+        }
+        for (unsigned k = 0; k < n; ++k)
+        {
+          double apk = a[p * n + k];
+          double aqk = a[q * n + k];
+          a[p * n + k] = c * apk - s * aqk;
+          a[q * n + k] = s * apk + c * aqk;
+        }
+        for (unsigned k = 0; k < n; ++k)
+        {
+          double vkp = v[k * n + p];
+          double vkq = v[k * n + q];
+          v[k * n + p] = c * vkp - s * vkq;
+          v[k * n + q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+  values->resize(n);
+  for (unsigned i = 0; i < n; ++i)
+    (*values)[i] = a[i * n + i];
+}
+
+// RIPPLE /////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Creates a flat ripple layer centered on the origin.
+///
+/// @param dimension The number of cells along each side of the window. This
+///   must be a multiple of 4.
+/// @param cell_size The length of a cell in meters. Ripples are only visible
+///   on the water mesh when this is close to the mesh's vertex spacing.
+/// @param threads The number of threads used by a step, including the one
+///   calling Advance. Zero uses one thread per core.
+///////////////////////////////////////////////////////////////////////////////
+Ripple::Ripple(unsigned dimension, float cell_size, unsigned threads) :
+  m_Damping(0.3f), m_Gravity(9.81f), m_Dimension(dimension),
+  m_Stride(dimension + 2 * RIPPLE_KERNEL_RADIUS), m_CellSize(cell_size),
+  m_CenterX(0), m_CenterZ(0), m_Time(0.0), m_Started(false),
+  m_PendingCenter(0.0f, 0.0f), m_PendingRecenter(false),
+  m_Pool(threads ? threads : std::thread::hardware_concurrency())
+{
+  if (dimension == 0 || dimension % 4 != 0 || cell_size <= 0.0f)
+  {
+    Error error("Ripple.cpp", "Ripple::Ripple");
+    error.Add("The ripple dimension must be a positive multiple of 4 and the "
+      "cell size must be positive.");
+    throw(error);
+  }
+  m_Height.assign(m_Stride * m_Stride, 0.0f);
+  m_Previous.assign(m_Stride * m_Stride, 0.0f);
+  m_SlopeX.assign(m_Stride * m_Stride, 0.0f);
+  m_SlopeZ.assign(m_Stride * m_Stride, 0.0f);
+
+  m_Fade.resize(m_Dimension * m_Dimension);
+  for (unsigned z = 0; z < m_Dimension; ++z)
+  {
+    for (unsigned x = 0; x < m_Dimension; ++x)
+    {
+      unsigned edge = std::min(std::min(x, m_Dimension - 1 - x),
+        std::min(z, m_Dimension - 1 - z));
+      float fade = 1.0f;
+      if (edge < RIPPLE_FADE_CELLS)
+      {
+        float t = 1.0f - (float)edge / (float)RIPPLE_FADE_CELLS;
+        fade -= RIPPLE_FADE_RATE * t * t;
+      }
+      m_Fade[z * m_Dimension + x] = fade;
+    }
+  }
+
+  BuildKernels();
+  m_RowPass.assign(m_RowKernels.size(),
+    std::vector<float>(m_Stride * m_Stride, 0.0f));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Queues disturbances that are applied at the start of the next
+/// step.
+///
+/// @param sources The disturbances.
+/// @param count The number of disturbances.
+///////////////////////////////////////////////////////////////////////////////
+void Ripple::Disturb(const RippleSource * sources, unsigned count)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_PendingSources.insert(m_PendingSources.end(), sources, sources + count);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Moves the window so it is centered on a location. The move happens
+/// at the start of the next step and is snapped to whole cells so the
+/// existing ripples stay where they are.
+///
+/// @param center The location on the xz plane.
+///////////////////////////////////////////////////////////////////////////////
+void Ripple::Recenter(const glm::vec2 & center)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_PendingCenter = center;
+  m_PendingRecenter = true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Steps the ripples forward to a simulation time. The ripples only
+/// move forward, so earlier times are ignored.
+///
+/// @param time The simulation time in seconds.
+///////////////////////////////////////////////////////////////////////////////
+void Ripple::Advance(double time)
+{
+  if (!m_Started)
+  {
+    m_Time = time;
+    m_Started = true;
+  }
+  ApplyPending();
+  unsigned steps = 0;
+  while (m_Time + RIPPLE_STEP <= time)
+  {
+    if (steps == RIPPLE_MAX_STEPS)
+    {
+      m_Time = time;
+      break;
+    }
+    Step(RIPPLE_STEP);
+    m_Time += RIPPLE_STEP;
+    ++steps;
+  }
+  if (steps > 0)
+  {
+    m_Pool.ParallelFor(m_Dimension, [this](unsigned begin, unsigned end)
+      { SlopePass(begin, end); });
+  }
+}
+
+//! The location the window is centered on.
+glm::vec2 Ripple::Center() const
+{
+  return glm::vec2(m_CenterX, m_CenterZ) * m_CellSize;
+}
+
+//! The number of separable terms used for the kernel.
+unsigned Ripple::KernelRank() const
+{
+  return (unsigned)m_RowKernels.size();
+}
+
+// The ripple heights and slopes are added with AddWindowRow.
+bool Ripple::SampleRow(float z, float x_start, float dx, unsigned count,
+  float * height, float * slope_x, float * slope_z) const
+{
+  LayerWindow window = { m_Height.data(), m_SlopeX.data(), m_SlopeZ.data(),
+    m_Dimension, m_Stride, RIPPLE_KERNEL_RADIUS, m_CellSize, m_CenterX,
+    m_CenterZ };
+  return AddWindowRow(window, z, x_start, dx, count, height, slope_x,
+    slope_z);
+}
+
+// Takes a single iWave step. The new heights are
+// (h * (2 - a * dt) - h_previous - g * dt^2 * (G * h)) / (1 + a * dt)
+// where G * h is the convolution of the heights with the vertical derivative
+// kernel.
+void Ripple::Step(float dt)
+{
+  for (unsigned term = 0; term < m_RowKernels.size(); ++term)
+  {
+    m_Pool.ParallelFor(m_Dimension, [this, term](unsigned begin, unsigned end)
+      { RowPass(term, begin, end); });
+  }
+  m_Pool.ParallelFor(m_Dimension, [this, dt](unsigned begin, unsigned end)
+    { ColumnPass(dt, begin, end); });
+}
+
+// Moves the window and adds the sources that were queued since the last
+// step.
+void Ripple::ApplyPending()
+{
+  std::vector<RippleSource> sources;
+  glm::vec2 center;
+  bool recenter;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    sources.swap(m_PendingSources);
+    center = m_PendingCenter;
+    recenter = m_PendingRecenter;
+    m_PendingRecenter = false;
+  }
+  if (recenter)
+  {
+    int center_x = (int)std::floor(center.x / m_CellSize + 0.5f);
+    int center_z = (int)std::floor(center.y / m_CellSize + 0.5f);
+    Shift(center_x - m_CenterX, center_z - m_CenterZ);
+    m_CenterX = center_x;
+    m_CenterZ = center_z;
+  }
+  for (const RippleSource & source : sources)
+    Splat(source);
+}
+
+// Moves the heights so cell (x, z) holds what was at
+// (x + shift_x, z + shift_z). Cells that enter the window are flat.
+void Ripple::Shift(int shift_x, int shift_z)
+{
+  if (shift_x == 0 && shift_z == 0)
+    return;
+  int dimension = (int)m_Dimension;
+  std::vector<float> * fields[] = { &m_Height, &m_Previous };
+  for (std::vector<float> * field : fields)
+  {
+    std::vector<float> moved(field->size(), 0.0f);
+    for (int z = 0; z < dimension; ++z)
+    {
+      int source_z = z + shift_z;
+      if (source_z < 0 || source_z >= dimension)
+        continue;
+      for (int x = 0; x < dimension; ++x)
+      {
+        int source_x = x + shift_x;
+        if (source_x < 0 || source_x >= dimension)
+          continue;
+        Cell(moved, x, z) = Cell(*field, source_x, source_z);
+      }
+    }
+    field->swap(moved);
+  }
+}
+
+// Adds a smooth bump to the heights. The bump is added to the previous
+// heights too so it starts at rest and spreads out as ripples.
+void Ripple::Splat(const RippleSource & source)
+{
+  float half = 0.5f * (float)m_Dimension;
+  float cx = source.m_Location.x / m_CellSize - (float)m_CenterX + half;
+  float cz = source.m_Location.y / m_CellSize - (float)m_CenterZ + half;
+  float radius = std::max(source.m_Radius / m_CellSize, 1.0f);
+  int x_begin = std::max((int)std::floor(cx - radius), 0);
+  int x_end = std::min((int)std::ceil(cx + radius), (int)m_Dimension - 1);
+  int z_begin = std::max((int)std::floor(cz - radius), 0);
+  int z_end = std::min((int)std::ceil(cz + radius), (int)m_Dimension - 1);
+  for (int z = z_begin; z <= z_end; ++z)
+  {
+    for (int x = x_begin; x <= x_end; ++x)
+    {
+      float dx = (float)x - cx;
+      float dz = (float)z - cz;
+      float t = (dx * dx + dz * dz) / (radius * radius);
+      if (t >= 1.0f)
+        continue;
+      float bump = source.m_Strength * (1.0f - t) * (1.0f - t);
+      Cell(m_Height, x, z) += bump;
+      Cell(m_Previous, x, z) += bump;
+    }
+  }
+}
+
+// Convolves rows [begin, end) of the heights with the row weights of one
+// kernel term.
+void Ripple::RowPass(unsigned term, unsigned begin, unsigned end)
+{
+  const float * kernel = m_RowKernels[term].data();
+  for (unsigned z = begin; z < end; ++z)
+  {
+    unsigned row = (z + RIPPLE_KERNEL_RADIUS) * m_Stride;
+    const float * in = m_Height.data() + row;
+    float * out = m_RowPass[term].data() + row + RIPPLE_KERNEL_RADIUS;
+    unsigned x = 0;
+#ifdef RIPPLE_SIMD
+    for (; x + 4 <= m_Dimension; x += 4)
+    {
+      __m128 sum = _mm_setzero_ps();
+      for (unsigned j = 0; j < RIPPLE_KERNEL_SIZE; ++j)
+      {
+        sum = _mm_add_ps(sum,
+          _mm_mul_ps(_mm_set1_ps(kernel[j]), _mm_loadu_ps(in + x + j)));
+      }
+      _mm_storeu_ps(out + x, sum);
+    }
+#endif
+    for (; x < m_Dimension; ++x)
+    {
+      float sum = 0.0f;
+      for (unsigned j = 0; j < RIPPLE_KERNEL_SIZE; ++j)
+        sum += kernel[j] * in[x + j];
+      out[x] = sum;
+    }
+  }
+}
+
+// Convolves the row passes of rows [begin, end) with the column weights of
+// every term and uses the result to step those rows. The row passes are
+// finished before this starts, so the heights can be replaced in place.
+void Ripple::ColumnPass(float dt, unsigned begin, unsigned end)
+{
+  float denominator = 1.0f + m_Damping * dt;
+  float current_factor = (2.0f - m_Damping * dt) / denominator;
+  float previous_factor = 1.0f / denominator;
+  float derivative_factor = m_Gravity * dt * dt / (m_CellSize * denominator);
+  unsigned terms = (unsigned)m_ColumnKernels.size();
+  for (unsigned z = begin; z < end; ++z)
+  {
+    unsigned row = (z + RIPPLE_KERNEL_RADIUS) * m_Stride + RIPPLE_KERNEL_RADIUS;
+    float * height = m_Height.data() + row;
+    float * previous = m_Previous.data() + row;
+    const float * fade = m_Fade.data() + z * m_Dimension;
+    unsigned x = 0;
+#ifdef RIPPLE_SIMD
+    __m128 current_4 = _mm_set1_ps(current_factor);
+    __m128 previous_4 = _mm_set1_ps(previous_factor);
+    __m128 derivative_4 = _mm_set1_ps(derivative_factor);
+    for (; x + 4 <= m_Dimension; x += 4)
+    {
+      __m128 derivative = _mm_setzero_ps();
+      for (unsigned t = 0; t < terms; ++t)
+      {
+        const float * kernel = m_ColumnKernels[t].data();
+        const float * in = m_RowPass[t].data() + z * m_Stride +
+          RIPPLE_KERNEL_RADIUS + x;
+        for (unsigned j = 0; j < RIPPLE_KERNEL_SIZE; ++j)
+        {
+          derivative = _mm_add_ps(derivative, _mm_mul_ps(
+            _mm_set1_ps(kernel[j]), _mm_loadu_ps(in + j * m_Stride)));
+        }
+      }
+      __m128 h = _mm_loadu_ps(height + x);
+      __m128 h_new = _mm_sub_ps(_mm_mul_ps(h, current_4),
+        _mm_mul_ps(_mm_loadu_ps(previous + x), previous_4));
+      h_new = _mm_sub_ps(h_new, _mm_mul_ps(derivative, derivative_4));
+      __m128 f = _mm_loadu_ps(fade + x);
+      _mm_storeu_ps(previous + x, _mm_mul_ps(h, f));
+      _mm_storeu_ps(height + x, _mm_mul_ps(h_new, f));
+    }
+#endif
+    for (; x < m_Dimension; ++x)
+    {
+      float derivative = 0.0f;
+      for (unsigned t = 0; t < terms; ++t)
+      {
+        const float * kernel = m_ColumnKernels[t].data();
+        const float * in = m_RowPass[t].data() + z * m_Stride +
+          RIPPLE_KERNEL_RADIUS + x;
+        for (unsigned j = 0; j < RIPPLE_KERNEL_SIZE; ++j)
+          derivative += kernel[j] * in[j * m_Stride];
+      }
+      float h = height[x];
+      float h_new = h * current_factor - previous[x] * previous_factor -
+        derivative * derivative_factor;
+      previous[x] = h * fade[x];
+      height[x] = h_new * fade[x];
+    }
+  }
+}
+
+// Finds the slopes of rows [begin, end) with central differences.
+void Ripple::SlopePass(unsigned begin, unsigned end)
+{
+  float factor = 0.5f / m_CellSize;
+  for (int z = (int)begin; z < (int)end; ++z)
+  {
+    for (int x = 0; x < (int)m_Dimension; ++x)
+    {
+      Cell(m_SlopeX, x, z) =
+        (Cell(m_Height, x + 1, z) - Cell(m_Height, x - 1, z)) * factor;
+      Cell(m_SlopeZ, x, z) =
+        (Cell(m_Height, x, z + 1) - Cell(m_Height, x, z - 1)) * factor;
+    }
+  }
+}
+
+// Builds the iWave kernel and splits it into separable terms. The kernel is
+// symmetric, so its eigenvectors give G = sum(lambda_i * v_i * v_i^T). Each
+// term is a row pass with lambda_i * v_i followed by a column pass with v_i.
+void Ripple::BuildKernels()
+{
+  const unsigned size = RIPPLE_KERNEL_SIZE;
+  std::vector<double> kernel(size * size);
+  for (unsigned z = 0; z < size; ++z)
+  {
+    for (unsigned x = 0; x < size; ++x)
+    {
+      double dx = (double)x - RIPPLE_KERNEL_RADIUS;
+      double dz = (double)z - RIPPLE_KERNEL_RADIUS;
+      kernel[z * size + x] = VerticalDerivative(std::sqrt(dx * dx + dz * dz));
+    }
+  }
+  std::vector<double> values, vectors;
+  SymmetricEigen(kernel, size, &values, &vectors);
+  std::vector<unsigned> order(size);
+  for (unsigned i = 0; i < size; ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.end(), [&values](unsigned a, unsigned b)
+    { return std::fabs(values[a]) > std::fabs(values[b]); });
+
+  m_RowKernels.clear();
+  m_ColumnKernels.clear();
+  for (unsigned i = 0; i < size && i < RIPPLE_KERNEL_MAX_RANK; ++i)
+  {
+    double value = values[order[i]];
+    double largest = std::fabs(values[order[0]]);
+    if (std::fabs(value) < RIPPLE_KERNEL_TOLERANCE * largest)
+      break;
+    std::vector<float> row(size), column(size);
+    for (unsigned j = 0; j < size; ++j)
+    {
+      double element = vectors[j * size + order[i]];
+      row[j] = (float)(value * element);
+      column[j] = (float)element;
+    }
+    m_RowKernels.push_back(row);
+    m_ColumnKernels.push_back(column);
+  }
+}
+
+// Gets a cell of the window. Cells up to RIPPLE_KERNEL_RADIUS outside the
+// window are in the zero padding.
+inline float & Ripple::Cell(std::vector<float> & values, int x, int z)
+{
+  return values[(z + RIPPLE_KERNEL_RADIUS) * m_Stride +
+    x + RIPPLE_KERNEL_RADIUS];
+}
+
+inline float Ripple::Cell(const std::vector<float> & values, int x,
+  int z) const
+{
+  return values[(z + RIPPLE_KERNEL_RADIUS) * m_Stride +
+    x + RIPPLE_KERNEL_RADIUS];
+}
@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file Ripple.h
+/// @date 2026-10-17
+///
+/// @brief Contains the interface for the interactive ripple layer that is
+/// added on top of the WaterFFT surface.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <GLM\glm\glm.hpp>
+#include <mutex>
+#include <vector>
+
+#include "SurfaceLayer.h"
+#include "ThreadUtils.h"
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// A disturbance of the water. The surface inside the radius is pushed by
+/// strength meters, fading to nothing at the edge.
+///////////////////////////////////////////////////////////////////////////////
+struct RippleSource
+{
+  //! The location on the xz plane.
+  glm::vec2 m_Location;
+  //! The radius of the disturbance in meters.
+  float m_Radius;
+  //! The height added at the center in meters. Negative values push down.
+  float m_Strength;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// An iWave height field on a square window of cells that follows the camera.
+/// Each step convolves the heights with the iWave vertical derivative kernel.
+/// The kernel is split into a few separable terms, so the convolution is a
+/// row pass and a column pass per term. Both passes are spread across a
+/// thread pool.
+///
+/// Important Notes
+/// - Disturb and Recenter may be called from any thread. Their effects are
+///   queued and applied at the start of the next step.
+/// - Advance and SampleRow must be called from the same thread. WaterFFT
+///   calls both from its Update.
+/// - Waves are faded out near the edges of the window so they do not reflect.
+///////////////////////////////////////////////////////////////////////////////
+class Ripple : public SurfaceLayer
+{
+public:
+  Ripple(unsigned dimension, float cell_size, unsigned threads = 0);
+  void Disturb(const RippleSource * sources, unsigned count);
+  void Recenter(const glm::vec2 & center);
+  void Advance(double time) override;
+  glm::vec2 Center() const override;
+  bool SampleRow(float z, float x_start, float dx, unsigned count,
+    float * height, float * slope_x, float * slope_z) const override;
+  unsigned KernelRank() const;
+  //! The damping of the waves. Larger values make ripples die out sooner.
+  float m_Damping;
+  //! The gravitational constant.
+  float m_Gravity;
+private:
+  void Step(float dt);
+  void ApplyPending();
+  void Shift(int shift_x, int shift_z);
+  void Splat(const RippleSource & source);
+  void RowPass(unsigned term, unsigned begin, unsigned end);
+  void ColumnPass(float dt, unsigned begin, unsigned end);
+  void SlopePass(unsigned begin, unsigned end);
+  void BuildKernels();
+  float & Cell(std::vector<float> & values, int x, int z);
+  float Cell(const std::vector<float> & values, int x, int z) const;
+
+  //! The number of cells along each side of the window.
+  unsigned m_Dimension;
+  //! The number of floats in a padded row. The window is surrounded by
+  // RIPPLE_KERNEL_RADIUS cells of zeros so the convolution never needs to
+  // check the edges.
+  unsigned m_Stride;
+  //! The length of a cell in meters.
+  float m_CellSize;
+  //! The cell the window is centered on.
+  int m_CenterX;
+  int m_CenterZ;
+  //! The simulation time the heights are at.
+  double m_Time;
+  //! Identifies whether m_Time has been set by Advance.
+  bool m_Started;
+  //! The heights at the current and previous steps.
+  std::vector<float> m_Height;
+  std::vector<float> m_Previous;
+  //! The heights after the row pass of each kernel term.
+  std::vector<std::vector<float> > m_RowPass;
+  //! The slopes of the current heights.
+  std::vector<float> m_SlopeX;
+  std::vector<float> m_SlopeZ;
+  //! The factor applied to each cell to fade waves out near the edges.
+  std::vector<float> m_Fade;
+  //! The row and column weights of each separable kernel term.
+  std::vector<std::vector<float> > m_RowKernels;
+  std::vector<std::vector<float> > m_ColumnKernels;
+  //! Guards the pending sources and center.
+  std::mutex m_Mutex;
+  std::vector<RippleSource> m_PendingSources;
+  glm::vec2 m_PendingCenter;
+  bool m_PendingRecenter;
+  //! The threads used by every pass of a step.
+  ThreadPool m_Pool;
+};
@@ -1,281 +1,658 @@
-/* All content(c) 2016 - 2017 DigiPen(USA) Corporation, all rights reserved. */
-/*****************************************************************************/
-/*!
-\file Shader.cpp
-\author Connor Deakin
-\par E-mail: connor.deakin\@digipen.edu
-\par Project: Graphics
-\date 27/09/2016
-\brief
-  Contains the implementation of the Shader class.
-*/
-/*****************************************************************************/
-
-#include <iostream>
-#include <fstream>
-
-#include "OpenGLError.h"
-
-#include "Shader.h"
-
-//! The size of the buffer (in bytes) that is used to store the errors
-// encountered during the shader link and compile steps.
-#define ERROR_BUFFER_SIZE 512
-
-/*****************************************************************************/
-/*!
-\brief
-  The constructor for a shader. Given the path to the vertex and fragment shader
-  files from the executable directory, the constructor will compile and link
-  the shaders.
-
-\param vertex_file
-  The path to the vertex shader from the executable.
-
-\param fragment_file
-  The path to the fragment shader from the executable.
-*/
-/*****************************************************************************/
-Shader::Shader(const std::string & vertex_file, 
-               const std::string & fragment_file) :
-_vertexFile(vertex_file), _fragmentFile(fragment_file)
-{
-  try
-  {
-    //compile shaders
-    GLuint vshader = CompileShader(vertex_file, GL_VERTEX_SHADER);
-    GLuint fshader = CompileShader(fragment_file, GL_FRAGMENT_SHADER);
-    //link shaders
-    CreateProgram(vshader, fshader);
-  }
-  catch (Error & error) 
-  { 
-    error.Add("<Shader Files Involved>");
-    error.Add(vertex_file.c_str());
-    error.Add(fragment_file.c_str());
-    ErrorLog::Write(error);
-  }
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Will find the location of an attribute given the name of the attribute.
-  Writes an error to the ErrorLog if the attribute is not found.
-
-\par Important Notes
-  - Call Use() on the shader instance before calling this function.
-
-\param name
-  The name of the attribute being searched for.
-
-\return The GLuint attribute location.
-*/
-/*****************************************************************************/
-GLuint Shader::GetAttribLocation(const std::string & name)
-{
-  GLuint attribute_location = glGetAttribLocation(_programID, name.c_str());
-  if (attribute_location == -1) {
-    Error error("Shader.cpp", "GetUniformLocation");
-    error.Add("An attribute was not found.");
-    error.Add("<Attribute name>");
-    error.Add(name.c_str());
-    error.Add("<Shader Files Involved>");
-    error.Add(_vertexFile); error.Add(_fragmentFile);
-    ErrorLog::Write(error);
-  }
-  return attribute_location;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Will find the location of an uniform given the name of the uniform. Writes
-  an error to the ErrorLog if the uniform is not found.
-
-\par Important Notes
-  - Call Use() on the shader instance before calling this function.
-
-\param name
-  The name of the uniform being searched for.
-
-\return The GLuint uniform location.
-*/
-/*****************************************************************************/
-GLuint Shader::GetUniformLocation(const std::string & name)
-{
-  GLuint uniform_location = glGetUniformLocation(_programID, name.c_str());
-  if (uniform_location == -1) {
-    Error error("Shader.cpp", "GetUniformLocation");
-    error.Add("An uniform was not found.");
-    error.Add("<Uniform name>");
-    error.Add(name.c_str());
-    error.Add("<Shader Files Involved>");
-    error.Add(_vertexFile); error.Add(_fragmentFile);
-    ErrorLog::Write(error);
-  }
-  return uniform_location;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  This will return the program ID that OpenGL uses to identify the shader
-  program. This ID is to be used when making OpenGL calls that manipulate this
-  shader.
-
-\return The OpenGL program ID.
-*/
-/*****************************************************************************/
-GLuint Shader::ID() const
-{
-  return _programID;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Will use the shader program created by the shader class for all OpenGL
-  rendering steps that are called after the Shader is activated. Make sure to 
-  call this before executing any drawing code.
-*/
-/*****************************************************************************/
-void Shader::Use() const
-{
-  glUseProgram(_programID);
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Deletes the Shader program. Do this before the shader is de-allocated.
-*/
-/*****************************************************************************/
-void Shader::Purge() const
-{
-  glDeleteProgram(_programID);
-  // error check
-  GLenum error_code = glGetError();
-  if (error_code) {
-    OpenGLError error("Shader.cpp", "Purge");
-    error.Add("Encountered while deleting the Shader program.");
-    error.Code(error_code);
-    throw(error);
-  }
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  This will compile a single shader. If any errors occur during the compilation
-  of the shader, the function will throw an Error.
-
-\param filename
-  The path the shader file from the executable directory.
-\param type
-  The type of shader being compiled. (GL_VERTEX_SHADER, GL_FRAGMENT_SHADER)
-
-\return The ID of the compiled shader.
-*/
-/*****************************************************************************/
-GLuint Shader::CompileShader(const std::string & filename, GLenum type) const
-{
-  //read from file
-  std::string shader_content = ReadShaderFile(filename);
-  const GLchar * shader_cstr = shader_content.c_str();
-  //create and compile
-  GLuint shader = glCreateShader(type);
-  glShaderSource(shader, 1, &shader_cstr, nullptr);
-  glCompileShader(shader);
-  //check for success
-  GLint success;
-  glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-  if (!success)
-  {
-    //print errors
-    GLchar errorlog[ERROR_BUFFER_SIZE];
-    glGetShaderInfoLog(shader, ERROR_BUFFER_SIZE, nullptr, errorlog);
-    Error error("Shader.cpp" ,"CompileShader");
-    error.Add("SHADER COMPILE ERROR");
-    error.Add(filename.c_str());
-    error.Add(errorlog);
-    throw(error);
-  }
-  return shader;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Reads an entire shader file into a standard string.
-
-\param shader_file
-  The path to the shader file that will be read.
-
-\return A standard string containing the contents of the shader file. If the
-  file could not be opened, the function will throw an Error.
-*/
-/*****************************************************************************/
-std::string Shader::ReadShaderFile(const std::string & shader_file) const
-{
-  //opening file
-  std::ifstream file(shader_file.c_str());
-  if (!file.is_open())
-  {
-    Error error("Shader.cpp", "ReadShaderFile");
-    error.Add("The following Shader file failed to open.");
-    error.Add(shader_file.c_str());
-    throw(error);
-  }
-  //copying over data
-  std::string content;
-  std::string line;
-  std::getline(file, line);
-  while (!file.eof())
-  {
-    content.append(line + "\n");
-    std::getline(file, line);
-  }
-  return content;
-}
-
-/*****************************************************************************/
-/*!
-\brief
-  Links and creates the shader program given a compiled vertex and fragment 
-  shader. If any errors occur during the link step, an exception of type Error
-  is thrown. The string contains the linker error generated when the shaders
-  were linked.
-
-\param vshader
-  The compiled vertex shader ID.
-\param fshader
-  The compiled fragment shader ID.
-*/
-/*****************************************************************************/
-void Shader::CreateProgram(GLuint vshader, GLuint fshader)
-{
-  //creating program and linking shaders
-  _programID = glCreateProgram();
-  glAttachShader(_programID, vshader);
-  glAttachShader(_programID, fshader);
-  glLinkProgram(_programID);
-  //checking for success
-  GLint success;
-  glGetProgramiv(_programID, GL_LINK_STATUS, &success);
-  if (!success)
-  {
-    //throw error
-    GLchar errorlog[ERROR_BUFFER_SIZE];
-    glGetProgramInfoLog(_programID, ERROR_BUFFER_SIZE, nullptr, errorlog);
-    Error error("Shader.cpp", "CreateProgram");
-    error.Add("SHADER LINK ERROR");
-    error.Add(errorlog);
-    throw(error);
-  }
-  //deleting shaders
-  glDetachShader(_programID, vshader);
-  glDetachShader(_programID, fshader);
-  glDeleteShader(vshader);
-  glDeleteShader(fshader);
-}
+/* All content(c) 2016 - 2017 DigiPen(USA) Corporation, all rights reserved. */
+/*****************************************************************************/
+/*!
+\file Shader.cpp
+\author Connor Deakin
+\par E-mail: connor.deakin\@digipen.edu
+\par Project: Graphics
+\date 27/09/2016
+\brief
+  Contains the implementation of the Shader class.
+*/
+/*****************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+#include "OpenGLError.h"
+
+#include "Shader.h"
+
+//! The size of the buffer (in bytes) that is used to store the errors
+// encountered during the shader link and compile steps.
+#define ERROR_BUFFER_SIZE 512
+//! The size of the buffer (in bytes) used to read attribute and uniform names
+// during reflection.
+#define NAME_BUFFER_SIZE 256
+//! Identifies a program binary cache file written by the Shader class.
+#define CACHE_MAGIC 0x53484452
+//! Taken from GL_KHR_parallel_shader_compile. The ARB version of the
+// extension uses the same value.
+#define COMPLETION_STATUS 0x91B1
+
+// static initializations
+std::string Shader::_cacheDirectory = "Shader/";
+bool Shader::_parallelCompile = false;
+bool Shader::_programBinary = false;
+
+/*****************************************************************************/
+/*!
+\brief
+  Hashes a string with 64 bit FNV-1a and mixes it into an existing hash.
+
+\param hash
+  The existing hash.
+\param value
+  The string being mixed into the hash.
+
+\return The new hash.
+*/
+/*****************************************************************************/
+static unsigned long long HashString(unsigned long long hash,
+  const std::string & value)
+{
+  for (char c : value) {
+    hash ^= (unsigned char)c;
+    hash *= 0x100000001b3ULL;
+  }
+  // separator so "ab" + "c" and "a" + "bc" hash differently
+  hash ^= 0xff;
+  hash *= 0x100000001b3ULL;
+  return hash;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Reads an OpenGL driver string. Returns an empty string if the driver does
+  not provide it.
+
+\param name
+  The name of the string (GL_VENDOR, GL_RENDERER, GL_VERSION).
+
+\return The driver string.
+*/
+/*****************************************************************************/
+static std::string DriverString(GLenum name)
+{
+  const GLubyte * value = glGetString(name);
+  if (!value)
+    return std::string();
+  return std::string((const char *)value);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  The constructor for a shader. Given the path to the vertex and fragment shader
+  files from the executable directory, the constructor will compile and link
+  the shaders. If a cached program binary exists for the current sources,
+  it is used instead.
+
+\param vertex_file
+  The path to the vertex shader from the executable.
+
+\param fragment_file
+  The path to the fragment shader from the executable.
+
+\param defer_link
+  If true, the compile and link are only started and Finish must be called
+  before the Shader is used. This lets the driver compile many shaders at
+  the same time.
+*/
+/*****************************************************************************/
+Shader::Shader(const std::string & vertex_file, 
+               const std::string & fragment_file, bool defer_link) :
+_programID(0), _vertexFile(vertex_file), _fragmentFile(fragment_file),
+_vertexShader(0), _fragmentShader(0), _sourceHash(0xcbf29ce484222325ULL),
+_finished(false), _fromCache(false)
+{
+  InitializeCompiler();
+  try
+  {
+    //hash the sources and the driver
+    std::string vertex_source = ReadShaderFile(vertex_file);
+    std::string fragment_source = ReadShaderFile(fragment_file);
+    _sourceHash = HashString(_sourceHash, vertex_source);
+    _sourceHash = HashString(_sourceHash, fragment_source);
+    _sourceHash = HashString(_sourceHash, DriverString(GL_VENDOR));
+    _sourceHash = HashString(_sourceHash, DriverString(GL_RENDERER));
+    _sourceHash = HashString(_sourceHash, DriverString(GL_VERSION));
+    if (!LoadBinary())
+    {
+      //compile shaders
+      _vertexShader = CompileShader(vertex_source, GL_VERTEX_SHADER);
+      _fragmentShader = CompileShader(fragment_source, GL_FRAGMENT_SHADER);
+      //link shaders
+      CreateProgram(_vertexShader, _fragmentShader);
+    }
+  }
+  catch (Error & error) 
+  { 
+    error.Add("<Shader Files Involved>");
+    error.Add(vertex_file.c_str());
+    error.Add(fragment_file.c_str());
+    ErrorLog::Write(error);
+    _finished = true;
+  }
+  if (!defer_link)
+    Finish();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Identifies whether the driver has finished compiling and linking the
+  Shader. Finish will not block once this returns true. Drivers without
+  parallel shader compilation always report true.
+
+\return If the Shader can be finished without waiting, true.
+*/
+/*****************************************************************************/
+bool Shader::Ready() const
+{
+  if (_finished || _fromCache || !_parallelCompile)
+    return true;
+  GLint complete = GL_TRUE;
+  glGetProgramiv(_programID, COMPLETION_STATUS, &complete);
+  return complete == GL_TRUE;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Waits for the compile and link to finish, checks them for errors, writes
+  the program binary to the cache, and finds all attribute and uniform
+  locations. Calling this more than once does nothing.
+*/
+/*****************************************************************************/
+void Shader::Finish()
+{
+  if (_finished)
+    return;
+  _finished = true;
+  try
+  {
+    if (!_fromCache)
+    {
+      CheckShader(_vertexShader, _vertexFile);
+      CheckShader(_fragmentShader, _fragmentFile);
+      CheckProgram();
+      SaveBinary();
+    }
+    Reflect();
+  }
+  catch (Error & error)
+  {
+    error.Add("<Shader Files Involved>");
+    error.Add(_vertexFile);
+    error.Add(_fragmentFile);
+    ErrorLog::Write(error);
+  }
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Will find the location of an attribute given the name of the attribute.
+  Writes an error to the ErrorLog if the attribute is not found. The location
+  comes from the table built when the Shader was finished.
+
+\param name
+  The name of the attribute being searched for.
+
+\return The GLuint attribute location.
+*/
+/*****************************************************************************/
+GLuint Shader::GetAttribLocation(const std::string & name)
+{
+  Finish();
+  GLuint attribute_location = FindLocation(_attributes, name);
+  if (attribute_location == -1) {
+    Error error("Shader.cpp", "GetAttribLocation");
+    error.Add("An attribute was not found.");
+    error.Add("<Attribute name>");
+    error.Add(name.c_str());
+    error.Add("<Shader Files Involved>");
+    error.Add(_vertexFile); error.Add(_fragmentFile);
+    ErrorLog::Write(error);
+  }
+  return attribute_location;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Will find the location of an uniform given the name of the uniform. Writes
+  an error to the ErrorLog if the uniform is not found. The location comes
+  from the table built when the Shader was finished.
+
+\param name
+  The name of the uniform being searched for.
+
+\return The GLuint uniform location.
+*/
+/*****************************************************************************/
+GLuint Shader::GetUniformLocation(const std::string & name)
+{
+  Finish();
+  GLuint uniform_location = FindLocation(_uniforms, name);
+  if (uniform_location == -1) {
+    Error error("Shader.cpp", "GetUniformLocation");
+    error.Add("An uniform was not found.");
+    error.Add("<Uniform name>");
+    error.Add(name.c_str());
+    error.Add("<Shader Files Involved>");
+    error.Add(_vertexFile); error.Add(_fragmentFile);
+    ErrorLog::Write(error);
+  }
+  return uniform_location;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  This will return the program ID that OpenGL uses to identify the shader
+  program. This ID is to be used when making OpenGL calls that manipulate this
+  shader.
+
+\return The OpenGL program ID.
+*/
+/*****************************************************************************/
+GLuint Shader::ID() const
+{
+  return _programID;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Will use the shader program created by the shader class for all OpenGL
+  rendering steps that are called after the Shader is activated. Make sure to 
+  call this before executing any drawing code.
+*/
+/*****************************************************************************/
+void Shader::Use() const
+{
+  glUseProgram(_programID);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Deletes the Shader program. Do this before the shader is de-allocated.
+*/
+/*****************************************************************************/
+void Shader::Purge() const
+{
+  glDeleteProgram(_programID);
+  // error check
+  GLenum error_code = glGetError();
+  if (error_code) {
+    OpenGLError error("Shader.cpp", "Purge");
+    error.Add("Encountered while deleting the Shader program.");
+    error.Code(error_code);
+    throw(error);
+  }
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Finds out which optional compiler features the driver supports. Parallel
+  compilation is enabled with as many threads as the driver wants to use.
+*/
+/*****************************************************************************/
+void Shader::InitializeCompiler()
+{
+  static bool initialized = false;
+  if (initialized)
+    return;
+  initialized = true;
+  _programBinary = GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary;
+  _parallelCompile = GLEW_ARB_parallel_shader_compile ||
+    glewIsSupported("GL_KHR_parallel_shader_compile");
+  if (GLEW_ARB_parallel_shader_compile)
+    glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  This will start the compile of a single shader. The compile status is not
+  checked here so the driver is free to compile in the background. Use
+  CheckShader to find out if the compile succeeded.
+
+\param source
+  The source code of the shader.
+\param type
+  The type of shader being compiled. (GL_VERTEX_SHADER, GL_FRAGMENT_SHADER)
+
+\return The ID of the shader.
+*/
+/*****************************************************************************/
+GLuint Shader::CompileShader(const std::string & source, GLenum type) const
+{
+  const GLchar * shader_cstr = source.c_str();
+  //create and compile
+  GLuint shader = glCreateShader(type);
+  glShaderSource(shader, 1, &shader_cstr, nullptr);
+  glCompileShader(shader);
+  return shader;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Checks whether a shader compiled. If any errors occured during the
+  compilation of the shader, the function will throw an Error.
+
+\param shader
+  The ID of the shader.
+\param filename
+  The path the shader file from the executable directory.
+*/
+/*****************************************************************************/
+void Shader::CheckShader(GLuint shader, const std::string & filename) const
+{
+  GLint success;
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+  if (!success)
+  {
+    //print errors
+    GLchar errorlog[ERROR_BUFFER_SIZE];
+    glGetShaderInfoLog(shader, ERROR_BUFFER_SIZE, nullptr, errorlog);
+    Error error("Shader.cpp" ,"CompileShader");
+    error.Add("SHADER COMPILE ERROR");
+    error.Add(filename.c_str());
+    error.Add(errorlog);
+    throw(error);
+  }
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Reads an entire shader file into a standard string.
+
+\param shader_file
+  The path to the shader file that will be read.
+
+\return A standard string containing the contents of the shader file. If the
+  file could not be opened, the function will throw an Error.
+*/
+/*****************************************************************************/
+std::string Shader::ReadShaderFile(const std::string & shader_file) const
+{
+  //opening file
+  std::ifstream file(shader_file.c_str());
+  if (!file.is_open())
+  {
+    Error error("Shader.cpp", "ReadShaderFile");
+    error.Add("The following Shader file failed to open.");
+    error.Add(shader_file.c_str());
+    throw(error);
+  }
+  //copying over data
+  std::string content;
+  std::string line;
+  std::getline(file, line);
+  while (!file.eof())
+  {
+    content.append(line + "\n");
+    std::getline(file, line);
+  }
+  return content;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Creates the shader program given a vertex and fragment shader and starts
+  the link. Use CheckProgram to find out if the link succeeded.
+
+\param vshader
+  The vertex shader ID.
+\param fshader
+  The fragment shader ID.
+*/
+/*****************************************************************************/
+void Shader::CreateProgram(GLuint vshader, GLuint fshader)
+{
+  //creating program and linking shaders
+  _programID = glCreateProgram();
+  if (_programBinary)
+    glProgramParameteri(_programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, 
+      GL_TRUE);
+  glAttachShader(_programID, vshader);
+  glAttachShader(_programID, fshader);
+  glLinkProgram(_programID);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Checks the link of the shader program. If any errors occured during the
+  link step, an exception of type Error is thrown. The string contains the
+  linker error generated when the shaders were linked. The shaders are
+  deleted either way.
+*/
+/*****************************************************************************/
+void Shader::CheckProgram()
+{
+  //checking for success
+  GLint success;
+  glGetProgramiv(_programID, GL_LINK_STATUS, &success);
+  //deleting shaders
+  glDetachShader(_programID, _vertexShader);
+  glDetachShader(_programID, _fragmentShader);
+  glDeleteShader(_vertexShader);
+  glDeleteShader(_fragmentShader);
+  _vertexShader = 0;
+  _fragmentShader = 0;
+  if (!success)
+  {
+    //throw error
+    GLchar errorlog[ERROR_BUFFER_SIZE];
+    glGetProgramInfoLog(_programID, ERROR_BUFFER_SIZE, nullptr, errorlog);
+    Error error("Shader.cpp", "CreateProgram");
+    error.Add("SHADER LINK ERROR");
+    error.Add(errorlog);
+    throw(error);
+  }
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Finds the path of the cache file for the current sources and driver.
+
+\return The path of the cache file. Empty if caching is not possible.
+*/
+/*****************************************************************************/
+std::string Shader::CacheFilename() const
+{
+  if (!_programBinary || _cacheDirectory.empty())
+    return std::string();
+  std::ostringstream filename;
+  filename << _cacheDirectory << std::hex << _sourceHash << ".program";
+  return filename.str();
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Creates the program from the cached program binary if one exists. A cache
+  file that the driver rejects is ignored so the shaders are compiled again.
+
+\return If the program was created from the cache, true.
+*/
+/*****************************************************************************/
+bool Shader::LoadBinary()
+{
+  std::string filename = CacheFilename();
+  if (filename.empty())
+    return false;
+  std::ifstream file(filename.c_str(), std::ios::binary);
+  if (!file.is_open())
+    return false;
+  // header
+  GLuint magic = 0;
+  GLenum format = 0;
+  GLint length = 0;
+  file.read((char *)&magic, sizeof(magic));
+  file.read((char *)&format, sizeof(format));
+  file.read((char *)&length, sizeof(length));
+  if (!file || magic != CACHE_MAGIC || length <= 0)
+    return false;
+  // binary
+  std::vector<char> binary(length);
+  file.read(binary.data(), length);
+  if (!file)
+    return false;
+  _programID = glCreateProgram();
+  glProgramBinary(_programID, format, binary.data(), length);
+  GLint success;
+  glGetProgramiv(_programID, GL_LINK_STATUS, &success);
+  if (!success)
+  {
+    glDeleteProgram(_programID);
+    _programID = 0;
+    return false;
+  }
+  _fromCache = true;
+  return true;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Writes the linked program binary to the cache. Nothing is written if the
+  driver does not support program binaries or the file can not be opened.
+*/
+/*****************************************************************************/
+void Shader::SaveBinary() const
+{
+  std::string filename = CacheFilename();
+  if (filename.empty())
+    return;
+  GLint length = 0;
+  glGetProgramiv(_programID, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0)
+    return;
+  std::vector<char> binary(length);
+  GLenum format = 0;
+  glGetProgramBinary(_programID, length, nullptr, &format, binary.data());
+  std::ofstream file(filename.c_str(), std::ios::binary);
+  if (!file.is_open())
+    return;
+  GLuint magic = CACHE_MAGIC;
+  file.write((const char *)&magic, sizeof(magic));
+  file.write((const char *)&format, sizeof(format));
+  file.write((const char *)&length, sizeof(length));
+  file.write(binary.data(), length);
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Finds the location of every active attribute and uniform in the program
+  and stores them in tables sorted by name. Uniform arrays are stored under
+  "name", "name[0]", and "name[i]" for every other element.
+*/
+/*****************************************************************************/
+void Shader::Reflect()
+{
+  _attributes.clear();
+  _uniforms.clear();
+  GLchar name[NAME_BUFFER_SIZE];
+  GLsizei name_length;
+  GLint size;
+  GLenum type;
+  // attributes
+  GLint num_attributes = 0;
+  glGetProgramiv(_programID, GL_ACTIVE_ATTRIBUTES, &num_attributes);
+  for (GLint i = 0; i < num_attributes; ++i)
+  {
+    glGetActiveAttrib(_programID, i, NAME_BUFFER_SIZE, &name_length, &size,
+      &type, name);
+    Location location;
+    location._name.assign(name, name_length);
+    location._location = glGetAttribLocation(_programID, name);
+    _attributes.push_back(location);
+  }
+  // uniforms
+  GLint num_uniforms = 0;
+  glGetProgramiv(_programID, GL_ACTIVE_UNIFORMS, &num_uniforms);
+  for (GLint i = 0; i < num_uniforms; ++i)
+  {
+    glGetActiveUniform(_programID, i, NAME_BUFFER_SIZE, &name_length, &size,
+      &type, name);
+    Location location;
+    location._name.assign(name, name_length);
+    location._location = glGetUniformLocation(_programID, name);
+    _uniforms.push_back(location);
+    std::string::size_type bracket = location._name.find("[0]");
+    if (bracket != std::string::npos && 
+      bracket + 3 == location._name.size())
+    {
+      location._name.erase(bracket);
+      _uniforms.push_back(location);
+      // The other elements are queried because the spec does not promise
+      // that they follow the first element's location.
+      std::string array_name = location._name;
+      for (GLint element = 1; element < size; ++element)
+      {
+        location._name = array_name + "[" + std::to_string(element) + "]";
+        location._location = glGetUniformLocation(_programID,
+          location._name.c_str());
+        _uniforms.push_back(location);
+      }
+    }
+  }
+  std::sort(_attributes.begin(), _attributes.end());
+  std::sort(_uniforms.begin(), _uniforms.end());
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Searches a reflection table for a name.
+
+\param table
+  The sorted table being searched.
+\param name
+  The name of the attribute or uniform.
+
+\return The location or -1 if the name is not in the table.
+*/
+/*****************************************************************************/
+GLint Shader::FindLocation(const std::vector<Location> & table,
+  const std::string & name) const
+{
+  Location key;
+  key._name = name;
+  std::vector<Location>::const_iterator it = 
+    std::lower_bound(table.begin(), table.end(), key);
+  if (it == table.end() || it->_name != name)
+    return -1;
+  return it->_location;
+}
+
+/*****************************************************************************/
+/*!
+\brief
+  Orders Locations by name.
+
+\param other
+  The Location being compared against.
+
+\return If this Location's name comes first, true.
+*/
+/*****************************************************************************/
+bool Shader::Location::operator<(const Location & other) const
+{
+  return _name < other._name;
+}
@@ -1,78 +1,133 @@
-/* All content(c) 2016 - 2017 DigiPen(USA) Corporation, all rights reserved. */
-/*****************************************************************************/
-/*!
-\file Shader.h
-\author Connor Deakin
-\par E-mail: connor.deakin\@digipen.edu
-\par Project: Graphics
-\date 27/09/2016
-\brief
-  Contains the interface for the Shader class which is responsible for
-  reading, compiling, linking, and activating shader programs.
-*/
-/*****************************************************************************/
-#ifndef SHADER_H
-#define SHADER_H
-
-#include <string>
-#include <GL\glew.h>
-
-#include "Error.h"
-
-/*****************************************************************************/
-/*!
-\class Shader
-\brief
-  This is responsible for managing everything to do with shaders.
-  Given the files that the vertex shader and fragment shader are located in, the
-  shader class will compile, link, and use those shaders to create a shader
-  program. That shader can then be managed with this object. Contact me if you 
-  want to know about how to write and manipulate shaders.
-*/
-/*****************************************************************************/
-class Shader
-{
-  public:
-    Shader(const std::string & vertex_file, const std::string & fragment_file);
-    GLuint GetAttribLocation(const std::string & name);
-    GLuint GetUniformLocation(const std::string & name);
-    GLuint ID() const;
-    virtual void Use() const;
-    void Purge() const;
-  protected:
-    //! The ID of the program created after linking the shaders.
-    GLuint _programID;
-    //! The name of the vertex shader file.
-    std::string _vertexFile;
-    //! The name of the fragment shader file.
-    std::string _fragmentFile;
-  private:
-    GLuint CompileShader(const std::string & filename, GLenum type) const;
-    std::string ReadShaderFile(const std::string & shader_file) const;
-    void CreateProgram(GLuint vshader, GLuint fshader);
-};
-
-// Use GetAttribLocation instead
-// Here for legacy code
-//! Throws an error if an attribute was not found in the shader.
-#define CHECKATTRIBUTE(attribute, name, vert_file, frag_file)\
-if(attribute == -1) {\
-  Error error("Shader.h", "CHECKATTRIBUTE");\
-  error.Add("The "##name##" attribute was not found.");\
-  error.Add("<Shader Files Involved>");\
-  error.Add(vert_file); error.Add(frag_file);\
-  throw(error);\
-}
-// Use GetUniformLocation instead
-// Here for legacy code
-//! Throws an error if an uniform was not found in the shader.
-#define CHECKUNIFORM(uniform, name, vert_file, frag_file)\
-if(uniform == -1) {\
-  Error error("Shader.h", "CHECKUNIFORM");\
-  error.Add("The "##name##" uniform was not found.");\
-  error.Add("<Shader Files Involved>");\
-  error.Add(vert_file); error.Add(frag_file);\
-  throw(error);\
-}
-
-#endif // SHADER_H
+/* All content(c) 2016 - 2017 DigiPen(USA) Corporation, all rights reserved. */
+/*****************************************************************************/
+/*!
+\file Shader.h
+\author Connor Deakin
+\par E-mail: connor.deakin\@digipen.edu
+\par Project: Graphics
+\date 27/09/2016
+\brief
+  Contains the interface for the Shader class which is responsible for
+  reading, compiling, linking, and activating shader programs.
+*/
+/*****************************************************************************/
+#ifndef SHADER_H
+#define SHADER_H
+
+#include <string>
+#include <vector>
+#include <GL\glew.h>
+
+#include "Error.h"
+
+/*****************************************************************************/
+/*!
+\class Shader
+\brief
+  This is responsible for managing everything to do with shaders.
+  Given the files that the vertex shader and fragment shader are located in, the
+  shader class will compile, link, and use those shaders to create a shader
+  program. That shader can then be managed with this object. Contact me if you 
+  want to know about how to write and manipulate shaders.
+
+  Linked programs are cached as program binaries in the directory given by
+  _cacheDirectory. The cache file is named after a hash of both shader sources
+  and the OpenGL driver strings, so editing a shader or updating the driver
+  causes a fresh compile. All attribute and uniform locations are found in a
+  single reflection pass after linking and stored in sorted tables, so the
+  location getters never ask the driver.
+
+\par Important Notes
+  - When many shaders are created at once, construct them with defer_link set
+    to true and call Finish on each of them afterwards. The drivers that
+    support GL_KHR_parallel_shader_compile (or the ARB version) will then
+    compile all of them at the same time. Ready can be used to poll.
+*/
+/*****************************************************************************/
+class Shader
+{
+  public:
+    Shader(const std::string & vertex_file, const std::string & fragment_file,
+      bool defer_link = false);
+    bool Ready() const;
+    void Finish();
+    GLuint GetAttribLocation(const std::string & name);
+    GLuint GetUniformLocation(const std::string & name);
+    GLuint ID() const;
+    virtual void Use() const;
+    void Purge() const;
+    //! The directory that program binaries are cached in. An empty string
+    // disables the cache.
+    static std::string _cacheDirectory;
+  protected:
+    //! The ID of the program created after linking the shaders.
+    GLuint _programID;
+    //! The name of the vertex shader file.
+    std::string _vertexFile;
+    //! The name of the fragment shader file.
+    std::string _fragmentFile;
+  private:
+    //! A name and location pair found during reflection.
+    struct Location
+    {
+      std::string _name;
+      GLint _location;
+      bool operator<(const Location & other) const;
+    };
+    static void InitializeCompiler();
+    GLuint CompileShader(const std::string & source, GLenum type) const;
+    void CheckShader(GLuint shader, const std::string & filename) const;
+    std::string ReadShaderFile(const std::string & shader_file) const;
+    void CreateProgram(GLuint vshader, GLuint fshader);
+    void CheckProgram();
+    std::string CacheFilename() const;
+    bool LoadBinary();
+    void SaveBinary() const;
+    void Reflect();
+    GLint FindLocation(const std::vector<Location> & table,
+      const std::string & name) const;
+    //! The compiled vertex shader. Zero once the program is linked.
+    GLuint _vertexShader;
+    //! The compiled fragment shader. Zero once the program is linked.
+    GLuint _fragmentShader;
+    //! A hash of the shader sources and the driver used to name the cache
+    // file.
+    unsigned long long _sourceHash;
+    //! Tracks whether the link has been checked and reflection performed.
+    bool _finished;
+    //! Tracks whether the program was loaded from the binary cache.
+    bool _fromCache;
+    //! All active attributes sorted by name.
+    std::vector<Location> _attributes;
+    //! All active uniforms sorted by name.
+    std::vector<Location> _uniforms;
+    //! Whether the driver can report compile completion without blocking.
+    static bool _parallelCompile;
+    //! Whether the driver supports program binaries.
+    static bool _programBinary;
+};
+
+// Use GetAttribLocation instead
+// Here for legacy code
+//! Throws an error if an attribute was not found in the shader.
+#define CHECKATTRIBUTE(attribute, name, vert_file, frag_file)\
+if(attribute == -1) {\
+  Error error("Shader.h", "CHECKATTRIBUTE");\
+  error.Add("The "##name##" attribute was not found.");\
+  error.Add("<Shader Files Involved>");\
+  error.Add(vert_file); error.Add(frag_file);\
+  throw(error);\
+}
+// Use GetUniformLocation instead
+// Here for legacy code
+//! Throws an error if an uniform was not found in the shader.
+#define CHECKUNIFORM(uniform, name, vert_file, frag_file)\
+if(uniform == -1) {\
+  Error error("Shader.h", "CHECKUNIFORM");\
+  error.Add("The "##name##" uniform was not found.");\
+  error.Add("<Shader Files Involved>");\
+  error.Add(vert_file); error.Add(frag_file);\
+  throw(error);\
+}
+
+#endif // SHADER_H
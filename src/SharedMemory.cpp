@@ -0,0 +1,193 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file SharedMemory.cpp
+/// @date 2026-10-17
+///
+/// @brief Contains the implementation of the memory shared between processes.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Error.h"
+
+#include "SharedMemory.h"
+
+#ifndef _WIN32
+// shm_open names must start with a slash.
+static std::string PosixName(const std::string & name)
+{
+  if (!name.empty() && name[0] == '/')
+    return name;
+  return "/" + name;
+}
+#endif
+
+SharedMemory::SharedMemory() :
+  m_Data(nullptr), m_Size(0), m_Owner(false), m_Handle(nullptr)
+{}
+
+SharedMemory::~SharedMemory()
+{
+  Close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Creates a block and maps it. The block is filled with zeros. An
+/// existing block with the same name is replaced.
+///
+/// @param name The name other processes open the block with.
+/// @param bytes The size of the block.
+///////////////////////////////////////////////////////////////////////////////
+void SharedMemory::Create(const std::string & name, size_t bytes)
+{
+  Close();
+  Error error("SharedMemory.cpp", "SharedMemory::Create");
+#ifdef _WIN32
+  unsigned long long size = bytes;
+  HANDLE handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr,
+    PAGE_READWRITE, (DWORD)(size >> 32), (DWORD)size, name.c_str());
+  if (!handle)
+  {
+    error.Add("CreateFileMapping failed for " + name + ".");
+    throw(error);
+  }
+  void * data = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+  if (!data)
+  {
+    CloseHandle(handle);
+    error.Add("MapViewOfFile failed for " + name + ".");
+    throw(error);
+  }
+  m_Handle = handle;
+#else
+  std::string posix_name = PosixName(name);
+  shm_unlink(posix_name.c_str());
+  int file = shm_open(posix_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (file < 0)
+  {
+    error.Add("shm_open failed for " + posix_name + ": " +
+      strerror(errno));
+    throw(error);
+  }
+  if (ftruncate(file, (off_t)bytes) != 0)
+  {
+    close(file);
+    shm_unlink(posix_name.c_str());
+    error.Add("ftruncate failed for " + posix_name + ": " + strerror(errno));
+    throw(error);
+  }
+  void * data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+    file, 0);
+  close(file);
+  if (data == MAP_FAILED)
+  {
+    shm_unlink(posix_name.c_str());
+    error.Add("mmap failed for " + posix_name + ": " + strerror(errno));
+    throw(error);
+  }
+#endif
+  m_Name = name;
+  m_Data = data;
+  m_Size = bytes;
+  m_Owner = true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Maps a block created by another process.
+///
+/// @param name The name the block was created with.
+///////////////////////////////////////////////////////////////////////////////
+void SharedMemory::Open(const std::string & name)
+{
+  Close();
+  Error error("SharedMemory.cpp", "SharedMemory::Open");
+#ifdef _WIN32
+  HANDLE handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+  if (!handle)
+  {
+    error.Add("OpenFileMapping failed for " + name + ".");
+    throw(error);
+  }
+  void * data = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+  MEMORY_BASIC_INFORMATION info;
+  if (!data || !VirtualQuery(data, &info, sizeof(info)))
+  {
+    if (data)
+      UnmapViewOfFile(data);
+    CloseHandle(handle);
+    error.Add("MapViewOfFile failed for " + name + ".");
+    throw(error);
+  }
+  m_Handle = handle;
+  size_t bytes = info.RegionSize;
+#else
+  std::string posix_name = PosixName(name);
+  int file = shm_open(posix_name.c_str(), O_RDWR, 0);
+  if (file < 0)
+  {
+    error.Add("shm_open failed for " + posix_name + ": " +
+      strerror(errno));
+    throw(error);
+  }
+  struct stat status;
+  if (fstat(file, &status) != 0 || status.st_size <= 0)
+  {
+    close(file);
+    error.Add("The block " + posix_name + " has no size.");
+    throw(error);
+  }
+  size_t bytes = (size_t)status.st_size;
+  void * data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+    file, 0);
+  close(file);
+  if (data == MAP_FAILED)
+  {
+    error.Add("mmap failed for " + posix_name + ": " + strerror(errno));
+    throw(error);
+  }
+#endif
+  m_Name = name;
+  m_Data = data;
+  m_Size = bytes;
+  m_Owner = false;
+}
+
+//! Unmaps the block and removes its name if this process created it.
+void SharedMemory::Close()
+{
+  if (!m_Data)
+    return;
+#ifdef _WIN32
+  UnmapViewOfFile(m_Data);
+  CloseHandle((HANDLE)m_Handle);
+  m_Handle = nullptr;
+#else
+  munmap(m_Data, m_Size);
+  if (m_Owner)
+    shm_unlink(PosixName(m_Name).c_str());
+#endif
+  m_Data = nullptr;
+  m_Size = 0;
+  m_Owner = false;
+}
+
+void * SharedMemory::Data() const
+{
+  return m_Data;
+}
+
+//! The size of the mapping. On Windows this is rounded up to whole pages.
+size_t SharedMemory::Size() const
+{
+  return m_Size;
+}
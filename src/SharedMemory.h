@@ -0,0 +1,45 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file SharedMemory.h
+/// @date 2026-10-17
+///
+/// @brief Contains the interface for named memory that is shared between
+/// processes.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// A named block of memory mapped into this process. The creator of a block
+/// owns its name. POSIX systems use shm_open and Windows uses a named file
+/// mapping.
+///
+/// Important Notes
+/// - The name is removed when the creator closes the block. Processes that
+///   already opened it keep their mapping until they close it.
+///////////////////////////////////////////////////////////////////////////////
+class SharedMemory
+{
+public:
+  SharedMemory();
+  ~SharedMemory();
+  SharedMemory(const SharedMemory & other) = delete;
+  SharedMemory & operator=(const SharedMemory & other) = delete;
+  void Create(const std::string & name, size_t bytes);
+  void Open(const std::string & name);
+  void Close();
+  void * Data() const;
+  size_t Size() const;
+private:
+  //! The name the block was created or opened with.
+  std::string m_Name;
+  //! The mapped memory. Null when nothing is mapped.
+  void * m_Data;
+  size_t m_Size;
+  //! Identifies whether this process created the block.
+  bool m_Owner;
+  //! The file mapping handle on Windows. It is unused elsewhere.
+  void * m_Handle;
+};
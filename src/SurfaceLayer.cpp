@@ -0,0 +1,53 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file SurfaceLayer.cpp
+/// @date 2026-10-17
+///
+/// @brief Contains the sampling shared by the surface layers.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "SurfaceLayer.h"
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Adds the bilinearly filtered heights and slopes of a window along a
+/// row of locations. Locations outside of the window add nothing. This is the
+/// usual way to implement SurfaceLayer::SampleRow.
+///
+/// @param window The window being sampled.
+///
+/// @return False when the row misses the window.
+///////////////////////////////////////////////////////////////////////////////
+bool AddWindowRow(const LayerWindow & window, float z, float x_start,
+  float dx, unsigned count, float * height, float * slope_x, float * slope_z)
+{
+  float half = 0.5f * (float)window.m_Dimension;
+  float fz = z / window.m_CellSize - (float)window.m_CenterZ + half;
+  float last = (float)(window.m_Dimension - 1);
+  if (!(fz >= 0.0f && fz <= last))
+    return false;
+  int z0 = std::min((int)fz, (int)window.m_Dimension - 2);
+  float tz = fz - (float)z0;
+  unsigned row = (z0 + window.m_Padding) * window.m_Stride + window.m_Padding;
+  const float * fields[] = { window.m_Height, window.m_SlopeX,
+    window.m_SlopeZ };
+  float * outputs[] = { height, slope_x, slope_z };
+  for (unsigned i = 0; i < count; ++i)
+  {
+    float fx = (x_start + dx * (float)i) / window.m_CellSize -
+      (float)window.m_CenterX + half;
+    if (!(fx >= 0.0f && fx <= last))
+      continue;
+    int x0 = std::min((int)fx, (int)window.m_Dimension - 2);
+    float tx = fx - (float)x0;
+    for (unsigned f = 0; f < 3; ++f)
+    {
+      const float * top_row = fields[f] + row + x0;
+      const float * bottom_row = top_row + window.m_Stride;
+      float top = top_row[0] + (top_row[1] - top_row[0]) * tx;
+      float bottom = bottom_row[0] + (bottom_row[1] - bottom_row[0]) * tx;
+      outputs[f][i] += top + (bottom - top) * tz;
+    }
+  }
+  return true;
+}
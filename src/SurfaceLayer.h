@@ -0,0 +1,69 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file SurfaceLayer.h
+/// @date 2026-10-17
+///
+/// @brief Contains the interface for height fields that are added on top of
+/// the WaterFFT surface.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <GLM\glm\glm.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// A height field on a window that is added to the WaterFFT vertices while
+/// they are written.
+///
+/// Important Notes
+/// - Advance and SampleRow are called by WaterFFT::Update on the simulation
+///   thread.
+///////////////////////////////////////////////////////////////////////////////
+class SurfaceLayer
+{
+public:
+  virtual ~SurfaceLayer() {}
+  //! Brings the layer to a simulation time in seconds.
+  virtual void Advance(double time) = 0;
+  //! The location on the xz plane the layer's window is centered on.
+  virtual glm::vec2 Center() const = 0;
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Adds the layer's heights and slopes along a row of locations.
+  ///
+  /// @param z The z location of the row.
+  /// @param x_start The x location of the first value.
+  /// @param dx The distance between values.
+  /// @param count The number of values.
+  /// @param height The heights are added here.
+  /// @param slope_x The slopes in the x direction are added here.
+  /// @param slope_z The slopes in the z direction are added here.
+  ///
+  /// @return False when the row misses the window. Nothing is added then.
+  //////////////////////////////////////////////////////////////////////////////
+  virtual bool SampleRow(float z, float x_start, float dx, unsigned count,
+    float * height, float * slope_x, float * slope_z) const = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// A square window of cells that a layer stores its heights and slopes in.
+/// The cells are row major and each row is m_Stride floats long. Cell (0, 0)
+/// of the window is m_Padding rows and columns into each array.
+///////////////////////////////////////////////////////////////////////////////
+struct LayerWindow
+{
+  const float * m_Height;
+  const float * m_SlopeX;
+  const float * m_SlopeZ;
+  //! The number of cells along each side of the window.
+  unsigned m_Dimension;
+  unsigned m_Stride;
+  unsigned m_Padding;
+  //! The length of a cell in meters.
+  float m_CellSize;
+  //! The cell the window is centered on.
+  int m_CenterX;
+  int m_CenterZ;
+};
+
+bool AddWindowRow(const LayerWindow & window, float z, float x_start,
+  float dx, unsigned count, float * height, float * slope_x, float * slope_z);
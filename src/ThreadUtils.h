@@ -1,43 +1,139 @@
-#pragma once
-#include <mutex>
-#include <condition_variable>
-#include <functional>
-
-class Barrier
-{
-public:
-  Barrier()
-  {}
-  Barrier(int total_threads) :
-    m_KnockedDown(false), m_ThreadsLeft(total_threads), m_TotalThreads(total_threads)
-  {}
-  void WaitForAllThreads(std::function<void()> single_callback, 
-    bool knock_down)
-  {
-    if(knock_down)
-    {
-      m_KnockedDown = true;
-      m_CV.notify_all();
-    }
-    if(!m_KnockedDown)
-    {
-      std::unique_lock<std::mutex> lock(m_Mutex);
-      --m_ThreadsLeft;
-      if (m_ThreadsLeft == 0)
-      {
-        single_callback();
-        m_ThreadsLeft = m_TotalThreads;
-        m_CV.notify_all();
-      }
-      else
-      {
-        m_CV.wait(lock);
-      }
-    }
-  }
-  std::mutex m_Mutex;
-  std::condition_variable m_CV;
-  bool m_KnockedDown;
-  int m_ThreadsLeft;
-  int m_TotalThreads;
-};
\ No newline at end of file
+#pragma once
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <thread>
+#include <vector>
+
+class Barrier
+{
+public:
+  Barrier()
+  {}
+  Barrier(int total_threads) :
+    m_KnockedDown(false), m_ThreadsLeft(total_threads), m_TotalThreads(total_threads)
+  {}
+  void WaitForAllThreads(std::function<void()> single_callback, 
+    bool knock_down)
+  {
+    if(knock_down)
+    {
+      m_KnockedDown = true;
+      m_CV.notify_all();
+    }
+    if(!m_KnockedDown)
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      --m_ThreadsLeft;
+      if (m_ThreadsLeft == 0)
+      {
+        single_callback();
+        m_ThreadsLeft = m_TotalThreads;
+        m_CV.notify_all();
+      }
+      else
+      {
+        m_CV.wait(lock);
+      }
+    }
+  }
+  std::mutex m_Mutex;
+  std::condition_variable m_CV;
+  bool m_KnockedDown;
+  int m_ThreadsLeft;
+  int m_TotalThreads;
+};
+
+// Splits a range of work between a fixed set of threads. The calling thread
+// does the first part of the range itself, so a pool made with one thread
+// runs everything on the caller.
+//
+// Kernels run on a pool find each result inside a single range in a fixed
+// order and never combine values across ranges. That keeps their results
+// the same for any number of threads, which WaterFFT's determinism relies on.
+class ThreadPool
+{
+public:
+  ThreadPool(unsigned total_threads) :
+    m_Generation(0), m_Busy(0), m_Count(0), m_Running(true)
+  {
+    if (total_threads == 0)
+      total_threads = 1;
+    for (unsigned i = 1; i < total_threads; ++i)
+      m_Threads.push_back(std::thread(&ThreadPool::Work, this, i));
+  }
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Running = false;
+    }
+    m_Start.notify_all();
+    for (std::thread & thread : m_Threads)
+      thread.join();
+  }
+  unsigned TotalThreads() const
+  {
+    return (unsigned)m_Threads.size() + 1;
+  }
+  // Calls work(begin, end) once per thread with contiguous ranges that cover
+  // [0, count) and returns when every range is finished.
+  void ParallelFor(unsigned count,
+    const std::function<void(unsigned, unsigned)> & work)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Work = work;
+      m_Count = count;
+      m_Busy = (unsigned)m_Threads.size();
+      ++m_Generation;
+    }
+    m_Start.notify_all();
+    unsigned begin, end;
+    Range(0, &begin, &end);
+    if (begin < end)
+      work(begin, end);
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Done.wait(lock, [this]() { return m_Busy == 0; });
+  }
+private:
+  void Range(unsigned part, unsigned * begin, unsigned * end) const
+  {
+    unsigned parts = TotalThreads();
+    *begin = (unsigned)((unsigned long long)m_Count * part / parts);
+    *end = (unsigned)((unsigned long long)m_Count * (part + 1) / parts);
+  }
+  void Work(unsigned part)
+  {
+    unsigned generation = 0;
+    while (true)
+    {
+      std::function<void(unsigned, unsigned)> work;
+      unsigned begin, end;
+      {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Start.wait(lock, [&]()
+          { return !m_Running || m_Generation != generation; });
+        if (!m_Running)
+          return;
+        generation = m_Generation;
+        work = m_Work;
+        Range(part, &begin, &end);
+      }
+      if (begin < end)
+        work(begin, end);
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if (--m_Busy == 0)
+        m_Done.notify_one();
+    }
+  }
+  std::vector<std::thread> m_Threads;
+  std::mutex m_Mutex;
+  std::condition_variable m_Start;
+  std::condition_variable m_Done;
+  std::function<void(unsigned, unsigned)> m_Work;
+  unsigned m_Generation;
+  unsigned m_Busy;
+  unsigned m_Count;
+  bool m_Running;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+#include "Time.h"
+#include "WaterFFT.h"
+
+// 30 days of frames at 60 fps
+#define TEST_TIME_STEP (1.0f / 60.0f)
+#define TEST_TIME_DAYS 30
+#define TEST_TIME_FRAMES (TEST_TIME_DAYS * 24 * 60 * 60 * 60)
+
+void test_time();
+void test_time_continuity();
+void test_phase_continuity();
+
+void test_time()
+{
+  test_time_continuity();
+  test_phase_continuity();
+}
+
+// Updates Time with a fixed step for 30 days of frames and checks that the
+// scaled total time moves forward by the step every frame.
+void test_time_continuity()
+{
+  Time::FixedStep(TEST_TIME_STEP);
+  double start = Time::TotalTimeScaledPrecise();
+  double previous = start;
+  double max_error = 0.0;
+  for (unsigned frame = 0; frame < TEST_TIME_FRAMES; ++frame)
+  {
+    Time::Update();
+    double current = Time::TotalTimeScaledPrecise();
+    double error = std::fabs((current - previous) - TEST_TIME_STEP);
+    if (error > max_error)
+      max_error = error;
+    previous = current;
+  }
+  Time::FixedStep(0.0f);
+  double days = (previous - start) / (24.0 * 60.0 * 60.0);
+  // days: 30, max error: less than 1e-6
+  std::cout << "days: " << days << ", max frame step error: " << max_error
+    << (max_error < 1.0e-6 ? " PASS" : " FAIL") << std::endl;
+}
+
+// Checks that the phase angle used by WaterFFT::HTilde advances by
+// omega * step between consecutive frames after 30 days. The frequencies
+// cover the range produced by WaterFFT::DispersionRelation.
+void test_phase_continuity()
+{
+  double start = (double)TEST_TIME_FRAMES * TEST_TIME_STEP;
+  float w_0 = 6.28318530718f / 200.0f;
+  double max_error = 0.0;
+  for (unsigned n = 1; n <= 200; ++n)
+  {
+    float omega = w_0 * (float)n;
+    for (unsigned frame = 0; frame < 600; ++frame)
+    {
+      double time = start + (double)frame * TEST_TIME_STEP;
+      float a = PhaseAngle(omega, time);
+      float b = PhaseAngle(omega, time + TEST_TIME_STEP);
+      // the difference between the angles is compared on the unit circle
+      // so wrapping past TAU does not count as an error
+      float expected = omega * TEST_TIME_STEP;
+      double error = std::fabs(std::sin((double)b - (double)a - expected));
+      if (error > max_error)
+        max_error = error;
+    }
+  }
+  // max error: less than 1e-4
+  std::cout << "max phase step error: " << max_error
+    << (max_error < 1.0e-4 ? " PASS" : " FAIL") << std::endl;
+}
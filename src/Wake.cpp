@@ -0,0 +1,387 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file Wake.cpp
+/// @date 2026-10-17
+///
+/// @brief Contains the implementation of the Kelvin wakes.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "Error.h"
+
+#include "Wake.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define WAKE_SIMD
+#include <emmintrin.h>
+#endif
+
+#define WAKE_PI 3.14159265358979323846
+// tan(asin(1 / 3)), the half angle of a Kelvin wedge.
+#define WAKE_KELVIN_TAN 0.35355339059327376220f
+// The size of the pattern table in table units, where one unit is U^2 / g
+// meters. A transverse wave is 2 * PI units long, so the table holds about
+// ten of them. The margin widens the wedge so the cusps are not cut off.
+#define WAKE_PATTERN_LENGTH 64.0f
+#define WAKE_PATTERN_MARGIN 4.0f
+#define WAKE_PATTERN_WIDTH \
+  (WAKE_PATTERN_LENGTH * WAKE_KELVIN_TAN + WAKE_PATTERN_MARGIN)
+#define WAKE_PATTERN_STEP 0.25f
+// The number of wave directions summed for each value of the table and the
+// damping of the short waves that travel close to sideways.
+#define WAKE_PATTERN_ANGLES 256
+#define WAKE_SHORT_WAVE_DAMPING 0.1
+// Wakes whose transverse waves are shorter than this many cells are skipped.
+#define WAKE_MIN_WAVELENGTH_CELLS 2.0f
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Creates a window without any ships centered on the origin.
+///
+/// @param dimension The number of cells along each side of the window.
+/// @param cell_size The length of a cell in meters.
+/// @param threads The number of threads used by Advance, including the one
+///   calling it. Zero uses one thread per core.
+///////////////////////////////////////////////////////////////////////////////
+Wake::Wake(unsigned dimension, float cell_size, unsigned threads) :
+  m_Steepness(0.02f), m_CullDistance(1024.0f), m_Gravity(9.81f),
+  m_Dimension(dimension), m_Stride(dimension + 2), m_CellSize(cell_size),
+  m_CenterX(0), m_CenterZ(0), m_ActiveShips(0),
+  m_PendingCenter(0.0f, 0.0f), m_Pool(threads ? threads : std::thread::hardware_concurrency())
+{
+  if (dimension < 2 || cell_size <= 0.0f)
+  {
+    Error error("Wake.cpp", "Wake::Wake");
+    error.Add("The wake dimension must be at least 2 and the cell size must "
+      "be positive.");
+    throw(error);
+  }
+  m_Height.assign(m_Stride * m_Stride, 0.0f);
+  m_SlopeX.assign(m_Stride * m_Stride, 0.0f);
+  m_SlopeZ.assign(m_Stride * m_Stride, 0.0f);
+  BuildPattern();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Replaces the ships used by the next Advance.
+///
+/// @param ships The state of every ship.
+/// @param count The number of ships.
+///////////////////////////////////////////////////////////////////////////////
+void Wake::SetShips(const ShipTrack * ships, unsigned count)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Ships.assign(ships, ships + count);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Moves the window so it is centered on a location. The window is
+/// snapped to whole cells.
+///
+/// @param center The location on the xz plane.
+///////////////////////////////////////////////////////////////////////////////
+void Wake::Recenter(const glm::vec2 & center)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_PendingCenter = center;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Rebuilds the window from the latest ships. A wake only depends on
+/// the ship's state, so the time is not used.
+///////////////////////////////////////////////////////////////////////////////
+void Wake::Advance(double)
+{
+  std::vector<ShipTrack> ships;
+  glm::vec2 center;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ships = m_Ships;
+    center = m_PendingCenter;
+  }
+  m_CenterX = (int)std::floor(center.x / m_CellSize + 0.5f);
+  m_CenterZ = (int)std::floor(center.y / m_CellSize + 0.5f);
+
+  // Find the ships whose wedges reach the window.
+  bool was_empty = m_Active.empty();
+  m_Active.clear();
+  glm::vec2 window_center = glm::vec2(m_CenterX, m_CenterZ) * m_CellSize;
+  glm::vec2 origin = glm::vec2(m_CenterX, m_CenterZ) -
+    glm::vec2(0.5f * (float)m_Dimension);
+  float last = (float)(m_Dimension - 1);
+  for (const ShipTrack & ship : ships)
+  {
+    float u2 = ship.m_Speed * ship.m_Speed;
+    float wavelength = 2.0f * (float)WAKE_PI * u2 / m_Gravity;
+    if (wavelength < WAKE_MIN_WAVELENGTH_CELLS * m_CellSize)
+      continue;
+    if (glm::length(ship.m_Location - window_center) > m_CullDistance)
+      continue;
+    ActiveShip active;
+    active.m_Cell = ship.m_Location / m_CellSize - origin;
+    active.m_Forward = glm::vec2(std::cos(ship.m_Heading),
+      std::sin(ship.m_Heading));
+    active.m_Scale = m_Gravity * m_CellSize / u2;
+    active.m_Amplitude = m_Steepness * wavelength;
+    glm::vec2 side(-active.m_Forward.y, active.m_Forward.x);
+    float length = WAKE_PATTERN_LENGTH / active.m_Scale;
+    float width = WAKE_PATTERN_WIDTH / active.m_Scale;
+    float margin = WAKE_PATTERN_MARGIN / active.m_Scale;
+    glm::vec2 tail = active.m_Cell - active.m_Forward * length;
+    active.m_Corners[0] = active.m_Cell + side * margin;
+    active.m_Corners[1] = tail + side * width;
+    active.m_Corners[2] = tail - side * width;
+    active.m_Corners[3] = active.m_Cell - side * margin;
+    glm::vec2 low = active.m_Corners[0];
+    glm::vec2 high = active.m_Corners[0];
+    for (const glm::vec2 & corner : active.m_Corners)
+    {
+      low = glm::min(low, corner);
+      high = glm::max(high, corner);
+    }
+    if (high.x < 0.0f || high.y < 0.0f || low.x > last || low.y > last)
+      continue;
+    m_Active.push_back(active);
+  }
+  m_ActiveShips = (unsigned)m_Active.size();
+  if (m_Active.empty() && was_empty)
+    return;
+
+  m_Pool.ParallelFor(m_Dimension, [this](unsigned begin, unsigned end)
+    { BuildRows(begin, end); });
+  m_Pool.ParallelFor(m_Dimension, [this](unsigned begin, unsigned end)
+    { SlopeRows(begin, end); });
+}
+
+//! The location the window is centered on.
+glm::vec2 Wake::Center() const
+{
+  return glm::vec2(m_CenterX, m_CenterZ) * m_CellSize;
+}
+
+// The wake heights and slopes are added with AddWindowRow.
+bool Wake::SampleRow(float z, float x_start, float dx, unsigned count,
+  float * height, float * slope_x, float * slope_z) const
+{
+  if (m_Active.empty())
+    return false;
+  LayerWindow window = { m_Height.data(), m_SlopeX.data(), m_SlopeZ.data(),
+    m_Dimension, m_Stride, 1, m_CellSize, m_CenterX, m_CenterZ };
+  return AddWindowRow(window, z, x_start, dx, count, height, slope_x,
+    slope_z);
+}
+
+//! The number of ships that affected the window in the last Advance. This
+// can be called while another thread runs Advance.
+unsigned Wake::ActiveShips() const
+{
+  return m_ActiveShips;
+}
+
+// Finds the wake of a point of pressure moving along -behind at unit speed
+// with g = 1. This is the Havelock integral over the wave directions theta:
+// sum(sec^3 * cos(sec^2 * (behind * cos + side * sin))), where the waves
+// close to sideways are damped by exp(-c * sec^4). The waves only add up
+// inside the Kelvin wedge. The near field at the bow is faded in over half a
+// transverse wave and the table is faded out over its last fifth.
+void Wake::BuildPattern()
+{
+  m_PatternBehind = (unsigned)(WAKE_PATTERN_LENGTH / WAKE_PATTERN_STEP) + 1;
+  m_PatternSide = (unsigned)(WAKE_PATTERN_WIDTH / WAKE_PATTERN_STEP) + 1;
+  m_Pattern.assign(m_PatternBehind * m_PatternSide, 0.0f);
+
+  std::vector<double> cosine(WAKE_PATTERN_ANGLES);
+  std::vector<double> sine(WAKE_PATTERN_ANGLES);
+  std::vector<double> secant2(WAKE_PATTERN_ANGLES);
+  std::vector<double> weight(WAKE_PATTERN_ANGLES);
+  double dtheta = 0.5 * WAKE_PI / WAKE_PATTERN_ANGLES;
+  for (unsigned a = 0; a < WAKE_PATTERN_ANGLES; ++a)
+  {
+    double theta = ((double)a + 0.5) * dtheta;
+    cosine[a] = std::cos(theta);
+    sine[a] = std::sin(theta);
+    secant2[a] = 1.0 / (cosine[a] * cosine[a]);
+    weight[a] = secant2[a] / cosine[a] *
+      std::exp(-WAKE_SHORT_WAVE_DAMPING * secant2[a] * secant2[a]) * dtheta;
+  }
+
+  // The rows of the table are split between the threads.
+  m_Pool.ParallelFor(m_PatternBehind, [&](unsigned begin, unsigned end)
+  {
+    for (unsigned b = begin; b < end; ++b)
+    {
+      double behind = b * WAKE_PATTERN_STEP;
+      double fade_in = std::min(behind / WAKE_PI, 1.0);
+      double fade_out = std::min((WAKE_PATTERN_LENGTH - behind) /
+        (0.2 * WAKE_PATTERN_LENGTH), 1.0);
+      double fade = fade_in * fade_in * (3.0 - 2.0 * fade_in) *
+        fade_out * fade_out * (3.0 - 2.0 * fade_out);
+      for (unsigned s = 0; s < m_PatternSide; ++s)
+      {
+        double side = s * WAKE_PATTERN_STEP;
+        double sum = 0.0;
+        for (unsigned a = 0; a < WAKE_PATTERN_ANGLES; ++a)
+        {
+          // theta and -theta are summed together.
+          double along = behind * cosine[a];
+          double across = side * sine[a];
+          sum += weight[a] * (std::cos(secant2[a] * (along + across)) +
+            std::cos(secant2[a] * (along - across)));
+        }
+        m_Pattern[b * m_PatternSide + s] = (float)(sum * fade);
+      }
+    }
+  });
+  float largest = 0.0f;
+  for (float value : m_Pattern)
+    largest = std::max(largest, std::fabs(value));
+  for (float & value : m_Pattern)
+    value /= largest;
+}
+
+// Clears rows [begin, end) of the window and adds every wedge that crosses
+// them. Only the cells between the edges of a wedge are visited.
+void Wake::BuildRows(unsigned begin, unsigned end)
+{
+  for (unsigned z = begin; z < end; ++z)
+  {
+    float * row = m_Height.data() + (z + 1) * m_Stride + 1;
+    std::fill(row, row + m_Dimension, 0.0f);
+    float zf = (float)z;
+    for (const ActiveShip & ship : m_Active)
+    {
+      // Find where the row crosses the edges of the wedge.
+      float x_low = (float)m_Dimension;
+      float x_high = -1.0f;
+      for (unsigned e = 0; e < 4; ++e)
+      {
+        const glm::vec2 & a = ship.m_Corners[e];
+        const glm::vec2 & b = ship.m_Corners[(e + 1) % 4];
+        if ((zf < a.y && zf < b.y) || (zf > a.y && zf > b.y))
+          continue;
+        float x = a.x;
+        if (b.y != a.y)
+          x = a.x + (b.x - a.x) * (zf - a.y) / (b.y - a.y);
+        else
+        {
+          x_low = std::min(x_low, b.x);
+          x_high = std::max(x_high, b.x);
+        }
+        x_low = std::min(x_low, x);
+        x_high = std::max(x_high, x);
+      }
+      int x_begin = std::max((int)std::floor(x_low), 0);
+      int x_end = std::min((int)std::ceil(x_high), (int)m_Dimension - 1);
+      // The table coordinates change by a constant amount with each cell.
+      glm::vec2 forward = ship.m_Forward * ship.m_Scale;
+      glm::vec2 side(-forward.y, forward.x);
+      glm::vec2 start = glm::vec2(0.0f, zf) - ship.m_Cell;
+      float behind_0 = -glm::dot(start, forward);
+      float across_0 = glm::dot(start, side);
+      float behind_dx = -forward.x;
+      float across_dx = side.x;
+      int x = x_begin;
+#ifdef WAKE_SIMD
+      __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+      __m128 sign_mask = _mm_set1_ps(-0.0f);
+      __m128 zero = _mm_setzero_ps();
+      __m128 step_inverse = _mm_set1_ps(1.0f / WAKE_PATTERN_STEP);
+      __m128 behind_last = _mm_set1_ps((float)(m_PatternBehind - 1));
+      __m128 side_last = _mm_set1_ps((float)(m_PatternSide - 1));
+      __m128 behind_limit = _mm_set1_ps((float)(m_PatternBehind - 2));
+      __m128 side_limit = _mm_set1_ps((float)(m_PatternSide - 2));
+      __m128 amplitude = _mm_set1_ps(ship.m_Amplitude);
+      for (; x + 4 <= x_end + 1; x += 4)
+      {
+        __m128 cell = _mm_add_ps(_mm_set1_ps((float)x), lanes);
+        __m128 fb = _mm_mul_ps(_mm_add_ps(_mm_set1_ps(behind_0),
+          _mm_mul_ps(cell, _mm_set1_ps(behind_dx))), step_inverse);
+        __m128 fs = _mm_mul_ps(_mm_andnot_ps(sign_mask,
+          _mm_add_ps(_mm_set1_ps(across_0),
+          _mm_mul_ps(cell, _mm_set1_ps(across_dx)))), step_inverse);
+        __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(fb, zero),
+          _mm_cmplt_ps(fb, behind_last)), _mm_cmplt_ps(fs, side_last));
+        if (_mm_movemask_ps(inside) == 0)
+          continue;
+        // Clamp so the lanes outside of the table still read valid values.
+        fb = _mm_min_ps(_mm_max_ps(fb, zero), behind_limit);
+        fs = _mm_min_ps(fs, side_limit);
+        __m128i b = _mm_cvttps_epi32(fb);
+        __m128i s = _mm_cvttps_epi32(fs);
+        __m128 tb = _mm_sub_ps(fb, _mm_cvtepi32_ps(b));
+        __m128 ts = _mm_sub_ps(fs, _mm_cvtepi32_ps(s));
+        int behind_index[4], side_index[4];
+        _mm_storeu_si128((__m128i *)behind_index, b);
+        _mm_storeu_si128((__m128i *)side_index, s);
+        const float * p0 = m_Pattern.data() +
+          behind_index[0] * m_PatternSide + side_index[0];
+        const float * p1 = m_Pattern.data() +
+          behind_index[1] * m_PatternSide + side_index[1];
+        const float * p2 = m_Pattern.data() +
+          behind_index[2] * m_PatternSide + side_index[2];
+        const float * p3 = m_Pattern.data() +
+          behind_index[3] * m_PatternSide + side_index[3];
+        unsigned far = m_PatternSide;
+        __m128 a = _mm_set_ps(p3[0], p2[0], p1[0], p0[0]);
+        __m128 c = _mm_set_ps(p3[1], p2[1], p1[1], p0[1]);
+        __m128 d = _mm_set_ps(p3[far], p2[far], p1[far], p0[far]);
+        __m128 e = _mm_set_ps(p3[far + 1], p2[far + 1], p1[far + 1],
+          p0[far + 1]);
+        __m128 near_value = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(c, a), ts));
+        __m128 far_value = _mm_add_ps(d, _mm_mul_ps(_mm_sub_ps(e, d), ts));
+        __m128 value = _mm_add_ps(near_value,
+          _mm_mul_ps(_mm_sub_ps(far_value, near_value), tb));
+        value = _mm_and_ps(_mm_mul_ps(value, amplitude), inside);
+        _mm_storeu_ps(row + x, _mm_add_ps(_mm_loadu_ps(row + x), value));
+      }
+#endif
+      for (; x <= x_end; ++x)
+      {
+        float behind = behind_0 + behind_dx * (float)x;
+        float across = std::fabs(across_0 + across_dx * (float)x);
+        row[x] += ship.m_Amplitude * Pattern(behind, across);
+      }
+    }
+  }
+}
+
+// Finds the slopes of rows [begin, end) with central differences.
+void Wake::SlopeRows(unsigned begin, unsigned end)
+{
+  float factor = 0.5f / m_CellSize;
+  for (unsigned z = begin; z < end; ++z)
+  {
+    unsigned row = (z + 1) * m_Stride + 1;
+    const float * height = m_Height.data() + row;
+    const float * above = height - m_Stride;
+    const float * below = height + m_Stride;
+    float * slope_x = m_SlopeX.data() + row;
+    float * slope_z = m_SlopeZ.data() + row;
+    for (int x = 0; x < (int)m_Dimension; ++x)
+    {
+      slope_x[x] = (height[x + 1] - height[x - 1]) * factor;
+      slope_z[x] = (below[x] - above[x]) * factor;
+    }
+  }
+}
+
+// Reads the pattern table with bilinear filtering. Values outside the table
+// are zero.
+inline float Wake::Pattern(float behind, float side) const
+{
+  float fb = behind / WAKE_PATTERN_STEP;
+  float fs = side / WAKE_PATTERN_STEP;
+  if (!(fb >= 0.0f) || fb >= (float)(m_PatternBehind - 1) ||
+    fs >= (float)(m_PatternSide - 1))
+    return 0.0f;
+  unsigned b = (unsigned)fb;
+  unsigned s = (unsigned)fs;
+  float tb = fb - (float)b;
+  float ts = fs - (float)s;
+  const float * near_row = m_Pattern.data() + b * m_PatternSide + s;
+  const float * far_row = near_row + m_PatternSide;
+  float near_value = near_row[0] + (near_row[1] - near_row[0]) * ts;
+  float far_value = far_row[0] + (far_row[1] - far_row[0]) * ts;
+  return near_value + (far_value - near_value) * tb;
+}
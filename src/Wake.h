@@ -0,0 +1,116 @@
+//////////////////////////////////////////////////////////////////////////////
+/// @file Wake.h
+/// @date 2026-10-17
+///
+/// @brief Contains the interface for the Kelvin wakes left by moving ships.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <GLM\glm\glm.hpp>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "SurfaceLayer.h"
+#include "ThreadUtils.h"
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// The state of a ship for a single frame.
+///////////////////////////////////////////////////////////////////////////////
+struct ShipTrack
+{
+  //! The location of the bow on the xz plane.
+  glm::vec2 m_Location;
+  //! The direction the ship is moving in radians. Zero moves along +x and
+  // PI / 2 moves along +z.
+  float m_Heading;
+  //! The speed of the ship in meters per second.
+  float m_Speed;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Builds the Kelvin wakes of every ship into a window of cells that follows
+/// the camera.
+///
+/// The wake of a ship moving at speed U is a fixed pattern that is scaled by
+/// U^2 / g. That pattern is found once with the Havelock integral for a
+/// moving point of pressure and stored in a table. Each Advance clears the
+/// window and adds the table to the cells inside each ship's wedge. The rows
+/// of the window are split between the threads of a pool.
+///
+/// Important Notes
+/// - SetShips and Recenter may be called from any thread. The latest values
+///   are used by the next Advance.
+/// - A wake only depends on the ship's current state, so a turning ship
+///   drags a straight wake behind it.
+///////////////////////////////////////////////////////////////////////////////
+class Wake : public SurfaceLayer
+{
+public:
+  Wake(unsigned dimension, float cell_size, unsigned threads = 0);
+  void SetShips(const ShipTrack * ships, unsigned count);
+  void Recenter(const glm::vec2 & center);
+  void Advance(double time) override;
+  glm::vec2 Center() const override;
+  bool SampleRow(float z, float x_start, float dx, unsigned count,
+    float * height, float * slope_x, float * slope_z) const override;
+  unsigned ActiveShips() const;
+  //! The wave height of a wake is this fraction of its transverse wavelength.
+  float m_Steepness;
+  //! Ships further than this from the window's center in meters are skipped.
+  float m_CullDistance;
+  //! The gravitational constant.
+  float m_Gravity;
+private:
+  //! A ship that affects the window and the values needed to add its wake.
+  struct ActiveShip
+  {
+    //! The location of the bow in cells relative to cell (0, 0).
+    glm::vec2 m_Cell;
+    //! The unit direction the ship moves in.
+    glm::vec2 m_Forward;
+    //! g / U^2 times the cell size. This converts cells to table units.
+    float m_Scale;
+    //! The height of the wake in meters.
+    float m_Amplitude;
+    //! The corners of the wedge in cells relative to cell (0, 0). The wedge
+    // is widened by WAKE_PATTERN_MARGIN so its sides hold the cusps.
+    glm::vec2 m_Corners[4];
+  };
+  void BuildPattern();
+  void BuildRows(unsigned begin, unsigned end);
+  void SlopeRows(unsigned begin, unsigned end);
+  float Pattern(float behind, float side) const;
+
+  //! The number of cells along each side of the window.
+  unsigned m_Dimension;
+  //! The number of floats in a row. There is a cell of padding on each side.
+  unsigned m_Stride;
+  //! The length of a cell in meters.
+  float m_CellSize;
+  //! The cell the window is centered on.
+  int m_CenterX;
+  int m_CenterZ;
+  //! The heights and slopes of the window.
+  std::vector<float> m_Height;
+  std::vector<float> m_SlopeX;
+  std::vector<float> m_SlopeZ;
+  //! The wake of a ship in table units, where the ship is at the origin
+  // moving along -behind. Only the side >= 0 half is stored.
+  std::vector<float> m_Pattern;
+  unsigned m_PatternBehind;
+  unsigned m_PatternSide;
+  //! The ships used by the current Advance.
+  std::vector<ActiveShip> m_Active;
+  //! The size of m_Active after the last Advance. Other threads read this
+  // instead of m_Active.
+  std::atomic<unsigned> m_ActiveShips;
+  //! Guards the values below.
+  std::mutex m_Mutex;
+  std::vector<ShipTrack> m_Ships;
+  glm::vec2 m_PendingCenter;
+  //! The threads used by Advance.
+  ThreadPool m_Pool;
+};
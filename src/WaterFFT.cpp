@@ -1,1084 +1,2586 @@
-
-
-#include <GLM\glm\vec3.hpp>
-#include <GLM\glm\glm.hpp>
-#include <GLM\glm\gtc\type_ptr.hpp>
-#define STB_IMAGE_IMPLEMENTATION
-#include <STB\stb_image.h>
-#include <cmath>
-#include <thread>
-#include "Random.h"
-#include "OpenGLError.h"
-#include "Time.h"
-#include "Context.h"
-#include "WaterFFT.h"
-
-// math constants //
-#define EPSILON 1.0e-4f
-#define DELTA 1.0e-1
-#define PI 3.14159265358979323846264338f
-#define TAU 6.28318530718f
-#define INDICIES_PER_QUAD 6
-#define MIN_DX_DZ 0.02f
-
-// MATH HELPERS ///////////////////////////////////////////////////////////////
-
-float Lerp(float a, float b, float t)
-{
-  return a + (b - a) * t;
-}
-
-float QuadLerp(float a, float b, float c, float d, float tx, float ty)
-{
-  float ab = Lerp(a, b, tx);
-  float cd = Lerp(c, d, tx);
-  return Lerp(ab, cd, ty);
-}
-
-int Clamp(int min, int max, int value)
-{
-  return glm::min(max, glm::max(min, value));
-}
-
-// INTENSITY MAP //////////////////////////////////////////////////////////////
-
-WaterFFT::IntensityMap::IntensityMap(const std::string & filename) :
-  m_InstensityFile(filename)
-{
-   m_Data = stbi_load(filename.c_str(), &m_Width, &m_Height,
-    &m_Channels, 1);
-   m_MaxX = static_cast<uint>(m_Width - 1);
-   m_MaxY = static_cast<uint>(m_Height - 1);
-}
-
-WaterFFT::IntensityMap::~IntensityMap()
-{
-  stbi_image_free(m_Data);
-}
-
-float WaterFFT::IntensityMap::GetIntensity(float x, float z)
-{
-  // finding the pixel location in the texture
-  float xi_f = x * m_Width;
-  float yi_f = z * m_Height;
-
-  uint xi0 = static_cast<uint>(xi_f);
-  uint xi1 = glm::min(xi0 + 1, m_MaxX);
-  uint yi0 = static_cast<uint>(yi_f);
-  uint yi1 = glm::min(yi0 + 1, m_MaxY);
-
-  // Getting the interpolation parameters for x / y directions
-  float x_t = xi_f - static_cast<float>(xi0);
-  float y_t = yi_f - static_cast<float>(yi0);
-  
-  uint ai = yi0 * m_Width + xi0;
-  uint bi = yi0 * m_Width + xi1;
-  uint ci = yi1 * m_Width + xi0;
-  uint di = yi1 * m_Width + xi1;
-
-  float a = static_cast<float>(m_Data[ai]) / 255.0f;
-  float b = static_cast<float>(m_Data[bi]) / 255.0f;
-  float c = static_cast<float>(m_Data[ci]) / 255.0f;
-  float d = static_cast<float>(m_Data[di]) / 255.0f;
-  return QuadLerp(a, b, c, d, x_t, y_t);
-}
-
-// WATERFFT ///////////////////////////////////////////////////////////////////
-
-WaterFFT::WaterFFT(unsigned grid_dimension, float meter_dimension, 
-  unsigned expansion, bool use_fft = true) :
-  m_HeightScale(1.0f), m_DisplaceScale(1.0f), 
-  m_XLength(meter_dimension), m_ZLength(meter_dimension), 
-  m_Amplitude(0.00005f), m_Gravity(9.81f), m_Wind(64.0f, 64.0f), 
-  m_IMap(nullptr)
-{
-  // Check for errors before continuing. First check that the grid dimension
-  // passed in is a power of 2.
-  unsigned gd_check = grid_dimension;
-  while (gd_check > 2)
-  {
-    if (gd_check % 2 != 0) {
-      WaterFFTError error(WaterFFTError::INVALID_GRID_DIM, "The water grid's"
-        " dimension must be a power of 2");
-      throw(error);
-    }
-    gd_check /= 2;
-  }
-
-  // Check that the ratio of dimension over stride is greater than some minimum
-  // value.
-  float dx_dz = meter_dimension / (float)m_XStride;
-  if (dx_dz < MIN_DX_DZ)
-  {
-    WaterFFTError error(WaterFFTError::SMALL_DX_DZ, "The dimension in meters"
-      " divided by the dimension in grid units should be larger than 2 cm");
-      throw(error);
-  }
-
-  // Set up the strides for the complete mesh and the part of the mesh that the
-  // fft will be used to compute positions for.
-  m_XStride = grid_dimension + 1;
-  m_ZStride = grid_dimension + 1;
-  m_NumVerts = m_XStride * m_ZStride;
-  m_fft_XStride = grid_dimension;
-  m_fft_ZStride = grid_dimension;
-  m_fft_NumVerts = m_fft_XStride * m_fft_ZStride;
-
-  // Allocating arrays for FFTW input and output. 
-  uint num_fft_bytes = sizeof(Complex) * m_fft_NumVerts;
-  m_HTildeIn = (Complex *)fftwf_malloc(num_fft_bytes);
-  m_HTildeSlopeXIn = (Complex *)fftwf_malloc(num_fft_bytes);
-  m_HTildeSlopeZIn = (Complex *)fftwf_malloc(num_fft_bytes);
-  m_HTildeDisplaceXIn = (Complex *)fftwf_malloc(num_fft_bytes);
-  m_HTildeDisplaceZIn = (Complex *)fftwf_malloc(num_fft_bytes);
-  m_HTildeOut = (Complex *)fftwf_malloc(num_fft_bytes);
-  m_HTildeSlopeXOut = (Complex *)fftwf_malloc(num_fft_bytes);
-  m_HTildeSlopeZOut = (Complex *)fftwf_malloc(num_fft_bytes);
-  m_HTildeDisplaceXOut = (Complex *)fftwf_malloc(num_fft_bytes);
-  m_HTildeDisplaceZOut = (Complex *)fftwf_malloc(num_fft_bytes);
-  
-  // Creating FFTW plans.
-  m_HTildeFFTWPlan = fftwf_plan_dft_2d(m_fft_XStride, m_fft_ZStride,
-    (fftwf_complex *)m_HTildeIn, 
-    (fftwf_complex *)m_HTildeOut,
-    FFTW_FORWARD, FFTW_MEASURE);
-  m_HTildeSlopeXPlan = fftwf_plan_dft_2d(m_fft_XStride, m_fft_ZStride,
-    (fftwf_complex *)m_HTildeSlopeXIn, 
-    (fftwf_complex *)m_HTildeSlopeXOut,
-    FFTW_FORWARD, FFTW_MEASURE);
-  m_HTildeSlopeZPlan = fftwf_plan_dft_2d(m_fft_XStride, m_fft_ZStride,
-    (fftwf_complex *)m_HTildeSlopeZIn, 
-    (fftwf_complex *)m_HTildeSlopeZOut,
-    FFTW_FORWARD, FFTW_MEASURE);
-  m_HTildeDisplaceXPlan = fftwf_plan_dft_2d(m_fft_XStride, m_fft_ZStride,
-    (fftwf_complex *)m_HTildeDisplaceXIn, 
-    (fftwf_complex *)m_HTildeDisplaceXOut,
-    FFTW_FORWARD, FFTW_MEASURE);
-  m_HTildeDisplaceZPlan = fftwf_plan_dft_2d(m_fft_XStride, m_fft_ZStride,
-    (fftwf_complex *)m_HTildeDisplaceZIn, 
-    (fftwf_complex *)m_HTildeDisplaceZOut,
-    FFTW_FORWARD, FFTW_MEASURE);
-
-  // Initializing all of the buffers needed for the water.
-  InitializeVertexBuffer();
-  InitializeIndexBuffer();
-  InitializeOffsetBuffer(expansion);
-}
-
-WaterFFT::~WaterFFT()
-{
-  // freeing FFTW in and out arrays
-  fftwf_free(m_HTildeIn);
-  fftwf_free(m_HTildeSlopeXIn);
-  fftwf_free(m_HTildeSlopeZIn);
-  fftwf_free(m_HTildeDisplaceXIn);
-  fftwf_free(m_HTildeDisplaceZIn);
-  fftwf_free(m_HTildeOut);
-  fftwf_free(m_HTildeSlopeXOut);
-  fftwf_free(m_HTildeSlopeZOut);
-  fftwf_free(m_HTildeDisplaceXOut);
-  fftwf_free(m_HTildeDisplaceZOut);
-  RemoveIntensityMap();
-}
-
-bool WaterFFT::UseIntensityMap(const std::string & filename)
-{
-  RemoveIntensityMap();
-  m_IMap = new IntensityMap(filename);
-  return true;
-}
-
-bool WaterFFT::RemoveIntensityMap()
-{
-  if (m_IMap)
-  {
-    delete m_IMap;
-    m_IMap = nullptr;
-    return true;
-  }
-  return false;
-}
-
-std::pair<float, glm::vec3> WaterFFT::HeightNormalAtLocation(
-  const glm::vec2 & location, float time)
-{
-  std::pair<float, glm::vec3> result;
-  result = GetLocationHeightNormalFFT(location);
-  return result;
-}
-
-float WaterFFT::HeightAtLocation(const glm::vec2 & location)
-{
-  MeshPosition mp = LocationToMeshPosition(location);
-  return GetLocationHeightFFT(mp);
-}
-
-void WaterFFT::Update(float time)
-{
-  UpdateFFT(time);
-}
-
-void WaterFFT::SwapBuffers()
-{
-  std::vector<Vertex> * temp = m_ReadBuffer;
-  m_ReadBuffer = m_WriteBuffer;
-  m_WriteBuffer = temp;
-}
-
-const void * WaterFFT::VertexBuffer()
-{
-  return (void *)m_ReadBuffer->data();
-}
-
-const void * WaterFFT::IndexBuffer()
-{
-  return (void *)m_IndexBuffer.data();
-}
-
-const void * WaterFFT::OffsetBuffer()
-{
-  return (void *)m_OffsetBuffer.data();
-}
-
-unsigned WaterFFT::VertexBufferSizeBytes()
-{
-  return m_ReadBuffer->size() * sizeof(Vertex);
-}
-
-unsigned WaterFFT::IndexBufferSizeBytes()
-{
-  return m_IndexBuffer.size() * sizeof(unsigned int);
-}
-
-unsigned WaterFFT::IndexBufferSize()
-{
-  return m_IndexBuffer.size();
-}
-
-unsigned WaterFFT::OffsetBufferSizeBytes()
-{
-  return m_OffsetBuffer.size() * sizeof(Offset);
-}
-
-unsigned WaterFFT::OffsetBufferSize()
-{
-  return m_OffsetBuffer.size();
-}
-
-void WaterFFT::UpdateFFT(float time)
-{
-  unsigned fft_vertex_index = 0;
-  for (unsigned z = 0; z < m_fft_ZStride; ++z) 
-  {
-    float m = z - (m_fft_ZStride / 2.0f);
-    float kz = (TAU * m) / m_ZLength;
-    for (unsigned x = 0; x < m_fft_XStride; ++x) 
-    {
-      float n = x - (m_fft_XStride / 2.0f);
-      float kx = (TAU * n) / m_XLength;
-      glm::vec2 k(kx, kz);
-      float k_magnitude = glm::length(k);
-      // calculate htilde / fourier domain
-      const Complex & htilde0 = 
-        m_VertexExtrasBuffer[fft_vertex_index].m_HTilde0;
-      const Complex & htilde0_conj = 
-        m_VertexExtrasBuffer[fft_vertex_index].m_HTilde0Conjugate;
-      Complex htilde = HTilde(htilde0, htilde0_conj, k, time);
-      // use htilde to set values for fft computation
-      m_HTildeIn[fft_vertex_index] = htilde;
-      m_HTildeSlopeXIn[fft_vertex_index] = htilde * Complex(0, kx);
-      m_HTildeSlopeZIn[fft_vertex_index] = htilde * Complex(0, kz);
-      if (k_magnitude < EPSILON)
-      {
-        m_HTildeDisplaceXIn[fft_vertex_index] = Complex(0.0f, 0.0f);
-        m_HTildeDisplaceZIn[fft_vertex_index] = Complex(0.0f, 0.0f);
-      }
-      else
-      {
-        m_HTildeDisplaceXIn[fft_vertex_index] = 
-          htilde * Complex(0.0f, -kx / k_magnitude);
-        m_HTildeDisplaceZIn[fft_vertex_index] = 
-          htilde * Complex(0.0f, -kz / k_magnitude);
-      }
-      ++fft_vertex_index;
-    }
-  }
-
-  // Execute the fft.
-  fftwf_execute(m_HTildeFFTWPlan);
-  fftwf_execute(m_HTildeSlopeXPlan);
-  fftwf_execute(m_HTildeSlopeZPlan);
-  fftwf_execute(m_HTildeDisplaceXPlan);
-  fftwf_execute(m_HTildeDisplaceZPlan);
-
-  // Use the output from the fft for the new vertex positions of the mesh.
-  unsigned vertex_index = 0;
-  fft_vertex_index = 0;
-  int sign = 1;
-  for (unsigned z = 0; z < m_fft_ZStride; ++z) 
-  {
-    for (unsigned x = 0; x < m_fft_XStride; ++x) 
-    {
-      // Apply sign to all fft output.
-      m_HTildeOut[fft_vertex_index] *= (float)sign;
-      m_HTildeSlopeXOut[fft_vertex_index] *= (float)sign;
-      m_HTildeSlopeZOut[fft_vertex_index] *= (float)sign;
-      m_HTildeDisplaceXOut[fft_vertex_index] *= (float)sign;
-      m_HTildeDisplaceZOut[fft_vertex_index] *= (float)sign;
-      
-      // Get the starting values for the vertices new position. 
-      Vertex & vert = (*m_WriteBuffer)[vertex_index];
-      float x_location = m_VertexExtrasBuffer[fft_vertex_index].m_Ox;
-      float z_location = m_VertexExtrasBuffer[fft_vertex_index].m_Oz;
-      float position_y_factor = m_HeightScale;
-      float normal_y_factor = 1.0f / m_HeightScale;
-      
-      // Get the factors that need to be applied from the intensity map.
-      if (m_IMap)
-      {
-        float x_0to1 = x / static_cast<float>(m_fft_XStride);
-        float z_0to1 = z / static_cast<float>(m_fft_XStride);
-        float intensity = m_IMap->GetIntensity(x_0to1, z_0to1);
-        if(intensity == 0.0f)
-          intensity = EPSILON;
-        position_y_factor *= intensity;
-        normal_y_factor *= 1.0f / intensity;
-      }
-
-      // Set the new position of the vertex.
-      vert.m_Px = x_location + 
-        m_DisplaceScale * m_HTildeDisplaceXOut[fft_vertex_index].Real();
-      vert.m_Py = m_HTildeOut[fft_vertex_index].Real() * position_y_factor;
-      vert.m_Pz = z_location + m_DisplaceScale * 
-        m_HTildeDisplaceZOut[fft_vertex_index].Real();
-
-      // Set the new normal of the vertex. 
-      glm::vec3 normal(0.0f - m_HTildeSlopeXOut[fft_vertex_index].Real(),
-        1.0f, 0.0f - m_HTildeSlopeZOut[fft_vertex_index].Real());
-      vert.m_Nx = normal.x;
-      vert.m_Ny = normal.y * normal_y_factor;
-      vert.m_Nz = normal.z;
-
-      ++vertex_index;
-      ++fft_vertex_index;
-      sign *= -1;
-    }
-
-    // We need to increment the vertex index again because the number of
-    // vertices in the actual vertex array is extended by one in both the x
-    // and z direction when compared to the arrays used for computing the fft.
-    ++vertex_index;
-    sign *= -1;
-  }
-
-  // Updating the last row and column. These vertices are "attached" to the
-  // other side of the grid, so their heights should be equivalent. The first
-  // call updates the last vertices in the x direction. The second call updates
-  // the last vertices in the z direction.
-  UpdateTailEdge(0);
-  UpdateTailEdge(1);
-  
-  // Now the tail corner is updated. This is a special case because the
-  // original vertex that is used is diagonally 
-  // opposite from the vertex that is being updated.
-  Vertex & update_vert = (*m_WriteBuffer)[m_NumVerts - 1];
-  Vertex & og_vert = (*m_WriteBuffer)[0];
-  update_vert.m_Px = og_vert.m_Px + m_XLength;
-  update_vert.m_Py = og_vert.m_Py;
-  update_vert.m_Pz = og_vert.m_Pz + m_ZLength;
-}
-
-void WaterFFT::UpdateTailEdge(char edge)
-{
-  // These values will be different depending on the edge that we choose to
-  // update.
-  unsigned up_vertex_index;
-  unsigned og_vertex_index;
-  unsigned d_vertex_index;
-  float x_offset;
-  float z_offset;
-  
-  // If the tail to be updated is zero, we update the vertices at the end of the
-  // grid in the x direction. If it is not zero, we update the vertices at the
-  // end of the grid in the z direction.
-  if(edge == 0)
-  {
-    up_vertex_index = m_XStride - 1;
-    og_vertex_index = 0;
-    d_vertex_index = m_XStride;
-    x_offset = m_XLength;
-    z_offset = 0.0f;
-  }
-  else
-  {
-    up_vertex_index = m_XStride * (m_ZStride - 1);
-    og_vertex_index = 0;
-    d_vertex_index = 1;
-    x_offset = 0.0f;
-    z_offset = m_ZLength;
-  }
-
-  for(unsigned i = 0; i < (m_ZStride - 1); ++i)
-  {
-    // The vertex being updated is the very last vertex (an edge vertex). The
-    // vertex that this updated vertex is attached to is the vextex on the other
-    // side of the grid. This other vertex is the original (og) vertex.
-    Vertex & update_vert = (*m_WriteBuffer)[up_vertex_index];
-    Vertex & og_vert = (*m_WriteBuffer)[og_vertex_index];
-
-    // Update the vertex position.
-    update_vert.m_Px = og_vert.m_Px + x_offset;
-    update_vert.m_Py = og_vert.m_Py; 
-    update_vert.m_Pz = og_vert.m_Pz + z_offset;
-
-    // Update the vertices normal.
-    update_vert.m_Nx = og_vert.m_Nx;
-    update_vert.m_Ny = og_vert.m_Ny;
-    update_vert.m_Nz = og_vert.m_Nz;
-
-    // Move the vertex indices forward.
-    up_vertex_index += d_vertex_index;
-    og_vertex_index += d_vertex_index;
-  }
-}
-
-std::pair<float, glm::vec3> WaterFFT::GetLocationHeightNormalFFT(
-  const glm::vec2 & location)
-{
-  MeshPosition mp = LocationToMeshPosition(location);
-  float height = GetLocationHeightFFT(mp);
-  glm::vec3 normal = GetLocationNormalFFT(mp);
-  return std::pair<float, glm::vec3>(height, normal);
-}
-
-// This relates to the next two functions
-/* a---b                  **
-** | / |                  **
-** c---d                  **
-** horizontal goes over x **
-** vertical goes over z   */
-
-float WaterFFT::GetLocationHeightFFT(const MeshPosition & mp)
-{
-  const Vertex & a = (*m_ReadBuffer)[mp.m_VertexIndex];
-  const Vertex & b = (*m_ReadBuffer)[mp.m_VertexIndex + 1];
-  const Vertex & c = (*m_ReadBuffer)[mp.m_VertexIndex + m_XStride];
-  const Vertex & d = (*m_ReadBuffer)[mp.m_VertexIndex + m_XStride + 1];
-  //heights
-  float ha = a.m_Py;
-  float hb = b.m_Py;
-  float hc = c.m_Py;
-  float hd = d.m_Py;
-  //performing bilinear interpolation
-  float hab = ha + (hb - ha) * mp.m_Xt; // use lerp formual
-  float hcd = hc + (hd - hc) * mp.m_Xt;
-  float habcd = hab + (hcd - hab) * mp.m_Zt;
-  return habcd;
-}
-
-glm::vec3 WaterFFT::GetLocationNormalFFT(const MeshPosition & mp)
-{
-  const Vertex & a = (*m_ReadBuffer)[mp.m_VertexIndex];
-  const Vertex & b = (*m_ReadBuffer)[mp.m_VertexIndex + 1];
-  const Vertex & c = (*m_ReadBuffer)[mp.m_VertexIndex + m_XStride];
-  const Vertex & d = (*m_ReadBuffer)[mp.m_VertexIndex + m_XStride + 1];
-  // getting normals
-  glm::vec3 na(a.m_Nx, a.m_Ny, a.m_Nz);
-  glm::vec3 nb(b.m_Nx, b.m_Ny, b.m_Nz);
-  glm::vec3 nc(c.m_Nx, c.m_Ny, c.m_Nz);
-  glm::vec3 nd(d.m_Nx, d.m_Ny, d.m_Nz);
-  // normal bilinear interpolation
-  glm::vec3 nab = na + (nb - na) * mp.m_Xt; // use lerp formual
-  glm::vec3 ncd = nc + (nd - nc) * mp.m_Xt;
-  glm::vec3 nabcd = nab + (ncd - nab) * mp.m_Zt;
-  nabcd = glm::normalize(nabcd);
-  return nabcd;
-}
-
-// TODO: This implementation will not work with displacements
-// It will only work with a displacement factor of 0
-WaterFFT::MeshPosition WaterFFT::LocationToMeshPosition(glm::vec2 location)
-{
-  // translating to our indicies
-  // TODO: remove the requirement (stride = lenght)
-  float x_index_float = location.x + (float)m_XStride / 2.0f;
-  float z_index_float = location.y + (float)m_ZStride / 2.0f;
-  // getting to an index that exists in our arrays
-  float x_max_index = (float)(m_XStride - 1);
-  if (x_index_float >= x_max_index) {
-    unsigned grids_to_offset = (unsigned)(x_index_float / x_max_index);
-    x_index_float -= (float)(grids_to_offset * x_max_index);
-  }
-  while (x_index_float < 0)
-    x_index_float += x_max_index;
-  // doing the same for z
-  float z_max_index = (float)(m_ZStride - 1);
-  if (z_index_float >= z_max_index) {
-    unsigned grids_to_offset = (unsigned)(z_index_float / z_max_index);
-    z_index_float -= (float)(grids_to_offset * z_max_index);
-  }
-  while (z_index_float < 0)
-    z_index_float += z_max_index;
-  // casting to our index and getting our lerp parameters
-  unsigned x_index = (unsigned)x_index_float;
-  float xt = x_index_float - (float)x_index;
-  unsigned z_index = (unsigned)z_index_float;
-  float zt = z_index_float - (float)z_index;
-  unsigned vertex_index = z_index * m_XStride + x_index;
-  return MeshPosition(vertex_index, xt, zt);
-}
-
-
-Complex WaterFFT::HTilde(const Complex & htilde0, 
-  const Complex & htilde0_conjugate,const glm::vec2 & k, float time)
-{
-  // h~(k, t) = h~0(k) * exp(i * w(k) * t) + h~0*(-k) * exp(-i * w(k) * t)
-  // h~   = htilde
-  // h~0  = htilde0
-  // w(k) = dispersion relation
-  // All values of h~0 are precomputed in InitializeVertexBuffer
-  float dispersion = DispersionRelation(k);
-  float omega_t = dispersion * time;
-  float cos_omega_t = cos(omega_t);
-  float sin_omega_t = sin(omega_t);
-  Complex e_1(cos_omega_t, sin_omega_t);
-  Complex e_2(-cos_omega_t, -sin_omega_t);
-  Complex term1 = htilde0 * e_1;
-  Complex term2 = htilde0_conjugate * e_2;
-  return term1 + term2;
-}
-
-float WaterFFT::DispersionRelation(const glm::vec2 & k)
-{
-  float w_0 = TAU / 200.0f;
-  float k_magnitude = glm::length(k);
-  return floor(sqrt(m_Gravity * k_magnitude) / w_0) * w_0;
-}
-
-Complex WaterFFT::HTilde0(const glm::vec2 & k)
-{
-  // h~0(k) = (q0 + i * q1) * sqrt(P(k) / 2)
-  // h~0    = htilde0
-  // q0, q1 = values from gaussian number generator
-  // P(k)   = phillips spectrum
-  float multiplicand = sqrt(PhillipsSpectrum(k) / 2.0f);
-  Complex multiplier = NormalComplexRandom();
-  Complex product = multiplier * multiplicand;
-  return product;
-}
-
-float WaterFFT::PhillipsSpectrum(const glm::vec2 & k)
-{
-  float k_magnitude = glm::length(k);
-  float wind_speed = glm::length(m_Wind);
-  glm::vec2 wind_normal = m_Wind / wind_speed;
-  if(k_magnitude < EPSILON) return 0.0f;
-  float k_mag_pow_2 = k_magnitude * k_magnitude;
-  float k_mag_pow_4 = k_mag_pow_2 * k_mag_pow_2;
-  float largest_wave = wind_speed * wind_speed / m_Gravity;
-  float largest_wave_pow_2 = largest_wave * largest_wave;
-  glm::vec2 k_normal = k / k_magnitude;
-  float k_dot_winddir = glm::dot(k_normal, wind_normal);
-  float k_dot_winddir_pow_2 = k_dot_winddir * k_dot_winddir;
-  float exponent = -1.0f / (k_mag_pow_2 * largest_wave_pow_2);
-  // taken from keiths article.
-  // I understand why this damping factor is here,
-  // but I don't understand WHY it is here
-  // Is there something we can do earlier to eliminate it
-  float damping = 0.001f;
-  float l2 = largest_wave_pow_2 * damping * damping;
-  float factor2 = exp(exponent) / k_mag_pow_4;
-  // TODO: Mess around with this spectrum, Keith's implementation has
-  // a multiple factor that is attatched to this that might have a dramatic
-  // effect. It is also mentioned in the tessendorf article
-  // The multiplicative factor is below
-  float additional_factor = exp(-k_mag_pow_2 * l2);
-  return m_Amplitude * factor2 * k_dot_winddir_pow_2 * additional_factor;
-}
-
-inline void WaterFFT::InitializeVertexBuffer()
-{
-  // Clear the vertex data if it happens to exist.
-  m_VertexBufferA.clear();
-
-  // Set the starting positions of the vertices and calculate the htilde vertex
-  // extra values that will be used for the fft computation.
-  m_VertexBufferA.reserve(m_NumVerts);
-  for (unsigned z = 0; z < m_ZStride; ++z) 
-  {
-    float m = z - (m_fft_ZStride / 2.0f);
-    float kz = (TAU * m) / m_ZLength; // TODO: Distribute the 2
-    
-    for (unsigned x = 0; x < m_XStride; ++x) 
-    {
-      float n = x - (m_fft_XStride / 2.0f);
-
-      // Find the vertice's starting position values.
-      float start_x = m_XLength *  n / m_fft_XStride;
-      float start_y = 0.0f;
-      float start_z = m_ZLength * m / m_fft_ZStride;
-
-      // Add the new vertex to the vertex buffers.
-      m_VertexBufferA.push_back(
-        Vertex(start_x, start_y, start_z, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f));
-      m_VertexBufferB.push_back(
-        Vertex(start_x, start_y, start_z, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f));
-
-      // Add the extra htilde values to the vertex extras buffer.
-      if(z < m_fft_ZStride && x < m_fft_XStride)
-      {
-        float kx = (TAU * n) / m_XLength; // TODO: Distribute the 2
-        glm::vec2 k(kx, kz);
-        Complex htilde0_vertex = HTilde0(k);
-        Complex htilde0_conjugate_vertex = HTilde0(-k).Conjugate();
-        m_VertexExtrasBuffer.push_back(
-          VertexExtra(start_x, start_y, start_z, 
-          htilde0_vertex, htilde0_conjugate_vertex));
-      }
-    }
-  }
-
-  // Vertex buffer A will be used to the first frame of the water. The
-  // simulation will being writing the next frame to vertex buffer B.
-  m_ReadBuffer = &m_VertexBufferA;
-  m_WriteBuffer = &m_VertexBufferB;
-}
-
-inline void WaterFFT::InitializeIndexBuffer()
-{
-  m_IndexBuffer.clear();
-  unsigned index_buffer_size = INDICIES_PER_QUAD * (m_NumVerts - m_XStride);
-  m_IndexBuffer.reserve(index_buffer_size);
-  // Finding indicies
-  unsigned limit = m_NumVerts - m_XStride;
-  // One iteration for each quad on the surface
-  for (unsigned int i = 0; i < limit;) {
-    m_IndexBuffer.push_back(i);
-    m_IndexBuffer.push_back(i + 1);
-    m_IndexBuffer.push_back(i + m_XStride);
-    // First half of the quad
-    // Triangle indices are i, i + 1, and i + m_XStride
-    ++i;
-    m_IndexBuffer.push_back(i);
-    m_IndexBuffer.push_back(i + m_XStride);
-    m_IndexBuffer.push_back(i + m_XStride - 1);
-    // Second half of the quad
-    // Triangle indicies are i, i + m_XStride, and i + m_XStride - 1
-    unsigned vertices_left = (i + 1) % m_XStride;
-    if (vertices_left == 0)
-      ++i;
-  }
-}
-
-inline void WaterFFT::InitializeOffsetBuffer(unsigned expansion)
-{
-  int num_instances = expansion * expansion;
-  for (int i = 0; i < num_instances; ++i)
-  {
-    int x = i % expansion;
-    int z = i / expansion;
-    float x_offset = (float)x * m_XLength;
-    float z_offset = (float)z * m_ZLength;
-    m_OffsetBuffer.push_back(Offset(x_offset, 0.0f, z_offset, 1.0f));
-  }
-}
-
-// WATERFFTHOLDER /////////////////////////////////////////////////////////////
-// static initialization
-WaterFFT * WaterFFTHolder::m_Water;
-
-void WaterFFTHolder::Initialize()
-{
-  m_Water = new WaterFFT(256, 256, 5, true);
-}
-
-void WaterFFTHolder::PrepBuffers()
-{
-  m_Water->SwapBuffers();
-  WaterRenderer::SetVertexBuffer(
-    (GLfloat *)WaterFFTHolder::GetWaterFFT()->VertexBuffer());
-}
-
-void WaterFFTHolder::Update(float time)
-{
-  m_Water->Update(time);
-}
-
-void WaterFFTHolder::Purge()
-{
-  delete m_Water;
-}
-
-WaterFFT * WaterFFTHolder::GetWaterFFT()
-{
-  return m_Water;
-}
-
-// WATERFFTTHREAD /////////////////////////////////////////////////////////////
-
-bool WaterFFTThread::m_Running = false;
-std::function<float()> WaterFFTThread::m_FetchTime;
-std::thread * WaterFFTThread::m_Water = nullptr;
-Barrier WaterFFTThread::m_Barrier(2);
-
-void WaterFFTThread::Execute(float (* fetch_time)(void))
-{
-  m_Running = true;
-  m_FetchTime = fetch_time;
-  m_Water = new std::thread(RunWater);
-}
-
-void WaterFFTThread::Wait(bool kill)
-{
-  m_Barrier.WaitForAllThreads(WaterFFTHolder::PrepBuffers, kill);
-}
-
-void WaterFFTThread::RunWater()
-{
-  while(m_Running)
-  {
-    WaterFFTHolder::Update(m_FetchTime());
-    m_Barrier.WaitForAllThreads(WaterFFTHolder::PrepBuffers, false);
-  }
-}
-
-void WaterFFTThread::Terminate()
-{
-  m_Running = false;
-  WaterFFTThread::Wait(true);
-  m_Water->join();
-}
-
-
-// WATERFFTERROR
-
-WaterFFTError::Type WaterFFTError::GetType() const
-{
-  return m_Type;
-}
-
-const std::string & WaterFFTError::GetDescription() const
-{
-  return m_Description;
-}
-
-WaterFFTError::WaterFFTError(Type type, const std::string & description) :
-  m_Type(type), m_Description(description)
-{}
-
-
-// static initializations
-glm::vec3 WaterRenderer::m_WaterColor = glm::vec3(0.0f, 0.5f, 1.0f);
-float WaterRenderer::m_AmbientFactor = 0.2f;
-glm::vec3 WaterRenderer::m_AmbientColor = glm::vec3(0.160f, 0.909f, 0.960f);
-glm::vec3 WaterRenderer::m_DiffuseColor = glm::vec3(0.160f, 0.909f, 0.960f);
-float WaterRenderer::m_SpecularFactor = 1.0f;
-int WaterRenderer::m_SpecularExponent = 20;
-glm::vec3 WaterRenderer::m_SpecularColor = glm::vec3(1.0f, 1.0f, 1.0f);
-WaterRenderer::WaterShader * WaterRenderer::m_WaterShader = nullptr;
-GLuint WaterRenderer::m_WaterVBOID = -1;
-GLuint WaterRenderer::m_WaterEBOID = -1;
-GLuint WaterRenderer::m_WaterVAOID = -1;
-GLuint WaterRenderer::m_OffsetVBOID = -1;
-
-const GLfloat * WaterRenderer::m_VertexBuffer = nullptr;
-const GLuint * WaterRenderer::m_IndexBuffer = nullptr;
-const GLfloat * WaterRenderer::m_OffsetBuffer = nullptr;
-GLuint WaterRenderer::m_VertexBufferSizeBytes = 0;
-GLuint WaterRenderer::m_IndexBufferSizeBytes = 0;
-GLuint WaterRenderer::m_OffsetBufferSizeBytes = 0;
-
-
-unsigned WaterRenderer::m_NumIndices = 0;
-unsigned WaterRenderer::m_NumInstances = 0;
-bool WaterRenderer::m_LineDraw = false;
-
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Creates the WaterShader shader type.
-///////////////////////////////////////////////////////////////////////////////
-WaterRenderer::WaterShader::WaterShader() :
-  Shader("Shader/water.vert", "Shader/water.frag")
-{
-  // finding attribute and uniform locations
-  this->Use();
-  m_APosition = GetAttribLocation("APosition");
-  m_ANormal = GetAttribLocation("ANormal");
-  m_AOffset = GetAttribLocation("AOffset");
-  m_UTransform = GetUniformLocation("UTransform");
-  m_UWaterColor = GetUniformLocation("UWaterColor");
-  m_UAmbientFactor = GetUniformLocation("UAmbientFactor");
-  m_UAmbientColor = GetUniformLocation("UAmbientColor");
-  m_UDiffuseColor = GetUniformLocation("UDiffuseColor");
-  m_USpecularFactor = GetUniformLocation("USpecularFactor");
-  m_USpecularExponent = GetUniformLocation("USpecularExponent");
-  m_USpecularColor = GetUniformLocation("USpecularColor");
-  m_ULightDirection = GetUniformLocation("ULightDirection");
-  m_UCameraPosition = GetUniformLocation("UCameraPosition");
-  m_UTime = GetUniformLocation("UTime");
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Sets the Water that will be rendered when the Render function
-/// is called.
-///
-/// @param water The water that will be used for rendering.
-///////////////////////////////////////////////////////////////////////////////
-void WaterRenderer::SetBuffers(const GLfloat * buff_vertex, 
-  const GLuint * buff_index, const GLfloat * buff_offset, 
-  GLuint vertex_size_bytes, GLuint index_size_bytes,
- unsigned index_size, GLuint offset_size_bytes,
-  unsigned num_instances)
-{
-  if (m_VertexBuffer || m_IndexBuffer)
-    DeleteBuffers();
-  else
-    m_WaterShader = new WaterShader();
-  m_VertexBuffer = buff_vertex;
-  m_IndexBuffer = buff_index;
-  m_OffsetBuffer = buff_offset;
-  m_VertexBufferSizeBytes = vertex_size_bytes;
-  m_IndexBufferSizeBytes = index_size_bytes;
-  m_NumIndices = index_size;
-  m_OffsetBufferSizeBytes = offset_size_bytes;
-  m_NumInstances = num_instances;
-  PrepareBuffers();
-}
-
-void WaterRenderer::SetVertexBuffer(const GLfloat * buff_vertex)
-{
-  m_VertexBuffer = buff_vertex;
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Renders the Water that the WaterRenderer is currently set to
-/// Render.
-///////////////////////////////////////////////////////////////////////////////
-void WaterRenderer::Render(const glm::vec3 & location,
-  const glm::mat4 & projection, const glm::mat4 & world_to_camera)
-{
-  // make sure water is set
-  if (!m_VertexBuffer || !m_IndexBuffer) {
-    RootError error("WaterFFT.cpp", "WaterRenderer::Render");
-    error.Add("Use SetBuffers before attempting to Render");
-    throw(error);
-  }
-  ManageInput();
-
-  // changing the water vertex data on the gpu
-  glBindBuffer(GL_ARRAY_BUFFER, m_WaterVBOID);
-  glBufferSubData(GL_ARRAY_BUFFER, 0, m_VertexBufferSizeBytes, m_VertexBuffer);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  // finding mesh transformation
-  glm::mat4 transformation(projection * world_to_camera);
-  m_WaterShader->Use();
-  // setting uniforms
-  glUniformMatrix4fv(m_WaterShader->m_UTransform, 1, GL_FALSE,
-    glm::value_ptr(transformation));
-  glUniform3f(m_WaterShader->m_UWaterColor,
-    m_WaterColor.x, m_WaterColor.y, m_WaterColor.z);
-  glUniform1f(m_WaterShader->m_UAmbientFactor, m_AmbientFactor);
-  glUniform3f(m_WaterShader->m_UAmbientColor,
-    m_AmbientColor.x, m_AmbientColor.y, m_AmbientColor.z);
-  glUniform3f(m_WaterShader->m_UDiffuseColor,
-    m_DiffuseColor.x, m_DiffuseColor.y, m_DiffuseColor.z);
-  glUniform1f(m_WaterShader->m_USpecularFactor, m_SpecularFactor);
-  glUniform1i(m_WaterShader->m_USpecularExponent, m_SpecularExponent);
-  glUniform3f(m_WaterShader->m_USpecularColor,
-    m_SpecularColor.x, m_SpecularColor.y, m_SpecularColor.z);
-  glUniform3f(m_WaterShader->m_UCameraPosition,
-    location.x, location.y, location.z);
-  glUniform1f(m_WaterShader->m_UTime, Time::TotalTimeScaled());
-  // rendering water
-  glBindVertexArray(m_WaterVAOID);
-  if (m_LineDraw) {
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    glDrawElementsInstanced(GL_TRIANGLES, m_NumIndices, GL_UNSIGNED_INT, 
-      nullptr, m_NumInstances);
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-  }
-  else
-    glDrawElementsInstanced(GL_TRIANGLES, m_NumIndices, GL_UNSIGNED_INT, 
-      nullptr, m_NumInstances);
-  glBindVertexArray(0);
-  // performing error check
-  GLenum gl_error = glGetError();
-  try {
-    OPENGLERRORCHECK("Water.cpp", "WaterRenderer::Render", 
-      "Water Rendering", gl_error);
-  }
-  catch (const Error & error) {
-    ErrorLog::Write(error);
-  }
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Deletes all of the GPU buffers that are being used to Render Water
-/// and reinitializes them. This is meant for when the size of the Water's
-/// grid changes in size.
-///////////////////////////////////////////////////////////////////////////////
-void WaterRenderer::DeleteBuffers()
-{
-  // deleting
-  glDeleteBuffers(1, &m_WaterVBOID);
-  glDeleteBuffers(1, &m_WaterEBOID);
-  glDeleteVertexArrays(1, &m_WaterVAOID);
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Initializes the GPU buffers that are used to Render the water. This
-/// will also fill those buffers with the current Water mesh vertex data.
-///////////////////////////////////////////////////////////////////////////////
-void WaterRenderer::PrepareBuffers()
-{
-  // offset buffer //
-  glGenBuffers(1, &m_OffsetVBOID);
-  glBindBuffer(GL_ARRAY_BUFFER, m_OffsetVBOID);
-  glBufferData(GL_ARRAY_BUFFER, m_OffsetBufferSizeBytes, m_OffsetBuffer,
-    GL_STREAM_DRAW);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  // water buffers //
-  glGenVertexArrays(1, &m_WaterVAOID);
-  glGenBuffers(1, &m_WaterVBOID);
-  glGenBuffers(1, &m_WaterEBOID);
-  glBindVertexArray(m_WaterVAOID);
-  // buffer data
-  glBindBuffer(GL_ARRAY_BUFFER, m_WaterVBOID);
-  glBufferData(GL_ARRAY_BUFFER, m_VertexBufferSizeBytes, m_VertexBuffer, 
-    GL_STREAM_DRAW);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_WaterEBOID);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferSizeBytes, m_IndexBuffer, 
-    GL_STATIC_DRAW);
-  // attributes
-  glVertexAttribPointer(m_WaterShader->m_APosition, 3, GL_FLOAT, GL_FALSE, 
-    8 * sizeof(GLfloat), nullptr);
-  glEnableVertexAttribArray(m_WaterShader->m_APosition);
-  glVertexAttribPointer(m_WaterShader->m_ANormal, 3, GL_FLOAT, GL_TRUE, 
-    8 * sizeof(GLfloat), (void *)(4 * sizeof(GLfloat)));
-  glEnableVertexAttribArray(m_WaterShader->m_ANormal);
-  // instanced offset attribute
-  glEnableVertexAttribArray(m_WaterShader->m_AOffset);
-  glBindBuffer(GL_ARRAY_BUFFER, m_OffsetVBOID);
-  glVertexAttribPointer(m_WaterShader->m_AOffset, 3, GL_FLOAT, GL_FALSE,
-    4 * sizeof(GLfloat), nullptr);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glVertexAttribDivisor(m_WaterShader->m_AOffset, 1);
-  // unbind
-  glBindVertexArray(0);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-  // error checking //
-  GLenum gl_error = glGetError();
-  try {
-    OPENGLERRORCHECK("Water.cpp", "Water", "Vertex Construction", gl_error);
-  }
-  catch (const Error & error) {
-    ErrorLog::Write(error);
-  }
-}
-
-//////////////////////////////////////////////////////////////////////////////
-/// @brief Handles input that will affect the WaterRenderer.
-///////////////////////////////////////////////////////////////////////////////
-inline void WaterRenderer::ManageInput()
-{
-  if (Input::KeyPressed(Key::SPACE)) {
-    m_LineDraw = !m_LineDraw;
-  }
-}
-
-/******************************************************************************
-// DEPRECATED /////////////////////////////////////////////////////////////////
-*******************************************************************************
-
-// DFT Implementation
-
-std::pair<float, glm::vec3> WaterFFT::GetLocationHeightNormalDFT(
-  glm::vec2 location, 
-  float time)
-{
-  // just scale the location by our scalers to bring it back
-  location.x /= m_HorizontalScale;
-  location.y /= m_HorizontalScale;
-
-
-  unsigned vertex_index = 0;
-  // The y height is the real part of the complex number
-  Complex final_height(0.0f, 0.0f);
-  glm::vec3 final_normal(0.0f, 0.0f, 0.0f);
-  for (unsigned z = 0; z < m_ZStride; ++z) {
-    float m = z - (m_ZStride / 2.0f);
-    float kz = (TAU * m) / m_ZLength; // TODO: Distribute the 2
-    for (unsigned x = 0; x < m_XStride; ++x) {
-      float n = x - (m_XStride / 2.0f);
-      float kx = (TAU * n) / m_XLength; // TODO: Distribute the 2
-      glm::vec2 k(kx, kz);
-      float k_dot_loc = glm::dot(k, location);
-      Complex htilde0_vertex = 
-        m_VertexExtrasBuffer[vertex_index].m_HTilde0;
-      Complex htilde0_vertex_conjugate = 
-        m_VertexExtrasBuffer[vertex_index].m_HTilde0Conjugate;
-      Complex multiplier(cos(k_dot_loc), sin(k_dot_loc));
-      Complex h_tilde = HTilde(htilde0_vertex, htilde0_vertex_conjugate, 
-        k, time);
-      Complex offset = h_tilde * multiplier;
-      final_height += offset;
-      // probably take that kx out of here
-      final_normal += glm::vec3(kx * offset.Imaginary(), 0.0f, 
-        kz * offset.Imaginary());
-      ++vertex_index;
-    }
-  }
-  final_normal.y = 1.0f;
-  float normal_magnitude = sqrt(final_normal.x * final_normal.x + 
-    final_normal.y * final_normal.y + final_normal.z * final_normal.z);
-  // The scaling here relies on logic deduced from the transpose of the
-  // inverse of the transformation matrix
-  final_normal.x = final_normal.x * 1.0f / m_HorizontalScale;
-  final_normal.y = final_normal.y * 1.0f / m_HeightScale;
-  final_normal.z = final_normal.z * 1.0f / m_HorizontalScale;
-  // normalize the normal since it will since it will be needed for physics.
-  // Figure out more once we move this to the gpu
-  final_normal = glm::normalize(final_normal);
-  // So the real part describes our height and imaginary part describes our 
-  // slope maybe we can do it the other way so the imaginary part describes 
-  // our height and the real part describes our slope
-  return std::pair<float, glm::vec3>(final_height.Real() * m_HeightScale,
-    final_normal);
-}
-
-void WaterFFT::UpdateDFT(float time)
-{
-  std::pair<float, glm::vec3> height_normal;
-  unsigned vertex_index = 0;
-  for (unsigned z = 0; z < m_ZStride; ++z) 
-  {
-    for (unsigned x = 0; x < m_XStride; ++x) 
-    {
-      // get starting location
-      float x_position = m_VertexExtrasBuffer[vertex_index].m_Ox;
-      float z_position = m_VertexExtrasBuffer[vertex_index].m_Oz;
-      glm::vec2 location(x_position, z_position);
-      // finding height and normal
-      height_normal = GetLocationHeightNormalDFT(location, time);
-      // setting the position
-      m_VertexBufferA[vertex_index].m_Px = x_position * m_HorizontalScale;
-      m_VertexBufferA[vertex_index].m_Py = height_normal.first * m_HeightScale;
-      m_VertexBufferA[vertex_index].m_Pz = z_position * m_HorizontalScale;
-      // setting the normal
-      // scaling relies on logic deduced from the transpose of inverse of
-      // transformation matrix
-      m_VertexBufferA[vertex_index].m_Nx = 
-        height_normal.second.x * 1.0f / m_HorizontalScale;
-      m_VertexBufferA[vertex_index].m_Ny = 
-        height_normal.second.y * 1.0f / m_HeightScale;
-      m_VertexBufferA[vertex_index].m_Nz = 
-        height_normal.second.z * 1.0f / m_HorizontalScale;
-      ++vertex_index;
-    }
-  }
-}
-
-
-*******************************************************************************
-///////////////////////////////////////////////////////////////////////////////
-******************************************************************************/
+
+
+#include <GLM\glm\vec3.hpp>
+#include <GLM\glm\glm.hpp>
+#include <GLM\glm\gtc\type_ptr.hpp>
+#define STB_IMAGE_IMPLEMENTATION
+#include <STB\stb_image.h>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include "Error.h"
+#include "Time.h"
+#include "WaterFFT.h"
+#ifndef WATER_HEADLESS
+#include "OpenGLError.h"
+#include "Context.h"
+#endif
+// The fft output is written to the vertex buffer with SSE when it is available.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define WATER_SIMD
+#include <emmintrin.h>
+#endif
+
+// math constants //
+#define EPSILON 1.0e-4f
+#define DELTA 1.0e-1
+#define PI 3.14159265358979323846264338f
+#define TAU 6.28318530718f
+#define TAU_D 6.283185307179586476925286766559
+#define INDICIES_PER_QUAD 6
+#define MIN_DX_DZ 0.02f
+// simulation clock //
+#define WATER_STEP_RATE 30.0f
+#define NO_TICK INT_MIN
+#define WRITING_TICK (INT_MIN + 1)
+// Marks a buffer that is still being read but no longer holds a valid tick.
+#define READING_TICK (INT_MIN + 2)
+// The weight of the newest update in the running average of update times.
+#define UPDATE_TIME_WEIGHT 0.1f
+// The size of the ripple and wake windows used by WaterFFTHolder.
+#define RIPPLE_WINDOW 256
+#define RIPPLE_CELL_SIZE 1.0f
+#define WAKE_WINDOW 256
+#define WAKE_CELL_SIZE 1.0f
+
+// MATH HELPERS ///////////////////////////////////////////////////////////////
+
+float Lerp(float a, float b, float t)
+{
+  return a + (b - a) * t;
+}
+
+float QuadLerp(float a, float b, float c, float d, float tx, float ty)
+{
+  float ab = Lerp(a, b, tx);
+  float cd = Lerp(c, d, tx);
+  return Lerp(ab, cd, ty);
+}
+
+// Finds omega * time reduced to [0, TAU). The product is found in double
+// precision and the whole turns are removed before the result is turned into
+// a float, so the angle stays accurate no matter how large the time gets.
+float PhaseAngle(float omega, double time)
+{
+  double turns = (double)omega * time / TAU_D;
+  return (float)((turns - std::floor(turns)) * TAU_D);
+}
+
+#ifdef WATER_SIMD
+// Evaluates the Taylor series of sine to the x^11 term. This is accurate to
+// about 1e-7 on [-PI / 2, PI / 2].
+static inline __m128 SinPolynomial4(__m128 x)
+{
+  __m128 x2 = _mm_mul_ps(x, x);
+  __m128 result = _mm_set1_ps(-1.0f / 39916800.0f);
+  result = _mm_add_ps(_mm_mul_ps(result, x2), _mm_set1_ps(1.0f / 362880.0f));
+  result = _mm_add_ps(_mm_mul_ps(result, x2), _mm_set1_ps(-1.0f / 5040.0f));
+  result = _mm_add_ps(_mm_mul_ps(result, x2), _mm_set1_ps(1.0f / 120.0f));
+  result = _mm_add_ps(_mm_mul_ps(result, x2), _mm_set1_ps(-1.0f / 6.0f));
+  result = _mm_add_ps(_mm_mul_ps(result, x2), _mm_set1_ps(1.0f));
+  return _mm_mul_ps(result, x);
+}
+
+// Finds the sine and cosine of four angles. The angles are reduced to
+// [-PI, PI]. The sine is found after reflecting the angle into
+// [-PI / 2, PI / 2] and the cosine is found with cos(x) = sin(PI / 2 - |x|).
+static inline void SinCos4(__m128 x, __m128 * sine, __m128 * cosine)
+{
+  __m128 turns = _mm_cvtepi32_ps(_mm_cvtps_epi32(
+    _mm_mul_ps(x, _mm_set1_ps(1.0f / TAU))));
+  x = _mm_sub_ps(x, _mm_mul_ps(turns, _mm_set1_ps(TAU)));
+  __m128 sign_mask = _mm_set1_ps(-0.0f);
+  __m128 abs_x = _mm_andnot_ps(sign_mask, x);
+  __m128 sign = _mm_and_ps(sign_mask, x);
+  __m128 reflected = _mm_min_ps(abs_x, _mm_sub_ps(_mm_set1_ps(PI), abs_x));
+  *sine = SinPolynomial4(_mm_or_ps(reflected, sign));
+  *cosine = SinPolynomial4(_mm_sub_ps(_mm_set1_ps(PI / 2.0f), abs_x));
+}
+#endif
+
+int Clamp(int min, int max, int value)
+{
+  return glm::min(max, glm::max(min, value));
+}
+
+// INTENSITY MAP //////////////////////////////////////////////////////////////
+
+WaterFFT::IntensityMap::IntensityMap(const std::string & filename) :
+  m_InstensityFile(filename)
+{
+   m_Data = stbi_load(filename.c_str(), &m_Width, &m_Height,
+    &m_Channels, 1);
+   m_MaxX = static_cast<uint>(m_Width - 1);
+   m_MaxY = static_cast<uint>(m_Height - 1);
+}
+
+WaterFFT::IntensityMap::~IntensityMap()
+{
+  stbi_image_free(m_Data);
+}
+
+float WaterFFT::IntensityMap::GetIntensity(float x, float z)
+{
+  // finding the pixel location in the texture
+  float xi_f = x * m_Width;
+  float yi_f = z * m_Height;
+
+  uint xi0 = static_cast<uint>(xi_f);
+  uint xi1 = glm::min(xi0 + 1, m_MaxX);
+  uint yi0 = static_cast<uint>(yi_f);
+  uint yi1 = glm::min(yi0 + 1, m_MaxY);
+
+  // Getting the interpolation parameters for x / y directions
+  float x_t = xi_f - static_cast<float>(xi0);
+  float y_t = yi_f - static_cast<float>(yi0);
+  
+  uint ai = yi0 * m_Width + xi0;
+  uint bi = yi0 * m_Width + xi1;
+  uint ci = yi1 * m_Width + xi0;
+  uint di = yi1 * m_Width + xi1;
+
+  float a = static_cast<float>(m_Data[ai]) / 255.0f;
+  float b = static_cast<float>(m_Data[bi]) / 255.0f;
+  float c = static_cast<float>(m_Data[ci]) / 255.0f;
+  float d = static_cast<float>(m_Data[di]) / 255.0f;
+  return QuadLerp(a, b, c, d, x_t, y_t);
+}
+
+// WATERFFT ///////////////////////////////////////////////////////////////////
+
+WaterFFT::WaterFFT(unsigned grid_dimension, float meter_dimension, 
+  unsigned expansion) :
+  WaterFFT(grid_dimension, grid_dimension, meter_dimension, meter_dimension,
+    expansion)
+{}
+
+WaterFFT::WaterFFT(unsigned x_dimension, unsigned z_dimension,
+  float x_length, float z_length, unsigned expansion) :
+  m_HeightScale(1.0f), m_DisplaceScale(1.0f), m_HalfPrecision(false),
+  m_SpectrumThreshold(0.0f), m_SpectrumEnergyLoss(0.0f),
+  m_Deterministic(false), m_BuiltinFFT(nullptr), m_Seed(WATER_DEFAULT_SEED),
+  m_IMap(nullptr), m_XLength(x_length), m_ZLength(z_length), 
+  m_Amplitude(0.00005f), m_Gravity(9.81f), m_Wind(64.0f, 64.0f)
+{
+  // Check for errors before continuing. First check that both grid dimensions
+  // are sizes the fft can transform.
+  if (!ValidGridDimension(x_dimension) || !ValidGridDimension(z_dimension))
+  {
+    WaterFFTError error(WaterFFTError::INVALID_GRID_DIM, "The water grid's"
+      " dimensions must be even and have no prime factors other than 2, 3, 5,"
+      " and 7");
+    throw(error);
+  }
+
+  // Set up the strides for the complete mesh and the part of the mesh that the
+  // fft will be used to compute positions for.
+  m_XStride = x_dimension + 1;
+  m_ZStride = z_dimension + 1;
+  m_NumVerts = m_XStride * m_ZStride;
+  m_fft_XStride = x_dimension;
+  m_fft_ZStride = z_dimension;
+  m_fft_NumVerts = m_fft_XStride * m_fft_ZStride;
+
+  // Check that the distance between vertices is greater than some minimum
+  // value in both directions.
+  float dx = m_XLength / (float)m_fft_XStride;
+  float dz = m_ZLength / (float)m_fft_ZStride;
+  if (dx < MIN_DX_DZ || dz < MIN_DX_DZ)
+  {
+    WaterFFTError error(WaterFFTError::SMALL_DX_DZ, "The dimension in meters"
+      " divided by the dimension in grid units should be larger than 2 cm");
+      throw(error);
+  }
+
+  // Allocating arrays for FFTW input and output. 
+  uint num_fft_bytes = sizeof(Complex) * m_fft_NumVerts;
+  m_HTildeIn = (Complex *)fftwf_malloc(num_fft_bytes);
+  m_HTildeSlopeXIn = (Complex *)fftwf_malloc(num_fft_bytes);
+  m_HTildeSlopeZIn = (Complex *)fftwf_malloc(num_fft_bytes);
+  m_HTildeDisplaceXIn = (Complex *)fftwf_malloc(num_fft_bytes);
+  m_HTildeDisplaceZIn = (Complex *)fftwf_malloc(num_fft_bytes);
+  m_HTildeOut = (Complex *)fftwf_malloc(num_fft_bytes);
+  m_HTildeSlopeXOut = (Complex *)fftwf_malloc(num_fft_bytes);
+  m_HTildeSlopeZOut = (Complex *)fftwf_malloc(num_fft_bytes);
+  m_HTildeDisplaceXOut = (Complex *)fftwf_malloc(num_fft_bytes);
+  m_HTildeDisplaceZOut = (Complex *)fftwf_malloc(num_fft_bytes);
+  
+  CreatePlans();
+
+  // The wave numbers for each column and row of the spectrum.
+  m_KX.resize(m_fft_XStride);
+  for (unsigned x = 0; x < m_fft_XStride; ++x)
+    m_KX[x] = (TAU * Frequency(x, m_fft_XStride)) / m_XLength;
+  m_KZ.resize(m_fft_ZStride);
+  for (unsigned z = 0; z < m_fft_ZStride; ++z)
+    m_KZ[z] = (TAU * Frequency(z, m_fft_ZStride)) / m_ZLength;
+  m_RowDisplaceX.resize(m_fft_XStride);
+  m_RowDisplaceZ.resize(m_fft_XStride);
+  m_RowExtras.resize(2 * m_fft_XStride);
+  m_RowLayerHeight.resize(m_XStride);
+  m_RowLayerSlopeX.resize(m_XStride);
+  m_RowLayerSlopeZ.resize(m_XStride);
+
+  // Initializing all of the buffers needed for the water.
+  InitializeVertexBuffer();
+  InitializeIndexBuffer();
+  InitializeOffsetBuffer(expansion);
+}
+
+WaterFFT::~WaterFFT()
+{
+  delete m_BuiltinFFT;
+  DestroyPlans();
+  // freeing FFTW in and out arrays
+  fftwf_free(m_HTildeIn);
+  fftwf_free(m_HTildeSlopeXIn);
+  fftwf_free(m_HTildeSlopeZIn);
+  fftwf_free(m_HTildeDisplaceXIn);
+  fftwf_free(m_HTildeDisplaceZIn);
+  fftwf_free(m_HTildeOut);
+  fftwf_free(m_HTildeSlopeXOut);
+  fftwf_free(m_HTildeSlopeZOut);
+  fftwf_free(m_HTildeDisplaceXOut);
+  fftwf_free(m_HTildeDisplaceZOut);
+  RemoveIntensityMap();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Identifies whether a grid dimension can be simulated. The
+/// dimension must be even so the sign pattern applied to the fft output
+/// lines up across rows, and the fft requires that it has no prime factors
+/// other than 2, 3, 5, and 7.
+///
+/// @param dimension The number of quads along one side of the grid.
+///
+/// @return True if the dimension can be used.
+///////////////////////////////////////////////////////////////////////////////
+bool WaterFFT::ValidGridDimension(unsigned dimension)
+{
+  return dimension % 2 == 0 && FFT::Supported(dimension);
+}
+
+bool WaterFFT::UseIntensityMap(const std::string & filename)
+{
+  RemoveIntensityMap();
+  m_IMap = new IntensityMap(filename);
+  return true;
+}
+
+bool WaterFFT::RemoveIntensityMap()
+{
+  if (m_IMap)
+  {
+    delete m_IMap;
+    m_IMap = nullptr;
+    return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Changes how the htilde0 values are stored. Halves take half of the
+/// memory of the complex float each element needs, so less is read every
+/// update. The values are converted back to floats before they are
+/// used, so only their precision is lost. The spectra and fft outputs stay
+/// floats. bench_half_precision in WaterFFT_test.h measures why.
+///
+/// @param enabled True to store halves and false to store floats. Going back
+///   to floats does not restore the precision that was lost.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFT::HalfPrecision(bool enabled)
+{
+  static_assert(sizeof(VertexExtra) == 2 * sizeof(float),
+    "VertexExtra must be two packed floats");
+  if (enabled == m_HalfPrecision)
+    return;
+  if (enabled)
+  {
+    m_HalfVertexExtrasBuffer.resize(m_VertexExtrasBuffer.size());
+    FloatToHalf((const float *)m_VertexExtrasBuffer.data(),
+      m_HalfVertexExtrasBuffer[0].m_Values, 2 * m_fft_NumVerts);
+    std::vector<VertexExtra>().swap(m_VertexExtrasBuffer);
+  }
+  else
+  {
+    m_VertexExtrasBuffer.resize(m_HalfVertexExtrasBuffer.size());
+    HalfToFloat(m_HalfVertexExtrasBuffer[0].m_Values,
+      (float *)m_VertexExtrasBuffer.data(), 2 * m_fft_NumVerts);
+    std::vector<HalfVertexExtra>().swap(m_HalfVertexExtrasBuffer);
+  }
+  m_HalfPrecision = enabled;
+}
+
+bool WaterFFT::HalfPrecision() const
+{
+  return m_HalfPrecision;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Makes the spectrum again from a new seed. The half precision,
+/// spectrum threshold, and exact mode settings are kept.
+///
+/// @param seed The seed. Every WaterFFT given the same seed and size has the
+///   same spectrum.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFT::Seed(uint64_t seed)
+{
+  if (seed == m_Seed)
+    return;
+  m_Seed = seed;
+  bool half_precision = m_HalfPrecision;
+  std::vector<HalfVertexExtra>().swap(m_HalfVertexExtrasBuffer);
+  m_HalfPrecision = false;
+  InitializeSpectrum();
+  HalfPrecision(half_precision);
+  SpectrumThreshold(m_SpectrumThreshold);
+  if (!m_ModeKX.empty())
+    ExactModes((unsigned)m_ModeKX.size());
+}
+
+uint64_t WaterFFT::Seed() const
+{
+  return m_Seed;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Sets whether the FFTW plans are chosen by FFTW_ESTIMATE instead of
+/// by timing them. Estimated plans are always the same for the same build,
+/// which the determinism guarantee needs. They can be a little slower.
+///
+/// @param enabled True to use estimated plans.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFT::Deterministic(bool enabled)
+{
+  if (enabled == m_Deterministic)
+    return;
+  m_Deterministic = enabled;
+  DestroyPlans();
+  CreatePlans();
+}
+
+bool WaterFFT::Deterministic() const
+{
+  return m_Deterministic;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Sets whether the ffts are computed by the FFT2D in FFT.h instead
+/// of by the FFTW plans. FFT2D always runs the same code for a size, so it
+/// is deterministic either way. FFT_test.h times both.
+///
+/// @param enabled True to use FFT2D.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFT::BuiltinFFT(bool enabled)
+{
+  if (enabled == (m_BuiltinFFT != nullptr))
+    return;
+  delete m_BuiltinFFT;
+  m_BuiltinFFT = nullptr;
+  if (enabled)
+    m_BuiltinFFT = new FFT2D(m_fft_XStride, m_fft_ZStride);
+}
+
+bool WaterFFT::BuiltinFFT() const
+{
+  return m_BuiltinFFT != nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Skips the parts of the spectrum with too little energy to matter.
+/// The Phillips spectrum is zero at k = 0 and close to zero for waves
+/// perpendicular to the wind and for very short waves. Elements whose |h~0|
+/// and mirrored |h~0| are both at or under the threshold are left at zero
+/// instead of being updated every frame. The energy that is lost is found
+/// here and can be read with SpectrumEnergyLoss.
+///
+/// @param threshold A fraction of the largest |h~0|. Zero updates every
+///   element.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFT::SpectrumThreshold(float threshold)
+{
+  m_SpectrumThreshold = threshold;
+  m_SpectrumPairs.clear();
+  m_SpectrumEnergyLoss = 0.0f;
+  if (threshold <= 0.0f)
+    return;
+
+  // Find the total energy and the largest magnitude.
+  double total_energy = 0.0;
+  float max_magnitude_pow_2 = 0.0f;
+  for (unsigned i = 0; i < m_fft_NumVerts; ++i)
+  {
+    Complex htilde0 = HTilde0At(i);
+    float magnitude_pow_2 = htilde0.Real() * htilde0.Real() +
+      htilde0.Imaginary() * htilde0.Imaginary();
+    total_energy += magnitude_pow_2;
+    max_magnitude_pow_2 = glm::max(max_magnitude_pow_2, magnitude_pow_2);
+  }
+
+  // Keep the pairs where either element is above the threshold. The pairs
+  // are visited in the same order as UpdateFFT visits them.
+  float limit = threshold * threshold * max_magnitude_pow_2;
+  double kept_energy = 0.0;
+  for (unsigned z = 0; z <= m_fft_ZStride / 2; ++z)
+  {
+    unsigned z_mirror = (m_fft_ZStride - z) % m_fft_ZStride;
+    unsigned x_end = m_fft_XStride;
+    if (z == z_mirror)
+      x_end = m_fft_XStride / 2 + 1;
+    for (unsigned x = 0; x < x_end; ++x)
+    {
+      unsigned x_mirror = (m_fft_XStride - x) % m_fft_XStride;
+      unsigned index = z * m_fft_XStride + x;
+      unsigned mirror_index = z_mirror * m_fft_XStride + x_mirror;
+      Complex a = HTilde0At(index);
+      Complex b = HTilde0At(mirror_index);
+      float a_pow_2 = a.Real() * a.Real() + a.Imaginary() * a.Imaginary();
+      float b_pow_2 = b.Real() * b.Real() + b.Imaginary() * b.Imaginary();
+      if (a_pow_2 <= limit && b_pow_2 <= limit)
+        continue;
+      SpectrumPair pair = { x, z, x_mirror, z_mirror };
+      m_SpectrumPairs.push_back(pair);
+      kept_energy += a_pow_2;
+      if (mirror_index != index)
+        kept_energy += b_pow_2;
+    }
+  }
+  if (total_energy > 0.0)
+    m_SpectrumEnergyLoss = (float)(1.0 - kept_energy / total_energy);
+}
+
+float WaterFFT::SpectrumThreshold() const
+{
+  return m_SpectrumThreshold;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the number of spectrum elements that are updated each frame.
+///
+/// @return The number of elements.
+///////////////////////////////////////////////////////////////////////////////
+unsigned WaterFFT::SpectrumActiveCount() const
+{
+  if (m_SpectrumThreshold <= 0.0f)
+    return m_fft_NumVerts;
+  unsigned count = 0;
+  for (const SpectrumPair & pair : m_SpectrumPairs)
+  {
+    bool same = pair.m_X == pair.m_MirrorX && pair.m_Z == pair.m_MirrorZ;
+    count += same ? 1 : 2;
+  }
+  return count;
+}
+
+unsigned WaterFFT::SpectrumCount() const
+{
+  return m_fft_NumVerts;
+}
+
+float WaterFFT::SpectrumEnergyLoss() const
+{
+  return m_SpectrumEnergyLoss;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Chooses the modes used by SampleExact. The modes with the most
+/// energy, |h~0(k)|^2 + |h~0(-k)|^2, are kept.
+///
+/// @param count The number of modes to keep. Around 256 to 1024 modes give
+///   accurate heights for far less work than a full FFT. Zero removes all of
+///   the modes.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFT::ExactModes(unsigned count)
+{
+  count = glm::min(count, m_fft_NumVerts);
+  std::vector<float> energy(m_fft_NumVerts);
+  std::vector<unsigned> order(m_fft_NumVerts);
+  for (unsigned z = 0; z < m_fft_ZStride; ++z)
+  {
+    unsigned z_mirror = (m_fft_ZStride - z) % m_fft_ZStride;
+    for (unsigned x = 0; x < m_fft_XStride; ++x)
+    {
+      unsigned x_mirror = (m_fft_XStride - x) % m_fft_XStride;
+      unsigned index = z * m_fft_XStride + x;
+      Complex a = HTilde0At(index);
+      Complex b = HTilde0At(z_mirror * m_fft_XStride + x_mirror);
+      energy[index] = a.Real() * a.Real() + a.Imaginary() * a.Imaginary() +
+        b.Real() * b.Real() + b.Imaginary() * b.Imaginary();
+      order[index] = index;
+    }
+  }
+  std::partial_sort(order.begin(), order.begin() + count, order.end(),
+    [&energy](unsigned a, unsigned b) { return energy[a] > energy[b]; });
+
+  std::vector<float> * mode_arrays[] = { &m_ModeKX, &m_ModeKZ, &m_ModeOmega,
+    &m_ModeH0Real, &m_ModeH0Imaginary, &m_ModeH0MirrorReal,
+    &m_ModeH0MirrorImaginary };
+  for (std::vector<float> * mode_array : mode_arrays)
+    mode_array->resize(count);
+  for (unsigned m = 0; m < count; ++m)
+  {
+    unsigned x = order[m] % m_fft_XStride;
+    unsigned z = order[m] / m_fft_XStride;
+    unsigned x_mirror = (m_fft_XStride - x) % m_fft_XStride;
+    unsigned z_mirror = (m_fft_ZStride - z) % m_fft_ZStride;
+    glm::vec2 k(m_KX[x], m_KZ[z]);
+    Complex htilde0 = HTilde0At(order[m]);
+    Complex htilde0_mirror =
+      HTilde0At(z_mirror * m_fft_XStride + x_mirror).Conjugate();
+    m_ModeKX[m] = k.x;
+    m_ModeKZ[m] = k.y;
+    m_ModeOmega[m] = DispersionRelation(k);
+    m_ModeH0Real[m] = htilde0.Real();
+    m_ModeH0Imaginary[m] = htilde0.Imaginary();
+    m_ModeH0MirrorReal[m] = htilde0_mirror.Real();
+    m_ModeH0MirrorImaginary[m] = htilde0_mirror.Imaginary();
+  }
+}
+
+unsigned WaterFFT::ExactModeCount() const
+{
+  return (unsigned)m_ModeKX.size();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Finds the surface at any number of locations by summing the modes
+/// chosen by ExactModes. Unlike HeightAtLocation, the result does not depend
+/// on the grid resolution and is not interpolated. The intensity map is not
+/// applied.
+///
+/// @param locations The locations on the xz plane.
+/// @param count The number of locations.
+/// @param time The simulation time to sample at.
+/// @param samples The surface at each location is written here.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFT::SampleExact(const glm::vec2 * locations, unsigned count,
+  double time, SurfaceSample * samples)
+{
+  // Find h~(k, t) for every mode. This is the same as HTildePair:
+  // h~ = h~0(k) * e_1 + h~0*(-k) * e_2 with e_2 = -e_1.
+  unsigned modes = (unsigned)m_ModeKX.size();
+  std::vector<float> h_real(modes);
+  std::vector<float> h_imaginary(modes);
+  std::vector<float> kx_unit(modes);
+  std::vector<float> kz_unit(modes);
+  for (unsigned m = 0; m < modes; ++m)
+  {
+    float omega_t = PhaseAngle(m_ModeOmega[m], time);
+    Complex e_1(cos(omega_t), sin(omega_t));
+    Complex htilde0(m_ModeH0Real[m], m_ModeH0Imaginary[m]);
+    Complex htilde0_mirror(m_ModeH0MirrorReal[m], m_ModeH0MirrorImaginary[m]);
+    Complex htilde = (htilde0 - htilde0_mirror) * e_1;
+    h_real[m] = htilde.Real();
+    h_imaginary[m] = htilde.Imaginary();
+    float k_magnitude = std::sqrt(m_ModeKX[m] * m_ModeKX[m] +
+      m_ModeKZ[m] * m_ModeKZ[m]);
+    kx_unit[m] = k_magnitude < EPSILON ? 0.0f : m_ModeKX[m] / k_magnitude;
+    kz_unit[m] = k_magnitude < EPSILON ? 0.0f : m_ModeKZ[m] / k_magnitude;
+  }
+
+  // The fft output at grid index x is at x * L / N - L / 2, so the phase of a
+  // mode is k dot (location + L / 2). With theta as that phase,
+  // Re(h~ * exp(-i * theta)) = h_real * cos + h_imaginary * sin and the
+  // slope and displacement use q = h_imaginary * cos - h_real * sin.
+  float x_shift = 0.5f * m_XLength;
+  float z_shift = 0.5f * m_ZLength;
+  unsigned i = 0;
+#ifdef WATER_SIMD
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 px = _mm_set_ps(locations[i + 3].x, locations[i + 2].x,
+      locations[i + 1].x, locations[i].x);
+    __m128 pz = _mm_set_ps(locations[i + 3].y, locations[i + 2].y,
+      locations[i + 1].y, locations[i].y);
+    px = _mm_add_ps(px, _mm_set1_ps(x_shift));
+    pz = _mm_add_ps(pz, _mm_set1_ps(z_shift));
+    __m128 height = _mm_setzero_ps();
+    __m128 slope_x = _mm_setzero_ps();
+    __m128 slope_z = _mm_setzero_ps();
+    __m128 displace_x = _mm_setzero_ps();
+    __m128 displace_z = _mm_setzero_ps();
+    for (unsigned m = 0; m < modes; ++m)
+    {
+      __m128 kx = _mm_set1_ps(m_ModeKX[m]);
+      __m128 kz = _mm_set1_ps(m_ModeKZ[m]);
+      __m128 theta = _mm_add_ps(_mm_mul_ps(kx, px), _mm_mul_ps(kz, pz));
+      __m128 sine, cosine;
+      SinCos4(theta, &sine, &cosine);
+      __m128 hr = _mm_set1_ps(h_real[m]);
+      __m128 hi = _mm_set1_ps(h_imaginary[m]);
+      height = _mm_add_ps(height,
+        _mm_add_ps(_mm_mul_ps(hr, cosine), _mm_mul_ps(hi, sine)));
+      __m128 q = _mm_sub_ps(_mm_mul_ps(hi, cosine), _mm_mul_ps(hr, sine));
+      slope_x = _mm_sub_ps(slope_x, _mm_mul_ps(kx, q));
+      slope_z = _mm_sub_ps(slope_z, _mm_mul_ps(kz, q));
+      displace_x = _mm_add_ps(displace_x,
+        _mm_mul_ps(_mm_set1_ps(kx_unit[m]), q));
+      displace_z = _mm_add_ps(displace_z,
+        _mm_mul_ps(_mm_set1_ps(kz_unit[m]), q));
+    }
+    float h[4], sx[4], sz[4], dx[4], dz[4];
+    _mm_storeu_ps(h, height);
+    _mm_storeu_ps(sx, slope_x);
+    _mm_storeu_ps(sz, slope_z);
+    _mm_storeu_ps(dx, displace_x);
+    _mm_storeu_ps(dz, displace_z);
+    for (unsigned j = 0; j < 4; ++j)
+    {
+      SurfaceSample & sample = samples[i + j];
+      sample.m_Height = h[j] * m_HeightScale;
+      sample.m_Normal = glm::normalize(
+        glm::vec3(-sx[j], 1.0f / m_HeightScale, -sz[j]));
+      sample.m_Displacement = glm::vec2(dx[j], dz[j]) * m_DisplaceScale;
+    }
+  }
+#endif
+
+  // The locations that do not fill a group of four.
+  for (; i < count; ++i)
+  {
+    float px = locations[i].x + x_shift;
+    float pz = locations[i].y + z_shift;
+    float height = 0.0f;
+    glm::vec2 slope(0.0f, 0.0f);
+    glm::vec2 displace(0.0f, 0.0f);
+    for (unsigned m = 0; m < modes; ++m)
+    {
+      float theta = m_ModeKX[m] * px + m_ModeKZ[m] * pz;
+      float cosine = cos(theta);
+      float sine = sin(theta);
+      height += h_real[m] * cosine + h_imaginary[m] * sine;
+      float q = h_imaginary[m] * cosine - h_real[m] * sine;
+      slope -= glm::vec2(m_ModeKX[m], m_ModeKZ[m]) * q;
+      displace += glm::vec2(kx_unit[m], kz_unit[m]) * q;
+    }
+    SurfaceSample & sample = samples[i];
+    sample.m_Height = height * m_HeightScale;
+    sample.m_Normal = glm::normalize(
+      glm::vec3(-slope.x, 1.0f / m_HeightScale, -slope.y));
+    sample.m_Displacement = displace * m_DisplaceScale;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Finds the surface at any number of locations by interpolating the
+/// vertices of one vertex buffer. Layers and the intensity map are included
+/// because they are part of the vertices.
+///
+/// @param buffer The vertex buffer to read. It must not be written while it
+///   is read.
+/// @param locations The locations on the xz plane.
+/// @param count The number of locations.
+/// @param samples The surface at each location is written here.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFT::SampleBuffer(unsigned buffer, const glm::vec2 * locations,
+  unsigned count, SurfaceSample * samples)
+{
+  const std::vector<Vertex> & vertices = m_VertexBuffers[buffer];
+  float dx = m_XLength / (float)m_fft_XStride;
+  float dz = m_ZLength / (float)m_fft_ZStride;
+  for (unsigned i = 0; i < count; ++i)
+  {
+    MeshPosition mp = LocationToMeshPosition(locations[i]);
+    const Vertex & a = vertices[mp.m_VertexIndex];
+    const Vertex & b = vertices[mp.m_VertexIndex + 1];
+    const Vertex & c = vertices[mp.m_VertexIndex + m_XStride];
+    const Vertex & d = vertices[mp.m_VertexIndex + m_XStride + 1];
+    float xt = mp.m_Xt;
+    float zt = mp.m_Zt;
+    // The displacement is the interpolated position minus the position the
+    // vertices would have without any waves.
+    float rest_x = (float)(mp.m_VertexIndex % m_XStride) * dx -
+      m_XLength / 2.0f + xt * dx;
+    float rest_z = (float)(mp.m_VertexIndex / m_XStride) * dz -
+      m_ZLength / 2.0f + zt * dz;
+    SurfaceSample & sample = samples[i];
+    sample.m_Height = QuadLerp(a.m_Py, b.m_Py, c.m_Py, d.m_Py, xt, zt);
+    sample.m_Normal = glm::normalize(glm::vec3(
+      QuadLerp(a.m_Nx, b.m_Nx, c.m_Nx, d.m_Nx, xt, zt),
+      QuadLerp(a.m_Ny, b.m_Ny, c.m_Ny, d.m_Ny, xt, zt),
+      QuadLerp(a.m_Nz, b.m_Nz, c.m_Nz, d.m_Nz, xt, zt)));
+    sample.m_Displacement = glm::vec2(
+      QuadLerp(a.m_Px, b.m_Px, c.m_Px, d.m_Px, xt, zt) - rest_x,
+      QuadLerp(a.m_Pz, b.m_Pz, c.m_Pz, d.m_Pz, xt, zt) - rest_z);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Copies one row of a vertex buffer out as separate fields. The
+/// fields are the displacement in x, y, and z and the normal in x, y, and z.
+/// The displacement is the vertex position minus its position without any
+/// waves, so the y displacement is the height. The last column and row of
+/// the mesh repeat the first, so only XVertices() - 1 values of the rows
+/// 0 to ZVertices() - 2 are given. Together they tile.
+///
+/// @param buffer The vertex buffer to read. It must not be written while it
+///   is read.
+/// @param z The row.
+/// @param fields WATER_FIELDS arrays of XVertices() - 1 values, one after
+///   the other.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFT::FieldRow(unsigned buffer, unsigned z, float * fields) const
+{
+  const Vertex * row = m_VertexBuffers[buffer].data() + z * m_XStride;
+  unsigned count = m_fft_XStride;
+  float dx = m_XLength / (float)m_fft_XStride;
+  float dz = m_ZLength / (float)m_fft_ZStride;
+  float rest_z = (float)z * dz - m_ZLength / 2.0f;
+  float * displace_x = fields;
+  float * displace_y = fields + count;
+  float * displace_z = fields + 2 * count;
+  float * normal_x = fields + 3 * count;
+  float * normal_y = fields + 4 * count;
+  float * normal_z = fields + 5 * count;
+  for (unsigned x = 0; x < count; ++x)
+  {
+    const Vertex & vertex = row[x];
+    displace_x[x] = vertex.m_Px - ((float)x * dx - m_XLength / 2.0f);
+    displace_y[x] = vertex.m_Py;
+    displace_z[x] = vertex.m_Pz - rest_z;
+    normal_x[x] = vertex.m_Nx;
+    normal_y[x] = vertex.m_Ny;
+    normal_z[x] = vertex.m_Nz;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Adds a layer to the surface. Update brings the layer to the
+/// simulation time and adds its heights and slopes to the vertices. The mesh
+/// is instanced, so a layer appears on every instance. It is only in the
+/// right place on the instance its window is centered in.
+///
+/// @param layer The layer. The WaterFFT does not own it.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFT::AttachLayer(SurfaceLayer * layer)
+{
+  m_Layers.push_back(layer);
+  m_LayerOffsets.push_back(glm::vec2(0.0f, 0.0f));
+}
+
+//! Removes every layer from the surface.
+void WaterFFT::ClearLayers()
+{
+  m_Layers.clear();
+  m_LayerOffsets.clear();
+}
+
+std::pair<float, glm::vec3> WaterFFT::HeightNormalAtLocation(
+  const glm::vec2 & location, float time)
+{
+  std::pair<float, glm::vec3> result;
+  result = GetLocationHeightNormalFFT(location);
+  return result;
+}
+
+float WaterFFT::HeightAtLocation(const glm::vec2 & location)
+{
+  MeshPosition mp = LocationToMeshPosition(location);
+  return GetLocationHeightFFT(mp);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Finds the height of the read buffer at many locations. This gives
+/// the same results as calling HeightAtLocation for each location, but the
+/// wrapping and interpolation parameters of four locations are found at once.
+/// The read buffer is only read, so separate ranges of locations can be
+/// queried from separate threads.
+///
+/// @param x The x value of each location.
+/// @param z The z value of each location.
+/// @param count The number of locations.
+/// @param heights The height at each location is written here.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFT::HeightsAtLocations(const float * x, const float * z,
+  unsigned count, float * heights)
+{
+  unsigned i = 0;
+#ifdef WATER_SIMD
+  const Vertex * vertices = m_ReadBuffer->data();
+  float x_grid = (float)m_fft_XStride;
+  float z_grid = (float)m_fft_ZStride;
+  __m128 x_scale = _mm_set1_ps(x_grid / m_XLength);
+  __m128 z_scale = _mm_set1_ps(z_grid / m_ZLength);
+  __m128 x_half = _mm_set1_ps(x_grid / 2.0f);
+  __m128 z_half = _mm_set1_ps(z_grid / 2.0f);
+  __m128 x_grid4 = _mm_set1_ps(x_grid);
+  __m128 z_grid4 = _mm_set1_ps(z_grid);
+  __m128 x_last = _mm_set1_ps(x_grid - 1.0f);
+  __m128 z_last = _mm_set1_ps(z_grid - 1.0f);
+  __m128 one = _mm_set1_ps(1.0f);
+  __m128 zero = _mm_setzero_ps();
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 xf = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + i), x_scale), x_half);
+    __m128 zf = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(z + i), z_scale), z_half);
+    // Wrap onto the grid with value - grid * floor(value / grid). The
+    // truncated quotient is one too large for negative values.
+    __m128 x_turns = _mm_div_ps(xf, x_grid4);
+    __m128 z_turns = _mm_div_ps(zf, z_grid4);
+    __m128 x_floor = _mm_cvtepi32_ps(_mm_cvttps_epi32(x_turns));
+    __m128 z_floor = _mm_cvtepi32_ps(_mm_cvttps_epi32(z_turns));
+    x_floor = _mm_sub_ps(x_floor,
+      _mm_and_ps(_mm_cmpgt_ps(x_floor, x_turns), one));
+    z_floor = _mm_sub_ps(z_floor,
+      _mm_and_ps(_mm_cmpgt_ps(z_floor, z_turns), one));
+    xf = _mm_max_ps(_mm_sub_ps(xf, _mm_mul_ps(x_floor, x_grid4)), zero);
+    zf = _mm_max_ps(_mm_sub_ps(zf, _mm_mul_ps(z_floor, z_grid4)), zero);
+    // The minimums keep a rounded up value off the tail edge.
+    __m128 x_index = _mm_min_ps(
+      _mm_cvtepi32_ps(_mm_cvttps_epi32(xf)), x_last);
+    __m128 z_index = _mm_min_ps(
+      _mm_cvtepi32_ps(_mm_cvttps_epi32(zf)), z_last);
+    __m128 xt = _mm_sub_ps(xf, x_index);
+    __m128 zt = _mm_sub_ps(zf, z_index);
+    int x_indices[4], z_indices[4];
+    _mm_storeu_si128((__m128i *)x_indices, _mm_cvttps_epi32(x_index));
+    _mm_storeu_si128((__m128i *)z_indices, _mm_cvttps_epi32(z_index));
+    float ha[4], hb[4], hc[4], hd[4];
+    for (unsigned j = 0; j < 4; ++j)
+    {
+      const Vertex * a = vertices + z_indices[j] * m_XStride + x_indices[j];
+      ha[j] = a[0].m_Py;
+      hb[j] = a[1].m_Py;
+      hc[j] = a[m_XStride].m_Py;
+      hd[j] = a[m_XStride + 1].m_Py;
+    }
+    __m128 a = _mm_loadu_ps(ha);
+    __m128 c = _mm_loadu_ps(hc);
+    __m128 ab = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(hb), a), xt));
+    __m128 cd = _mm_add_ps(c, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(hd), c), xt));
+    _mm_storeu_ps(heights + i,
+      _mm_add_ps(ab, _mm_mul_ps(_mm_sub_ps(cd, ab), zt)));
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    MeshPosition mp = LocationToMeshPosition(glm::vec2(x[i], z[i]));
+    heights[i] = GetLocationHeightFFT(mp);
+  }
+}
+
+void WaterFFT::Update(double time, unsigned buffer)
+{
+  m_WriteBuffer = &m_VertexBuffers[buffer];
+  for (unsigned i = 0; i < m_Layers.size(); ++i)
+  {
+    // A layer is added to the instance that holds its window's center.
+    m_Layers[i]->Advance(time);
+    glm::vec2 center = m_Layers[i]->Center();
+    m_LayerOffsets[i].x = m_XLength * std::floor(center.x / m_XLength + 0.5f);
+    m_LayerOffsets[i].y = m_ZLength * std::floor(center.y / m_ZLength + 0.5f);
+  }
+  UpdateFFT(time);
+}
+
+void WaterFFT::SetReadBuffer(unsigned buffer)
+{
+  m_ReadBuffer = &m_VertexBuffers[buffer];
+}
+
+const void * WaterFFT::VertexBuffer()
+{
+  return (void *)m_ReadBuffer->data();
+}
+
+const void * WaterFFT::VertexBuffer(unsigned buffer)
+{
+  return (void *)m_VertexBuffers[buffer].data();
+}
+
+const void * WaterFFT::IndexBuffer()
+{
+  return (void *)m_IndexBuffer.data();
+}
+
+const void * WaterFFT::OffsetBuffer()
+{
+  return (void *)m_OffsetBuffer.data();
+}
+
+unsigned WaterFFT::VertexBufferSizeBytes()
+{
+  return m_ReadBuffer->size() * sizeof(Vertex);
+}
+
+//! The number of vertices along the x axis of a vertex buffer.
+unsigned WaterFFT::XVertices() const
+{
+  return m_XStride;
+}
+
+//! The number of vertices along the z axis of a vertex buffer.
+unsigned WaterFFT::ZVertices() const
+{
+  return m_ZStride;
+}
+
+//! The length of the mesh on the x axis in meters.
+float WaterFFT::XLength() const
+{
+  return m_XLength;
+}
+
+//! The length of the mesh on the z axis in meters.
+float WaterFFT::ZLength() const
+{
+  return m_ZLength;
+}
+
+unsigned WaterFFT::IndexBufferSizeBytes()
+{
+  return m_IndexBuffer.size() * sizeof(unsigned int);
+}
+
+unsigned WaterFFT::IndexBufferSize()
+{
+  return m_IndexBuffer.size();
+}
+
+unsigned WaterFFT::OffsetBufferSizeBytes()
+{
+  return m_OffsetBuffer.size() * sizeof(Offset);
+}
+
+unsigned WaterFFT::OffsetBufferSize()
+{
+  return m_OffsetBuffer.size();
+}
+
+void WaterFFT::UpdateFFT(double time)
+{
+  if (m_SpectrumThreshold > 0.0f)
+    UpdateSparseSpectrum(time);
+  else
+  {
+    // h~(k) and h~(-k) are found together. -k is at the mirrored index
+    // ((N - x) mod N, (N - z) mod N), so row z is paired with row N - z and
+    // each pair of h~0 values is read once. Rows 0 and N / 2 are their own
+    // mirrors, so only their first half and center are visited.
+    for (unsigned z = 0; z <= m_fft_ZStride / 2; ++z)
+    {
+      unsigned z_mirror = (m_fft_ZStride - z) % m_fft_ZStride;
+      float kz = m_KZ[z];
+      const VertexExtra * extras = RowExtras(z, 0);
+      const VertexExtra * extras_mirror = RowExtras(z_mirror, 1);
+      Complex * htilde = m_HTildeIn + z * m_fft_XStride;
+      Complex * htilde_mirror = m_HTildeIn + z_mirror * m_fft_XStride;
+      unsigned x_end = m_fft_XStride;
+      if (z == z_mirror)
+        x_end = m_fft_XStride / 2 + 1;
+      for (unsigned x = 0; x < x_end; ++x)
+      {
+        unsigned x_mirror = (m_fft_XStride - x) % m_fft_XStride;
+        glm::vec2 k(m_KX[x], kz);
+        HTildePair(extras[x].m_HTilde0, extras_mirror[x_mirror].m_HTilde0, k,
+          time, htilde + x, htilde_mirror + x_mirror);
+      }
+      BuildRowInputs(z);
+      if (z_mirror != z)
+        BuildRowInputs(z_mirror);
+    }
+  }
+
+  // Execute the fft.
+  ExecuteFFTs();
+
+  // Use the output from the fft for the new vertex positions of the mesh. The
+  // vertex array is extended by one row and one column when compared to the
+  // fft arrays. These vertices are "attached" to the other side of the grid,
+  // so the last row is written from the first fft row moved forward by the
+  // length of the mesh in the z direction. WriteRow handles the last column.
+  Vertex * vertices = m_WriteBuffer->data();
+  float z_start = -0.5f * m_ZLength;
+  float dz = m_ZLength / (float)m_fft_ZStride;
+  for (unsigned z = 0; z < m_fft_ZStride; ++z)
+    WriteRow(z, vertices + z * m_XStride, z_start + dz * (float)z);
+  WriteRow(0, vertices + m_fft_ZStride * m_XStride, z_start + m_ZLength);
+#ifdef WATER_SIMD
+  // Make the streamed vertices visible before the buffer is handed off.
+  _mm_sfence();
+#endif
+}
+
+// Gets a row of vertex extras as floats. Half precision rows are converted
+// into one of two slots of m_RowExtras, so a row and its mirror can be used
+// at the same time.
+inline const WaterFFT::VertexExtra * WaterFFT::RowExtras(unsigned z,
+  unsigned slot)
+{
+  unsigned row = z * m_fft_XStride;
+  if (!m_HalfPrecision)
+    return m_VertexExtrasBuffer.data() + row;
+  VertexExtra * extras = m_RowExtras.data() + slot * m_fft_XStride;
+  HalfToFloat(m_HalfVertexExtrasBuffer[row].m_Values, (float *)extras,
+    2 * m_fft_XStride);
+  return extras;
+}
+
+// Updates only the pairs in m_SpectrumPairs. Every other element of the fft
+// inputs is zero.
+void WaterFFT::UpdateSparseSpectrum(double time)
+{
+  Complex * inputs[] = { m_HTildeIn, m_HTildeSlopeXIn, m_HTildeSlopeZIn,
+    m_HTildeDisplaceXIn, m_HTildeDisplaceZIn };
+  for (Complex * input : inputs)
+    std::fill(input, input + m_fft_NumVerts, Complex());
+  for (const SpectrumPair & pair : m_SpectrumPairs)
+  {
+    unsigned index = pair.m_Z * m_fft_XStride + pair.m_X;
+    unsigned mirror_index = pair.m_MirrorZ * m_fft_XStride + pair.m_MirrorX;
+    glm::vec2 k(m_KX[pair.m_X], m_KZ[pair.m_Z]);
+    Complex htilde, htilde_mirror;
+    HTildePair(HTilde0At(index), HTilde0At(mirror_index), k, time, &htilde,
+      &htilde_mirror);
+    WriteSpectrumElement(pair.m_X, pair.m_Z, htilde);
+    WriteSpectrumElement(pair.m_MirrorX, pair.m_MirrorZ, htilde_mirror);
+  }
+}
+
+// Sets h~ and the slope and displacement inputs for a single element.
+inline void WaterFFT::WriteSpectrumElement(unsigned x, unsigned z,
+  const Complex & htilde)
+{
+  unsigned index = z * m_fft_XStride + x;
+  float kx = m_KX[x];
+  float kz = m_KZ[z];
+  float k_magnitude = std::sqrt(kx * kx + kz * kz);
+  m_HTildeIn[index] = htilde;
+  m_HTildeSlopeXIn[index] = htilde * Complex(0.0f, kx);
+  m_HTildeSlopeZIn[index] = htilde * Complex(0.0f, kz);
+  if (k_magnitude >= EPSILON)
+  {
+    m_HTildeDisplaceXIn[index] = htilde * Complex(0.0f, -kx / k_magnitude);
+    m_HTildeDisplaceZIn[index] = htilde * Complex(0.0f, -kz / k_magnitude);
+  }
+}
+
+// Gets h~0 for an element from whichever table is in use.
+inline Complex WaterFFT::HTilde0At(unsigned index)
+{
+  if (!m_HalfPrecision)
+    return m_VertexExtrasBuffer[index].m_HTilde0;
+  const Half * values = m_HalfVertexExtrasBuffer[index].m_Values;
+  return Complex(HalfToFloat(values[0]), HalfToFloat(values[1]));
+}
+
+// Sets the slope and displacement inputs for one row of the spectrum. They
+// are the row of h~ multiplied by i times a wave number.
+void WaterFFT::BuildRowInputs(unsigned z)
+{
+  unsigned row = z * m_fft_XStride;
+  float kz = m_KZ[z];
+  float * displace_x = m_RowDisplaceX.data();
+  float * displace_z = m_RowDisplaceZ.data();
+  for (unsigned x = 0; x < m_fft_XStride; ++x)
+  {
+    // the displacement uses the negated, normalized wave vector
+    float kx = m_KX[x];
+    float k_magnitude = std::sqrt(kx * kx + kz * kz);
+    if (k_magnitude < EPSILON)
+    {
+      displace_x[x] = 0.0f;
+      displace_z[x] = 0.0f;
+    }
+    else
+    {
+      displace_x[x] = -kx / k_magnitude;
+      displace_z[x] = -kz / k_magnitude;
+    }
+  }
+  const Complex * htilde = m_HTildeIn + row;
+  ComplexMultiplyI(htilde, m_KX.data(), m_HTildeSlopeXIn + row,
+    m_fft_XStride);
+  ComplexMultiplyI(htilde, kz, m_HTildeSlopeZIn + row, m_fft_XStride);
+  ComplexMultiplyI(htilde, displace_x, m_HTildeDisplaceXIn + row,
+    m_fft_XStride);
+  ComplexMultiplyI(htilde, displace_z, m_HTildeDisplaceZIn + row,
+    m_fft_XStride);
+}
+
+// Streams the vertices for one row of the mesh to the vertex buffer. The
+// values come from the real parts of one row of fft output. Four vertices are
+// computed at once and transposed into the vertex layout before they are
+// written, skipping the cache when the row is aligned.
+void WaterFFT::WriteRow(unsigned fft_row, Vertex * row, float z_location)
+{
+  unsigned fft_index = fft_row * m_fft_XStride;
+  const float * height = (const float *)(m_HTildeOut + fft_index);
+  const float * slope_x = (const float *)(m_HTildeSlopeXOut + fft_index);
+  const float * slope_z = (const float *)(m_HTildeSlopeZOut + fft_index);
+  const float * displace_x = (const float *)(m_HTildeDisplaceXOut + fft_index);
+  const float * displace_z = (const float *)(m_HTildeDisplaceZOut + fft_index);
+  float x_start = -0.5f * m_XLength;
+  float dx = m_XLength / (float)m_fft_XStride;
+  float z_0to1 = fft_row / static_cast<float>(m_fft_ZStride);
+  float position_y_factor = m_HeightScale;
+  float normal_y_factor = 1.0f / m_HeightScale;
+
+  // The layer slopes are added to the fft slopes after they are scaled by
+  // the y component of the normal, since the normal is
+  // (-slope_x, 1, -slope_z) scaled by that value.
+  float * layer_height = m_RowLayerHeight.data();
+  float * layer_slope_x = m_RowLayerSlopeX.data();
+  float * layer_slope_z = m_RowLayerSlopeZ.data();
+  bool layered = false;
+  if (!m_Layers.empty())
+  {
+    std::fill(m_RowLayerHeight.begin(), m_RowLayerHeight.end(), 0.0f);
+    std::fill(m_RowLayerSlopeX.begin(), m_RowLayerSlopeX.end(), 0.0f);
+    std::fill(m_RowLayerSlopeZ.begin(), m_RowLayerSlopeZ.end(), 0.0f);
+    for (unsigned i = 0; i < m_Layers.size(); ++i)
+    {
+      const glm::vec2 & offset = m_LayerOffsets[i];
+      layered |= m_Layers[i]->SampleRow(z_location + offset.y,
+        x_start + offset.x, dx, m_XStride, layer_height, layer_slope_x,
+        layer_slope_z);
+    }
+  }
+
+  unsigned x = 0;
+#ifdef WATER_SIMD
+  bool stream = ((uintptr_t)row & 15) == 0;
+  __m128 zero = _mm_setzero_ps();
+  __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+  __m128 dx_4 = _mm_set1_ps(dx);
+  __m128 z_4 = _mm_set1_ps(z_location);
+  __m128 displace_scale = _mm_set1_ps(m_DisplaceScale);
+  __m128 position_y_4 = _mm_set1_ps(position_y_factor);
+  __m128 normal_y_4 = _mm_set1_ps(normal_y_factor);
+  for (; x + 4 <= m_fft_XStride; x += 4)
+  {
+    // Get the factors that need to be applied from the intensity map.
+    if (m_IMap)
+    {
+      float intensity[4];
+      for (unsigned i = 0; i < 4; ++i)
+      {
+        float x_0to1 = (x + i) / static_cast<float>(m_fft_XStride);
+        intensity[i] = m_IMap->GetIntensity(x_0to1, z_0to1);
+        if (intensity[i] == 0.0f)
+          intensity[i] = EPSILON;
+      }
+      __m128 intensity_4 = _mm_loadu_ps(intensity);
+      position_y_4 = _mm_mul_ps(_mm_set1_ps(position_y_factor), intensity_4);
+      normal_y_4 = _mm_div_ps(_mm_set1_ps(normal_y_factor), intensity_4);
+    }
+
+    // The real parts of four complex values are the even floats.
+    unsigned i = 2 * x;
+    __m128 h = _mm_shuffle_ps(_mm_loadu_ps(height + i),
+      _mm_loadu_ps(height + i + 4), _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 sx = _mm_shuffle_ps(_mm_loadu_ps(slope_x + i),
+      _mm_loadu_ps(slope_x + i + 4), _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 sz = _mm_shuffle_ps(_mm_loadu_ps(slope_z + i),
+      _mm_loadu_ps(slope_z + i + 4), _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 ddx = _mm_shuffle_ps(_mm_loadu_ps(displace_x + i),
+      _mm_loadu_ps(displace_x + i + 4), _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 ddz = _mm_shuffle_ps(_mm_loadu_ps(displace_z + i),
+      _mm_loadu_ps(displace_z + i + 4), _MM_SHUFFLE(2, 0, 2, 0));
+
+    // Find the positions and normals of the four vertices.
+    __m128 x_location = _mm_add_ps(_mm_set1_ps(x_start + dx * (float)x),
+      _mm_mul_ps(lanes, dx_4));
+    __m128 px = _mm_add_ps(x_location, _mm_mul_ps(displace_scale, ddx));
+    __m128 py = _mm_mul_ps(h, position_y_4);
+    __m128 pz = _mm_add_ps(z_4, _mm_mul_ps(displace_scale, ddz));
+    __m128 pw = zero;
+    __m128 nx = _mm_sub_ps(zero, sx);
+    __m128 ny = normal_y_4;
+    __m128 nz = _mm_sub_ps(zero, sz);
+    __m128 nw = zero;
+    if (layered)
+    {
+      py = _mm_add_ps(py, _mm_loadu_ps(layer_height + x));
+      nx = _mm_sub_ps(nx, _mm_mul_ps(ny, _mm_loadu_ps(layer_slope_x + x)));
+      nz = _mm_sub_ps(nz, _mm_mul_ps(ny, _mm_loadu_ps(layer_slope_z + x)));
+    }
+    _MM_TRANSPOSE4_PS(px, py, pz, pw);
+    _MM_TRANSPOSE4_PS(nx, ny, nz, nw);
+
+    float * out = (float *)(row + x);
+    if (stream)
+    {
+      _mm_stream_ps(out, px);
+      _mm_stream_ps(out + 4, nx);
+      _mm_stream_ps(out + 8, py);
+      _mm_stream_ps(out + 12, ny);
+      _mm_stream_ps(out + 16, pz);
+      _mm_stream_ps(out + 20, nz);
+      _mm_stream_ps(out + 24, pw);
+      _mm_stream_ps(out + 28, nw);
+    }
+    else
+    {
+      _mm_storeu_ps(out, px);
+      _mm_storeu_ps(out + 4, nx);
+      _mm_storeu_ps(out + 8, py);
+      _mm_storeu_ps(out + 12, ny);
+      _mm_storeu_ps(out + 16, pz);
+      _mm_storeu_ps(out + 20, nz);
+      _mm_storeu_ps(out + 24, pw);
+      _mm_storeu_ps(out + 28, nw);
+    }
+  }
+#endif
+
+  // The vertices that do not fill a group of four. The last vertex in the row
+  // uses the first fft value because it is attached to the first vertex.
+  for (; x <= m_fft_XStride; ++x)
+  {
+    unsigned source = x % m_fft_XStride;
+    float y_factor = position_y_factor;
+    float ny_factor = normal_y_factor;
+    if (m_IMap)
+    {
+      float x_0to1 = source / static_cast<float>(m_fft_XStride);
+      float intensity = m_IMap->GetIntensity(x_0to1, z_0to1);
+      if (intensity == 0.0f)
+        intensity = EPSILON;
+      y_factor *= intensity;
+      ny_factor *= 1.0f / intensity;
+    }
+    unsigned i = 2 * source;
+    Vertex & vert = row[x];
+    vert.m_Px = x_start + dx * (float)x + m_DisplaceScale * displace_x[i];
+    vert.m_Py = height[i] * y_factor;
+    vert.m_Pz = z_location + m_DisplaceScale * displace_z[i];
+    vert.m_Pw = 0.0f;
+    vert.m_Nx = 0.0f - slope_x[i];
+    vert.m_Ny = ny_factor;
+    vert.m_Nz = 0.0f - slope_z[i];
+    vert.m_Nw = 0.0f;
+    if (layered)
+    {
+      vert.m_Py += layer_height[x];
+      vert.m_Nx -= ny_factor * layer_slope_x[x];
+      vert.m_Nz -= ny_factor * layer_slope_z[x];
+    }
+  }
+}
+
+// Finds the frequency stored at an index of the spectrum. The spectrum is
+// stored in fft order, so the second half of the indices hold the negative
+// frequencies.
+inline float WaterFFT::Frequency(unsigned index, unsigned dimension)
+{
+  if (index < dimension / 2)
+    return (float)index;
+  return (float)index - (float)dimension;
+}
+
+std::pair<float, glm::vec3> WaterFFT::GetLocationHeightNormalFFT(
+  const glm::vec2 & location)
+{
+  MeshPosition mp = LocationToMeshPosition(location);
+  float height = GetLocationHeightFFT(mp);
+  glm::vec3 normal = GetLocationNormalFFT(mp);
+  return std::pair<float, glm::vec3>(height, normal);
+}
+
+// This relates to the next two functions
+/* a---b                  **
+** | / |                  **
+** c---d                  **
+** horizontal goes over x **
+** vertical goes over z   */
+
+float WaterFFT::GetLocationHeightFFT(const MeshPosition & mp)
+{
+  const Vertex & a = (*m_ReadBuffer)[mp.m_VertexIndex];
+  const Vertex & b = (*m_ReadBuffer)[mp.m_VertexIndex + 1];
+  const Vertex & c = (*m_ReadBuffer)[mp.m_VertexIndex + m_XStride];
+  const Vertex & d = (*m_ReadBuffer)[mp.m_VertexIndex + m_XStride + 1];
+  //heights
+  float ha = a.m_Py;
+  float hb = b.m_Py;
+  float hc = c.m_Py;
+  float hd = d.m_Py;
+  //performing bilinear interpolation
+  float hab = ha + (hb - ha) * mp.m_Xt; // use lerp formual
+  float hcd = hc + (hd - hc) * mp.m_Xt;
+  float habcd = hab + (hcd - hab) * mp.m_Zt;
+  return habcd;
+}
+
+glm::vec3 WaterFFT::GetLocationNormalFFT(const MeshPosition & mp)
+{
+  const Vertex & a = (*m_ReadBuffer)[mp.m_VertexIndex];
+  const Vertex & b = (*m_ReadBuffer)[mp.m_VertexIndex + 1];
+  const Vertex & c = (*m_ReadBuffer)[mp.m_VertexIndex + m_XStride];
+  const Vertex & d = (*m_ReadBuffer)[mp.m_VertexIndex + m_XStride + 1];
+  // getting normals
+  glm::vec3 na(a.m_Nx, a.m_Ny, a.m_Nz);
+  glm::vec3 nb(b.m_Nx, b.m_Ny, b.m_Nz);
+  glm::vec3 nc(c.m_Nx, c.m_Ny, c.m_Nz);
+  glm::vec3 nd(d.m_Nx, d.m_Ny, d.m_Nz);
+  // normal bilinear interpolation
+  glm::vec3 nab = na + (nb - na) * mp.m_Xt; // use lerp formual
+  glm::vec3 ncd = nc + (nd - nc) * mp.m_Xt;
+  glm::vec3 nabcd = nab + (ncd - nab) * mp.m_Zt;
+  nabcd = glm::normalize(nabcd);
+  return nabcd;
+}
+
+// TODO: This implementation will not work with displacements
+// It will only work with a displacement factor of 0
+WaterFFT::MeshPosition WaterFFT::LocationToMeshPosition(glm::vec2 location)
+{
+  // translating from meters to our indicies
+  float x_grid = (float)m_fft_XStride;
+  float z_grid = (float)m_fft_ZStride;
+  float x_index_float = location.x * x_grid / m_XLength + x_grid / 2.0f;
+  float z_index_float = location.y * z_grid / m_ZLength + z_grid / 2.0f;
+  // getting to an index that exists in our arrays
+  x_index_float = std::fmod(x_index_float, x_grid);
+  if (x_index_float < 0.0f)
+    x_index_float += x_grid;
+  z_index_float = std::fmod(z_index_float, z_grid);
+  if (z_index_float < 0.0f)
+    z_index_float += z_grid;
+  // casting to our index and getting our lerp parameters
+  // the minimums keep a rounded up value off the tail edge
+  unsigned x_index = glm::min((unsigned)x_index_float, m_fft_XStride - 1);
+  float xt = x_index_float - (float)x_index;
+  unsigned z_index = glm::min((unsigned)z_index_float, m_fft_ZStride - 1);
+  float zt = z_index_float - (float)z_index;
+  unsigned vertex_index = z_index * m_XStride + x_index;
+  return MeshPosition(vertex_index, xt, zt);
+}
+
+
+void WaterFFT::HTildePair(const Complex & htilde0,
+  const Complex & htilde0_mirror, const glm::vec2 & k, double time,
+  Complex * htilde, Complex * htilde_mirror)
+{
+  // h~(k, t) = h~0(k) * exp(i * w(k) * t) + h~0*(-k) * exp(-i * w(k) * t)
+  // h~   = htilde
+  // h~0  = htilde0
+  // w(k) = dispersion relation
+  // All values of h~0 are precomputed in InitializeVertexBuffer. Since
+  // w(k) = w(-k), h~(-k, t) uses the same exponentials with the two h~0
+  // values swapped.
+  float dispersion = DispersionRelation(k);
+  float omega_t = PhaseAngle(dispersion, time);
+  float cos_omega_t = cos(omega_t);
+  float sin_omega_t = sin(omega_t);
+  Complex e_1(cos_omega_t, sin_omega_t);
+  Complex e_2(-cos_omega_t, -sin_omega_t);
+  // The mirror may be the same element, so both results are found before
+  // either is written.
+  Complex result = htilde0 * e_1 + htilde0_mirror.Conjugate() * e_2;
+  Complex result_mirror = htilde0_mirror * e_1 + htilde0.Conjugate() * e_2;
+  *htilde = result;
+  *htilde_mirror = result_mirror;
+}
+
+float WaterFFT::DispersionRelation(const glm::vec2 & k)
+{
+  float w_0 = TAU / 200.0f;
+  float k_magnitude = glm::length(k);
+  return floor(sqrt(m_Gravity * k_magnitude) / w_0) * w_0;
+}
+
+Complex WaterFFT::HTilde0(const glm::vec2 & k)
+{
+  // h~0(k) = (q0 + i * q1) * sqrt(P(k) / 2)
+  // h~0    = htilde0
+  // q0, q1 = values from gaussian number generator
+  // P(k)   = phillips spectrum
+  float multiplicand = sqrt(PhillipsSpectrum(k) / 2.0f);
+  Complex multiplier = m_Random.NormalComplex();
+  Complex product = multiplier * multiplicand;
+  return product;
+}
+
+float WaterFFT::PhillipsSpectrum(const glm::vec2 & k)
+{
+  float k_magnitude = glm::length(k);
+  float wind_speed = glm::length(m_Wind);
+  glm::vec2 wind_normal = m_Wind / wind_speed;
+  if(k_magnitude < EPSILON) return 0.0f;
+  float k_mag_pow_2 = k_magnitude * k_magnitude;
+  float k_mag_pow_4 = k_mag_pow_2 * k_mag_pow_2;
+  float largest_wave = wind_speed * wind_speed / m_Gravity;
+  float largest_wave_pow_2 = largest_wave * largest_wave;
+  glm::vec2 k_normal = k / k_magnitude;
+  float k_dot_winddir = glm::dot(k_normal, wind_normal);
+  float k_dot_winddir_pow_2 = k_dot_winddir * k_dot_winddir;
+  float exponent = -1.0f / (k_mag_pow_2 * largest_wave_pow_2);
+  // taken from keiths article.
+  // I understand why this damping factor is here,
+  // but I don't understand WHY it is here
+  // Is there something we can do earlier to eliminate it
+  float damping = 0.001f;
+  float l2 = largest_wave_pow_2 * damping * damping;
+  float factor2 = exp(exponent) / k_mag_pow_4;
+  // TODO: Mess around with this spectrum, Keith's implementation has
+  // a multiple factor that is attatched to this that might have a dramatic
+  // effect. It is also mentioned in the tessendorf article
+  // The multiplicative factor is below
+  float additional_factor = exp(-k_mag_pow_2 * l2);
+  return m_Amplitude * factor2 * k_dot_winddir_pow_2 * additional_factor;
+}
+
+// Creates the FFTW plans. Measuring overwrites the fft arrays, which is
+// fine because every update fills the inputs again.
+void WaterFFT::CreatePlans()
+{
+  unsigned flags = m_Deterministic ? FFTW_ESTIMATE : FFTW_MEASURE;
+  // The arrays are stored row by row along z, so the z dimension is the
+  // slowest changing one.
+  m_HTildeFFTWPlan = fftwf_plan_dft_2d(m_fft_ZStride, m_fft_XStride,
+    (fftwf_complex *)m_HTildeIn, 
+    (fftwf_complex *)m_HTildeOut,
+    FFTW_FORWARD, flags);
+  m_HTildeSlopeXPlan = fftwf_plan_dft_2d(m_fft_ZStride, m_fft_XStride,
+    (fftwf_complex *)m_HTildeSlopeXIn, 
+    (fftwf_complex *)m_HTildeSlopeXOut,
+    FFTW_FORWARD, flags);
+  m_HTildeSlopeZPlan = fftwf_plan_dft_2d(m_fft_ZStride, m_fft_XStride,
+    (fftwf_complex *)m_HTildeSlopeZIn, 
+    (fftwf_complex *)m_HTildeSlopeZOut,
+    FFTW_FORWARD, flags);
+  m_HTildeDisplaceXPlan = fftwf_plan_dft_2d(m_fft_ZStride, m_fft_XStride,
+    (fftwf_complex *)m_HTildeDisplaceXIn, 
+    (fftwf_complex *)m_HTildeDisplaceXOut,
+    FFTW_FORWARD, flags);
+  m_HTildeDisplaceZPlan = fftwf_plan_dft_2d(m_fft_ZStride, m_fft_XStride,
+    (fftwf_complex *)m_HTildeDisplaceZIn, 
+    (fftwf_complex *)m_HTildeDisplaceZOut,
+    FFTW_FORWARD, flags);
+
+}
+
+// Transforms every input array into its output array.
+void WaterFFT::ExecuteFFTs()
+{
+  if (!m_BuiltinFFT)
+  {
+    fftwf_execute(m_HTildeFFTWPlan);
+    fftwf_execute(m_HTildeSlopeXPlan);
+    fftwf_execute(m_HTildeSlopeZPlan);
+    fftwf_execute(m_HTildeDisplaceXPlan);
+    fftwf_execute(m_HTildeDisplaceZPlan);
+    return;
+  }
+  ExecuteBuiltinFFT(m_HTildeIn, m_HTildeOut);
+  ExecuteBuiltinFFT(m_HTildeSlopeXIn, m_HTildeSlopeXOut);
+  ExecuteBuiltinFFT(m_HTildeSlopeZIn, m_HTildeSlopeZOut);
+  ExecuteBuiltinFFT(m_HTildeDisplaceXIn, m_HTildeDisplaceXOut);
+  ExecuteBuiltinFFT(m_HTildeDisplaceZIn, m_HTildeDisplaceZOut);
+}
+
+// The plans use FFTW_FORWARD, the negative exponent, and FFT2D uses the
+// positive one. Conjugating the input and the output turns one into the
+// other. The input is filled again by every update, so it can be changed.
+void WaterFFT::ExecuteBuiltinFFT(Complex * in, Complex * out)
+{
+  for (unsigned i = 0; i < m_fft_NumVerts; ++i)
+    in[i] = in[i].Conjugate();
+  m_BuiltinFFT->fft(in, out);
+  for (unsigned i = 0; i < m_fft_NumVerts; ++i)
+    out[i] = out[i].Conjugate();
+}
+
+void WaterFFT::DestroyPlans()
+{
+  fftwf_destroy_plan(m_HTildeFFTWPlan);
+  fftwf_destroy_plan(m_HTildeSlopeXPlan);
+  fftwf_destroy_plan(m_HTildeSlopeZPlan);
+  fftwf_destroy_plan(m_HTildeDisplaceXPlan);
+  fftwf_destroy_plan(m_HTildeDisplaceZPlan);
+}
+
+inline void WaterFFT::InitializeVertexBuffer()
+{
+  // Clear the vertex data if it happens to exist.
+  for (std::vector<Vertex> & vertex_buffer : m_VertexBuffers)
+  {
+    vertex_buffer.clear();
+    vertex_buffer.reserve(m_NumVerts);
+  }
+
+  // Set the starting positions of the vertices.
+  for (unsigned z = 0; z < m_ZStride; ++z) 
+  {
+    float m = z - (m_fft_ZStride / 2.0f);
+    for (unsigned x = 0; x < m_XStride; ++x) 
+    {
+      float n = x - (m_fft_XStride / 2.0f);
+
+      // Find the vertice's starting position values.
+      float start_x = m_XLength *  n / m_fft_XStride;
+      float start_y = 0.0f;
+      float start_z = m_ZLength * m / m_fft_ZStride;
+
+      // Add the new vertex to the vertex buffers.
+      for (std::vector<Vertex> & vertex_buffer : m_VertexBuffers)
+        vertex_buffer.push_back(
+          Vertex(start_x, start_y, start_z, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f));
+    }
+  }
+
+  InitializeSpectrum();
+
+  // The flat mesh in the first buffer is used until the simulation has
+  // written a state.
+  m_ReadBuffer = &m_VertexBuffers[0];
+  m_WriteBuffer = &m_VertexBuffers[0];
+}
+
+// Calculates the htilde vertex extra values that will be used for the fft
+// computation. These are stored in fft order. The generator is seeded here
+// and drawn from in a fixed order, so the spectrum only depends on the seed.
+void WaterFFT::InitializeSpectrum()
+{
+  m_Random.Seed(m_Seed);
+  m_VertexExtrasBuffer.clear();
+  m_VertexExtrasBuffer.reserve(m_fft_NumVerts);
+  for (unsigned z = 0; z < m_fft_ZStride; ++z)
+  {
+    float kz = m_KZ[z];
+    for (unsigned x = 0; x < m_fft_XStride; ++x)
+    {
+      glm::vec2 k(m_KX[x], kz);
+      m_VertexExtrasBuffer.push_back(VertexExtra(HTilde0(k)));
+    }
+  }
+}
+
+inline void WaterFFT::InitializeIndexBuffer()
+{
+  m_IndexBuffer.clear();
+  unsigned index_buffer_size = INDICIES_PER_QUAD * (m_NumVerts - m_XStride);
+  m_IndexBuffer.reserve(index_buffer_size);
+  // Finding indicies
+  unsigned limit = m_NumVerts - m_XStride;
+  // One iteration for each quad on the surface
+  for (unsigned int i = 0; i < limit;) {
+    m_IndexBuffer.push_back(i);
+    m_IndexBuffer.push_back(i + 1);
+    m_IndexBuffer.push_back(i + m_XStride);
+    // First half of the quad
+    // Triangle indices are i, i + 1, and i + m_XStride
+    ++i;
+    m_IndexBuffer.push_back(i);
+    m_IndexBuffer.push_back(i + m_XStride);
+    m_IndexBuffer.push_back(i + m_XStride - 1);
+    // Second half of the quad
+    // Triangle indicies are i, i + m_XStride, and i + m_XStride - 1
+    unsigned vertices_left = (i + 1) % m_XStride;
+    if (vertices_left == 0)
+      ++i;
+  }
+}
+
+inline void WaterFFT::InitializeOffsetBuffer(unsigned expansion)
+{
+  int num_instances = expansion * expansion;
+  for (int i = 0; i < num_instances; ++i)
+  {
+    int x = i % expansion;
+    int z = i / expansion;
+    float x_offset = (float)x * m_XLength;
+    float z_offset = (float)z * m_ZLength;
+    m_OffsetBuffer.push_back(Offset(x_offset, 0.0f, z_offset, 1.0f));
+  }
+}
+
+// WATERFFTHOLDER /////////////////////////////////////////////////////////////
+// static initialization
+WaterFFT * WaterFFTHolder::m_Water;
+bool WaterFFTHolder::m_HalfPrecision = false;
+float WaterFFTHolder::m_SpectrumThreshold = 0.0f;
+uint64_t WaterFFTHolder::m_Seed = WATER_DEFAULT_SEED;
+bool WaterFFTHolder::m_Deterministic = false;
+bool WaterFFTHolder::m_BuiltinFFT = false;
+Ripple * WaterFFTHolder::m_Ripple = nullptr;
+Wake * WaterFFTHolder::m_Wake = nullptr;
+std::string WaterFFTHolder::m_PublishName;
+FramePublisher * WaterFFTHolder::m_Publisher = nullptr;
+std::string WaterFFTHolder::m_StreamName;
+FrameStreamWriter * WaterFFTHolder::m_StreamWriter = nullptr;
+unsigned WaterFFTHolder::m_StreamSegment = 0;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Creates the WaterFFT. The mesh is always 256 meters wide.
+///
+/// @param grid_dimension The number of vertices along each side of the grid.
+/// @param expansion The number of instances along each side of the water.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTHolder::Initialize(unsigned grid_dimension, unsigned expansion)
+{
+  m_Water = new WaterFFT(grid_dimension, 256, expansion);
+  m_Water->Deterministic(m_Deterministic);
+  m_Water->BuiltinFFT(m_BuiltinFFT);
+  m_Water->Seed(m_Seed);
+  m_Water->HalfPrecision(m_HalfPrecision);
+  m_Water->SpectrumThreshold(m_SpectrumThreshold);
+  AttachLayers();
+  if (!m_PublishName.empty())
+    m_Publisher = new FramePublisher(m_PublishName, m_Water->XVertices(),
+      m_Water->ZVertices(), m_Water->XLength(), m_Water->ZLength());
+  if (m_StreamName.empty())
+    return;
+  if (!m_StreamWriter)
+    StartStream();
+  else if (m_StreamWriter->XVertices() != m_Water->XVertices() ||
+    m_StreamWriter->ZVertices() != m_Water->ZVertices())
+  {
+    // A stream holds one size, so the finished frames are kept and the
+    // new size is recorded to the next file.
+    ++m_StreamSegment;
+    StartStream();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Sets whether the WaterFFT stores its spectrum as halves. This
+/// applies to the current WaterFFT and every one created by Initialize. It
+/// must not be called while the WaterFFTThread is running.
+///
+/// @param enabled True to store halves.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTHolder::HalfPrecision(bool enabled)
+{
+  m_HalfPrecision = enabled;
+  if (m_Water)
+    m_Water->HalfPrecision(enabled);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the spectrum threshold of the WaterFFT. This applies to the
+/// current WaterFFT and every one created by Initialize. It must not be
+/// called while the WaterFFTThread is running.
+///
+/// @param threshold A fraction of the largest |h~0|. See
+///   WaterFFT::SpectrumThreshold.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTHolder::SpectrumThreshold(float threshold)
+{
+  m_SpectrumThreshold = threshold;
+  if (m_Water)
+    m_Water->SpectrumThreshold(threshold);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the seed of the WaterFFT's spectrum. This applies to the
+/// current WaterFFT and every one created by Initialize. It must not be
+/// called while the WaterFFTThread is running.
+///
+/// @param seed See WaterFFT::Seed.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTHolder::Seed(uint64_t seed)
+{
+  m_Seed = seed;
+  if (m_Water)
+    m_Water->Seed(seed);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Sets whether the WaterFFT uses deterministic plans. This applies
+/// to the current WaterFFT and every one created by Initialize. It must not
+/// be called while the WaterFFTThread is running.
+///
+/// @param enabled See WaterFFT::Deterministic.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTHolder::Deterministic(bool enabled)
+{
+  m_Deterministic = enabled;
+  if (m_Water)
+    m_Water->Deterministic(enabled);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Sets whether the WaterFFT uses FFT2D instead of FFTW. This applies
+/// to the current WaterFFT and every one created by Initialize. It must not
+/// be called while the WaterFFTThread is running.
+///
+/// @param enabled See WaterFFT::BuiltinFFT.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTHolder::BuiltinFFT(bool enabled)
+{
+  m_BuiltinFFT = enabled;
+  if (m_Water)
+    m_Water->BuiltinFFT(enabled);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Creates or removes the ripple layer. The window is 256 meters wide
+/// with one meter cells, which matches the vertex spacing of the default
+/// grid. It must not be called while the WaterFFTThread is running.
+///
+/// @param enabled True to add ripples to the water.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTHolder::Ripples(bool enabled)
+{
+  if (enabled && !m_Ripple)
+    m_Ripple = new Ripple(RIPPLE_WINDOW, RIPPLE_CELL_SIZE);
+  else if (!enabled && m_Ripple)
+  {
+    delete m_Ripple;
+    m_Ripple = nullptr;
+  }
+  if (m_Water)
+    AttachLayers();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Creates or removes the ship wakes. The window matches the ripple
+/// window. It must not be called while the WaterFFTThread is running.
+///
+/// @param enabled True to add wakes to the water.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTHolder::Wakes(bool enabled)
+{
+  if (enabled && !m_Wake)
+    m_Wake = new Wake(WAKE_WINDOW, WAKE_CELL_SIZE);
+  else if (!enabled && m_Wake)
+  {
+    delete m_Wake;
+    m_Wake = nullptr;
+  }
+  if (m_Water)
+    AttachLayers();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Starts or stops publishing every finished frame to shared memory
+/// so other processes can read it with a FrameReader. The ring is created
+/// again by Initialize, so readers must reopen it after a restart. It must
+/// not be called while the WaterFFTThread is running.
+///
+/// @param name The name of the shared memory. Empty stops publishing.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTHolder::Publish(const std::string & name)
+{
+  m_PublishName = name;
+  delete m_Publisher;
+  m_Publisher = nullptr;
+  if (m_Water && !name.empty())
+    m_Publisher = new FramePublisher(name, m_Water->XVertices(),
+      m_Water->ZVertices(), m_Water->XLength(), m_Water->ZLength());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Starts or stops recording every finished frame to a compressed
+/// stream file that can be played back with a FrameStreamReader. A restart
+/// to a different size finishes the file and records the new size to
+/// <filename>.1, then <filename>.2, and so on. It must not be called while
+/// the WaterFFTThread is running.
+///
+/// @param filename The file to record to. Empty stops recording and
+///   finishes the file.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTHolder::Stream(const std::string & filename)
+{
+  m_StreamName = filename;
+  m_StreamSegment = 0;
+  delete m_StreamWriter;
+  m_StreamWriter = nullptr;
+  if (m_Water && !filename.empty())
+    StartStream();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Gives the WaterFFT's buffers to the WaterRenderer.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef WATER_HEADLESS
+void WaterFFTHolder::ShareBuffers()
+{
+  WaterRenderer::SetBuffers((const GLfloat *)m_Water->VertexBuffer(),
+    (const GLuint *)m_Water->IndexBuffer(),
+    (const GLfloat *)m_Water->OffsetBuffer(),
+    m_Water->VertexBufferSizeBytes(),
+    m_Water->IndexBufferSizeBytes(),
+    m_Water->IndexBufferSize(),
+    m_Water->OffsetBufferSizeBytes(),
+    m_Water->OffsetBufferSize());
+}
+#endif
+
+void WaterFFTHolder::Update(double time, unsigned buffer)
+{
+  m_Water->Update(time, buffer);
+  // The buffer is not handed to the renderer until this returns, so it is
+  // published before anything can overwrite it.
+  if (m_Publisher)
+    m_Publisher->Publish(m_Water->VertexBuffer(buffer), time);
+  // A failed recording is stopped so it does not stop the simulation.
+  if (m_StreamWriter)
+  {
+    try {
+      m_StreamWriter->Write(m_Water->VertexBuffer(buffer), time);
+    }
+    catch (const Error & error) {
+      ErrorLog::Write(error);
+      delete m_StreamWriter;
+      m_StreamWriter = nullptr;
+      m_StreamName.clear();
+    }
+  }
+}
+
+void WaterFFTHolder::Purge()
+{
+  delete m_Water;
+  m_Water = nullptr;
+  delete m_Publisher;
+  m_Publisher = nullptr;
+}
+
+WaterFFT * WaterFFTHolder::GetWaterFFT()
+{
+  return m_Water;
+}
+
+Ripple * WaterFFTHolder::GetRipple()
+{
+  return m_Ripple;
+}
+
+Wake * WaterFFTHolder::GetWake()
+{
+  return m_Wake;
+}
+
+// Finishes the current stream file and starts recording the current WaterFFT
+// to the file for m_StreamSegment.
+void WaterFFTHolder::StartStream()
+{
+  delete m_StreamWriter;
+  m_StreamWriter = nullptr;
+  std::string filename = m_StreamName;
+  if (m_StreamSegment > 0)
+    filename += "." + std::to_string(m_StreamSegment);
+  m_StreamWriter = new FrameStreamWriter(filename, m_Water->XVertices(),
+    m_Water->ZVertices(), m_Water->XLength(), m_Water->ZLength());
+}
+
+// Gives the WaterFFT every layer the holder owns.
+void WaterFFTHolder::AttachLayers()
+{
+  m_Water->ClearLayers();
+  if (m_Ripple)
+    m_Water->AttachLayer(m_Ripple);
+  if (m_Wake)
+    m_Water->AttachLayer(m_Wake);
+}
+
+// WATERFFTTHREAD /////////////////////////////////////////////////////////////
+
+bool WaterFFTThread::m_Running = false;
+std::function<double()> WaterFFTThread::m_FetchTime;
+std::thread * WaterFFTThread::m_Water = nullptr;
+std::mutex WaterFFTThread::m_Mutex;
+std::condition_variable WaterFFTThread::m_Condition;
+float WaterFFTThread::m_Step = 1.0f / WATER_STEP_RATE;
+double WaterFFTThread::m_RenderTime = 0.0;
+int WaterFFTThread::m_BufferTicks[WATER_VERTEX_BUFFERS] = 
+  { NO_TICK, NO_TICK, NO_TICK };
+int WaterFFTThread::m_ReadBuffer = -1;
+float WaterFFTThread::m_UpdateTime = 0.0f;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Starts the simulation thread.
+///
+/// @param fetch_time The function used to get the current render time.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTThread::Execute(double (* fetch_time)(void))
+{
+  m_FetchTime = fetch_time;
+  Start();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Fetches the render time and gives the WaterRenderer the states of
+/// the ticks before and after it. This waits if the simulation has not
+/// computed those states yet.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTThread::Wait()
+{
+  unsigned previous, current;
+  float alpha;
+  Wait(&previous, &current, &alpha);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Does the same as Wait and also gives the buffers that hold the
+/// ticks around the render time. The simulation does not write to either
+/// buffer until the next call to Wait.
+///
+/// @param previous_buffer Set to the buffer holding the tick before the
+///   render time.
+/// @param current_buffer Set to the buffer holding the tick after the render
+///   time. This is also made the WaterFFT's read buffer.
+/// @param blend Set to how far the render time is from the previous tick to
+///   the current one, from 0 to 1.
+///
+/// @return False if the thread was stopped. Nothing is set then.
+///////////////////////////////////////////////////////////////////////////////
+bool WaterFFTThread::Wait(unsigned * previous_buffer,
+  unsigned * current_buffer, float * blend)
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  // Nothing reads the old read buffer while this waits, so it can be
+  // written to again if its tick was thrown away.
+  for (int & tick : m_BufferTicks)
+  {
+    if (tick == READING_TICK)
+      tick = NO_TICK;
+  }
+  m_RenderTime = m_FetchTime();
+  m_Condition.notify_all();
+  int current_tick = TargetTick();
+  int previous_tick = current_tick - 1;
+  m_Condition.wait(lock, [&]() {
+    return !m_Running || 
+      (FindBuffer(previous_tick) >= 0 && FindBuffer(current_tick) >= 0);
+  });
+  if (!m_Running)
+    return false;
+  unsigned previous = FindBuffer(previous_tick);
+  unsigned current = FindBuffer(current_tick);
+  float alpha = (float)((m_RenderTime - (double)previous_tick * m_Step) /
+    m_Step);
+  alpha = glm::clamp(alpha, 0.0f, 1.0f);
+  WaterFFT * water = WaterFFTHolder::GetWaterFFT();
+  water->SetReadBuffer(current);
+  m_ReadBuffer = (int)current;
+  *previous_buffer = previous;
+  *current_buffer = current;
+  *blend = alpha;
+#ifndef WATER_HEADLESS
+  // The renderer copies the states to the gpu before the lock is released,
+  // so the simulation is free to overwrite them afterwards.
+  WaterRenderer::SetVertexBuffers(
+    (const GLfloat *)water->VertexBuffer(previous), previous_tick,
+    (const GLfloat *)water->VertexBuffer(current), current_tick, alpha);
+#endif
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Stops the simulation thread and waits for it to finish.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTThread::Terminate()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Running = false;
+  }
+  m_Condition.notify_all();
+  m_Water->join();
+  delete m_Water;
+  m_Water = nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Stops the simulation thread, replaces the WaterFFT with one of a
+/// different size, and starts the thread again. The renderer is given the
+/// new buffers. This must be called from the rendering thread.
+///
+/// @param grid_dimension The number of vertices along each side of the grid.
+/// @param expansion The number of instances along each side of the water.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTThread::Restart(unsigned grid_dimension, unsigned expansion)
+{
+  Terminate();
+  WaterFFTHolder::Purge();
+  WaterFFTHolder::Initialize(grid_dimension, expansion);
+#ifndef WATER_HEADLESS
+  WaterFFTHolder::ShareBuffers();
+#endif
+  Start();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Changes the rate at which the simulation is stepped. The states
+/// that have already been computed are thrown away. The read buffer keeps
+/// its state until the next Wait so it is not overwritten while it is read.
+///
+/// @param rate The number of ticks per second.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTThread::StepRate(float rate)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Step = 1.0f / rate;
+  for (int i = 0; i < WATER_VERTEX_BUFFERS; ++i)
+  {
+    if (m_BufferTicks[i] == WRITING_TICK)
+      continue;
+    m_BufferTicks[i] = (i == m_ReadBuffer) ? READING_TICK : NO_TICK;
+  }
+  m_Condition.notify_all();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the rate at which the simulation is stepped.
+///
+/// @return The number of ticks per second.
+///////////////////////////////////////////////////////////////////////////////
+float WaterFFTThread::StepRate()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return 1.0f / m_Step;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Gets a running average of the time spent on each WaterFFT update.
+///
+/// @return The average update time in seconds.
+///////////////////////////////////////////////////////////////////////////////
+float WaterFFTThread::UpdateTime()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_UpdateTime;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Starts the simulation thread with none of the vertex buffers
+/// holding a tick.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTThread::Start()
+{
+  for (int & tick : m_BufferTicks)
+    tick = NO_TICK;
+  m_ReadBuffer = -1;
+  m_UpdateTime = 0.0f;
+  m_Running = true;
+  m_RenderTime = m_FetchTime();
+  m_Water = new std::thread(RunWater);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief The loop run by the simulation thread. The simulation is only
+/// updated outside of the lock.
+///////////////////////////////////////////////////////////////////////////////
+void WaterFFTThread::RunWater()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  while (true)
+  {
+    int tick;
+    unsigned buffer;
+    m_Condition.wait(lock, [&]() {
+      return !m_Running || FindWork(&tick, &buffer);
+    });
+    if (!m_Running)
+      return;
+    float step = m_Step;
+    m_BufferTicks[buffer] = WRITING_TICK;
+    lock.unlock();
+    std::chrono::high_resolution_clock::time_point start =
+      std::chrono::high_resolution_clock::now();
+    WaterFFTHolder::Update((double)tick * step, buffer);
+    std::chrono::duration<float> update_time =
+      std::chrono::high_resolution_clock::now() - start;
+    lock.lock();
+    if (m_UpdateTime == 0.0f)
+      m_UpdateTime = update_time.count();
+    else
+      m_UpdateTime += UPDATE_TIME_WEIGHT * (update_time.count() - m_UpdateTime);
+    // The state is thrown away if the step changed during the update.
+    m_BufferTicks[buffer] = (step == m_Step) ? tick : NO_TICK;
+    m_Condition.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Finds the first tick that starts after the render time. The
+/// renderer blends the state of this tick with the state of the tick before
+/// it.
+///
+/// @return The target tick.
+///////////////////////////////////////////////////////////////////////////////
+int WaterFFTThread::TargetTick()
+{
+  return (int)std::floor(m_RenderTime / m_Step) + 1;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Finds the vertex buffer holding the state of a tick.
+///
+/// @param tick The tick.
+///
+/// @return The index of the buffer or -1 if no buffer holds the tick.
+///////////////////////////////////////////////////////////////////////////////
+int WaterFFTThread::FindBuffer(int tick)
+{
+  for (int i = 0; i < WATER_VERTEX_BUFFERS; ++i)
+  {
+    if (m_BufferTicks[i] == tick)
+      return i;
+  }
+  return -1;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Finds the next tick the simulation should compute. The two ticks
+/// needed by the renderer come first and the tick after them is computed
+/// ahead of time. The state is written to a buffer that holds none of these
+/// ticks.
+///
+/// @param tick Set to the tick that should be computed.
+/// @param buffer Set to the buffer that the state should be written to.
+///
+/// @return If there is a tick to compute, true.
+///////////////////////////////////////////////////////////////////////////////
+bool WaterFFTThread::FindWork(int * tick, unsigned * buffer)
+{
+  int target = TargetTick();
+  int needed[3] = { target - 1, target, target + 1 };
+  int missing = NO_TICK;
+  for (int needed_tick : needed)
+  {
+    if (FindBuffer(needed_tick) < 0)
+    {
+      missing = needed_tick;
+      break;
+    }
+  }
+  if (missing == NO_TICK)
+    return false;
+  for (unsigned i = 0; i < WATER_VERTEX_BUFFERS; ++i)
+  {
+    int buffer_tick = m_BufferTicks[i];
+    if (buffer_tick != needed[0] && buffer_tick != needed[1] && 
+      buffer_tick != needed[2] && buffer_tick != WRITING_TICK &&
+      buffer_tick != READING_TICK)
+    {
+      *tick = missing;
+      *buffer = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+// WATERFFTERROR
+
+WaterFFTError::Type WaterFFTError::GetType() const
+{
+  return m_Type;
+}
+
+const std::string & WaterFFTError::GetDescription() const
+{
+  return m_Description;
+}
+
+WaterFFTError::WaterFFTError(Type type, const std::string & description) :
+  m_Type(type), m_Description(description)
+{}
+
+
+// WATERRENDERER /////////////////////////////////////////////////////////////
+#ifndef WATER_HEADLESS
+
+// static initializations
+glm::vec3 WaterRenderer::m_WaterColor = glm::vec3(0.0f, 0.5f, 1.0f);
+float WaterRenderer::m_AmbientFactor = 0.2f;
+glm::vec3 WaterRenderer::m_AmbientColor = glm::vec3(0.160f, 0.909f, 0.960f);
+glm::vec3 WaterRenderer::m_DiffuseColor = glm::vec3(0.160f, 0.909f, 0.960f);
+float WaterRenderer::m_SpecularFactor = 1.0f;
+int WaterRenderer::m_SpecularExponent = 20;
+glm::vec3 WaterRenderer::m_SpecularColor = glm::vec3(1.0f, 1.0f, 1.0f);
+WaterRenderer::WaterShader * WaterRenderer::m_WaterShader = nullptr;
+GLuint WaterRenderer::m_WaterVBOIDs[2] = { 0, 0 };
+int WaterRenderer::m_VBOTicks[2] = { NO_TICK, NO_TICK };
+unsigned WaterRenderer::m_PreviousVBO = 0;
+float WaterRenderer::m_Alpha = 0.0f;
+GLuint WaterRenderer::m_WaterEBOID = -1;
+GLuint WaterRenderer::m_WaterVAOIDs[2] = { 0, 0 };
+GLuint WaterRenderer::m_OffsetVBOID = -1;
+
+const GLfloat * WaterRenderer::m_VertexBuffer = nullptr;
+const GLuint * WaterRenderer::m_IndexBuffer = nullptr;
+const GLfloat * WaterRenderer::m_OffsetBuffer = nullptr;
+GLuint WaterRenderer::m_VertexBufferSizeBytes = 0;
+GLuint WaterRenderer::m_IndexBufferSizeBytes = 0;
+GLuint WaterRenderer::m_OffsetBufferSizeBytes = 0;
+
+
+unsigned WaterRenderer::m_NumIndices = 0;
+unsigned WaterRenderer::m_NumInstances = 0;
+bool WaterRenderer::m_LineDraw = false;
+
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Creates the WaterShader shader type.
+///////////////////////////////////////////////////////////////////////////////
+WaterRenderer::WaterShader::WaterShader() :
+  Shader("Shader/water.vert", "Shader/water.frag")
+{
+  // finding attribute and uniform locations
+  this->Use();
+  m_APosition = GetAttribLocation("APosition");
+  m_ANormal = GetAttribLocation("ANormal");
+  m_APositionNext = GetAttribLocation("APositionNext");
+  m_ANormalNext = GetAttribLocation("ANormalNext");
+  m_AOffset = GetAttribLocation("AOffset");
+  m_UTransform = GetUniformLocation("UTransform");
+  m_UWaterColor = GetUniformLocation("UWaterColor");
+  m_UAmbientFactor = GetUniformLocation("UAmbientFactor");
+  m_UAmbientColor = GetUniformLocation("UAmbientColor");
+  m_UDiffuseColor = GetUniformLocation("UDiffuseColor");
+  m_USpecularFactor = GetUniformLocation("USpecularFactor");
+  m_USpecularExponent = GetUniformLocation("USpecularExponent");
+  m_USpecularColor = GetUniformLocation("USpecularColor");
+  m_ULightDirection = GetUniformLocation("ULightDirection");
+  m_UCameraPosition = GetUniformLocation("UCameraPosition");
+  m_UTime = GetUniformLocation("UTime");
+  m_UAlpha = GetUniformLocation("UAlpha");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the Water that will be rendered when the Render function
+/// is called.
+///
+/// @param water The water that will be used for rendering.
+///////////////////////////////////////////////////////////////////////////////
+void WaterRenderer::SetBuffers(const GLfloat * buff_vertex, 
+  const GLuint * buff_index, const GLfloat * buff_offset, 
+  GLuint vertex_size_bytes, GLuint index_size_bytes,
+ unsigned index_size, GLuint offset_size_bytes,
+  unsigned num_instances)
+{
+  if (m_VertexBuffer || m_IndexBuffer)
+    DeleteBuffers();
+  else
+    m_WaterShader = new WaterShader();
+  m_VertexBuffer = buff_vertex;
+  m_IndexBuffer = buff_index;
+  m_OffsetBuffer = buff_offset;
+  m_VertexBufferSizeBytes = vertex_size_bytes;
+  m_IndexBufferSizeBytes = index_size_bytes;
+  m_NumIndices = index_size;
+  m_OffsetBufferSizeBytes = offset_size_bytes;
+  m_NumInstances = num_instances;
+  PrepareBuffers();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the two states that are blended when rendering. A state is
+/// only copied to the gpu when neither vertex buffer already holds its tick,
+/// so each simulated state is uploaded once.
+///
+/// @param buff_previous The vertex data of the previous state.
+/// @param previous_tick The simulation tick of the previous state.
+/// @param buff_current The vertex data of the current state.
+/// @param current_tick The simulation tick of the current state.
+/// @param alpha The blend factor from the previous to the current state.
+///////////////////////////////////////////////////////////////////////////////
+void WaterRenderer::SetVertexBuffers(const GLfloat * buff_previous,
+  int previous_tick, const GLfloat * buff_current, int current_tick,
+  float alpha)
+{
+  const GLfloat * buffers[2] = { buff_previous, buff_current };
+  int ticks[2] = { previous_tick, current_tick };
+  for (int i = 0; i < 2; ++i)
+  {
+    if (m_VBOTicks[0] == ticks[i] || m_VBOTicks[1] == ticks[i])
+      continue;
+    // replace the vertex buffer that does not hold the other state
+    unsigned vbo = (m_VBOTicks[0] == ticks[1 - i]) ? 1 : 0;
+    glBindBuffer(GL_ARRAY_BUFFER, m_WaterVBOIDs[vbo]);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, m_VertexBufferSizeBytes, buffers[i]);
+    m_VBOTicks[vbo] = ticks[i];
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  m_PreviousVBO = (m_VBOTicks[0] == previous_tick) ? 0 : 1;
+  m_Alpha = alpha;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Does the same as the other SetVertexBuffers, but a state that has
+/// to be uploaded is written straight into the mapped vertex buffer by a
+/// callback instead of being copied from memory.
+///
+/// @param previous_tick The tick of the previous state.
+/// @param current_tick The tick of the current state.
+/// @param alpha The blend factor from the previous to the current state.
+/// @param fill Called with a tick and the mapped buffer when that tick's
+///   state needs to be uploaded. It must write every vertex.
+///////////////////////////////////////////////////////////////////////////////
+void WaterRenderer::SetVertexBuffers(int previous_tick, int current_tick,
+  float alpha, const std::function<void(int, GLfloat *)> & fill)
+{
+  int ticks[2] = { previous_tick, current_tick };
+  for (int i = 0; i < 2; ++i)
+  {
+    if (m_VBOTicks[0] == ticks[i] || m_VBOTicks[1] == ticks[i])
+      continue;
+    unsigned vbo = (m_VBOTicks[0] == ticks[1 - i]) ? 1 : 0;
+    glBindBuffer(GL_ARRAY_BUFFER, m_WaterVBOIDs[vbo]);
+    GLfloat * vertices = (GLfloat *)glMapBufferRange(GL_ARRAY_BUFFER, 0,
+      m_VertexBufferSizeBytes,
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (vertices)
+    {
+      fill(ticks[i], vertices);
+      glUnmapBuffer(GL_ARRAY_BUFFER);
+      m_VBOTicks[vbo] = ticks[i];
+    }
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  m_PreviousVBO = (m_VBOTicks[0] == previous_tick) ? 0 : 1;
+  m_Alpha = alpha;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Renders the Water that the WaterRenderer is currently set to
+/// Render.
+///////////////////////////////////////////////////////////////////////////////
+void WaterRenderer::Render(const glm::vec3 & location,
+  const glm::mat4 & projection, const glm::mat4 & world_to_camera)
+{
+  // make sure water is set
+  if (!m_VertexBuffer || !m_IndexBuffer) {
+    RootError error("WaterFFT.cpp", "WaterRenderer::Render");
+    error.Add("Use SetBuffers before attempting to Render");
+    throw(error);
+  }
+  ManageInput();
+
+  // finding mesh transformation
+  glm::mat4 transformation(projection * world_to_camera);
+  m_WaterShader->Use();
+  // setting uniforms
+  glUniformMatrix4fv(m_WaterShader->m_UTransform, 1, GL_FALSE,
+    glm::value_ptr(transformation));
+  glUniform3f(m_WaterShader->m_UWaterColor,
+    m_WaterColor.x, m_WaterColor.y, m_WaterColor.z);
+  glUniform1f(m_WaterShader->m_UAmbientFactor, m_AmbientFactor);
+  glUniform3f(m_WaterShader->m_UAmbientColor,
+    m_AmbientColor.x, m_AmbientColor.y, m_AmbientColor.z);
+  glUniform3f(m_WaterShader->m_UDiffuseColor,
+    m_DiffuseColor.x, m_DiffuseColor.y, m_DiffuseColor.z);
+  glUniform1f(m_WaterShader->m_USpecularFactor, m_SpecularFactor);
+  glUniform1i(m_WaterShader->m_USpecularExponent, m_SpecularExponent);
+  glUniform3f(m_WaterShader->m_USpecularColor,
+    m_SpecularColor.x, m_SpecularColor.y, m_SpecularColor.z);
+  glUniform3f(m_WaterShader->m_UCameraPosition,
+    location.x, location.y, location.z);
+  glUniform1f(m_WaterShader->m_UTime, Time::TotalTimeScaled());
+  glUniform1f(m_WaterShader->m_UAlpha, m_Alpha);
+  // rendering water
+  glBindVertexArray(m_WaterVAOIDs[m_PreviousVBO]);
+  if (m_LineDraw) {
+    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    glDrawElementsInstanced(GL_TRIANGLES, m_NumIndices, GL_UNSIGNED_INT, 
+      nullptr, m_NumInstances);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+  }
+  else
+    glDrawElementsInstanced(GL_TRIANGLES, m_NumIndices, GL_UNSIGNED_INT, 
+      nullptr, m_NumInstances);
+  glBindVertexArray(0);
+  // performing error check
+  GLenum gl_error = glGetError();
+  try {
+    OPENGLERRORCHECK("Water.cpp", "WaterRenderer::Render", 
+      "Water Rendering", gl_error);
+  }
+  catch (const Error & error) {
+    ErrorLog::Write(error);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Deletes all of the GPU buffers that are being used to Render Water
+/// and reinitializes them. This is meant for when the size of the Water's
+/// grid changes in size.
+///////////////////////////////////////////////////////////////////////////////
+void WaterRenderer::DeleteBuffers()
+{
+  // deleting
+  glDeleteBuffers(2, m_WaterVBOIDs);
+  glDeleteBuffers(1, &m_WaterEBOID);
+  glDeleteBuffers(1, &m_OffsetVBOID);
+  glDeleteVertexArrays(2, m_WaterVAOIDs);
+  m_VBOTicks[0] = NO_TICK;
+  m_VBOTicks[1] = NO_TICK;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Initializes the GPU buffers that are used to Render the water. This
+/// will also fill those buffers with the current Water mesh vertex data.
+///////////////////////////////////////////////////////////////////////////////
+void WaterRenderer::PrepareBuffers()
+{
+  // offset buffer //
+  glGenBuffers(1, &m_OffsetVBOID);
+  glBindBuffer(GL_ARRAY_BUFFER, m_OffsetVBOID);
+  glBufferData(GL_ARRAY_BUFFER, m_OffsetBufferSizeBytes, m_OffsetBuffer,
+    GL_STREAM_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  // water buffers //
+  glGenVertexArrays(2, m_WaterVAOIDs);
+  glGenBuffers(2, m_WaterVBOIDs);
+  glGenBuffers(1, &m_WaterEBOID);
+  // buffer data
+  for (int i = 0; i < 2; ++i)
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, m_WaterVBOIDs[i]);
+    glBufferData(GL_ARRAY_BUFFER, m_VertexBufferSizeBytes, m_VertexBuffer,
+      GL_STREAM_DRAW);
+  }
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_WaterEBOID);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferSizeBytes, m_IndexBuffer, 
+    GL_STATIC_DRAW);
+  // Each vertex array reads the previous state from one vertex buffer and the
+  // current state from the other.
+  for (int i = 0; i < 2; ++i)
+  {
+    glBindVertexArray(m_WaterVAOIDs[i]);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_WaterEBOID);
+    // attributes
+    glBindBuffer(GL_ARRAY_BUFFER, m_WaterVBOIDs[i]);
+    glVertexAttribPointer(m_WaterShader->m_APosition, 3, GL_FLOAT, GL_FALSE, 
+      8 * sizeof(GLfloat), nullptr);
+    glEnableVertexAttribArray(m_WaterShader->m_APosition);
+    glVertexAttribPointer(m_WaterShader->m_ANormal, 3, GL_FLOAT, GL_TRUE, 
+      8 * sizeof(GLfloat), (void *)(4 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(m_WaterShader->m_ANormal);
+    glBindBuffer(GL_ARRAY_BUFFER, m_WaterVBOIDs[1 - i]);
+    glVertexAttribPointer(m_WaterShader->m_APositionNext, 3, GL_FLOAT,
+      GL_FALSE, 8 * sizeof(GLfloat), nullptr);
+    glEnableVertexAttribArray(m_WaterShader->m_APositionNext);
+    glVertexAttribPointer(m_WaterShader->m_ANormalNext, 3, GL_FLOAT, GL_TRUE,
+      8 * sizeof(GLfloat), (void *)(4 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(m_WaterShader->m_ANormalNext);
+    // instanced offset attribute
+    glEnableVertexAttribArray(m_WaterShader->m_AOffset);
+    glBindBuffer(GL_ARRAY_BUFFER, m_OffsetVBOID);
+    glVertexAttribPointer(m_WaterShader->m_AOffset, 3, GL_FLOAT, GL_FALSE,
+      4 * sizeof(GLfloat), nullptr);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glVertexAttribDivisor(m_WaterShader->m_AOffset, 1);
+  }
+  // unbind
+  glBindVertexArray(0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  // error checking //
+  GLenum gl_error = glGetError();
+  try {
+    OPENGLERRORCHECK("Water.cpp", "Water", "Vertex Construction", gl_error);
+  }
+  catch (const Error & error) {
+    ErrorLog::Write(error);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Handles input that will affect the WaterRenderer.
+///////////////////////////////////////////////////////////////////////////////
+inline void WaterRenderer::ManageInput()
+{
+  if (Input::KeyPressed(Key::SPACE)) {
+    m_LineDraw = !m_LineDraw;
+  }
+}
+
+#endif // !WATER_HEADLESS
+
+/******************************************************************************
+// DEPRECATED /////////////////////////////////////////////////////////////////
+*******************************************************************************
+
+// DFT Implementation
+
+std::pair<float, glm::vec3> WaterFFT::GetLocationHeightNormalDFT(
+  glm::vec2 location, 
+  float time)
+{
+  // just scale the location by our scalers to bring it back
+  location.x /= m_HorizontalScale;
+  location.y /= m_HorizontalScale;
+
+
+  unsigned vertex_index = 0;
+  // The y height is the real part of the complex number
+  Complex final_height(0.0f, 0.0f);
+  glm::vec3 final_normal(0.0f, 0.0f, 0.0f);
+  for (unsigned z = 0; z < m_ZStride; ++z) {
+    float m = z - (m_ZStride / 2.0f);
+    float kz = (TAU * m) / m_ZLength; // TODO: Distribute the 2
+    for (unsigned x = 0; x < m_XStride; ++x) {
+      float n = x - (m_XStride / 2.0f);
+      float kx = (TAU * n) / m_XLength; // TODO: Distribute the 2
+      glm::vec2 k(kx, kz);
+      float k_dot_loc = glm::dot(k, location);
+      Complex htilde0_vertex = 
+        m_VertexExtrasBuffer[vertex_index].m_HTilde0;
+      Complex htilde0_vertex_conjugate = 
+        m_VertexExtrasBuffer[vertex_index].m_HTilde0Conjugate;
+      Complex multiplier(cos(k_dot_loc), sin(k_dot_loc));
+      Complex h_tilde = HTilde(htilde0_vertex, htilde0_vertex_conjugate, 
+        k, time);
+      Complex offset = h_tilde * multiplier;
+      final_height += offset;
+      // probably take that kx out of here
+      final_normal += glm::vec3(kx * offset.Imaginary(), 0.0f, 
+        kz * offset.Imaginary());
+      ++vertex_index;
+    }
+  }
+  final_normal.y = 1.0f;
+  float normal_magnitude = sqrt(final_normal.x * final_normal.x + 
+    final_normal.y * final_normal.y + final_normal.z * final_normal.z);
+  // The scaling here relies on logic deduced from the transpose of the
+  // inverse of the transformation matrix
+  final_normal.x = final_normal.x * 1.0f / m_HorizontalScale;
+  final_normal.y = final_normal.y * 1.0f / m_HeightScale;
+  final_normal.z = final_normal.z * 1.0f / m_HorizontalScale;
+  // normalize the normal since it will since it will be needed for physics.
+  // Figure out more once we move this to the gpu
+  final_normal = glm::normalize(final_normal);
+  // So the real part describes our height and imaginary part describes our 
+  // slope maybe we can do it the other way so the imaginary part describes 
+  // our height and the real part describes our slope
+  return std::pair<float, glm::vec3>(final_height.Real() * m_HeightScale,
+    final_normal);
+}
+
+void WaterFFT::UpdateDFT(float time)
+{
+  std::pair<float, glm::vec3> height_normal;
+  unsigned vertex_index = 0;
+  for (unsigned z = 0; z < m_ZStride; ++z) 
+  {
+    for (unsigned x = 0; x < m_XStride; ++x) 
+    {
+      // get starting location
+      float x_position = m_VertexExtrasBuffer[vertex_index].m_Ox;
+      float z_position = m_VertexExtrasBuffer[vertex_index].m_Oz;
+      glm::vec2 location(x_position, z_position);
+      // finding height and normal
+      height_normal = GetLocationHeightNormalDFT(location, time);
+      // setting the position
+      m_VertexBufferA[vertex_index].m_Px = x_position * m_HorizontalScale;
+      m_VertexBufferA[vertex_index].m_Py = height_normal.first * m_HeightScale;
+      m_VertexBufferA[vertex_index].m_Pz = z_position * m_HorizontalScale;
+      // setting the normal
+      // scaling relies on logic deduced from the transpose of inverse of
+      // transformation matrix
+      m_VertexBufferA[vertex_index].m_Nx = 
+        height_normal.second.x * 1.0f / m_HorizontalScale;
+      m_VertexBufferA[vertex_index].m_Ny = 
+        height_normal.second.y * 1.0f / m_HeightScale;
+      m_VertexBufferA[vertex_index].m_Nz = 
+        height_normal.second.z * 1.0f / m_HorizontalScale;
+      ++vertex_index;
+    }
+  }
+}
+
+
+*******************************************************************************
+///////////////////////////////////////////////////////////////////////////////
+******************************************************************************/
@@ -1,377 +1,650 @@
-///////////////////////////////////////////////////////////////////////////////
-/// @file WaterFFT.h
-/// @author Connor Deakin
-/// @email connor.deakin@digipen.edu
-/// @date 2017-10-05
-///
-/// @brief Contains the interface for the fast fourier transform water
-/// simulation.
-///////////////////////////////////////////////////////////////////////////////
-#pragma once
-
-#include <FFTW\fftw3.h>
-#include <functional>
-#include <GL\glew.h>
-#include <GLM\glm\vec3.hpp>
-#include <string>
-#include <thread>
-#include <utility>
-#include <vector>
-
-#include "Complex.h"
-#include "FFT.h"
-#include "Shader.h"
-#include "ThreadUtils.h"
-
-typedef unsigned int uint;
-typedef unsigned char uchar;
-
-// MATH HELPERS ///////////////////////////////////////////////////////////////
-
-float Lerp(float a, float b, float t);
-float QuadLerp(float a, float b, float c, float d, float tx, float ty);
-int Clamp(int min, int max, int value);
-
-// WATERFFT ///////////////////////////////////////////////////////////////////
-
-///////////////////////////////////////////////////////////////////////////////
-/// @brief 
-/// A fast fourier transform water simulation. This will create a mesh that 
-/// can with a vertex buffer and index buffer that can be rendered with any
-/// rendering system.
-///
-/// Important Notes
-/// - Call Update each frame before uploading the new water data to the GPU.
-/// - Update takes the total time as the argument.
-///////////////////////////////////////////////////////////////////////////////
-class WaterFFT
-{
-private:
-  /////////////////////////////////////////////////////////////////////////////
-  /// @brief
-  /// A single vertex that will make up the entire water vertex buffer.
-  /// 
-  /// Important Notes
-  /// - There is w component for position and normal so data is sent to the
-  ///   GPU as four floats
-  /////////////////////////////////////////////////////////////////////////////
-  struct Vertex
-  {
-    Vertex(float x, float y, float z, float w, 
-      float nx, float ny, float nz, float nw) :
-      m_Px(x), m_Py(y), m_Pz(z), m_Pw(w), 
-      m_Nx(nx), m_Ny(ny), m_Nz(nz), m_Nw(nw)
-      {}
-    // W components create proper byte alignment for rendering pipeline
-    //! The position of the vertex.
-    float m_Px, m_Py, m_Pz, m_Pw;
-    //! The normal of the vertex.
-    float m_Nx, m_Ny, m_Nz, m_Nw;
-  };
-  /////////////////////////////////////////////////////////////////////////////
-  /// @brief
-  /// Stores extra information about each vertex that is needed to perform the
-  /// FFT simulation.
-  /////////////////////////////////////////////////////////////////////////////
-  struct VertexExtra
-  {
-    VertexExtra(float ox, float oy, float oz, const Complex & htilde0,
-      const Complex & htilde0_conjugate) : m_Ox(ox), m_Oy(oy), m_Oz(oz),
-      m_HTilde0(htilde0), m_HTilde0Conjugate(htilde0_conjugate) {}
-    //! Original vertex position.
-    float m_Ox, m_Oy, m_Oz;
-    //! Complex HTilde0(k) value for a vertex.
-    Complex m_HTilde0;
-    //! Complex HTilde0(-k) conjugate value for a vertex.
-    Complex m_HTilde0Conjugate;
-  };
-
-  struct Offset
-  {
-    Offset(float x, float y, float z, float w) :
-      m_Ox(x), m_Oy(y), m_Oz(z), m_Ow(w)
-    {}
-    float m_Ox, m_Oy, m_Oz, m_Ow;
-  };
-  /////////////////////////////////////////////////////////////////////////////
-  /// @brief
-  /// Stores a postion on the mesh using a vertex index and linear
-  /// interpolation parameters in the positive x and z directions.
-  /////////////////////////////////////////////////////////////////////////////
-  struct MeshPosition
-  {
-    MeshPosition(unsigned vertex_index, float xt, float zt) :
-      m_VertexIndex(vertex_index), m_Xt(xt), m_Zt(zt) {}
-    //! The vertex index on the mesh.
-    unsigned m_VertexIndex;
-    //! The linear interpolation parameter on the positive x axis.
-    float m_Xt;
-    //! The linear interpolation parameter on the positive z axis.
-    float m_Zt;
-  };
-  /////////////////////////////////////////////////////////////////////////////
-  /// @brief
-  /// Used for loading and storing an intensity map. An intensity map is used
-  /// to adjust the how much the water simulation takes affect on parts of the
-  /// mesh. Any entirely white texutre will result in max intensity across
-  /// the entire water surface. Darker shades indicate that the water will be
-  /// less intense on those areas of the surface.
-  /////////////////////////////////////////////////////////////////////////////
-  struct IntensityMap
-  {
-    IntensityMap(const std::string & filename);
-    ~IntensityMap();
-    float GetIntensity(float x, float z);
-    std::string m_InstensityFile;
-    uchar * m_Data;
-    int m_Width;
-    int m_Height;
-    uint m_MaxX;
-    uint m_MaxY;
-    int m_Channels;
-  };
-public:
-  WaterFFT(unsigned grid_dimension, float meter_dimension, unsigned expansion,
-    bool use_fft);
-  ~WaterFFT();
-  bool UseIntensityMap(const std::string & filename);
-  bool RemoveIntensityMap();
-  std::pair<float, glm::vec3> HeightNormalAtLocation(
-    const glm::vec2 & location, float time);
-  float HeightAtLocation(const glm::vec2 & location);
-  void Update(float time);
-  void SwapBuffers();
-  const void * VertexBuffer();
-  const void * IndexBuffer();
-  const void * OffsetBuffer();
-  unsigned VertexBufferSizeBytes();
-  unsigned IndexBufferSizeBytes();
-  unsigned IndexBufferSize();
-  unsigned OffsetBufferSizeBytes();
-  unsigned OffsetBufferSize();
-  // Scaler for the height of verts
-  float m_HeightScale;
-  // Scaler for the displace of verts
-  float m_DisplaceScale;
-private:
-  void UpdateFFT(float time);
-  void UpdateTailEdge(char edge);
-  std::pair<float, glm::vec3> GetLocationHeightNormalFFT(
-    const glm::vec2 & location);
-  float GetLocationHeightFFT(const MeshPosition & mesh_position);
-  glm::vec3 GetLocationNormalFFT(const MeshPosition & mesh_position);
-  MeshPosition LocationToMeshPosition(glm::vec2 location);
-  Complex HTilde(const Complex & htilde0,
-    const Complex & htilde0_conjugate, const glm::vec2 & k, float time);
-  float DispersionRelation(const glm::vec2 & k);
-  Complex HTilde0(const glm::vec2 & k);
-  float PhillipsSpectrum(const glm::vec2 & k);
-  void InitializeVertexBuffer();
-  void InitializeIndexBuffer();
-  void InitializeOffsetBuffer(unsigned expansion);
-
-  // Vertex information for the complete mesh.
-  //! Number of vertices on the x axis.
-  unsigned m_XStride;
-  //! Number of vertices on the z axis.
-  unsigned m_ZStride;
-  //! The total number of verts on the mesh.
-  unsigned m_NumVerts;
-
-  // Vertex information for the fft computation.
-  //! Number of vertices on the x axis.
-  unsigned m_fft_XStride;
-  //! Number of vertices on the z axis.
-  unsigned m_fft_ZStride;
-  //! The total number of verts on the mesh.
-  unsigned m_fft_NumVerts;
-
-  //! The front and back buffers. m_ReadBuffer is the buffer that is currently
-  // being treated as the front buffer.
-  std::vector<Vertex> m_VertexBufferA;
-  std::vector<Vertex> m_VertexBufferB;
-  std::vector<Vertex> * m_ReadBuffer;
-  std::vector<Vertex> * m_WriteBuffer;
-  //! The index buffer used for rendering the mesh.
-  std::vector<unsigned int> m_IndexBuffer;
-  //! The positional offsets for each instance. The size of this is number
-  // of instances to be drawn.
-  std::vector<Offset> m_OffsetBuffer;
-  // Buffer for all of the extra vertex information (not needed for rendering)
-  std::vector<VertexExtra> m_VertexExtrasBuffer;
-  // Used for computing FFT
-  // Input arrays
-  Complex * m_HTildeIn;
-  Complex * m_HTildeSlopeXIn;
-  Complex * m_HTildeSlopeZIn;
-  Complex * m_HTildeDisplaceXIn;
-  Complex * m_HTildeDisplaceZIn;
-  // Ouput arrays
-  Complex * m_HTildeOut;
-  Complex * m_HTildeSlopeXOut;
-  Complex * m_HTildeSlopeZOut;
-  Complex * m_HTildeDisplaceXOut;
-  Complex * m_HTildeDisplaceZOut;
-  // The plans for computing FFT.
-  fftwf_plan m_HTildeFFTWPlan;
-  fftwf_plan m_HTildeSlopeXPlan;
-  fftwf_plan m_HTildeSlopeZPlan;
-  fftwf_plan m_HTildeDisplaceXPlan;
-  fftwf_plan m_HTildeDisplaceZPlan;
-  //! The intensity map used for scaling sections of the simulation.
-  IntensityMap * m_IMap;
-  //! The length of the mesh in the x direction in meters.
-  float m_XLength;
-  //! The length of the mesh in the z direction in meters.
-  float m_ZLength;
-  //! This will affect amplitude, but it is not directly
-  // representitive of wave heights.
-  float m_Amplitude;
-  //! The gravitional constant.
-  float m_Gravity;
-  //! The wind direction and magnitude.
-  glm::vec2 m_Wind;
-};
-
-// WATERFFTHOLDER /////////////////////////////////////////////////////////////
-
-class WaterFFTHolder
-{
-  public:
-    static void Initialize();
-    static void PrepBuffers();
-    static void Update(float time);
-    static void Purge();
-  public:
-    static WaterFFT * GetWaterFFT();
-  private:
-    static WaterFFT * m_Water;
-};
-
-// WATERFFTTHREAD /////////////////////////////////////////////////////////////
-
-class WaterFFTThread
-{
-  public:
-    static void Execute(float (* fetch_time)(void));
-    static void Wait(bool kill = false);
-    static void Terminate();
-  private:
-    static void RunWater();
-    static bool m_Running;
-    static std::function<float()> m_FetchTime;
-    static std::thread * m_Water;
-    static Barrier m_Barrier;
-};
-
-// WATERFFTERROR //////////////////////////////////////////////////////////////
-
-///////////////////////////////////////////////////////////////////////////////
-/// @brief
-/// The type that is thrown when a WaterFFT instance encounters an error.
-///////////////////////////////////////////////////////////////////////////////
-class WaterFFTError
-{
-public:
-  //! The types of WaterFFT errors that can occur.
-  enum Type
-  {
-    INVALID_GRID_DIM,
-    SMALL_DX_DZ
-  };
-  Type GetType() const;
-  const std::string & GetDescription() const;
-private:
-  WaterFFTError(Type type, const std::string & description);
-  //! The type of the error.
-  Type m_Type;
-  //! A description of the error.
-  std::string m_Description;
-  friend WaterFFT;
-};
-
-// WATERRENDERER /////////////////////////////////////////////////////////////
-
-///////////////////////////////////////////////////////////////////////////////
-/// @brief
-/// An OpenGL renderer used to show a WaterFFT instance. It can be abstracted
-/// to show any mesh.
-///////////////////////////////////////////////////////////////////////////////
-class WaterRenderer
-{
-private:
-  ////////////////////////////////////////////////////////////////////////////
-  /// @brief 
-  /// The GLSL shader that is used for drawing the Water surface.
-  ////////////////////////////////////////////////////////////////////////////
-  class WaterShader : public Shader
-  {
-  public:
-    WaterShader();
-    // Attribute locations
-    GLuint m_APosition;
-    GLuint m_ANormal;
-    GLuint m_AOffset;
-    // Uniform locations
-    GLuint m_UTransform;
-    GLuint m_UWaterColor;
-    GLuint m_UAmbientFactor;
-    GLuint m_UAmbientColor;
-    GLuint m_UDiffuseColor;
-    GLuint m_USpecularFactor;
-    GLuint m_USpecularExponent;
-    GLuint m_USpecularColor;
-    GLuint m_ULightDirection;
-    GLuint m_UCameraPosition;
-    GLuint m_UTime;
-  };
-public:
-  static void SetBuffers(const GLfloat * buff_vertex, 
-    const GLuint * buff_index, const GLfloat * buff_offset, 
-    GLuint vertex_size_bytes, GLuint index_size_bytes, 
-    unsigned index_size, GLuint offset_size_bytes,
-    unsigned num_instances);
-  static void SetVertexBuffer(const GLfloat * buff_vertex);
-  static void Render(const glm::vec3 & location,const glm::mat4 & projection, 
-    const glm::mat4 & world_to_camera);
-  // The water color.
-  static glm::vec3 m_WaterColor;
-  // Material values used for phong rendering.
-  static float m_AmbientFactor;
-  static float m_DiffuseFactor;
-  static float m_SpecularFactor;
-  static int m_SpecularExponent;
-  // Color values used for phong rendering.
-  static glm::vec3 m_AmbientColor;
-  static glm::vec3 m_DiffuseColor;
-  static glm::vec3 m_SpecularColor;
-private:
-  WaterRenderer() {}
-  static void DeleteBuffers();
-  static void PrepareBuffers();
-  static void ManageInput();
-  // The shader being used by the WaterRenderer.
-  static WaterShader * m_WaterShader;
-  // The vertex buffer ID.
-  static GLuint m_WaterVBOID;
-  // The element buffer ID.
-  static GLuint m_WaterEBOID;
-  // The vertex attribute ID.
-  static GLuint m_WaterVAOID;
-  // The offset buffer ID
-  static GLuint m_OffsetVBOID;
-  // Pointers to the vertex and index buffers.
-  static const GLfloat * m_VertexBuffer;
-  static const GLuint * m_IndexBuffer;
-  static const GLfloat * m_OffsetBuffer;
-  // Sizes of the vertex, index and offset buffers.
-  static GLuint m_VertexBufferSizeBytes;
-  static GLuint m_IndexBufferSizeBytes;
-  static GLuint m_OffsetBufferSizeBytes;
-  // The number of values in the index buffer.
-  static unsigned m_NumIndices;
-  // The number of instances that will be drawn.
-  static unsigned m_NumInstances;
-  // Determines whether the water is drawn with LINE or FILL.
-  static bool m_LineDraw;
-};
+///////////////////////////////////////////////////////////////////////////////
+/// @file WaterFFT.h
+/// @author Connor Deakin
+/// @email connor.deakin@digipen.edu
+/// @date 2017-10-05
+///
+/// @brief Contains the interface for the fast fourier transform water
+/// simulation.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <condition_variable>
+#include <FFTW\fftw3.h>
+#include <functional>
+#include <GLM\glm\glm.hpp>
+#include <GLM\glm\vec3.hpp>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Complex.h"
+#include "FFT.h"
+#include "FramePublisher.h"
+#include "FrameStream.h"
+#include "Half.h"
+#include "Random.h"
+#include "Ripple.h"
+#include "SurfaceLayer.h"
+#include "Wake.h"
+// Defining WATER_HEADLESS leaves out the WaterRenderer and everything else
+// that needs OpenGL so the simulation can run in programs without a window.
+#ifndef WATER_HEADLESS
+#include <GL\glew.h>
+#include "Shader.h"
+#endif
+
+typedef unsigned int uint;
+typedef unsigned char uchar;
+
+// MATH HELPERS ///////////////////////////////////////////////////////////////
+
+float Lerp(float a, float b, float t);
+float QuadLerp(float a, float b, float c, float d, float tx, float ty);
+int Clamp(int min, int max, int value);
+float PhaseAngle(float omega, double time);
+
+// WATERFFT ///////////////////////////////////////////////////////////////////
+
+//! The number of vertex buffers a WaterFFT owns. Two hold the states being
+// blended by the renderer and the third is written by the simulation.
+#define WATER_VERTEX_BUFFERS 3
+//! The seed a WaterFFT's spectrum is made from until Seed is called.
+#define WATER_DEFAULT_SEED 0x5eedull
+//! The number of values FieldRow gives for each vertex.
+#define WATER_FIELDS 6
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief 
+/// A fast fourier transform water simulation. This will create a mesh that 
+/// can with a vertex buffer and index buffer that can be rendered with any
+/// rendering system.
+///
+/// Important Notes
+/// - Update takes the simulation time in double precision and the vertex
+///   buffer that the new state is written to. The buffer must not be read
+///   while it is being written.
+/// - SetReadBuffer chooses the buffer used by the height and normal queries.
+///
+/// Determinism
+/// - Two WaterFFTs write bitwise identical vertex buffers for the same time
+///   when they have the same dimensions, seed, and settings, are
+///   Deterministic, and run the same build on the same kind of CPU. This
+///   holds across processes and machines, so a client that is given the
+///   seed and the time can compute the surface itself.
+/// - Update is a pure function of time. The order times are given in does
+///   not matter.
+/// - Layers keep the guarantee when they do. Wake only depends on the ships
+///   and its center. Ripple depends on every step it has taken, so clients
+///   must give it the same sources at the same times. Neither depends on the
+///   number of threads it uses.
+/// - Different compilers, compiler flags, math libraries, FFTW builds, or
+///   instruction sets can round differently. Nothing is promised between
+///   them.
+///////////////////////////////////////////////////////////////////////////////
+class WaterFFT
+{
+private:
+  /////////////////////////////////////////////////////////////////////////////
+  /// @brief
+  /// A single vertex that will make up the entire water vertex buffer.
+  /// 
+  /// Important Notes
+  /// - There is w component for position and normal so data is sent to the
+  ///   GPU as four floats
+  /////////////////////////////////////////////////////////////////////////////
+  struct Vertex
+  {
+    Vertex(float x, float y, float z, float w, 
+      float nx, float ny, float nz, float nw) :
+      m_Px(x), m_Py(y), m_Pz(z), m_Pw(w), 
+      m_Nx(nx), m_Ny(ny), m_Nz(nz), m_Nw(nw)
+      {}
+    // W components create proper byte alignment for rendering pipeline
+    //! The position of the vertex.
+    float m_Px, m_Py, m_Pz, m_Pw;
+    //! The normal of the vertex.
+    float m_Nx, m_Ny, m_Nz, m_Nw;
+  };
+  /////////////////////////////////////////////////////////////////////////////
+  /// @brief
+  /// Stores extra information about each element of the spectrum that is
+  /// needed to perform the FFT simulation.
+  ///
+  /// Important Notes
+  /// - The spectrum is stored in fft order. The element at index x holds the
+  ///   frequency x for x < N / 2 and x - N for the rest. This is the
+  ///   checkerboard sign that would otherwise be applied to the fft output.
+  /////////////////////////////////////////////////////////////////////////////
+  struct VertexExtra
+  {
+    VertexExtra() {}
+    VertexExtra(const Complex & htilde0) : m_HTilde0(htilde0) {}
+    //! Complex HTilde0(k) value for a vertex. The HTilde0(-k) value is the
+    // HTilde0 of the mirrored element.
+    Complex m_HTilde0;
+  };
+  /////////////////////////////////////////////////////////////////////////////
+  /// @brief
+  /// A VertexExtra stored as halves. The values are in the same order, so a
+  /// row of these converts to a row of VertexExtras with HalfToFloat.
+  /////////////////////////////////////////////////////////////////////////////
+  struct HalfVertexExtra
+  {
+    Half m_Values[2];
+  };
+
+  /////////////////////////////////////////////////////////////////////////////
+  /// @brief
+  /// An element of the spectrum and its mirrored element. These are only
+  /// kept for pairs where either h~0 is above the spectrum threshold.
+  /////////////////////////////////////////////////////////////////////////////
+  struct SpectrumPair
+  {
+    unsigned m_X, m_Z;
+    unsigned m_MirrorX, m_MirrorZ;
+  };
+
+  struct Offset
+  {
+    Offset(float x, float y, float z, float w) :
+      m_Ox(x), m_Oy(y), m_Oz(z), m_Ow(w)
+    {}
+    float m_Ox, m_Oy, m_Oz, m_Ow;
+  };
+  /////////////////////////////////////////////////////////////////////////////
+  /// @brief
+  /// Stores a postion on the mesh using a vertex index and linear
+  /// interpolation parameters in the positive x and z directions.
+  /////////////////////////////////////////////////////////////////////////////
+  struct MeshPosition
+  {
+    MeshPosition(unsigned vertex_index, float xt, float zt) :
+      m_VertexIndex(vertex_index), m_Xt(xt), m_Zt(zt) {}
+    //! The vertex index on the mesh.
+    unsigned m_VertexIndex;
+    //! The linear interpolation parameter on the positive x axis.
+    float m_Xt;
+    //! The linear interpolation parameter on the positive z axis.
+    float m_Zt;
+  };
+  /////////////////////////////////////////////////////////////////////////////
+  /// @brief
+  /// Used for loading and storing an intensity map. An intensity map is used
+  /// to adjust the how much the water simulation takes affect on parts of the
+  /// mesh. Any entirely white texutre will result in max intensity across
+  /// the entire water surface. Darker shades indicate that the water will be
+  /// less intense on those areas of the surface.
+  /////////////////////////////////////////////////////////////////////////////
+  struct IntensityMap
+  {
+    IntensityMap(const std::string & filename);
+    ~IntensityMap();
+    float GetIntensity(float x, float z);
+    std::string m_InstensityFile;
+    uchar * m_Data;
+    int m_Width;
+    int m_Height;
+    uint m_MaxX;
+    uint m_MaxY;
+    int m_Channels;
+  };
+public:
+  /////////////////////////////////////////////////////////////////////////////
+  /// @brief
+  /// The surface at a single location as found by SampleExact.
+  /////////////////////////////////////////////////////////////////////////////
+  struct SurfaceSample
+  {
+    //! The height of the surface.
+    float m_Height;
+    //! The normalized surface normal.
+    glm::vec3 m_Normal;
+    //! The horizontal displacement of the surface in the x and z directions.
+    glm::vec2 m_Displacement;
+  };
+  WaterFFT(unsigned grid_dimension, float meter_dimension, unsigned expansion);
+  WaterFFT(unsigned x_dimension, unsigned z_dimension, float x_length,
+    float z_length, unsigned expansion);
+  ~WaterFFT();
+  static bool ValidGridDimension(unsigned dimension);
+  bool UseIntensityMap(const std::string & filename);
+  bool RemoveIntensityMap();
+  std::pair<float, glm::vec3> HeightNormalAtLocation(
+    const glm::vec2 & location, float time);
+  float HeightAtLocation(const glm::vec2 & location);
+  void HeightsAtLocations(const float * x, const float * z, unsigned count,
+    float * heights);
+  void HalfPrecision(bool enabled);
+  bool HalfPrecision() const;
+  void Seed(uint64_t seed);
+  uint64_t Seed() const;
+  void Deterministic(bool enabled);
+  bool Deterministic() const;
+  void BuiltinFFT(bool enabled);
+  bool BuiltinFFT() const;
+  void SpectrumThreshold(float threshold);
+  float SpectrumThreshold() const;
+  unsigned SpectrumActiveCount() const;
+  unsigned SpectrumCount() const;
+  float SpectrumEnergyLoss() const;
+  void ExactModes(unsigned count);
+  unsigned ExactModeCount() const;
+  void SampleExact(const glm::vec2 * locations, unsigned count, double time,
+    SurfaceSample * samples);
+  void SampleBuffer(unsigned buffer, const glm::vec2 * locations,
+    unsigned count, SurfaceSample * samples);
+  void FieldRow(unsigned buffer, unsigned z, float * fields) const;
+  void AttachLayer(SurfaceLayer * layer);
+  void ClearLayers();
+  void Update(double time, unsigned buffer);
+  void SetReadBuffer(unsigned buffer);
+  const void * VertexBuffer();
+  const void * VertexBuffer(unsigned buffer);
+  const void * IndexBuffer();
+  const void * OffsetBuffer();
+  unsigned VertexBufferSizeBytes();
+  unsigned IndexBufferSizeBytes();
+  unsigned IndexBufferSize();
+  unsigned OffsetBufferSizeBytes();
+  unsigned OffsetBufferSize();
+  unsigned XVertices() const;
+  unsigned ZVertices() const;
+  float XLength() const;
+  float ZLength() const;
+  // Scaler for the height of verts
+  float m_HeightScale;
+  // Scaler for the displace of verts
+  float m_DisplaceScale;
+private:
+  void UpdateFFT(double time);
+  void WriteRow(unsigned fft_row, Vertex * row, float z_location);
+  float Frequency(unsigned index, unsigned dimension);
+  std::pair<float, glm::vec3> GetLocationHeightNormalFFT(
+    const glm::vec2 & location);
+  float GetLocationHeightFFT(const MeshPosition & mesh_position);
+  glm::vec3 GetLocationNormalFFT(const MeshPosition & mesh_position);
+  MeshPosition LocationToMeshPosition(glm::vec2 location);
+  void HTildePair(const Complex & htilde0, const Complex & htilde0_mirror,
+    const glm::vec2 & k, double time, Complex * htilde,
+    Complex * htilde_mirror);
+  const VertexExtra * RowExtras(unsigned z, unsigned slot);
+  void BuildRowInputs(unsigned z);
+  void UpdateSparseSpectrum(double time);
+  void WriteSpectrumElement(unsigned x, unsigned z, const Complex & htilde);
+  Complex HTilde0At(unsigned index);
+  float DispersionRelation(const glm::vec2 & k);
+  Complex HTilde0(const glm::vec2 & k);
+  float PhillipsSpectrum(const glm::vec2 & k);
+  void CreatePlans();
+  void DestroyPlans();
+  void ExecuteFFTs();
+  void ExecuteBuiltinFFT(Complex * in, Complex * out);
+  void InitializeVertexBuffer();
+  void InitializeSpectrum();
+  void InitializeIndexBuffer();
+  void InitializeOffsetBuffer(unsigned expansion);
+
+  // Vertex information for the complete mesh.
+  //! Number of vertices on the x axis.
+  unsigned m_XStride;
+  //! Number of vertices on the z axis.
+  unsigned m_ZStride;
+  //! The total number of verts on the mesh.
+  unsigned m_NumVerts;
+
+  // Vertex information for the fft computation.
+  //! Number of vertices on the x axis.
+  unsigned m_fft_XStride;
+  //! Number of vertices on the z axis.
+  unsigned m_fft_ZStride;
+  //! The total number of verts on the mesh.
+  unsigned m_fft_NumVerts;
+
+  //! The vertex buffers. Each one holds the mesh at a different simulation
+  // time. m_ReadBuffer is the buffer used for height and normal queries and
+  // m_WriteBuffer is the buffer written by the most recent Update.
+  std::vector<Vertex> m_VertexBuffers[WATER_VERTEX_BUFFERS];
+  std::vector<Vertex> * m_ReadBuffer;
+  std::vector<Vertex> * m_WriteBuffer;
+  //! The index buffer used for rendering the mesh.
+  std::vector<unsigned int> m_IndexBuffer;
+  //! The positional offsets for each instance. The size of this is number
+  // of instances to be drawn.
+  std::vector<Offset> m_OffsetBuffer;
+  // Buffer for all of the extra vertex information (not needed for rendering)
+  std::vector<VertexExtra> m_VertexExtrasBuffer;
+  //! The vertex extras stored as halves. When half precision is enabled
+  // these are used and m_VertexExtrasBuffer is empty.
+  std::vector<HalfVertexExtra> m_HalfVertexExtrasBuffer;
+  //! Identifies whether the vertex extras are stored as halves.
+  bool m_HalfPrecision;
+  //! A row and its mirrored row of vertex extras converted back to floats.
+  std::vector<VertexExtra> m_RowExtras;
+  //! The wave number in the x direction for each column of the spectrum.
+  std::vector<float> m_KX;
+  //! The wave number in the z direction for each row of the spectrum.
+  std::vector<float> m_KZ;
+  //! The fraction of the largest |h~0| an element must be above to be
+  // updated. Zero updates every element.
+  float m_SpectrumThreshold;
+  //! The pairs of elements that are updated when the threshold is not zero.
+  std::vector<SpectrumPair> m_SpectrumPairs;
+  //! The fraction of the spectrum's energy in the elements that are skipped.
+  float m_SpectrumEnergyLoss;
+  // The modes used by SampleExact. Each value is kept in its own array so
+  // four modes can be loaded at once.
+  //! The wave vector of each mode.
+  std::vector<float> m_ModeKX;
+  std::vector<float> m_ModeKZ;
+  //! The dispersion relation of each mode.
+  std::vector<float> m_ModeOmega;
+  //! h~0(k) of each mode.
+  std::vector<float> m_ModeH0Real;
+  std::vector<float> m_ModeH0Imaginary;
+  //! The conjugate of h~0(-k) of each mode.
+  std::vector<float> m_ModeH0MirrorReal;
+  std::vector<float> m_ModeH0MirrorImaginary;
+  //! The layers added to the surface.
+  std::vector<SurfaceLayer *> m_Layers;
+  //! The offset from the mesh to the instance each layer's window is on.
+  std::vector<glm::vec2> m_LayerOffsets;
+  //! The sum of the layer heights and slopes along the row being written.
+  std::vector<float> m_RowLayerHeight;
+  std::vector<float> m_RowLayerSlopeX;
+  std::vector<float> m_RowLayerSlopeZ;
+  //! The x and z factors that turn one row of the spectrum into the
+  // displacement inputs.
+  std::vector<float> m_RowDisplaceX;
+  std::vector<float> m_RowDisplaceZ;
+  // Used for computing FFT
+  // Input arrays
+  Complex * m_HTildeIn;
+  Complex * m_HTildeSlopeXIn;
+  Complex * m_HTildeSlopeZIn;
+  Complex * m_HTildeDisplaceXIn;
+  Complex * m_HTildeDisplaceZIn;
+  // Ouput arrays
+  Complex * m_HTildeOut;
+  Complex * m_HTildeSlopeXOut;
+  Complex * m_HTildeSlopeZOut;
+  Complex * m_HTildeDisplaceXOut;
+  Complex * m_HTildeDisplaceZOut;
+  // The plans for computing FFT.
+  fftwf_plan m_HTildeFFTWPlan;
+  fftwf_plan m_HTildeSlopeXPlan;
+  fftwf_plan m_HTildeSlopeZPlan;
+  fftwf_plan m_HTildeDisplaceXPlan;
+  fftwf_plan m_HTildeDisplaceZPlan;
+  //! Identifies whether the plans were made with FFTW_ESTIMATE. Measured
+  // plans are chosen by timing them, so two processes can end up with
+  // plans that round differently.
+  bool m_Deterministic;
+  //! Computes the ffts in place of the plans when it is set. See BuiltinFFT.
+  FFT2D * m_BuiltinFFT;
+  //! The seed the spectrum was made from.
+  uint64_t m_Seed;
+  //! Gives the gaussian numbers that h~0 is made from.
+  Random m_Random;
+  //! The intensity map used for scaling sections of the simulation.
+  IntensityMap * m_IMap;
+  //! The length of the mesh in the x direction in meters.
+  float m_XLength;
+  //! The length of the mesh in the z direction in meters.
+  float m_ZLength;
+  //! This will affect amplitude, but it is not directly
+  // representitive of wave heights.
+  float m_Amplitude;
+  //! The gravitional constant.
+  float m_Gravity;
+  //! The wind direction and magnitude.
+  glm::vec2 m_Wind;
+};
+
+// WATERFFTHOLDER /////////////////////////////////////////////////////////////
+
+class WaterFFTHolder
+{
+  public:
+    static void Initialize(unsigned grid_dimension = 256,
+      unsigned expansion = 5);
+#ifndef WATER_HEADLESS
+    static void ShareBuffers();
+#endif
+    static void Update(double time, unsigned buffer);
+    static void Purge();
+    static void HalfPrecision(bool enabled);
+    static void SpectrumThreshold(float threshold);
+    static void Seed(uint64_t seed);
+    static void Deterministic(bool enabled);
+    static void BuiltinFFT(bool enabled);
+    static void Ripples(bool enabled);
+    static void Wakes(bool enabled);
+    static void Publish(const std::string & name);
+    static void Stream(const std::string & filename);
+  public:
+    static WaterFFT * GetWaterFFT();
+    static Ripple * GetRipple();
+    static Wake * GetWake();
+  private:
+    static void AttachLayers();
+    static void StartStream();
+    static WaterFFT * m_Water;
+    //! Identifies whether new WaterFFTs store their spectrum as halves.
+    static bool m_HalfPrecision;
+    //! The spectrum threshold given to new WaterFFTs.
+    static float m_SpectrumThreshold;
+    //! The seed given to new WaterFFTs.
+    static uint64_t m_Seed;
+    //! Identifies whether new WaterFFTs use deterministic plans.
+    static bool m_Deterministic;
+    //! Identifies whether new WaterFFTs use FFT2D instead of FFTW.
+    static bool m_BuiltinFFT;
+    //! The ripple layer attached to new WaterFFTs. It outlives the WaterFFTs
+    // so the ripples survive a restart.
+    static Ripple * m_Ripple;
+    //! The ship wakes attached to new WaterFFTs.
+    static Wake * m_Wake;
+    //! The name of the shared memory frames are published to. Frames are
+    // not published when it is empty.
+    static std::string m_PublishName;
+    //! Publishes every frame of the current WaterFFT.
+    static FramePublisher * m_Publisher;
+    //! The file frames are recorded to. Frames are not recorded when it is
+    // empty.
+    static std::string m_StreamName;
+    //! Records every frame. It outlives the WaterFFTs so a restart to the
+    // same size keeps recording to the same file.
+    static FrameStreamWriter * m_StreamWriter;
+    //! The number of files recorded to since Stream was called. Every
+    // change of size starts another one.
+    static unsigned m_StreamSegment;
+};
+
+// WATERFFTTHREAD /////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Runs the WaterFFT on its own thread with a fixed time step. Simulation
+/// time is split into ticks that are one step long and every simulated state
+/// belongs to a tick. When the render time is between two ticks, the
+/// renderer blends the states of those ticks. The simulation computes the
+/// tick after them ahead of time so the renderer does not have to wait for it.
+///
+/// Important Notes
+/// - Call Wait once per frame before rendering. It gives the renderer the two
+///   states around the current time and only blocks when the simulation has
+///   fallen behind.
+///////////////////////////////////////////////////////////////////////////////
+class WaterFFTThread
+{
+  public:
+    static void Execute(double (* fetch_time)(void));
+    static void Wait();
+    static bool Wait(unsigned * previous_buffer, unsigned * current_buffer,
+      float * blend);
+    static void Terminate();
+    static void Restart(unsigned grid_dimension, unsigned expansion);
+    static void StepRate(float rate);
+    static float StepRate();
+    static float UpdateTime();
+  private:
+    static void Start();
+    static void RunWater();
+    static int TargetTick();
+    static int FindBuffer(int tick);
+    static bool FindWork(int * tick, unsigned * buffer);
+    //! Tracks whether the simulation thread should keep running.
+    static bool m_Running;
+    //! Used to get the current render time.
+    static std::function<double()> m_FetchTime;
+    //! The simulation thread.
+    static std::thread * m_Water;
+    //! Guards every value below and the vertex buffers that hold a tick.
+    static std::mutex m_Mutex;
+    //! Used by both threads to wait on the other.
+    static std::condition_variable m_Condition;
+    //! The length of a tick in seconds.
+    static float m_Step;
+    //! The most recent time fetched by Wait.
+    static double m_RenderTime;
+    //! The tick held by each WaterFFT vertex buffer.
+    static int m_BufferTicks[WATER_VERTEX_BUFFERS];
+    //! The buffer last made the WaterFFT's read buffer by Wait. -1 when
+    // there is none.
+    static int m_ReadBuffer;
+    //! A running average of the seconds spent on each WaterFFT update.
+    static float m_UpdateTime;
+};
+
+// WATERFFTERROR //////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// The type that is thrown when a WaterFFT instance encounters an error.
+///////////////////////////////////////////////////////////////////////////////
+class WaterFFTError
+{
+public:
+  //! The types of WaterFFT errors that can occur.
+  enum Type
+  {
+    INVALID_GRID_DIM,
+    SMALL_DX_DZ
+  };
+  Type GetType() const;
+  const std::string & GetDescription() const;
+private:
+  WaterFFTError(Type type, const std::string & description);
+  //! The type of the error.
+  Type m_Type;
+  //! A description of the error.
+  std::string m_Description;
+  friend WaterFFT;
+};
+
+// WATERRENDERER /////////////////////////////////////////////////////////////
+#ifndef WATER_HEADLESS
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// An OpenGL renderer used to show a WaterFFT instance. It can be abstracted
+/// to show any mesh.
+///////////////////////////////////////////////////////////////////////////////
+class WaterRenderer
+{
+private:
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief 
+  /// The GLSL shader that is used for drawing the Water surface.
+  ////////////////////////////////////////////////////////////////////////////
+  class WaterShader : public Shader
+  {
+  public:
+    WaterShader();
+    // Attribute locations
+    GLuint m_APosition;
+    GLuint m_ANormal;
+    GLuint m_APositionNext;
+    GLuint m_ANormalNext;
+    GLuint m_AOffset;
+    // Uniform locations
+    GLuint m_UTransform;
+    GLuint m_UWaterColor;
+    GLuint m_UAmbientFactor;
+    GLuint m_UAmbientColor;
+    GLuint m_UDiffuseColor;
+    GLuint m_USpecularFactor;
+    GLuint m_USpecularExponent;
+    GLuint m_USpecularColor;
+    GLuint m_ULightDirection;
+    GLuint m_UCameraPosition;
+    GLuint m_UTime;
+    GLuint m_UAlpha;
+  };
+public:
+  static void SetBuffers(const GLfloat * buff_vertex, 
+    const GLuint * buff_index, const GLfloat * buff_offset, 
+    GLuint vertex_size_bytes, GLuint index_size_bytes, 
+    unsigned index_size, GLuint offset_size_bytes,
+    unsigned num_instances);
+  static void SetVertexBuffers(const GLfloat * buff_previous,
+    int previous_tick, const GLfloat * buff_current, int current_tick,
+    float alpha);
+  static void SetVertexBuffers(int previous_tick, int current_tick,
+    float alpha, const std::function<void(int, GLfloat *)> & fill);
+  static void Render(const glm::vec3 & location,const glm::mat4 & projection, 
+    const glm::mat4 & world_to_camera);
+  // The water color.
+  static glm::vec3 m_WaterColor;
+  // Material values used for phong rendering.
+  static float m_AmbientFactor;
+  static float m_DiffuseFactor;
+  static float m_SpecularFactor;
+  static int m_SpecularExponent;
+  // Color values used for phong rendering.
+  static glm::vec3 m_AmbientColor;
+  static glm::vec3 m_DiffuseColor;
+  static glm::vec3 m_SpecularColor;
+private:
+  WaterRenderer() {}
+  static void DeleteBuffers();
+  static void PrepareBuffers();
+  static void ManageInput();
+  // The shader being used by the WaterRenderer.
+  static WaterShader * m_WaterShader;
+  // The two vertex buffer IDs. One holds the previous state and the other
+  // holds the current state.
+  static GLuint m_WaterVBOIDs[2];
+  // The simulation tick of the state held by each vertex buffer.
+  static int m_VBOTicks[2];
+  // The vertex buffer holding the previous state.
+  static unsigned m_PreviousVBO;
+  // How far the render time is from the previous state to the current state.
+  static float m_Alpha;
+  // The element buffer ID.
+  static GLuint m_WaterEBOID;
+  // The vertex attribute IDs. m_WaterVAOIDs[i] reads the previous state from
+  // m_WaterVBOIDs[i] and the current state from the other vertex buffer.
+  static GLuint m_WaterVAOIDs[2];
+  // The offset buffer ID
+  static GLuint m_OffsetVBOID;
+  // Pointers to the initial vertex buffer and the index buffer.
+  static const GLfloat * m_VertexBuffer;
+  static const GLuint * m_IndexBuffer;
+  static const GLfloat * m_OffsetBuffer;
+  // Sizes of the vertex, index and offset buffers.
+  static GLuint m_VertexBufferSizeBytes;
+  static GLuint m_IndexBufferSizeBytes;
+  static GLuint m_OffsetBufferSizeBytes;
+  // The number of values in the index buffer.
+  static unsigned m_NumIndices;
+  // The number of instances that will be drawn.
+  static unsigned m_NumInstances;
+  // Determines whether the water is drawn with LINE or FILL.
+  static bool m_LineDraw;
+};
+
+#endif // !WATER_HEADLESS
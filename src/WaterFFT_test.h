@@ -0,0 +1,129 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "FFT.h"
+#include "WaterFFT.h"
+
+// The largest height error allowed when the spectrum is stored as halves, as
+// a fraction of the largest height.
+#define TEST_HALF_ERROR_BUDGET 1.0e-3f
+#define TEST_HALF_SEED 12345
+#define TEST_HALF_GRID 256
+#define BENCH_HALF_UPDATES 20
+
+void test_water_fft();
+void test_half_precision();
+void bench_half_precision();
+float bench_half_update(unsigned grid, bool half);
+
+void test_water_fft()
+{
+  test_half_precision();
+}
+
+// Builds the same water twice, stores one spectrum as halves, and compares
+// the heights of both at several times. Each WaterFFT is seeded the same way
+// so both start from the same spectrum.
+void test_half_precision()
+{
+  WaterFFT full(TEST_HALF_GRID, 256.0f, 1);
+  full.Seed(TEST_HALF_SEED);
+  WaterFFT half(TEST_HALF_GRID, 256.0f, 1);
+  half.Seed(TEST_HALF_SEED);
+  half.HalfPrecision(true);
+
+  float max_height = 0.0f;
+  float max_error = 0.0f;
+  double times[] = { 0.0, 1.0, 10.0, 100.0, 1000.0 };
+  for (double time : times)
+  {
+    full.Update(time, 0);
+    full.SetReadBuffer(0);
+    half.Update(time, 0);
+    half.SetReadBuffer(0);
+    for (int z = -TEST_HALF_GRID / 2; z < TEST_HALF_GRID / 2; ++z)
+    {
+      for (int x = -TEST_HALF_GRID / 2; x < TEST_HALF_GRID / 2; ++x)
+      {
+        glm::vec2 location((float)x + 0.5f, (float)z + 0.5f);
+        float full_height = full.HeightAtLocation(location);
+        float half_height = half.HeightAtLocation(location);
+        max_height = glm::max(max_height, std::fabs(full_height));
+        max_error = glm::max(max_error, std::fabs(full_height - half_height));
+      }
+    }
+  }
+  float relative_error = max_error / max_height;
+  // relative error: less than TEST_HALF_ERROR_BUDGET
+  std::cout << "max height: " << max_height << ", max half error: "
+    << max_error << ", relative: " << relative_error
+    << (relative_error < TEST_HALF_ERROR_BUDGET ? " PASS" : " FAIL")
+    << std::endl;
+}
+
+// Splits an FFT2D update into the parts that storing more of it as halves
+// could change. Only h~0 is stored as halves. The spectra and the fft
+// outputs could also be loaded and stored as halves around FFT2D, but
+// FFT2D's column passes need the whole grid as floats either way, so only
+// the spectrum writes, the first fft read, the last fft write, and the
+// vertex reads would shrink. This times those passes over the five float
+// arrays on their own. Halves would save at most half of that time.
+void bench_half_precision()
+{
+  typedef std::chrono::high_resolution_clock Clock;
+  unsigned grids[] = { 256, 512, 1024 };
+  for (unsigned grid : grids)
+  {
+    float full_ms = bench_half_update(grid, false);
+    float half_ms = bench_half_update(grid, true);
+
+    unsigned count = grid * grid;
+    std::vector<Complex> in(5 * count);
+    std::vector<Complex> out(5 * count);
+    FFT2D fft(grid, grid);
+    fft.fft(in.data(), out.data());
+    Clock::time_point start = Clock::now();
+    for (unsigned i = 0; i < 5; ++i)
+      fft.fft(in.data() + i * count, out.data() + i * count);
+    float fft_ms = std::chrono::duration<float, std::milli>(Clock::now() -
+      start).count();
+
+    // Writes the inputs, reads them into the outputs, and reads the outputs.
+    float sum = 0.0f;
+    start = Clock::now();
+    for (unsigned pass = 0; pass < BENCH_HALF_UPDATES; ++pass)
+    {
+      std::fill(in.begin(), in.end(), Complex((float)pass, 0.0f));
+      std::copy(in.begin(), in.end(), out.begin());
+      for (const Complex & value : out)
+        sum += value.Real();
+    }
+    float traffic_ms = std::chrono::duration<float, std::milli>(Clock::now() -
+      start).count() / BENCH_HALF_UPDATES;
+    std::cout << "grid " << grid << ": update " << full_ms
+      << " ms, with half h~0 " << half_ms << " ms, five FFT2Ds " << fft_ms
+      << " ms, float spectrum and output passes " << traffic_ms << " ms"
+      << (sum < 0.0f ? " " : "") << std::endl;
+  }
+}
+
+// Times WaterFFT::Update on FFT2D with h~0 stored as floats or halves.
+float bench_half_update(unsigned grid, bool half)
+{
+  typedef std::chrono::high_resolution_clock Clock;
+  WaterFFT water(grid, 256.0f, 1);
+  water.Seed(TEST_HALF_SEED);
+  water.BuiltinFFT(true);
+  water.HalfPrecision(half);
+  // The first update touches every array once so it is not timed.
+  water.Update(0.0, 0);
+  Clock::time_point start = Clock::now();
+  for (unsigned i = 0; i < BENCH_HALF_UPDATES; ++i)
+    water.Update((double)i / 30.0, 0);
+  Clock::time_point end = Clock::now();
+  return std::chrono::duration<float, std::milli>(end - start).count() /
+    BENCH_HALF_UPDATES;
+}
@@ -0,0 +1,213 @@
+///////////////////////////////////////////////////////////////////////////////
+/// @file WaterGovernor.cpp
+/// @date 2026-10-17
+///
+/// @brief Contains the implementation of the WaterGovernor.
+///////////////////////////////////////////////////////////////////////////////
+#include <iomanip>
+
+#include "Framer.h"
+#include "Time.h"
+#include "WaterFFT.h"
+
+#include "WaterGovernor.h"
+
+#define WATER_GOVERNOR_LOG_FILENAME "water.quality"
+// The seconds between evaluations.
+#define WATER_GOVERNOR_PERIOD 0.5f
+// Evaluations over the budget needed before the level is dropped.
+#define WATER_GOVERNOR_DROP_COUNT 2
+// Evaluations under the budget needed before the level is raised. This is
+// doubled every time a raise is followed by a drop.
+#define WATER_GOVERNOR_RAISE_COUNT 6
+#define WATER_GOVERNOR_MAX_RAISE_COUNT 96
+// Evaluations skipped after a change.
+#define WATER_GOVERNOR_COOLDOWN 2
+// The fraction of the budget a frame must stay under for the level to rise.
+#define WATER_GOVERNOR_RAISE_FRACTION 0.6f
+// The fraction of each step the simulation thread may spend updating. Above
+// this, the renderer starts waiting on the simulation.
+#define WATER_GOVERNOR_MAX_SIM_LOAD 0.9f
+// The simulation load the thread must stay under for the level to rise.
+#define WATER_GOVERNOR_RAISE_SIM_LOAD 0.5f
+
+//! The values set by a single quality level.
+struct QualityLevel
+{
+  //! The number of vertices along each side of the grid.
+  unsigned m_GridDimension;
+  //! The number of simulation steps per second.
+  float m_StepRate;
+  //! The number of instances along each side of the water.
+  unsigned m_Expansion;
+};
+
+//! The quality levels from cheapest to most expensive. The grid dimensions
+// between powers of 2 keep each step in cost small.
+static const QualityLevel quality_levels[] = {
+  { 64, 20.0f, 3 },
+  { 128, 20.0f, 4 },
+  { 128, 30.0f, 5 },
+  { 192, 30.0f, 5 },
+  { 256, 30.0f, 5 },
+  { 384, 30.0f, 5 },
+  { 384, 60.0f, 6 },
+  { 512, 60.0f, 6 }
+};
+//! The level used by WaterFFTHolder::Initialize's defaults.
+#define WATER_GOVERNOR_DEFAULT_LEVEL 4
+
+// static initializations
+float WaterGovernor::m_Budget = 0.0f;
+unsigned WaterGovernor::m_Level = WATER_GOVERNOR_DEFAULT_LEVEL;
+double WaterGovernor::m_EvaluationTime = 0.0;
+unsigned WaterGovernor::m_OverCount = 0;
+unsigned WaterGovernor::m_UnderCount = 0;
+unsigned WaterGovernor::m_UpgradeCount = WATER_GOVERNOR_RAISE_COUNT;
+unsigned WaterGovernor::m_Cooldown = 0;
+bool WaterGovernor::m_LastRaised = false;
+std::ofstream WaterGovernor::m_Log;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the frame time budget and starts the governor. The decision
+/// log is opened the first time this is called.
+///
+/// @param milliseconds The budget for a single frame. Zero stops the
+///   governor.
+///////////////////////////////////////////////////////////////////////////////
+void WaterGovernor::Budget(float milliseconds)
+{
+  m_Budget = milliseconds;
+  m_OverCount = 0;
+  m_UnderCount = 0;
+  m_Cooldown = WATER_GOVERNOR_COOLDOWN;
+  m_EvaluationTime = Time::TotalTimeExact();
+  if (!m_Log.is_open())
+    m_Log.open(WATER_GOVERNOR_LOG_FILENAME, std::ios::trunc);
+  const QualityLevel & level = quality_levels[m_Level];
+  m_Log << std::fixed << std::setprecision(2) << "[" << m_EvaluationTime
+    << "s] budget " << m_Budget << " ms at level " << m_Level << " (grid "
+    << level.m_GridDimension << ", " << level.m_StepRate << " Hz, expansion "
+    << level.m_Expansion << ")" << std::endl;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the frame time budget.
+///
+/// @return The budget in milliseconds.
+///////////////////////////////////////////////////////////////////////////////
+float WaterGovernor::Budget()
+{
+  return m_Budget;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Evaluates the most recent timings if enough time has passed since
+/// the previous evaluation.
+///////////////////////////////////////////////////////////////////////////////
+void WaterGovernor::Update()
+{
+  if (m_Budget <= 0.0f)
+    return;
+  double time = Time::TotalTimeExact();
+  if (time - m_EvaluationTime < WATER_GOVERNOR_PERIOD)
+    return;
+  m_EvaluationTime = time;
+  float frame_ms = Framer::AverageWorkTime() * 1000.0f;
+  float update_ms = WaterFFTThread::UpdateTime() * 1000.0f;
+  Evaluate(frame_ms, update_ms);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the current quality level.
+///
+/// @return The level. Zero is the cheapest level.
+///////////////////////////////////////////////////////////////////////////////
+unsigned WaterGovernor::Level()
+{
+  return m_Level;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the number of quality levels.
+///
+/// @return The number of levels.
+///////////////////////////////////////////////////////////////////////////////
+unsigned WaterGovernor::LevelCount()
+{
+  return sizeof(quality_levels) / sizeof(QualityLevel);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Closes the decision log.
+///////////////////////////////////////////////////////////////////////////////
+void WaterGovernor::Purge()
+{
+  if (m_Log.is_open())
+    m_Log.close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Decides whether the level should change.
+///
+/// @param frame_ms The average time spent working on a frame.
+/// @param update_ms The average time spent on a WaterFFT update.
+///////////////////////////////////////////////////////////////////////////////
+void WaterGovernor::Evaluate(float frame_ms, float update_ms)
+{
+  if (m_Cooldown > 0)
+  {
+    --m_Cooldown;
+    return;
+  }
+  float sim_load = update_ms * quality_levels[m_Level].m_StepRate / 1000.0f;
+  bool over = frame_ms > m_Budget || sim_load > WATER_GOVERNOR_MAX_SIM_LOAD;
+  bool under = frame_ms < m_Budget * WATER_GOVERNOR_RAISE_FRACTION &&
+    sim_load < WATER_GOVERNOR_RAISE_SIM_LOAD;
+  m_OverCount = over ? m_OverCount + 1 : 0;
+  m_UnderCount = under ? m_UnderCount + 1 : 0;
+  if (m_OverCount >= WATER_GOVERNOR_DROP_COUNT && m_Level > 0)
+  {
+    // a raise that could not be kept makes the next raise wait longer
+    if (m_LastRaised && m_UpgradeCount < WATER_GOVERNOR_MAX_RAISE_COUNT)
+      m_UpgradeCount *= 2;
+    m_LastRaised = false;
+    Apply(m_Level - 1, frame_ms, update_ms);
+  }
+  else if (m_UnderCount >= m_UpgradeCount && m_Level + 1 < LevelCount())
+  {
+    m_LastRaised = true;
+    Apply(m_Level + 1, frame_ms, update_ms);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Changes the level and logs the decision. The WaterFFT is only
+/// rebuilt when the grid dimension or expansion changes.
+///
+/// @param level The new level.
+/// @param frame_ms The frame time that led to the decision.
+/// @param update_ms The update time that led to the decision.
+///////////////////////////////////////////////////////////////////////////////
+void WaterGovernor::Apply(unsigned level, float frame_ms, float update_ms)
+{
+  const QualityLevel & previous = quality_levels[m_Level];
+  const QualityLevel & next = quality_levels[level];
+  m_Log << std::fixed << std::setprecision(2) << "[" << m_EvaluationTime
+    << "s] level " << m_Level << " -> " << level << " (grid "
+    << next.m_GridDimension << ", " << next.m_StepRate << " Hz, expansion "
+    << next.m_Expansion << "): frame " << frame_ms << " ms of " << m_Budget
+    << " ms, update " << update_ms << " ms at " << previous.m_StepRate
+    << " Hz";
+  if (level < m_Level)
+    m_Log << ", next raise after " << m_UpgradeCount << " evaluations";
+  m_Log << std::endl;
+  if (next.m_GridDimension != previous.m_GridDimension ||
+    next.m_Expansion != previous.m_Expansion)
+    WaterFFTThread::Restart(next.m_GridDimension, next.m_Expansion);
+  WaterFFTThread::StepRate(next.m_StepRate);
+  m_Level = level;
+  m_OverCount = 0;
+  m_UnderCount = 0;
+  m_Cooldown = WATER_GOVERNOR_COOLDOWN;
+}
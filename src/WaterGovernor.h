@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////
+/// @file WaterGovernor.h
+/// @date 2026-10-17
+///
+/// @brief Contains the interface for the WaterGovernor. It changes the
+/// quality of the water simulation so frames stay within a time budget.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <fstream>
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief
+/// Watches the time spent on each frame and on each WaterFFT update and moves
+/// between quality levels to stay within a budget. A level sets the grid
+/// dimension, the simulation step rate, and the number of instances along
+/// each side of the water.
+///
+/// A level is dropped when the budget is exceeded for a few evaluations in a
+/// row and raised only after a longer run of evaluations well under the
+/// budget. No evaluations are made for a short time after a change so the
+/// measurements can settle. When a raised level has to be dropped again,
+/// the next raise has to wait twice as long. Every change is written to
+/// WATER_GOVERNOR_LOG_FILENAME.
+///
+/// Important Notes
+/// - Call Update once per frame after Framer::End.
+/// - The governor does nothing until a budget is set.
+/// - Changing the grid dimension or expansion rebuilds the WaterFFT, so it
+///   must happen on the rendering thread.
+///////////////////////////////////////////////////////////////////////////////
+class WaterGovernor
+{
+public:
+  static void Budget(float milliseconds);
+  static float Budget();
+  static void Update();
+  static unsigned Level();
+  static unsigned LevelCount();
+  static void Purge();
+private:
+  WaterGovernor() {}
+  static void Evaluate(float frame_ms, float update_ms);
+  static void Apply(unsigned level, float frame_ms, float update_ms);
+  //! The frame time budget in milliseconds. Zero disables the governor.
+  static float m_Budget;
+  //! The current quality level.
+  static unsigned m_Level;
+  //! The exact time of the previous evaluation.
+  static double m_EvaluationTime;
+  //! The number of evaluations in a row that went over the budget.
+  static unsigned m_OverCount;
+  //! The number of evaluations in a row that were well under the budget.
+  static unsigned m_UnderCount;
+  //! The number of evaluations in a row needed before the level is raised.
+  static unsigned m_UpgradeCount;
+  //! The number of evaluations that are skipped after a change.
+  static unsigned m_Cooldown;
+  //! Identifies whether the most recent change raised the level.
+  static bool m_LastRaised;
+  //! The file every decision is written to.
+  static std::ofstream m_Log;
+};
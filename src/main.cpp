@@ -1,250 +1,535 @@
-//////////////////////////////////////////////////////////////////////////////
-/// @file main.cpp
-/// @author Connor Deakin
-/// @email connor.deakin@digipen.edu
-/// @date 2017-22-5
-///
-/// @brief
-/// Entry point for water simulation testing.
-///////////////////////////////////////////////////////////////////////////////
-#pragma once
-
-#include <iostream>
-#include <fstream>
-#include <utility>
-
-#include <GL/glew.h>
-#include <GLM/glm/gtc/type_ptr.hpp>
-#include "ext/imgui.h"
-#include "ext/imgui_impl_sdl_gl3.h"
-
-#include "Context.h"
-#include "OpenGLContext.h"
-#include "GenericAction.h"
-#include "Time.h"
-#include "Error.h"
-#include "Camera.h"
-#include "CameraController.h"
-#include "ShaderLibrary.h"
-#include "Framer.h"
-
-
-#include "Water.h"
-#include "WaterFFT.h"
-
-#define SHOW_BASIS
-//#define WATER_GERSTNER
-
-class vec3
-{
-public:
-  vec3(float x, float y, float z) : 
-    x(x), y(y), z(z) {}
-  union {
-    struct {
-      float x, y, z;
-    };
-    struct {
-      float r, g, b;
-    };
-  };
-};
-
-// temporary
-GLuint x_axis_vbo;
-GLuint y_axis_vbo;
-GLuint z_axis_vbo;
-GLuint test_vbo;
-
-GLuint x_axis_vao;
-GLuint y_axis_vao;
-GLuint z_axis_vao;
-GLuint test_vao;
-
-glm::vec2 location(0.0f, 0.0f);
-
-LineShader * line_shader;
-// temporary
-
-
-bool demo_mode = false;
-bool editor_show = true;
-vec3 editor_clear_color(0.0f, 0.0f, 0.0f);
-float editor_height_scale = 0.35;
-float editor_displace_scale = 0.35f;
-
-inline void WindowInit()
-{
-  Context::Create("Water", true, OpenGLContext::AdjustViewport);
-  OpenGLContext::Initialize();
-  Context::CheckEvents();
-}
-
-inline void InitialUpdate()
-{
-  Time::Update();
-  ImGui_ImplSdlGL3_NewFrame(Context::SDLWindow());
-  Context::CheckEvents();
-  GenericAction::UpdateAll();
-}
-
-void EditorUpdate()
-{
-  if ((Input::KeyDown(Key::SHIFTLEFT) || Input::KeyDown(Key::SHIFTRIGHT)) && Input::KeyPressed(Key::H))
-      editor_show = !editor_show;
-  if (!editor_show) 
-    return;
-  ImGui::Begin("Editor");
-  if (ImGui::CollapsingHeader("Debug Info")) 
-  {
-    ImGui::Text("Time Passed: %f", Time::TotalTime());
-    ImGui::Text("FPS: %f", Framer::AverageFPS());
-    ImGui::Text("Frame Usage: %f", Framer::AverageFrameUsage());
-  }
-  if (ImGui::CollapsingHeader("Global Properties")) 
-  {
-    ImGui::DragFloat("Time Scale", &Time::m_TimeScale, 0.01f);
-  }
-  if (ImGui::CollapsingHeader("Hotkeys")) 
-  {
-    ImGui::BulletText("Hide/Show Editor: Shift + H");
-  }
-  #ifndef WATER_GERSTNER
-  if (ImGui::CollapsingHeader("Other"))
-  {
-    ImGui::DragFloat("Height Scale", &editor_height_scale, 0.01f);
-    ImGui::DragFloat("Displace Scale", &editor_displace_scale, 0.01f);
-  }
-  WaterFFTHolder::GetWaterFFT()->m_HeightScale = editor_height_scale;
-  WaterFFTHolder::GetWaterFFT()->m_DisplaceScale = editor_displace_scale;
-  #endif // !WATER_GERSTNER
-  ImGui::End();
-}
-
-class Simulation
-{
-public:
-  Simulation() {}
-  void Initialize(bool run_gerstner);
-  void Clean();
-  void Run(Camera * cam);
-  bool gerstner;
-  Water * water;
-  WaterFFT * water_fft;
-};
-
-void Simulation::Initialize(bool run_gerstner)
-{
-  gerstner = run_gerstner;
-  if(gerstner)
-  {
-    water = new Water(100, 100);
-    WaterGerstnerRenderer::SetWater(water);
-    WaterEditor::SetWater(water);
-    WaterEditor::m_Show = true;
-  }
-  else
-  {
-    WaterFFTHolder::Initialize();
-    water_fft = WaterFFTHolder::GetWaterFFT();
-    const GLfloat * vbuff = (GLfloat *)water_fft->VertexBuffer();
-    const GLuint * ibuff = (GLuint *)water_fft->IndexBuffer();
-    const GLfloat * obuff = (GLfloat *)water_fft->OffsetBuffer();
-    unsigned vbuff_sb = water_fft->VertexBufferSizeBytes();
-    unsigned ibuff_sb = water_fft->IndexBufferSizeBytes();
-    unsigned ibuff_s = water_fft->IndexBufferSize();
-    unsigned obuff_sb = water_fft->OffsetBufferSizeBytes();
-    unsigned obuff_s = water_fft->OffsetBufferSize();
-    WaterRenderer::SetBuffers(vbuff, 
-                              ibuff,
-                              obuff,
-                              vbuff_sb,
-                              ibuff_sb,
-                              ibuff_s, obuff_sb,
-                              obuff_s);
-    //water_fft->UseIntensityMap("intensity0.png");
-    WaterFFTThread::Execute(Time::TotalTimeScaled);
-  }
-}
-
-void Simulation::Clean()
-{
-  if(!gerstner)
-  {
-    WaterFFTThread::Terminate();
-    WaterFFTHolder::Purge();
-  }
-}
-
-void Simulation::Run(Camera * cam)
-{
-  if(gerstner)
-  {
-    if(editor_show)
-      WaterEditor::DisplayEditor();
-    water->Update();
-    WaterGerstnerRenderer::Render();
-  }
-  else
-  {
-    WaterFFTThread::Wait();
-    glm::mat4 projection = glm::perspective(glm::radians(90.0f),
-      OpenGLContext::AspectRatio(), 0.1f, 1000.0f);
-    WaterRenderer::Render(cam->Location(), projection, cam->WorldToCamera());
-  }
-}
-
-int main(int argc, char * argv[])
-{
-  ErrorLog::Clean();
-  try {
-
-    WindowInit();
-    ImGui_ImplSdlGL3_Init(Context::SDLWindow());
-    Context::AddEventProcessor(ImGui_ImplSdlGL3_ProcessEvent);
-    glEnable(GL_DEPTH_TEST);
-
-    Camera * pcam = new Camera(); 
-    CameraController controller(*pcam);
-    controller.Update();
-
-    glm::mat4 model();
-    glm::vec3 light_position(1000.0f, 100.0f, -1000.0f); 
-    vec3 clear_color(0.0f, 0.0f, 0.0f);
-
-    Framer::Lock(60);
-
-    Simulation water_sim;
-    water_sim.Initialize(false);
-
-
-// NOTES
-// 373
-
-    while (Context::KeepOpen()) 
-    {
-      Framer::Start();
-      InitialUpdate();
-      controller.Update();
-
-      water_sim.Run(pcam);
-
-      EditorUpdate();
-      ImGui::Render();
-      OpenGLContext::Swap();
-      glClearColor(clear_color.r, clear_color.g, clear_color.b, 1.0f);
-      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-      Framer::End();
-    }
-    OpenGLContext::Purge();
-    Context::Purge();
-  }
-  catch (const RootError & error) {
-    ErrorLog::Write(error);
-  }
-  catch (Error & error) {
-    error.Add("> UNCAUGHT ERROR");
-    ErrorLog::Write(error);
-  }
-  return 0;
-}
+//////////////////////////////////////////////////////////////////////////////
+/// @file main.cpp
+/// @author Connor Deakin
+/// @email connor.deakin@digipen.edu
+/// @date 2017-22-5
+///
+/// @brief
+/// Entry point for water simulation testing.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <utility>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#include <GL/glew.h>
+#include <GLM/glm/gtc/type_ptr.hpp>
+#include "ext/imgui.h"
+#include "ext/imgui_impl_sdl_gl3.h"
+
+#include "Context.h"
+#include "OpenGLContext.h"
+#include "GenericAction.h"
+#include "Time.h"
+#include "Error.h"
+#include "Camera.h"
+#include "CameraController.h"
+#include "ShaderLibrary.h"
+#include "Framer.h"
+
+
+#include "Buoyancy.h"
+#include "FrameStream.h"
+#include "Water.h"
+#include "WaterFFT.h"
+#include "WaterGovernor.h"
+
+#define SHOW_BASIS
+//#define WATER_GERSTNER
+
+class vec3
+{
+public:
+  vec3(float x, float y, float z) : 
+    x(x), y(y), z(z) {}
+  union {
+    struct {
+      float x, y, z;
+    };
+    struct {
+      float r, g, b;
+    };
+  };
+};
+
+// temporary
+GLuint x_axis_vbo;
+GLuint y_axis_vbo;
+GLuint z_axis_vbo;
+GLuint test_vbo;
+
+GLuint x_axis_vao;
+GLuint y_axis_vao;
+GLuint z_axis_vao;
+GLuint test_vao;
+
+glm::vec2 location(0.0f, 0.0f);
+
+LineShader * line_shader;
+// temporary
+
+
+bool demo_mode = false;
+bool editor_show = true;
+vec3 editor_clear_color(0.0f, 0.0f, 0.0f);
+float editor_height_scale = 0.35;
+float editor_displace_scale = 0.35f;
+// The floating crates added with -bodies.
+Buoyancy * demo_bodies = nullptr;
+
+inline void WindowInit()
+{
+  Context::Create("Water", true, OpenGLContext::AdjustViewport);
+  OpenGLContext::Initialize();
+  Context::CheckEvents();
+}
+
+inline void InitialUpdate()
+{
+  Time::Update();
+  ImGui_ImplSdlGL3_NewFrame(Context::SDLWindow());
+  Context::CheckEvents();
+  GenericAction::UpdateAll();
+}
+
+void EditorUpdate()
+{
+  if ((Input::KeyDown(Key::SHIFTLEFT) || Input::KeyDown(Key::SHIFTRIGHT)) && Input::KeyPressed(Key::H))
+      editor_show = !editor_show;
+  if (!editor_show) 
+    return;
+  ImGui::Begin("Editor");
+  if (ImGui::CollapsingHeader("Debug Info")) 
+  {
+    ImGui::Text("Time Passed: %f", Time::TotalTime());
+    ImGui::Text("FPS: %f", Framer::AverageFPS());
+    ImGui::Text("Frame Usage: %f", Framer::AverageFrameUsage());
+    #ifndef WATER_GERSTNER
+    ImGui::Text("Water Update: %f ms", WaterFFTThread::UpdateTime() * 1000.0f);
+    ImGui::Text("Quality Level: %u / %u", WaterGovernor::Level(),
+      WaterGovernor::LevelCount() - 1);
+    WaterFFT * water = WaterFFTHolder::GetWaterFFT();
+    if (WaterFFTHolder::GetWake())
+      ImGui::Text("Wakes: %u ships in view",
+        WaterFFTHolder::GetWake()->ActiveShips());
+    if (demo_bodies)
+    {
+      float submerged = 0.0f;
+      for (unsigned i = 0; i < demo_bodies->BodyCount(); ++i)
+        submerged += demo_bodies->SubmergedVolume(i);
+      ImGui::Text("Bodies: %u floating, %f m^3 submerged",
+        demo_bodies->BodyCount(), submerged);
+    }
+    ImGui::Text("Spectrum: %u / %u active, %f%% energy lost",
+      water->SpectrumActiveCount(), water->SpectrumCount(),
+      water->SpectrumEnergyLoss() * 100.0f);
+    #endif // !WATER_GERSTNER
+  }
+  if (ImGui::CollapsingHeader("Global Properties")) 
+  {
+    ImGui::DragFloat("Time Scale", &Time::m_TimeScale, 0.01f);
+  }
+  if (ImGui::CollapsingHeader("Hotkeys")) 
+  {
+    ImGui::BulletText("Hide/Show Editor: Shift + H");
+    ImGui::BulletText("Splash Below Camera: Shift + R (with -ripple)");
+  }
+  #ifndef WATER_GERSTNER
+  if (ImGui::CollapsingHeader("Other"))
+  {
+    ImGui::DragFloat("Height Scale", &editor_height_scale, 0.01f);
+    ImGui::DragFloat("Displace Scale", &editor_displace_scale, 0.01f);
+  }
+  WaterFFTHolder::GetWaterFFT()->m_HeightScale = editor_height_scale;
+  WaterFFTHolder::GetWaterFFT()->m_DisplaceScale = editor_displace_scale;
+  #endif // !WATER_GERSTNER
+  ImGui::End();
+}
+
+// Sails demo ships in circles around the origin so their wakes can be seen.
+void UpdateDemoShips(Wake * wake, unsigned count, float time)
+{
+  std::vector<ShipTrack> ships(count);
+  for (unsigned i = 0; i < count; ++i)
+  {
+    float radius = 60.0f + 25.0f * (float)i;
+    float speed = 5.0f + (float)(i % 5);
+    float angle = speed / radius * time + (float)i;
+    ships[i].m_Location = glm::vec2(cos(angle), sin(angle)) * radius;
+    // The tangent of the circle is a quarter turn from the radius.
+    ships[i].m_Heading = angle + 1.57079633f;
+    ships[i].m_Speed = speed;
+  }
+  wake->SetShips(ships.data(), count);
+}
+
+// Drops crates on a grid around the origin. Each crate is a 2 x 1 x 4 meter
+// box that is 60% as dense as the water.
+void AddDemoBodies(Buoyancy * bodies, unsigned count)
+{
+  glm::vec3 corners[8];
+  for (unsigned i = 0; i < 8; ++i)
+    corners[i] = glm::vec3(i & 1 ? 1.0f : -1.0f, i & 2 ? 0.5f : -0.5f,
+      i & 4 ? 2.0f : -2.0f);
+  const unsigned faces[36] = { 0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5,
+    0, 4, 5, 0, 5, 1, 2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3 };
+  unsigned columns = (unsigned)std::ceil(std::sqrt((float)count));
+  for (unsigned i = 0; i < count; ++i)
+  {
+    BodyState state;
+    state.m_Position = glm::vec3(8.0f * (float)(i % columns),
+      2.0f, 8.0f * (float)(i / columns)) -
+      glm::vec3(4.0f * (float)columns, 0.0f, 4.0f * (float)columns);
+    state.m_Orientation = glm::angleAxis((float)i, glm::vec3(0.0f, 1.0f,
+      0.0f));
+    state.m_Velocity = glm::vec3(0.0f);
+    state.m_AngularVelocity = glm::vec3(0.0f);
+    bodies->AddHull(corners, faces, 12, 0.5f, 0.6f * 8.0f * 1025.0f, state);
+  }
+}
+
+class Simulation
+{
+public:
+  Simulation() {}
+  void Initialize(bool run_gerstner);
+  void Clean();
+  void Run(Camera * cam);
+  void PlayStream();
+  bool gerstner;
+  unsigned demo_ships;
+  //! Replaces the simulation when it is set.
+  FrameStreamReader * playback;
+  Water * water;
+};
+
+void Simulation::Initialize(bool run_gerstner)
+{
+  gerstner = run_gerstner;
+  if(gerstner)
+  {
+    water = new Water(100, 100);
+    WaterGerstnerRenderer::SetWater(water);
+    WaterEditor::SetWater(water);
+    WaterEditor::m_Show = true;
+  }
+  else
+  {
+    // A recording is played on a WaterFFT of the same size, which gives
+    // the renderer its index and offset buffers.
+    if (playback)
+      WaterFFTHolder::Initialize(playback->XVertices() - 1);
+    else
+      WaterFFTHolder::Initialize();
+    WaterFFT * water_fft = WaterFFTHolder::GetWaterFFT();
+    if (playback && (playback->ZVertices() != playback->XVertices() ||
+      playback->XLength() != water_fft->XLength() ||
+      playback->ZLength() != water_fft->ZLength()))
+    {
+      Error error("main.cpp", "Simulation::Initialize");
+      error.Add("Only streams recorded by this program can be played.");
+      throw(error);
+    }
+    WaterFFTHolder::ShareBuffers();
+    //water_fft->UseIntensityMap("intensity0.png");
+    if (!playback)
+      WaterFFTThread::Execute(Time::TotalTimeScaledPrecise);
+  }
+}
+
+void Simulation::Clean()
+{
+  if(!gerstner)
+  {
+    if (!playback)
+      WaterFFTThread::Terminate();
+    WaterFFTHolder::Purge();
+    WaterFFTHolder::Ripples(false);
+    WaterFFTHolder::Wakes(false);
+    WaterFFTHolder::Stream("");
+    delete playback;
+    playback = nullptr;
+    delete demo_bodies;
+    demo_bodies = nullptr;
+  }
+}
+
+void Simulation::Run(Camera * cam)
+{
+  if(gerstner)
+  {
+    if(editor_show)
+      WaterEditor::DisplayEditor();
+    water->Update();
+    WaterGerstnerRenderer::Render();
+  }
+  else
+  {
+    Ripple * ripple = WaterFFTHolder::GetRipple();
+    if (ripple)
+    {
+      glm::vec2 below(cam->Location().x, cam->Location().z);
+      ripple->Recenter(below);
+      if ((Input::KeyDown(Key::SHIFTLEFT) || Input::KeyDown(Key::SHIFTRIGHT))
+        && Input::KeyPressed(Key::R))
+      {
+        RippleSource splash = { below, 4.0f, 1.0f };
+        ripple->Disturb(&splash, 1);
+      }
+    }
+    Wake * wake = WaterFFTHolder::GetWake();
+    if (wake)
+    {
+      wake->Recenter(glm::vec2(cam->Location().x, cam->Location().z));
+      UpdateDemoShips(wake, demo_ships, Time::TotalTimeScaled());
+    }
+    if (playback)
+      PlayStream();
+    else
+      WaterFFTThread::Wait();
+    // Long frames are capped so the bodies do not jump through the water.
+    // The WaterFFT is fetched every frame because the governor replaces it
+    // when it changes the grid.
+    if (demo_bodies)
+      demo_bodies->Step(*WaterFFTHolder::GetWaterFFT(),
+        glm::min(Time::DTScaled(), 1.0f / 30.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f),
+      OpenGLContext::AspectRatio(), 0.1f, 1000.0f);
+    WaterRenderer::Render(cam->Location(), projection, cam->WorldToCamera());
+  }
+}
+
+// Shows the recorded frames around the current time. The frames are decoded
+// straight into the renderer's vertex buffers and the recording loops.
+void Simulation::PlayStream()
+{
+  unsigned frames = playback->Frames();
+  unsigned previous = 0;
+  unsigned current = 0;
+  float alpha = 1.0f;
+  if (frames > 1)
+  {
+    double first = playback->FrameTime(0);
+    double length = playback->FrameTime(frames - 1) - first;
+    double time = first + std::fmod(Time::TotalTimeScaledPrecise(), length);
+    previous = glm::min(playback->FrameAt(time), frames - 2);
+    current = previous + 1;
+    double previous_time = playback->FrameTime(previous);
+    alpha = (float)((time - previous_time) /
+      (playback->FrameTime(current) - previous_time));
+    alpha = glm::clamp(alpha, 0.0f, 1.0f);
+  }
+  WaterRenderer::SetVertexBuffers((int)previous, (int)current, alpha,
+    [this](int frame, GLfloat * vertices)
+    { playback->Read((unsigned)frame, vertices); });
+}
+
+// Command line options
+//  -record <file>  Records the input for every frame to a file.
+//  -replay <file>  Replays a recording with a hidden window as a benchmark.
+//  -step <seconds> The fixed time step used during a replay. Use zero to use
+//                  the delta times stored in the recording.
+//  -budget <ms>    Lets the WaterGovernor change the water quality to keep
+//                  frames within a budget.
+//  -ripple         Adds the interactive ripple layer to the water.
+//  -ships <count>  Adds Kelvin wakes and sails count demo ships.
+//  -bodies <count> Floats count crates on the water.
+//  -publish <name> Publishes every water frame to shared memory so other
+//                  processes can read it with a FrameReader.
+//  -stream <file>  Records every water frame to a compressed stream.
+//  -play <file>    Plays a stream recorded with -stream instead of running
+//                  the simulation. This can not be used with -bodies.
+//  -seed <value>   Builds the spectrum from a seed and uses deterministic
+//                  FFT plans, so another process given the same seed and
+//                  time computes the same surface.
+//  -builtin_fft    Computes the ffts with FFT2D instead of FFTW.
+struct Options
+{
+  Options(int argc, char * argv[]);
+  const char * record_file;
+  const char * replay_file;
+  float replay_step;
+  float budget;
+  bool half_precision;
+  bool builtin_fft;
+  float spectrum_threshold;
+  bool ripples;
+  unsigned ships;
+  unsigned bodies;
+  const char * publish_name;
+  bool seeded;
+  uint64_t seed;
+  const char * stream_file;
+  const char * play_file;
+};
+
+Options::Options(int argc, char * argv[]) :
+  record_file(nullptr), replay_file(nullptr), replay_step(1.0f / 60.0f),
+  budget(0.0f), half_precision(false), builtin_fft(false),
+  spectrum_threshold(0.0f),
+  ripples(false), ships(0), bodies(0), publish_name(nullptr),
+  seeded(false), seed(WATER_DEFAULT_SEED), stream_file(nullptr),
+  play_file(nullptr)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    if (!strcmp(argv[i], "-half"))
+      half_precision = true;
+    else if (!strcmp(argv[i], "-builtin_fft"))
+      builtin_fft = true;
+    else if (!strcmp(argv[i], "-ripple"))
+      ripples = true;
+    else if (i + 1 == argc)
+      break;
+    else if (!strcmp(argv[i], "-record"))
+      record_file = argv[++i];
+    else if (!strcmp(argv[i], "-replay"))
+      replay_file = argv[++i];
+    else if (!strcmp(argv[i], "-step"))
+      replay_step = (float)atof(argv[++i]);
+    else if (!strcmp(argv[i], "-budget"))
+      budget = (float)atof(argv[++i]);
+    else if (!strcmp(argv[i], "-sparse"))
+      spectrum_threshold = (float)atof(argv[++i]);
+    else if (!strcmp(argv[i], "-ships"))
+      ships = (unsigned)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-bodies"))
+      bodies = (unsigned)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-publish"))
+      publish_name = argv[++i];
+    else if (!strcmp(argv[i], "-seed"))
+    {
+      seeded = true;
+      seed = strtoull(argv[++i], nullptr, 0);
+    }
+    else if (!strcmp(argv[i], "-stream"))
+      stream_file = argv[++i];
+    else if (!strcmp(argv[i], "-play"))
+      play_file = argv[++i];
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  ErrorLog::Clean();
+  try {
+
+    Options options(argc, argv);
+    // The bodies sample the WaterFFT's buffers, which a recording does not
+    // fill.
+    if (options.play_file && options.bodies > 0)
+    {
+      Error error("main.cpp", "main");
+      error.Add("-bodies can not be used with -play.");
+      throw(error);
+    }
+    WindowInit();
+    ImGui_ImplSdlGL3_Init(Context::SDLWindow());
+    Context::AddEventProcessor(ImGui_ImplSdlGL3_ProcessEvent);
+    glEnable(GL_DEPTH_TEST);
+
+    Camera * pcam = new Camera(); 
+    CameraController controller(*pcam);
+    controller.Update();
+
+    glm::mat4 model();
+    glm::vec3 light_position(1000.0f, 100.0f, -1000.0f); 
+    vec3 clear_color(0.0f, 0.0f, 0.0f);
+
+    Framer::Lock(60);
+
+    WaterFFTHolder::HalfPrecision(options.half_precision);
+    WaterFFTHolder::BuiltinFFT(options.builtin_fft);
+    WaterFFTHolder::SpectrumThreshold(options.spectrum_threshold);
+    if (options.seeded)
+    {
+      WaterFFTHolder::Deterministic(true);
+      WaterFFTHolder::Seed(options.seed);
+    }
+    WaterFFTHolder::Ripples(options.ripples);
+    WaterFFTHolder::Wakes(options.ships > 0);
+    if (options.publish_name)
+      WaterFFTHolder::Publish(options.publish_name);
+    if (options.stream_file)
+      WaterFFTHolder::Stream(options.stream_file);
+    Simulation water_sim;
+    water_sim.demo_ships = options.ships;
+    water_sim.playback = nullptr;
+    if (options.play_file)
+      water_sim.playback = new FrameStreamReader(options.play_file);
+    water_sim.Initialize(false);
+    if (options.bodies > 0)
+    {
+      demo_bodies = new Buoyancy();
+      AddDemoBodies(demo_bodies, options.bodies);
+    }
+
+    // The editor parameters are recorded so a replay changes them at the
+    // same frames.
+    Input::TrackValue(&Time::m_TimeScale);
+    Input::TrackValue(&editor_height_scale);
+    Input::TrackValue(&editor_displace_scale);
+    if (options.replay_file)
+    {
+      Context::HideWindow();
+      Framer::Unlock();
+      Input::Replay(options.replay_file, options.replay_step);
+    }
+    else if (options.record_file)
+      Input::Record(options.record_file);
+    // The governor restarts the simulation, which is not running during
+    // playback.
+    if (options.budget > 0.0f && !water_sim.playback)
+      WaterGovernor::Budget(options.budget);
+    unsigned frames = 0;
+    double start_time = Time::TotalTimeExact();
+
+
+// NOTES
+// 373
+
+    while (Context::KeepOpen()) 
+    {
+      Framer::Start();
+      InitialUpdate();
+      controller.Update();
+
+      water_sim.Run(pcam);
+
+      EditorUpdate();
+      ImGui::Render();
+      OpenGLContext::Swap();
+      glClearColor(clear_color.r, clear_color.g, clear_color.b, 1.0f);
+      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+      Framer::End();
+      WaterGovernor::Update();
+      ++frames;
+    }
+    Input::StopRecording();
+    WaterGovernor::Purge();
+    // This finishes the stream file that -stream records to.
+    water_sim.Clean();
+    if (options.replay_file)
+    {
+      float run_time = (float)(Time::TotalTimeExact() - start_time);
+      std::cout << "Replayed " << frames << " frames in " << run_time
+        << " seconds (" << 1000.0f * run_time / (float)frames
+        << " ms per frame)" << std::endl;
+    }
+    OpenGLContext::Purge();
+    Context::Purge();
+  }
+  catch (const RootError & error) {
+    ErrorLog::Write(error);
+  }
+  catch (Error & error) {
+    error.Add("> UNCAUGHT ERROR");
+    ErrorLog::Write(error);
+  }
+  ErrorLog::Purge();
+  return 0;
+}